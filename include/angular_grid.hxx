@@ -19,6 +19,16 @@ namespace angular_grid {
       , int const echo=0 // log-level
   ); // declaration only
 
+  status_t transform( // several blocks with the same ellmax in a single matrix-matrix multiplication
+        double *const out[] // resulting matrices, one per block
+      , double const *const in[] // input matrices, one per block
+      , int const nblocks // number of blocks
+      , int const stride[] // strides for in[ib] and out[ib]
+      , int const ellmax // largest angular momentum
+      , bool const back=false // backtransform?
+      , int const echo=0 // log-level
+  ); // declaration only
+
   std::vector<gaunt_entry_t> create_numerical_Gaunt(int const ellmax, int const echo=0); // declaration only
 
   void cleanup(int const echo=0); // declaration only
@@ -3,10 +3,12 @@
 
 #include <cstdio> // std::printf, ::snprintf
 #include <algorithm> // std::min, ::max
-#include <cmath> // std::round, ::sqrt
+#include <cmath> // std::round, ::sqrt, ::abs
+#include <cstdint> // int8_t, int32_t
+#include <vector> // std::vector<T>
 
 #include "status.hxx" // status_t
-#include "data_view.hxx" // view2D, view4D
+#include "data_view.hxx" // view2D, view3D, view4D
 #include "inline_math.hxx" // set, pow2, product, is_integer
 #include "print_tools.hxx" // printf_vector
 
@@ -22,6 +24,8 @@ namespace brillouin_zone {
       , unsigned const nv[3] // grid along each dimension
       , bool const complex_phase_factors=true
       , int const echo=0 // log-level
+      , int8_t const (*symmetries)[3][3]=nullptr // point group operations acting on k-vectors in units of the reciprocal lattice
+      , int const nsymmetries=0 // number of operations, 0: only time reversal
   ) {
       unsigned n[3];
       double shift[3];
@@ -45,89 +49,79 @@ namespace brillouin_zone {
           if (echo > 18) std::printf("# k-point mesh entry %9.6f %9.6f %9.6f weight= %g\n", xyzw[0],xyzw[1],xyzw[2], xyzw[3]);
       }}} // iz iy iz
 
-//       int const nsymmetries = 1;
-//       view3D<int8_t> symmetry(nsymmetries, 4, 4, 0); // use only the 3x3 sub matrices of the 4x4 memory chunks
-//       for (int d = 0; d < 3; ++d) symmetry(0,d,d) = -1; // time reversal
-
-      int8_t const rot_mat[24*3*3] = {
-         1,  0,  0,  0,  1,  0,  0,  0,  1,
-        -1,  0,  0,  0, -1,  0,  0,  0,  1,
-        -1,  0,  0,  0,  1,  0,  0,  0, -1,
-         1,  0,  0,  0, -1,  0,  0,  0, -1,
-         0,  1,  0,  1,  0,  0,  0,  0, -1,
-         0, -1,  0, -1,  0,  0,  0,  0, -1,
-         0, -1,  0,  1,  0,  0,  0,  0,  1,
-         0,  1,  0, -1,  0,  0,  0,  0,  1,
-         0,  0,  1,  0, -1,  0,  1,  0,  0,
-         0,  0, -1,  0, -1,  0, -1,  0,  0,
-         0,  0, -1,  0,  1,  0,  1,  0,  0,
-         0,  0,  1,  0,  1,  0, -1,  0,  0,
-        -1,  0,  0,  0,  0,  1,  0,  1,  0,
-        -1,  0,  0,  0,  0, -1,  0, -1,  0,
-         1,  0,  0,  0,  0, -1,  0,  1,  0,
-         1,  0,  0,  0,  0,  1,  0, -1,  0,
-         0,  0,  1,  1,  0,  0,  0,  1,  0,
-         0,  0, -1, -1,  0,  0,  0,  1,  0,
-         0,  0, -1,  1,  0,  0,  0, -1,  0,
-         0,  0,  1, -1,  0,  0,  0, -1,  0,
-         0,  1,  0,  0,  0,  1,  1,  0,  0,
-         0, -1,  0,  0,  0, -1,  1,  0,  0,
-         0, -1,  0,  0,  0,  1, -1,  0,  0,
-         0,  1,  0,  0,  0, -1, -1,  0,  0};
-
-      int const n24 = control::get("hamiltonian.kmesh.symmetries", 1.);
-      assert(n24 < 25);
-
+      // reduce the mesh to the irreducible wedge: the orbit of each k-point under
+      // the point group operations (and time reversal, k and -k produce the same density)
+      // is represented by its first member which collects the weights of the orbit
       int const has_inv = 1 + (control::get("hamiltonian.kmesh.inversion", 1.) > 0);
+      int8_t const identity[1][3][3] = {{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}};
+      auto const ops = (nsymmetries > 0 && nullptr != symmetries) ? symmetries : identity;
+      int const nops = (nsymmetries > 0 && nullptr != symmetries) ? nsymmetries : 1;
+
+      auto const map_kpoint = [&] (int jxyz[3], double const vec[3], int const iop, int const inv) {
+          // returns true if the image of vec is a point of the mesh
+          auto const f_inv = 1. - inv*2.;
+          bool on_mesh{true};
+          for (int d = 0; d < 3; ++d) {
+              double xyz{0};
+              for (int j = 0; j < 3; ++j) {
+                  xyz += f_inv*ops[iop][d][j] * vec[j];
+              } // j
+              // convert xyz to nearest integers
+              auto const x = n[d]*xyz + 0.5*shift[d];
+              jxyz[d] = int(std::round(x));
+              on_mesh = on_mesh && (std::abs(x - jxyz[d]) < 1e-9);
+              jxyz[d] = ((jxyz[d] % int(n[d])) + n[d]) % n[d];
+          } // d
+          return on_mesh;
+      }; // map_kpoint
+
+      // only operations that map the mesh onto itself can be used, they form a subgroup
+      std::vector<bool> use_op(nops, true);
+      int nops_used{0};
+      for (int iop = 0; iop < nops; ++iop) {
+          for (int iz = 0; iz < n[2]; ++iz) {
+          for (int iy = 0; iy < n[1]; ++iy) {
+          for (int ix = 0; ix < n[0]; ++ix) {
+              int jxyz[3];
+              use_op[iop] = use_op[iop] && map_kpoint(jxyz, full(iz,iy,ix), iop, 0);
+          }}} // iz iy iz
+          nops_used += use_op[iop];
+          if (!use_op[iop] && echo > 7) std::printf("# symmetry #%i does not map the k-point mesh onto itself\n", iop);
+      } // iop
 
+      view3D<int32_t> representative(n[2], n[1], n[0], -1);
       for (int iz = 0; iz < n[2]; ++iz) {
       for (int iy = 0; iy < n[1]; ++iy) {
       for (int ix = 0; ix < n[0]; ++ix) {
-          // apply time reversal symmetry (k and -k produce the same density)
-        double const *const vec = full(iz,iy,ix);
-        for (int inv = 0; inv < has_inv; ++inv) { // inversion symmetry
-          double const f_inv = 1. - inv*2.;
-          for (int s = 0; s < n24; ++s) {
-              double xyz[] = {0, 0, 0};
-              for (int i = 0; i < 3; ++i) {
-                  for (int j = 0; j < 3; ++j) {
-                      xyz[i] += f_inv*rot_mat[s*3*3 + i*3 + j] * vec[j];
-                  } // j
-              } // i
-          // convert xyz to nearest integers
-          int jxyz[3];
-          for (int d = 0; d < 3; ++d) {
-              jxyz[d] = int(std::round(n[d]*xyz[d] + 0.5*shift[d]));
-              if (jxyz[d] < 0) jxyz[d] += n[d];
-              assert(jxyz[d] < n[d]);
-          } // d
-          int const jx = jxyz[0], jy = jxyz[1], jz = jxyz[2];
-          if (echo > 16) {
-              std::printf("# symmetry #%i maps k-point", 0);
-              printf_vector(" %9.6f", full(iz,iy,ix), 3, " to");
-              printf_vector(" %9.6f", full(jz,jy,jx), 3);
-          } // echo
-
-          auto const w8 = full(jz,jy,jx,WEIGHT);
-          if (w8 > 0) {
-              double diff2{0};
-              for (int d = 0; d < 3; ++d) {
-                  diff2 += pow2(xyz[d] - full(jz,jy,jx,d));
-              } // d
-              if (diff2 < 1e-12) {
-                  // k + (-k) == nullvector, transfer weight to (iz,iy,ix)
-                  full(iz,iy,ix,WEIGHT) += w8;
-                  full(jz,jy,jx,WEIGHT) -= w8;
-                  if (echo > 14) {
-                      std::printf("# transfer k-point weight %g from", w8);
-                      printf_vector(" %9.6f", full(jz,jy,jx), 3, " to");
-                      printf_vector(" %9.6f", full(iz,iy,ix), 3);
+          if (representative(iz,iy,ix) >= 0) continue; // already member of an orbit
+          int const ixyz = (iz*n[1] + iy)*n[0] + ix;
+          representative(iz,iy,ix) = ixyz;
+          double const *const vec = full(iz,iy,ix);
+          for (int inv = 0; inv < has_inv; ++inv) { // time reversal
+              for (int iop = 0; iop < nops; ++iop) {
+                  if (!use_op[iop]) continue;
+                  int jxyz[3];
+                  map_kpoint(jxyz, vec, iop, inv);
+                  int const jx = jxyz[0], jy = jxyz[1], jz = jxyz[2];
+                  if (echo > 16) {
+                      std::printf("# symmetry #%i maps k-point", iop*has_inv + inv);
+                      printf_vector(" %9.6f", full(iz,iy,ix), 3, " to");
+                      printf_vector(" %9.6f", full(jz,jy,jx), 3);
                   } // echo
-              } // d2 is zero
-          } // w8 > 0
-
-          } // s
-        } // inv
+                  if (representative(jz,jy,jx) < 0) {
+                      representative(jz,jy,jx) = ixyz;
+                      auto const w8 = full(jz,jy,jx,WEIGHT);
+                      // transfer weight to (iz,iy,ix)
+                      full(iz,iy,ix,WEIGHT) += w8;
+                      full(jz,jy,jx,WEIGHT) -= w8;
+                      if (echo > 14) {
+                          std::printf("# transfer k-point weight %g from", w8);
+                          printf_vector(" %9.6f", full(jz,jy,jx), 3, " to");
+                          printf_vector(" %9.6f", full(iz,iy,ix), 3);
+                      } // echo
+                  } // not assigned yet
+              } // iop
+          } // inv
       }}} // iz iy iz
 
       // copy kpoints with positive weight into result list
@@ -160,7 +154,7 @@ namespace brillouin_zone {
 
       auto const fraction = nmesh*wfull; // == nmesh/(n[X]*n[Y]*n[Z])
       if (echo > 3) std::printf("# k-point mesh with %d x %d x %d has %d points, %g %%, %g of %d\n",
-                                 n[0],n[1],n[2], nmesh, fraction*100, 1/fraction, has_inv*24);
+                                 n[0],n[1],n[2], nmesh, fraction*100, 1/fraction, has_inv*nops_used);
       return nmesh;
   } // get_kpoint_mesh
 
@@ -178,7 +172,8 @@ namespace brillouin_zone {
 
   inline int get_kpoint_mesh(
         view2D<double> & mesh
-      // , bool const complex_phase_factors=true
+      , int8_t const (*symmetries)[3][3]=nullptr // optional point group operations, see above
+      , int const nsymmetries=0
   ) {
       unsigned nv[3];
       auto const iso = control::get("hamiltonian.kmesh", 1.); // isotropic default value
@@ -187,7 +182,7 @@ namespace brillouin_zone {
       nv[2]          = control::get("hamiltonian.kmesh.z", iso);
       int const echo = control::get("hamiltonian.kmesh.echo", 0.);
       int const cmpl = control::get("hamiltonian.kmesh.complex", 1.);
-      return get_kpoint_mesh(mesh, nv, (0 != cmpl), echo);
+      return get_kpoint_mesh(mesh, nv, (0 != cmpl), echo, symmetries, nsymmetries);
   } // get_kpoint_mesh
 
 
@@ -273,11 +268,39 @@ namespace brillouin_zone {
       return (nm < 1); // error if less than 1 (the Gamma points) is in the mesh
   } // test_mesh
 
+  inline status_t test_cubic_reduction(int const echo=0) {
+      // the full cubic group has 48 operations: all signed permutations
+      int8_t ops[48][3][3];
+      int8_t constexpr permutation[6][3] = {{0,1,2},{1,2,0},{2,0,1},{2,1,0},{0,2,1},{1,0,2}};
+      for (int i48 = 0; i48 < 48; ++i48) {
+          for (int i = 0; i < 3; ++i) {
+              for (int j = 0; j < 3; ++j) ops[i48][i][j] = 0;
+              ops[i48][i][permutation[i48 >> 3][i]] = 1 - 2*((i48 >> i) & 0x1);
+          } // i
+      } // i48
+      status_t stat(0);
+      for (unsigned n = 1; n <= 8; ++n) {
+          view2D<double> mesh;
+          unsigned const nv[] = {n, n, n};
+          auto const nm = get_kpoint_mesh(mesh, nv, true, echo - 3, ops, 48);
+          // the irreducible points are the multisets of three out of m absolute values |k|
+          int const m = (n + 1)/2;
+          int const expected = (m*(m + 1)*(m + 2))/6;
+          double w8sum{0};
+          for (int ik = 0; ik < nm; ++ik) w8sum += mesh(ik,WEIGHT);
+          if (echo > 5) std::printf("# %s(n= %d) returns %d points, expected %d, weight sum = 1 + %.1e\n",
+                                        __func__, n, nm, expected, w8sum - 1);
+          stat += (nm != expected) + (std::abs(w8sum - 1) > 1e-12);
+      } // n
+      return stat;
+  } // test_cubic_reduction
+
   inline status_t all_tests(int const echo=0) {
       status_t stat(0);
       for (int n = 0; n <= 9; ++n) {
           stat += test_mesh(echo, n);
       } // n
+      stat += test_cubic_reduction(echo);
       return stat;
   } // all_tests
 
@@ -210,7 +210,7 @@ namespace davidson_solver {
                           int const ii = i + n_drop;
                           set(epsi[i], ndof, zero);
                           for (int j = 0; j < sub_space; ++j) {
-                              add_product(epsi[i], ndof, psi[j], complex_t(Ovl_copy(ii,j)));
+                              add_product(epsi[i], ndof, psi[j], complex_t(conjugate(Ovl_copy(ii,j))));
                           } // j
                       } // i
                       std::swap(psi, epsi); // pointer swap instead of deep copy
@@ -230,10 +230,11 @@ namespace davidson_solver {
               // if (echo > 8) show_matrix(eigvec.data(), eigvec.stride(), sub_space, sub_space, "Eigenvectors");
 
               // now rotate the basis into the eigenspace, ToDo: we should use DGEMM-style operations
+              // LAPACK has seen the transposed (==conjugated) row-major matrices, so we need to conjugate the coefficients
               for (int i = 0; i < sub_space; ++i) {
                   set(epsi[i], ndof, zero);
                   for (int j = 0; j < sub_space; ++j) {
-                      add_product(epsi[i], ndof, psi[j], complex_t(eigvec(i,j)));
+                      add_product(epsi[i], ndof, psi[j], complex_t(conjugate(eigvec(i,j))));
                   } // j
               } // i
               std::swap(psi, epsi); // pointer swap instead of deep copy
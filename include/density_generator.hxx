@@ -11,7 +11,7 @@
 #include "sho_projection.hxx" // ::sho_prefactor
 #include "data_view.hxx" // view3D<T>
 #include "data_list.hxx" // data_list<T>
-#include "inline_math.hxx" // scale
+#include "inline_math.hxx" // scale, parallel_block
 #include "control.hxx" // ::get
 #include "display_units.h" // Ang, _Ang, eV, _eV
 #include "fermi_distribution.hxx" // ::FermiLevel_t
@@ -36,6 +36,32 @@ namespace density_generator {
   } // add_to_density
 
 
+  template <typename complex_t>
+  void add_bands_to_density(
+        double rho[] // is modified
+      , size_t const nzyx // number of grid points
+      , complex_t const waves[] // wave functions on the real-space grid, shape [nbands][stride]
+      , size_t const stride // stride of the waves array
+      , double const weights[] // weights[nbands], bands with zero weight are skipped
+      , int const nbands // number of bands
+  ) {
+      // add the absolute squares of several bands to the density.
+      // The grid is distributed over threads in blocks while each thread runs over the bands in order,
+      // so every grid point receives its contributions in the same order as in a serial band loop
+      // and the result is bitwise independent of the number of threads.
+      size_t const nblocks = (nzyx + parallel_block - 1)/parallel_block;
+      #pragma omp parallel for schedule(static)
+      for (size_t ib = 0; ib < nblocks; ++ib) {
+          size_t const i0 = ib*parallel_block, i1 = std::min(nzyx, i0 + parallel_block);
+          for (int iband = 0; iband < nbands; ++iband) {
+              if (0 != weights[iband]) {
+                  add_to_density(rho + i0, i1 - i0, waves + iband*stride + i0, weights[iband]);
+              } // weight is non-zero
+          } // iband
+      } // ib
+  } // add_bands_to_density
+
+
   template <typename complex_t>
   void add_to_density_matrices(
         double *const atom_rho[] // atomic density matrices will be modified
@@ -186,7 +212,6 @@ namespace density_generator {
 
       auto const n_all_coeff = coeff_starts ? coeff_starts[natoms] : 0;
       if (echo > 3) std::printf("# %s assume psi(%d,%ld)\n", __func__, nbands, g.all());
-      view2D<complex_t const> const psi_k(eigenfunctions, g.all()); // wrap
       if (echo > 3) std::printf("# %s assume atom_coeff with stride %d\n", __func__, n_all_coeff);
       view2D<complex_t const> const a_coeff(atom_coeff, n_all_coeff); // wrap
 
@@ -206,10 +231,9 @@ namespace density_generator {
           Fermi.get_occupations(occupation.data(), eigenenergies, nbands, weight_k, echo, d_occupation.data());
 
           int ilub{nbands}; // index of lowest completely unoccupied band
-//        double old_charge{0};
           double charge_k[3] = {1, 0, 0}; // {1, charge of bands, derivative}
+          std::vector<double> weight_n(nbands, 0.0), d_weight_n(nbands, 0.0); // zero for bands that do not contribute
           for (int iband = 0; iband < nbands; ++iband) {
-              auto const psi_nk = psi_k[iband];
 
               if (occupation[iband] >= occ_threshold) {
                   charge_k[1] += occupation[iband]*spinfactor;
@@ -217,15 +241,7 @@ namespace density_generator {
                   if (echo > 6) std::printf("# %s: k-point #%i bands #%i \toccupation= %.6f d_occ= %g E= %g %s\n",
                       __func__, ikpoint, iband, occupation[iband], d_occupation[iband]*kT, eigenenergies[iband]*eV, _eV);
 
-                  add_to_density(rho, g.all(), psi_nk, weight_nk, echo, iband, ikpoint);
-#if 0 // def DEBUG
-                  if (echo > 0) { 
-                      std::printf("# valence density ");
-                      auto const new_charge = print_stats(rho, g.all(), g.dV());
-                      std::printf("# valence density of band #%i added %g electrons\n", iband, new_charge - old_charge);
-                      old_charge = new_charge;
-                  } // echo
-#endif // DEBUG
+                  weight_n[iband] = weight_nk; // the grid density is accumulated for all bands at once below
                   add_to_density_matrices(atom_rho, a_coeff[iband],
                                   coeff_starts, natoms, weight_nk, echo, iband, ikpoint);
 
@@ -233,9 +249,7 @@ namespace density_generator {
                       charge_k[2] += d_occupation[iband]*spinfactor;
                       double const d_weight_nk = d_occupation[iband] * weight_sk;
 
-                      if (d_rho) {
-                          add_to_density(d_rho, g.all(), psi_nk, d_weight_nk, echo, iband, ikpoint);
-                      } // d_rho != nullptr
+                      d_weight_n[iband] = d_weight_nk;
 
                       if (d_atom_rho) {
                           add_to_density_matrices(d_atom_rho, a_coeff[iband],
@@ -249,6 +263,12 @@ namespace density_generator {
               } // weight is considerable
 
           } // iband
+
+          add_bands_to_density(rho, g.all(), eigenfunctions, g.all(), weight_n.data(), nbands);
+          if (d_rho) {
+              add_bands_to_density(d_rho, g.all(), eigenfunctions, g.all(), d_weight_n.data(), nbands);
+          } // d_rho != nullptr
+
           if (ilub < nbands) {
               if (echo > 6) std::printf("# %s: k-point #%i band #%i at %g %s and above did not"
                   " contribute to the density\n", __func__, ikpoint, ilub, eigenenergies[ilub]*eV,_eV);
@@ -301,9 +321,35 @@ namespace density_generator {
                      nullptr, op.get_natoms(), g, 1, 1, echo, -1, nullptr, nullptr);
   } // test_init
 
+  inline status_t test_add_bands_to_density(int const echo=3) {
+      // the blocked accumulation must reproduce the band-by-band accumulation bitwise
+      size_t const nzyx = 3*parallel_block + 99;
+      int const nbands = 5;
+      view2D<std::complex<double>> waves(nbands, nzyx);
+      std::vector<double> weights(nbands);
+      for (int iband = 0; iband < nbands; ++iband) {
+          weights[iband] = (2 == iband) ? 0 : 1./(1. + iband); // band #2 does not contribute
+          for (size_t izyx = 0; izyx < nzyx; ++izyx) {
+              waves(iband,izyx) = std::complex<double>(std::cos(.01*izyx*(iband + 1)), std::sin(.003*izyx - iband));
+          } // izyx
+      } // iband
+      std::vector<double> rho_ref(nzyx, 0.0), rho(nzyx, 0.0);
+      for (int iband = 0; iband < nbands; ++iband) {
+          if (0 != weights[iband]) add_to_density(rho_ref.data(), nzyx, waves[iband], weights[iband]);
+      } // iband
+      add_bands_to_density(rho.data(), nzyx, waves.data(), waves.stride(), weights.data(), nbands);
+      status_t stat(0);
+      for (size_t izyx = 0; izyx < nzyx; ++izyx) {
+          stat += (rho[izyx] != rho_ref[izyx]);
+      } // izyx
+      if (echo > 2) std::printf("# %s: %d of %ld grid values differ\n", __func__, int(stat), nzyx);
+      return stat;
+  } // test_add_bands_to_density
+
   inline status_t all_tests(int const echo=0) {
       status_t stat(0);
       stat += test_init(echo);
+      stat += test_add_bands_to_density(echo);
       return stat;
   } // all_tests
 
@@ -5,6 +5,7 @@
 #include <cstdint> // int64_t, int32_t, uint32_t, int8_t
 #include <cassert> // assert
 #include <vector> // std::vector<T>
+#include <type_traits> // std::is_same
 
 #include "status.hxx" // status_t, STATUS_TEST_NOT_INCLUDED
 
@@ -36,7 +37,11 @@
 // #include "green_kinetic.hxx"// ::multiply, ::finite_difference_plan_t
 #include "green_kinetic.hxx"   // ::kinetic_plan_t
 #include "green_potential.hxx" // ::multiply
+#include "green_fused.hxx"     // ::fused_plan_t
 #include "green_dyadic.hxx"    // ::multiply, ::dyadic_plan_t
+#include "green_precision.hxx" // ::storage_name
+#include "profiler.hxx"        // ::region_t
+#include "recorded_warnings.hxx" // warn
 
 
 #ifdef    debug_printf
@@ -114,6 +119,10 @@ namespace green_action {
       std::complex<double> E_param; // energy parameter
 
       green_kinetic::kinetic_plan_t kinetic[3]; // plan to execute the kinetic energy operator
+      green_fused::fused_plan_t fused; // plan to execute potential and kinetic energy operator in one pass
+      bool fused_local = false; // use the fused kernel instead of potential + 3 kinetic passes
+      bool concurrent_kinetic = false; // run the 3 kinetic passes independently, needs 2 private Green functions
+      cudaStream_t kinetic_streams[3] = {0, 0, 0}; // streams for the concurrent kinetic passes
 
       uint32_t* RowStart = nullptr; // [nRows + 1] Needs to be transfered to the GPU?
       uint32_t* rowindx  = nullptr; // [nnzb] // allows different parallelization strategies
@@ -154,6 +163,11 @@ namespace green_action {
           free_memory(rowCubePos);
           free_memory(grid_spacing_trunc);
           free_memory(phase);
+#ifndef   HAS_NO_CUDA
+          for (int dd = 0; dd < 3; ++dd) {
+              if (kinetic_streams[dd]) cudaStreamDestroy(kinetic_streams[dd]);
+          } // dd
+#endif // HAS_NO_CUDA
       } // destructor
 
   }; // plan_t
@@ -162,7 +176,7 @@ namespace green_action {
 
 
 
-  template <typename floating_point_t=float, int R1C2=2, int Noco=1, int n64=64>
+  template <typename floating_point_t=float, int R1C2=2, int Noco=1, int n64=64, typename storage_t=floating_point_t>
   class action_t { // an action as used in tfQMRgpu
   public:
       typedef floating_point_t real_t;
@@ -174,22 +188,30 @@ namespace green_action {
       // compatible with the core algorithm of the tfqmrgpu-2.0 library.
       // Blocks are sized [LM][LM].
       // Arithmetic according to complex<real_t>
-      // with real_t either float or double
+      // with real_t either float or double.
+      // The blocks x and y are stored in storage_t, e.g. green_precision::float16_t,
+      // the kernels convert to real_t when loading and round when storing.
+      // tfQMRgpu allocates its vectors as real_t, so it can only use storage_t == real_t.
       //
       action_t(plan_t *plan)
-        : p(plan), apc(nullptr), aac(nullptr)
+        : p(plan), apc(nullptr), aac(nullptr), kinetic_yz(nullptr)
       {
           assert((1 == Noco && (1 == R1C2 || 2 == R1C2)) || (2 == Noco && 2 == R1C2));
           debug_printf("# construct %s\n", __func__);
           char* buffer{nullptr};
           take_memory(buffer);
           assert(nullptr != plan);
+          if (plan->fused_local && !std::is_same<storage_t,real_t>::value) {
+              warn("green_fused works on %s blocks only, %s blocks use the separate potential and kinetic kernels",
+                    real_t_name<real_t>(), green_precision::storage_name<storage_t>());
+          } // fused_local
       } // constructor
 
       ~action_t() {
           debug_printf("# destruct %s\n", __func__);
           free_memory(apc);
 //        free_memory(aac); // currently not used
+          free_memory(kinetic_yz);
       } // destructor
 
       void take_memory(char* &buffer) {
@@ -200,6 +222,10 @@ namespace green_action {
           // ToDo: how complicated would it be to have only one set of coefficients and multiply in-place?
           apc = get_memory<real_t[R1C2][Noco][LM]>(n, p->echo, "apc");
 //        aac = get_memory<real_t[R1C2][Noco][LM]>(n, p->echo, "aac"); // currently not used
+          green_dyadic::reserve_workspace<real_t,R1C2,Noco>(dp, p->echo); // temporaries of green_dyadic::multiply
+          if (p->concurrent_kinetic) {
+              kinetic_yz = get_memory<storage_t[R1C2][LM][LM]>(2*p->colindx.size(), p->echo, "kinetic_yz");
+          } // concurrent_kinetic
           // ToDo: alternatively, we could take GPU device memory from the buffer
       } // take_memory
 
@@ -220,8 +246,8 @@ namespace green_action {
 
 
       double multiply( // returns the number of flops performed
-            real_t         (*const __restrict y)[R1C2][LM][LM] // result, y[nnzb][2][LM][LM]
-          , real_t   const (*const __restrict x)[R1C2][LM][LM] // input,  x[nnzb][2][LM][LM]
+            storage_t       (*const __restrict y)[R1C2][LM][LM] // result, y[nnzb][2][LM][LM]
+          , storage_t const (*const __restrict x)[R1C2][LM][LM] // input,  x[nnzb][2][LM][LM]
           , uint16_t const (*const __restrict colIndex) // column indices [nnzb], warning: must be in device memory or managed memory
           , uint32_t const nnzb // number of nonzero blocks, typically colIndex.size()
           , uint32_t const nCols=1 // should match with p->nCols, number of block columns, assert(colIndex[:] < nCols)
@@ -229,7 +255,8 @@ namespace green_action {
           , cudaStream_t const streamId=0 // CUDA stream to run on
           , bool const precondition=false
       )
-        // GPU implementation of green_potential, green_kinetic and green_dyadic
+        // GPU implementation of green_potential, green_kinetic and green_dyadic,
+        // with plan_t::fused_local, the first two are replaced by green_fused
       {
           assert(p);
           if (2 == Noco) assert(p->noncollinear_spin && "Also the plan needs to be created with Noco=2");
@@ -238,19 +265,54 @@ namespace green_action {
           if (p->echo > 3) std::printf("\n");
           if (p->echo > 2) std::printf("# green_action::multiply\n");
 
-          // start with the local potential, assign y to initial values
-          nops += green_potential::multiply<real_t,R1C2,Noco>(y, x, p->Veff, p->veff_index,
-                      p->target_minus_source, p->grid_spacing_trunc, nnzb, p->E_param,
-                      p->V_confinement, pow2(p->r_confinement), p->echo);
-
-          // add the kinetic energy expressions
-          for (int dd = 0; dd < 3; ++dd) { // loop must run serial
-              nops += p->kinetic[dd].multiply<real_t,R1C2,Noco>(y, x, p->phase[dd], p->echo);
-          } // dd derivative direction
-
-          // add the non-local potential using the dyadic action of project + add
-          nops += green_dyadic::multiply<real_t,R1C2,Noco>(y, apc, x, p->dyadic_plan,
-                      p->rowindx, colIndex, p->rowCubePos, nnzb, p->echo);
+          double const block_bytes = nnzb*double(sizeof(storage_t)*R1C2*LM*LM); // size of x or y
+          profiler::region_t region("green_action");
+
+          if (p->fused_local && p->fused.is_set() && std::is_same<storage_t,real_t>::value) {
+              // scope: local potential and kinetic energy in one pass, assign y
+              assert(nnzb == p->fused.nnzb);
+              profiler::region_t region("local", 2*block_bytes); // read x (and its neighbors), write y
+              auto const n = multiply_fused(y, x);
+              region.add(0, n);
+              nops += n;
+          } else {
+
+          { // scope: start with the local potential, assign y to initial values
+              profiler::region_t region("Potential", 2*block_bytes); // read x, write y
+              auto const n = green_potential::multiply<real_t,R1C2,Noco,storage_t>(y, x, p->Veff, p->veff_index,
+                          p->target_minus_source, p->grid_spacing_trunc, nnzb, p->E_param,
+                          p->V_confinement, pow2(p->r_confinement), p->echo);
+              region.add(0, n);
+              nops += n;
+          } // scope
+
+          { // scope: add the kinetic energy expressions
+              profiler::region_t region("kinetic", 3*3*block_bytes); // read x, read and write y, for each direction
+              if (p->concurrent_kinetic && kinetic_yz) {
+                  assert(nnzb == p->kinetic[0].nnzb);
+                  region.add(6*block_bytes); // clear and reduce 2 private buffers
+                  auto const n = green_kinetic::multiply_concurrent<real_t,R1C2,Noco,storage_t>(y, kinetic_yz, x,
+                                                   p->kinetic, p->phase, p->kinetic_streams, p->echo);
+                  region.add(0, n);
+                  nops += n;
+              } else {
+                  for (int dd = 0; dd < 3; ++dd) { // loop must run serial
+                      auto const n = p->kinetic[dd].multiply<real_t,R1C2,Noco,storage_t>(y, x, p->phase[dd], p->echo);
+                      region.add(0, n);
+                      nops += n;
+                  } // dd derivative direction
+              } // concurrent_kinetic
+          } // scope
+
+          } // fused_local
+
+          { // scope: add the non-local potential using the dyadic action of project + add
+              profiler::region_t region("dyadic", 3*block_bytes); // read x, read and write y
+              auto const n = green_dyadic::multiply<real_t,R1C2,Noco,storage_t>(y, apc, x, p->dyadic_plan,
+                          p->rowindx, colIndex, p->rowCubePos, nnzb, p->echo);
+              region.add(0, n);
+              nops += n;
+          } // scope
 
           if (p->echo > 4) std::printf("# green_action::multiply %g Gflop\n", nops*1e-9);
 
@@ -259,6 +321,17 @@ namespace green_action {
 
       plan_t * get_plan() { return p; }
 
+    private:
+
+      size_t multiply_fused(real_t (*const y)[R1C2][LM][LM], real_t const (*const x)[R1C2][LM][LM]) {
+          return p->fused.multiply<real_t,R1C2,Noco>(y, x, p->Veff, p->veff_index,
+                      p->target_minus_source, p->grid_spacing_trunc, p->phase, p->E_param,
+                      p->V_confinement, pow2(p->r_confinement), p->echo);
+      } // multiply_fused
+
+      template <typename other_t> // green_fused reads and writes real_t blocks only
+      size_t multiply_fused(other_t (*const y)[R1C2][LM][LM], other_t const (*const x)[R1C2][LM][LM]) { return 0; } // not called
+
     private: // members
 
       plan_t *p; // the plan is independent of real_t and R1C2
@@ -268,6 +341,8 @@ namespace green_action {
       real_t (*aac)[R1C2][Noco][LM]; // atom   addition coefficients aac[n_all_projection_coefficients*nCols][R1C2][Noco][Noco*64]
       // (we could live with a single copy if the application of the atom-centered matrices is in-place)
 
+      storage_t (*kinetic_yz)[R1C2][LM][LM]; // private buffers [2*nnzb] for the concurrent kinetic passes in y- and z-direction
+
   }; // class action_t
 
 
@@ -284,6 +359,8 @@ namespace green_action {
           { action_t<double,1,1> action(&plan); }
           { action_t<double,2,1> action(&plan); }
           { action_t<double,2,2> action(&plan); }
+          { action_t<float ,2,1,64,green_precision::float16_t> action(&plan); }
+          { action_t<double,2,1,64,float> action(&plan); }
           if (echo > 5) std::printf("# Hint: to test action_t::multiply, please envoke --test green_function\n");
       } // destruct plan
       if (echo > 6) {
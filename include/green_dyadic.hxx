@@ -4,8 +4,12 @@
 #include <cstdio> // std::printf
 #include <cstdint> // int64_t, int32_t, uint32_t, int8_t
 #include <cassert> // assert
-#include <cmath> // std::exp
+#include <cmath> // std::exp, ::abs, ::ldexp
 #include <vector> // std::vector<T>
+#include <algorithm> // std::max, ::min
+#include <map> // std::map<K,V>
+#include <set> // std::set<T>
+#include <utility> // std::pair<T1,T2>, ::make_pair
 
 #include "status.hxx" // status_t, STATUS_TEST_NOT_INCLUDED
 #include "green_memory.hxx" // get_memory, free_memory, dim3, real_t_name
@@ -14,6 +18,8 @@
 #include "sho_tools.hxx" // ::nSHO, ::n2HO, ::n1HO
 #include "constants.hxx" // ::sqrtpi
 #include "green_parallel.hxx" // ::rank, ::size, ::dyadic_exchange
+#include "green_workspace.hxx" // ::workspace_t
+#include "green_precision.hxx" // ::load, ::add_to, ::storage_name
 
 #ifndef NO_UNIT_TESTS
     #include "control.hxx" // ::get
@@ -108,15 +114,57 @@ namespace green_dyadic {
     } // Hermite_polynomials_1D
 
 
+    struct projector_table_t {
+        // optional tables of the 1D Hermite-Gauss functions, they depend only on the geometry,
+        // so SHOprj and SHOadd can load them instead of evaluating std::exp and the recursion in every call
+        float    (*H1D)[3][4] = nullptr; // for each pair of row block and atom image: xi_squared[3][4], then H1D[0..lmax][3][4]
+        uint32_t* slab_start  = nullptr; // [sparse_SHOadd.nNonzeros()] where the slab of a non-zero starts in H1D, shared by all columns of a row
+        uint32_t* pair_of_prj = nullptr; // [prj_start[nrhs]] translates the non-zeros of sparse_SHOprj[irhs] into pairs
+        uint32_t* prj_start   = nullptr; // [nrhs + 1]
+
+        void release() {
+            free_memory(H1D);
+            free_memory(slab_start);
+            free_memory(pair_of_prj);
+            free_memory(prj_start);
+        } // release
+    }; // projector_table_t, passed by value to the kernels, does not own its memory
+
+
+    template <typename real_t>
+    float __host__ __device__
+    Hermite_polynomials_1D_table(
+          real_t (*const __restrict__ H1D)[3][4] // result H1D[nu][dir][i4]
+        , float  (*const __restrict__ xi_squared)[4] // distance^2 xi_squared[dir][i4]
+        , int    const ivec // thread index used for the vectorization (at least 3*4==12 threads must run)
+        , int    const lmax
+        , float  const (*const __restrict__ slab)[3][4] // tabulated xi_squared and H1D, see projector_table_t
+        , double const hxyz[3+1] // grid spacings in [0],[1],[2], projection radius in [3]
+    )
+      // Load the 1D Hermite-Gauss functions of a 3D block of 4^3 grid points, same result as Hermite_polynomials_1D
+    {
+        double const R2_projection = hxyz[3]*hxyz[3]; // projection radius can be controlled from outside
+        if (lmax < 0) return R2_projection; // as float
+        if (ivec < 3*4) { // use only the lowest 12 threads
+            int const idir = ivec >> 2, i4 = ivec & 0x3;
+            xi_squared[idir][i4] = slab[0][idir][i4];
+            for (int nu = 0; nu <= lmax; ++nu) {
+                H1D[nu][idir][i4] = slab[1 + nu][idir][i4];
+            } // nu
+        } // ivec < 3*4
+        return R2_projection; // as float
+    } // Hermite_polynomials_1D_table
+
+
     int constexpr Lmax_default=7; // reduce this to lower the GPU register and shared memory usage
 
-    template <typename real_t, int R1C2=2, int Noco=1, int Lmax=Lmax_default>
+    template <typename real_t, int R1C2=2, int Noco=1, int Lmax=Lmax_default, typename storage_t=real_t>
     void __global__ SHOprj( // launch SHOprj<real_t,R1C2,Noco> <<< {natoms, nrhs, 1}, {Noco*64, Noco, R1C2} >>> (...);
 #ifdef HAS_NO_CUDA
           dim3 const & gridDim, dim3 const & blockDim,
 #endif // HAS_NO_CUDA
           real_t         (*const __restrict__ Cpr)[R1C2][Noco   ][Noco*64] // result: projection coefficients, layout[natomcoeffs*nrhs][R1C2][Noco   ][Noco*64]
-        , real_t   const (*const __restrict__ Psi)[R1C2][Noco*64][Noco*64] // input:  Green function,               layout[ncubes*nrhs][R1C2][Noco*64][Noco*64]
+        , storage_t const (*const __restrict__ Psi)[R1C2][Noco*64][Noco*64] // input:  Green function,             layout[ncubes*nrhs][R1C2][Noco*64][Noco*64]
         , green_sparse::sparse_t<> const (*const __restrict__ sparse)
         , double   const (*const __restrict__ AtomPos)[3+1] // atomic positions [0],[1],[2], decay parameter [3]
         , int8_t   const (*const __restrict__ AtomLmax) // SHO basis size [iatom]
@@ -124,6 +172,7 @@ namespace green_dyadic {
         , uint32_t const (*const __restrict__ irow_of_inzb) // row index of the Green function as a function of the non-zero index
         , float    const (*const __restrict__ CubePos)[3+1] // only [0],[1],[2] used, CubePos[irow][0:3]
         , double   const (*const __restrict__ hGrid) // grid spacings in [0],[1],[2], projection radius in [3]
+        , projector_table_t const table // tabulated Hermite-Gauss functions, if table.H1D is set
     )
       // Compute the projection coefficients of wave/Green functions with atom-centered SHO-bases
     {
@@ -202,8 +251,11 @@ namespace green_dyadic {
 
             // generate Hx, Hy, Hz up to lmax inside the 4^3 cube
 
-            if (0 == threadIdx.y && 0 == threadIdx.z) // sufficient to be executed by the first 12 threads of a block
-                R2_proj = Hermite_polynomials_1D(H1D, xi_squared, j, lmax, xyza, xyzc, hgrid);
+            if (0 == threadIdx.y && 0 == threadIdx.z) { // sufficient to be executed by the first 12 threads of a block
+                R2_proj = table.H1D ? Hermite_polynomials_1D_table(H1D, xi_squared, j, lmax,
+                                          table.H1D + table.slab_start[table.pair_of_prj[table.prj_start[irhs] + bsr]], hgrid)
+                                    : Hermite_polynomials_1D(H1D, xi_squared, j, lmax, xyza, xyzc, hgrid);
+            }
             // how many times executed? nrhs * sparse[irhs].nNonzeros()
 
             __syncthreads();
@@ -211,7 +263,9 @@ namespace green_dyadic {
             set(xyzc, 3, CubePos[irow]);
 
             for (int jj = 0; jj < 12; ++jj) {
-                R2_proj = Hermite_polynomials_1D(H1D, xi_squared, jj, lmax, xyza, xyzc, hgrid);
+                R2_proj = table.H1D ? Hermite_polynomials_1D_table(H1D, xi_squared, jj, lmax,
+                                          table.H1D + table.slab_start[table.pair_of_prj[table.prj_start[irhs] + bsr]], hgrid)
+                                    : Hermite_polynomials_1D(H1D, xi_squared, jj, lmax, xyza, xyzc, hgrid);
             } // jj
 #endif // HAS_NO_CUDA
 
@@ -239,7 +293,7 @@ namespace green_dyadic {
                                 auto const d2xyz = xi_squared[X][x] + d2yz;
                                 if (d2xyz < 0) {
                                     int const xyz = (z*4 + y)*4 + x;
-                                    real_t const ps = Psi[inzb][reim][spin*64 + xyz][j]; // load from global memory
+                                    real_t const ps = green_precision::load<real_t>(Psi[inzb][reim][spin*64 + xyz][j]); // load from global memory
                                     for (int ix = 0; ix <= lmax; ++ix) { // loop over the 1st Cartesian SHO quantum number
                                         auto const Hx = H1D[ix][X][x]; // load Hx from shared memory
                                         ax[ix] += ps * Hx; // FMA: 2 flop * 4**3 * (L+1)
@@ -288,10 +342,10 @@ namespace green_dyadic {
 
     } // SHOprj
 
-    template <typename real_t, int R1C2=2, int Noco=1>
+    template <typename real_t, int R1C2=2, int Noco=1, typename storage_t=real_t>
     void __host__ SHOprj_driver(
           real_t         (*const __restrict__ Cpr)[R1C2][Noco   ][Noco*64] // result: projection coefficients
-        , real_t   const (*const __restrict__ Psi)[R1C2][Noco*64][Noco*64] // input: Green function
+        , storage_t const (*const __restrict__ Psi)[R1C2][Noco*64][Noco*64] // input: Green function
         , double   const (*const __restrict__ AtomPos)[3+1] // atomic positions [0],[1],[2], decay parameter [3]
         , int8_t   const (*const __restrict__ AtomLmax) // SHO basis size [iatom]
         , uint32_t const (*const __restrict__ AtomStarts) // prefix sum over nSHO(AtomLmax[:])
@@ -302,18 +356,19 @@ namespace green_dyadic {
         , double   const (*const __restrict__ hGrid) // grid spacings in [0],[1],[2], projection radius in [3]
         , int      const nrhs // number of block columns in the Green function, max due to data type 2^16, due to GPU launch 2^16-1
         , int const echo=0
+        , projector_table_t const & table=projector_table_t() // optional tabulated Hermite-Gauss functions
     ) {
         if (natoms*nrhs < 1) return;
         dim3 const gridDim(natoms, nrhs, 1), blockDim(Noco*64, Noco, R1C2);
-        if (echo > 3) std::printf("# %s<%s,R1C2=%d,Noco=%d> <<< {natoms=%d, nrhs=%d, 1}, {%d, Noco=%d, R1C2=%d} >>>\n",
-                            __func__, real_t_name<real_t>(), R1C2, Noco, natoms, nrhs, Noco*64, Noco, R1C2);
-        SHOprj<real_t,R1C2,Noco> // launch <<< {natoms, nrhs, 1}, {Noco*64, Noco, R1C2} >>>
+        if (echo > 3) std::printf("# %s<%s,R1C2=%d,Noco=%d,%s> <<< {natoms=%d, nrhs=%d, 1}, {%d, Noco=%d, R1C2=%d} >>>\n",
+                            __func__, real_t_name<real_t>(), R1C2, Noco, green_precision::storage_name<storage_t>(), natoms, nrhs, Noco*64, Noco, R1C2);
+        SHOprj<real_t,R1C2,Noco,Lmax_default,storage_t> // launch <<< {natoms, nrhs, 1}, {Noco*64, Noco, R1C2} >>>
 #ifndef HAS_NO_CUDA
               <<< gridDim, blockDim >>> (
 #else  // HAS_NO_CUDA
                 ( gridDim, blockDim,
 #endif // HAS_NO_CUDA
-               Cpr, Psi, sparse, AtomPos, AtomLmax, AtomStarts, RowIndexCube, CubePos, hGrid);
+               Cpr, Psi, sparse, AtomPos, AtomLmax, AtomStarts, RowIndexCube, CubePos, hGrid, table);
     } // SHOprj_driver
 
 
@@ -323,12 +378,12 @@ namespace green_dyadic {
 //         uint16_t u[4];
 //     }; // mask64_t
 
-    template <typename real_t, int R1C2=2, int Noco=1, int Lmax=Lmax_default>
+    template <typename real_t, int R1C2=2, int Noco=1, int Lmax=Lmax_default, typename storage_t=real_t>
     void __global__ SHOadd( // launch SHOadd<real_t,R1C2,Noco> <<< {nnzb, 1, 1}, {Noco*64, Noco, R1C2} >>>
 #ifdef HAS_NO_CUDA
           dim3 const & gridDim, dim3 const & blockDim,
 #endif // HAS_NO_CUDA
-          real_t         (*const __restrict__ Psi)[R1C2][Noco*64][Noco*64] // result: Green function to modify,       layout[nnzb][R1C2][Noco*64][Noco*64]
+          storage_t       (*const __restrict__ Psi)[R1C2][Noco*64][Noco*64] // result: Green function to modify,       layout[nnzb][R1C2][Noco*64][Noco*64]
         , real_t   const (*const __restrict__ Cad)[R1C2][Noco   ][Noco*64] // input: addition coefficients, layout[natomcoeffs*nrhs][R1C2][Noco   ][Noco*64]
         , uint32_t const (*const __restrict__ bsr_of_inzb)
         , uint32_t const (*const __restrict__ iatom_of_bsr)
@@ -340,6 +395,7 @@ namespace green_dyadic {
         , float    const (*const __restrict__ CubePos)[3+1] // only [0],[1],[2] used
         , double   const (*const __restrict__ hGrid) // grid spacings in [0],[1],[2], projection radius [3]
         , int      const nrhs // number of block columns in the Green function
+        , projector_table_t const table // tabulated Hermite-Gauss functions, if table.H1D is set
     )
       // Add linear combinations of SHO-basis function to wave/Green functions
     {
@@ -420,14 +476,17 @@ namespace green_dyadic {
             __syncthreads();
 
             // generate Hx, Hy, Hz up to Lmax inside the 4^3 cube
-            if (0 == threadIdx.y && 0 == threadIdx.z) // sufficient to be executed by the first 12 threads of a block
-                R2_proj = Hermite_polynomials_1D(H1D, xi_squared, j, lmax, xyza, xyzc, hgrid);
+            if (0 == threadIdx.y && 0 == threadIdx.z) { // sufficient to be executed by the first 12 threads of a block
+                R2_proj = table.H1D ? Hermite_polynomials_1D_table(H1D, xi_squared, j, lmax, table.H1D + table.slab_start[bsr], hgrid)
+                                    : Hermite_polynomials_1D(H1D, xi_squared, j, lmax, xyza, xyzc, hgrid);
+            }
 
 #else  // HAS_NO_CUDA
             set(xyza, 4, AtomPos[iatom]);
 
             for (int jj = 0; jj < 12; ++jj) {
-                R2_proj = Hermite_polynomials_1D(H1D, xi_squared, jj, lmax, xyza, xyzc, hgrid);
+                R2_proj = table.H1D ? Hermite_polynomials_1D_table(H1D, xi_squared, jj, lmax, table.H1D + table.slab_start[bsr], hgrid)
+                                    : Hermite_polynomials_1D(H1D, xi_squared, jj, lmax, xyza, xyzc, hgrid);
             } // jj
 #endif // HAS_NO_CUDA
 
@@ -506,7 +565,7 @@ namespace green_dyadic {
                     for (int x = 0; x < 4; ++x) {
                         int const xyz = (z*4 + y)*4 + x;
                         if ((mask_all >> xyz) & 0x1) { // probe the rightmost bit
-                            Psi[inzb][reim][spin*64 + xyz][j] += czyx[z][y][x]; // up to 64 negligible flop
+                            green_precision::add_to(Psi[inzb][reim][spin*64 + xyz][j], czyx[z][y][x]); // up to 64 negligible flop
                             // possibility to use atomic add here
                         } // mask
                     } // x
@@ -519,9 +578,9 @@ namespace green_dyadic {
     } // SHOadd
 
 
-    template <typename real_t, int R1C2=2, int Noco=1>
+    template <typename real_t, int R1C2=2, int Noco=1, typename storage_t=real_t>
     void __host__ SHOadd_driver(
-          real_t         (*const __restrict__ Psi)[R1C2][Noco*64][Noco*64] // result: Green functions to modify
+          storage_t       (*const __restrict__ Psi)[R1C2][Noco*64][Noco*64] // result: Green functions to modify
         , real_t   const (*const __restrict__ Cad)[R1C2][Noco   ][Noco*64] // input: addition coefficients
         , double   const (*const __restrict__ AtomPos)[3+1] // atomic positions [0],[1],[2], decay parameter [3]
         , int8_t   const (*const __restrict__ AtomLmax) // SHO basis size [iatom]
@@ -535,19 +594,20 @@ namespace green_dyadic {
         , int      const nnzb // == number of all non-zero blocks in the Green function
         , int      const nrhs // == number of columns in the Green function
         , int const echo=0
+        , projector_table_t const & table=projector_table_t() // optional tabulated Hermite-Gauss functions
     ) {
         if (nnzb < 1) return;
         if (nullptr == Psi) return;
         dim3 const gridDim(nnzb, 1, 1), blockDim(Noco*64, Noco, R1C2);
-        if (echo > 3) std::printf("# %s<%s,R1C2=%d,Noco=%d> <<< {nnzb=%d, 1, 1}, {%d, Noco=%d, R1C2=%d} >>>\n",
-                            __func__, real_t_name<real_t>(), R1C2, Noco, nnzb, Noco*64, Noco, R1C2);
-        SHOadd<real_t,R1C2,Noco> // launch {nnzb, 1, 1}, {Noco*64, Noco, R1C2} >>>
+        if (echo > 3) std::printf("# %s<%s,R1C2=%d,Noco=%d,%s> <<< {nnzb=%d, 1, 1}, {%d, Noco=%d, R1C2=%d} >>>\n",
+                            __func__, real_t_name<real_t>(), R1C2, Noco, green_precision::storage_name<storage_t>(), nnzb, Noco*64, Noco, R1C2);
+        SHOadd<real_t,R1C2,Noco,Lmax_default,storage_t> // launch {nnzb, 1, 1}, {Noco*64, Noco, R1C2} >>>
 #ifndef HAS_NO_CUDA
               <<< gridDim, blockDim >>> (
 #else  // HAS_NO_CUDA
                 ( gridDim, blockDim,
 #endif // HAS_NO_CUDA
-               Psi, Cad, RowStartCubes, ColIndexAtoms, RowIndexCubes, ColIndexCubes, AtomPos, AtomLmax, AtomStarts, CubePos, hGrid, nrhs);
+               Psi, Cad, RowStartCubes, ColIndexAtoms, RowIndexCubes, ColIndexCubes, AtomPos, AtomLmax, AtomStarts, CubePos, hGrid, nrhs, table);
     } // SHOadd_driver
 
 
@@ -856,6 +916,102 @@ namespace green_dyadic {
 
 
 
+    inline status_t __host__ tabulate_projectors(
+          projector_table_t & table // result, call table.release() to free the memory
+        , double   const (*const __restrict__ AtomPos)[3+1] // atomic positions [0],[1],[2], decay parameter [3]
+        , int8_t   const (*const __restrict__ AtomLmax) // SHO basis size [iatom]
+        , green_sparse::sparse_t<> const (*const __restrict__ sparse_SHOprj) // [nrhs]
+        , int      const nrhs // number of block columns in the Green function
+        , green_sparse::sparse_t<> const & sparse_SHOadd
+        , uint32_t const (*const __restrict__ RowIndexCubes) // row index of the Green function [nnzb]
+        , float    const (*const __restrict__ CubePos)[3+1] // only [0],[1],[2] used
+        , double   const (*const __restrict__ hGrid) // grid spacings in [0],[1],[2], projection radius in [3]
+        , int const echo=0
+    )
+      // Evaluate the 1D Hermite-Gauss functions for each pair of Green function row and atom image once,
+      // all non-zero blocks in the same row share the slab since H1D depends only on CubePos[irow]
+    {
+        status_t stat(0);
+        table.release();
+        auto const bsr_of_inzb  = sparse_SHOadd.rowStart();
+        auto const iatom_of_bsr = sparse_SHOadd.colIndex();
+        uint32_t const nnzb = sparse_SHOadd.nRows(), npairs = sparse_SHOadd.nNonzeros();
+        if (npairs < 1) return stat;
+
+        // assign a slab to each distinct pair of row and atom image
+        table.slab_start = get_memory<uint32_t>(npairs, echo, "slab_start");
+        std::map<std::pair<uint32_t,uint32_t>,uint32_t> slab_of_row_atom;
+        std::vector<std::pair<uint32_t,uint32_t>> row_atom; // inverse map, in order of the slabs
+        std::vector<uint32_t> slab_offset(1, 0);
+        for (uint32_t inzb = 0; inzb < nnzb; ++inzb) {
+            auto const irow = RowIndexCubes[inzb];
+            for (auto bsr = bsr_of_inzb[inzb]; bsr < bsr_of_inzb[inzb + 1]; ++bsr) {
+                auto const iatom = iatom_of_bsr[bsr];
+                auto const key = std::make_pair(irow, iatom);
+                auto const found = slab_of_row_atom.find(key);
+                if (slab_of_row_atom.end() == found) {
+                    table.slab_start[bsr] = slab_offset.back();
+                    slab_of_row_atom[key] = slab_offset.back();
+                    row_atom.push_back(key);
+                    slab_offset.push_back(slab_offset.back() + 1 + std::max(0, AtomLmax[iatom] + 1)); // xi_squared and H1D[0..lmax]
+                } else {
+                    table.slab_start[bsr] = found->second;
+                }
+            } // bsr
+        } // inzb
+        auto const nslabs = row_atom.size();
+        table.H1D = get_memory<float[3][4]>(slab_offset[nslabs], echo, "H1D_table");
+
+        for (size_t islab = 0; islab < nslabs; ++islab) {
+            auto const irow = row_atom[islab].first, iatom = row_atom[islab].second;
+            int const lmax = AtomLmax[iatom];
+            if (lmax < 0) continue;
+            if (lmax > Lmax_default) { ++stat; continue; }
+            double H1D[Lmax_default + 1][3][4];
+            float xi_squared[3][4];
+            for (int ivec = 0; ivec < 12; ++ivec) {
+                Hermite_polynomials_1D(H1D, xi_squared, ivec, lmax, AtomPos[iatom], CubePos[irow], hGrid);
+            } // ivec
+            auto const slab = table.H1D + slab_offset[islab];
+            for (int i12 = 0; i12 < 12; ++i12) {
+                slab[0][i12 >> 2][i12 & 0x3] = xi_squared[i12 >> 2][i12 & 0x3];
+                for (int nu = 0; nu <= lmax; ++nu) {
+                    slab[1 + nu][i12 >> 2][i12 & 0x3] = H1D[nu][i12 >> 2][i12 & 0x3]; // convert to float
+                } // nu
+            } // i12
+        } // islab
+
+        // translate the non-zeros of sparse_SHOprj[irhs] into pairs, i.e. into non-zeros of sparse_SHOadd
+        table.prj_start = get_memory<uint32_t>(nrhs + 1, echo, "prj_start");
+        table.prj_start[0] = 0;
+        for (int irhs = 0; irhs < nrhs; ++irhs) {
+            table.prj_start[irhs + 1] = table.prj_start[irhs] + sparse_SHOprj[irhs].nNonzeros();
+        } // irhs
+        table.pair_of_prj = get_memory<uint32_t>(table.prj_start[nrhs], echo, "pair_of_prj");
+        for (int irhs = 0; irhs < nrhs; ++irhs) {
+            auto const bsr_of_iatom = sparse_SHOprj[irhs].rowStart();
+            auto const inzb_of_bsr  = sparse_SHOprj[irhs].colIndex();
+            for (uint32_t iatom = 0; iatom < sparse_SHOprj[irhs].nRows(); ++iatom) {
+                for (auto bsr = bsr_of_iatom[iatom]; bsr < bsr_of_iatom[iatom + 1]; ++bsr) {
+                    auto const inzb = inzb_of_bsr[bsr];
+                    auto pair = bsr_of_inzb[inzb + 1]; // invalid
+                    for (auto jsr = bsr_of_inzb[inzb]; jsr < bsr_of_inzb[inzb + 1]; ++jsr) {
+                        if (iatom_of_bsr[jsr] == iatom) pair = jsr;
+                    } // jsr
+                    if (pair >= bsr_of_inzb[inzb + 1]) { ++stat; pair = 0; } // pair not found in sparse_SHOadd
+                    table.pair_of_prj[table.prj_start[irhs] + bsr] = pair;
+                } // bsr
+            } // iatom
+        } // irhs
+
+        if (stat) warn("projector tables are inconsistent in %d cases", int(stat));
+        if (echo > 3) std::printf("# %s for %d pairs of blocks and atom images in %ld slabs, %.3f MByte\n", __func__,
+                                    npairs, nslabs, slab_offset[nslabs]*sizeof(float[3][4])*1e-6);
+        return stat;
+    } // tabulate_projectors
+
+
+
   class dyadic_plan_t {
   public: // members
 
@@ -883,6 +1039,10 @@ namespace green_dyadic {
       std::vector<int32_t> global_atom_index;
       std::vector<int32_t> original_atom_index;
 
+      mutable green_workspace::workspace_t workspace; // temporaries of multiply, see reserve_workspace
+
+      projector_table_t projector_table; // optional, see tabulate_projectors
+
       size_t flop_count_SHOgen = 0,
              flop_count_SHOsum = 0,
              flop_count_SHOmul = 0,
@@ -910,8 +1070,11 @@ namespace green_dyadic {
           free_memory(AtomImagePhase);
           free_memory(AtomImageShift);
           free_memory(AtomLmax);
-          if (sparse_SHOprj) for (int32_t irhs = 0; irhs < nrhs; ++irhs) sparse_SHOprj[irhs].~sparse_t<>();
+#ifndef   HAS_NO_CUDA
+          if (sparse_SHOprj) for (int32_t irhs = 0; irhs < nrhs; ++irhs) sparse_SHOprj[irhs].~sparse_t<>(); // cudaFree does not call destructors, delete[] in free_memory does
+#endif // HAS_NO_CUDA
           free_memory(sparse_SHOprj);
+          projector_table.release();
       } // constructor
 
       status_t consistency_check() const {
@@ -932,7 +1095,7 @@ namespace green_dyadic {
 
 
 
-      inline int flop_count_SHOprj_SHOadd(int const L) {
+      inline static int flop_count_SHOprj_SHOadd(int const L) {
           return 2*(4*4*4 * (L+1) + 4*4 * (((L+1)*(L+2))/2) + 4 * (((L+1)*(L+2)*(L+3))/6));
       } // flop_count_SHOprj_SHOadd
 
@@ -975,6 +1138,45 @@ namespace green_dyadic {
 
       } // update_flop_counts
 
+      double projector_table_estimate(
+            uint32_t const (*const __restrict__ RowIndexCubes) // row index of the Green function [nnzb]
+          , int const echo=0
+      ) const {
+          // memory/compute trade-off of tabulate_projectors, returns the table size in Byte
+          auto const bsr_of_inzb = sparse_SHOadd.rowStart();
+          auto const iai_of_bsr  = sparse_SHOadd.colIndex();
+          size_t const nnzb = sparse_SHOadd.nRows(), npairs = sparse_SHOadd.nNonzeros();
+          std::set<std::pair<uint32_t,uint32_t>> row_atom; // slabs are shared by all blocks of a row
+          size_t nslabs_stored{0}, nslabs_loaded{0};
+          for (size_t inzb = 0; inzb < nnzb; ++inzb) {
+              for (auto bsr = bsr_of_inzb[inzb]; bsr < bsr_of_inzb[inzb + 1]; ++bsr) {
+                  auto const iai = iai_of_bsr[bsr];
+                  auto const nslab = 1 + std::max(0, AtomImageLmax[iai] + 1);
+                  nslabs_loaded += nslab;
+                  if (row_atom.insert(std::make_pair(RowIndexCubes[inzb], iai)).second) nslabs_stored += nslab;
+              } // bsr
+          } // inzb
+          size_t prj_nonzeros{0};
+          for (int32_t irhs = 0; irhs < nrhs*(nullptr != sparse_SHOprj); ++irhs) prj_nonzeros += sparse_SHOprj[irhs].nNonzeros();
+          double const bytes = nslabs_stored*sizeof(float[3][4]) + (npairs + prj_nonzeros + nrhs + 1)*sizeof(uint32_t);
+          // tabulation evaluates 12 exponentials and the recursion once per row and atom image,
+          // SHOprj and SHOadd evaluate them per pair of block and atom image, with tables they load the slabs
+          if (echo > 3) std::printf("# projector tables need %.3f MByte for %ld of %ld pairs, per dyadic multiply they replace %.3f M exp and %.3f Mflop "
+                                    "by loading %.3f MByte, i.e. %.1f Byte per flop\n", bytes*1e-6, row_atom.size(), npairs, 2*12*npairs*1e-6,
+                                    2*flop_count_SHOgen*1e-6, 2*nslabs_loaded*sizeof(float[3][4])*1e-6,
+                                    nslabs_loaded*sizeof(float[3][4])/std::max(1., 1.*flop_count_SHOgen));
+          return bytes;
+      } // projector_table_estimate
+
+      status_t tabulate_projectors(
+            uint32_t const (*const __restrict__ RowIndexCubes) // row index of the Green function [nnzb]
+          , float    const (*const __restrict__ CubePos)[3+1] // row cube positions
+          , int const echo=0
+      ) {
+          return green_dyadic::tabulate_projectors(projector_table, AtomImagePos, AtomImageLmax,
+                    sparse_SHOprj, nrhs, sparse_SHOadd, RowIndexCubes, CubePos, grid_spacing, echo);
+      } // tabulate_projectors
+
       size_t get_flop_count(int const R1C2, int const Noco, int const echo=0) const {
           size_t nops{0};
 //        nops += 0*flop_count_SHOgen; // Hermite Gauss functions
@@ -982,7 +1184,7 @@ namespace green_dyadic {
 //        nops += 0*flop_count_SHOsum*pow2(R1C2)*pow2(Noco); // collect
           nops +=   flop_count_SHOmul*pow2(R1C2)*pow3(Noco); // small matrix multiplication
           nops += 2*flop_count_SHOsum*pow2(R1C2)*pow2(Noco); // broadcast
-          nops += 2*flop_count_SHOgen; // Hermite Gauss functions
+          nops += 2*flop_count_SHOgen*(nullptr == projector_table.H1D); // Hermite Gauss functions, unless tabulated
           nops += 2*flop_count_SHOadd*R1C2*pow2(Noco); // addition
           return nops;
       } // get_flop_count
@@ -990,10 +1192,26 @@ namespace green_dyadic {
   }; // dyadic_plan_t
 
     template <typename real_t, int R1C2=2, int Noco=1>
+    void __host__ reserve_workspace(dyadic_plan_t const & p, int const echo=0) {
+        // reserve the temporaries of multiply once, so that calls to multiply do not allocate
+        if (p.nAtomImages*p.nrhs < 1) return;
+        size_t const natomcoeffs = p.AtomImageStarts[p.nAtomImages], ncoeffs = p.AtomStarts[p.nAtoms];
+        size_t const Cad_bytes = natomcoeffs*p.nrhs*sizeof(real_t[R1C2][Noco][Noco*64]);
+        if (p.nAtomImages > p.nAtoms) {
+            size_t const coeff_bytes = ncoeffs*p.nrhs*sizeof(double[R1C2][Noco][Noco*64]);
+            size_t const bytes[][2] = {{coeff_bytes, coeff_bytes}, {coeff_bytes, Cad_bytes}}; // {cprj, cadd}, then {cadd, Cad}
+            p.workspace.reserve(bytes[0], 2, echo);
+            p.workspace.reserve(bytes[1], 2, echo);
+        } else {
+            p.workspace.reserve(&Cad_bytes, 1, echo);
+        } // more images than atoms
+    } // reserve_workspace
+
+    template <typename real_t, int R1C2=2, int Noco=1, typename storage_t=real_t>
     size_t __host__ multiply(
-          real_t         (*const __restrict__ Ppsi)[R1C2][Noco*64][Noco*64] // result,  modified Green function blocks [nnzb][R1C2][Noco*64][Noco*64]
-        , real_t         (*const __restrict__  Cpr)[R1C2][Noco]   [Noco*64] // projection coefficients     [natomcoeffs*nrhs][R1C2][Noco   ][Noco*64]
-        , real_t   const (*const __restrict__  psi)[R1C2][Noco*64][Noco*64] // input, unmodified Green function blocks [nnzb][R1C2][Noco*64][Noco*64]
+          storage_t       (*const __restrict__ Ppsi)[R1C2][Noco*64][Noco*64] // result,  modified Green function blocks [nnzb][R1C2][Noco*64][Noco*64]
+        , real_t          (*const __restrict__  Cpr)[R1C2][Noco]   [Noco*64] // projection coefficients     [natomcoeffs*nrhs][R1C2][Noco   ][Noco*64]
+        , storage_t const (*const __restrict__  psi)[R1C2][Noco*64][Noco*64] // input, unmodified Green function blocks [nnzb][R1C2][Noco*64][Noco*64]
         , dyadic_plan_t const & p
         , uint32_t const (*const __restrict__ RowIndexCubes) // Green functions rowIndex[nnzb]
         , uint16_t const (*const __restrict__ ColIndexCubes) // Green functions colIndex[nnzb]
@@ -1010,8 +1228,8 @@ namespace green_dyadic {
         if (echo > 6) std::printf("# %s<%s,R1C2=%d,Noco=%d> nAtoms=%d nAtomImages=%d nrhs=%d ncoeffs=%ld\n",
                   __func__, real_t_name<real_t>(), R1C2, Noco, p.nAtoms, p.nAtomImages, p.nrhs, natomcoeffs);
 
-        SHOprj_driver<real_t,R1C2,Noco>(Cpr, psi, p.AtomImagePos, p.AtomImageLmax, p.AtomImageStarts, p.nAtomImages,
-                                                p.sparse_SHOprj, RowIndexCubes, CubePos, p.grid_spacing, p.nrhs, echo);
+        SHOprj_driver<real_t,R1C2,Noco,storage_t>(Cpr, psi, p.AtomImagePos, p.AtomImageLmax, p.AtomImageStarts, p.nAtomImages,
+                                                p.sparse_SHOprj, RowIndexCubes, CubePos, p.grid_spacing, p.nrhs, echo, p.projector_table);
 
         real_t (*Cad)[R1C2][Noco][Noco*64]{nullptr};
 
@@ -1019,40 +1237,40 @@ namespace green_dyadic {
         if (p.nAtomImages > p.nAtoms) {
             // we have to distinguish between atoms and their periodic images, this case: more images than atoms
 
-            auto cprj = Cpr_export ? Cpr_export : get_memory<double[R1C2][Noco][Noco*64]>(ncoeffs*p.nrhs, echo, "cprj");
+            auto cprj = Cpr_export ? Cpr_export : p.workspace.take<double[R1C2][Noco][Noco*64]>(ncoeffs*p.nrhs, "cprj");
 
             SHOsum_driver<real_t,R1C2,Noco>(cprj, Cpr, p.AtomLmax, p.AtomStarts, p.AtomImageStarts, p.AtomImagePhase,
                                             p.sparse_SHOsum, p.nAtoms, p.nrhs, true, echo); // true:collect
             if (Cpr_export) { return 0; }
 
-            auto cadd = get_memory<double[R1C2][Noco][Noco*64]>(ncoeffs*p.nrhs, echo, "cadd");
+            auto cadd = p.workspace.take<double[R1C2][Noco][Noco*64]>(ncoeffs*p.nrhs, "cadd");
 
             SHOmul_driver<double,R1C2,Noco>(cadd, cprj, p.AtomMatrices, p.AtomLmax, p.AtomStarts, p.nAtoms, p.nrhs, echo);
 
-            free_memory(cprj);
+            p.workspace.give(cprj);
 
-            Cad = get_memory<real_t[R1C2][Noco][Noco*64]>(natomcoeffs*p.nrhs, echo, "Cad"); // rectangular storage of atoms x right-hand-sides
+            Cad = p.workspace.take<real_t[R1C2][Noco][Noco*64]>(natomcoeffs*p.nrhs, "Cad"); // rectangular storage of atoms x right-hand-sides
 
             SHOsum_driver<real_t,R1C2,Noco>(cadd, Cad, p.AtomLmax, p.AtomStarts, p.AtomImageStarts, p.AtomImagePhase,
                                             p.sparse_SHOsum, p.nAtoms, p.nrhs, false, echo); // false:broadcast
 
-            free_memory(cadd);
+            p.workspace.give(cadd);
 
         } else {
             assert(p.nAtomImages == p.nAtoms); // there is at most one relevant image of each atom so we can ignore Bloch phases
             assert(natomcoeffs == ncoeffs);
             if (Cpr_export) { set(Cpr_export[0][0][0], ncoeffs*p.nrhs*R1C2*Noco*Noco*64, Cpr[0][0][0]); return 0; }
 
-            Cad = get_memory<real_t[R1C2][Noco][Noco*64]>(natomcoeffs*p.nrhs, echo, "Cad"); // rectangular storage of atoms x right-hand-sides
+            Cad = p.workspace.take<real_t[R1C2][Noco][Noco*64]>(natomcoeffs*p.nrhs, "Cad"); // rectangular storage of atoms x right-hand-sides
 
             SHOmul_driver<real_t,R1C2,Noco>(Cad, Cpr, p.AtomMatrices, p.AtomLmax, p.AtomStarts, p.nAtoms, p.nrhs, echo);
 
         } // more images than atoms
 
-        SHOadd_driver<real_t,R1C2,Noco>(Ppsi, Cad, p.AtomImagePos, p.AtomImageLmax, p.AtomImageStarts,
+        SHOadd_driver<real_t,R1C2,Noco,storage_t>(Ppsi, Cad, p.AtomImagePos, p.AtomImageLmax, p.AtomImageStarts,
                                         p.sparse_SHOadd.rowStart(), p.sparse_SHOadd.colIndex(),
-                                        RowIndexCubes, ColIndexCubes, CubePos, p.grid_spacing, nnzb, p.nrhs, echo);
-        free_memory(Cad);
+                                        RowIndexCubes, ColIndexCubes, CubePos, p.grid_spacing, nnzb, p.nrhs, echo, p.projector_table);
+        p.workspace.give(Cad);
 
         return p.get_flop_count(R1C2, Noco, echo);
     } // multiply (dyadic operations)
@@ -1457,6 +1675,32 @@ namespace green_dyadic {
           } // nu
       } // echo
 
+      float maxdev_table{0};
+      { // scope: repeat SHOadd and SHOprj with tabulated Hermite-Gauss functions
+          size_t const napc = natoms*nsho*nrhs*size_t(R1C2*Noco*Noco*64);
+          std::vector<real_t> apc_ref(apc[0][0][0], apc[0][0][0] + napc);
+          set(psi[0][0][0], nnzb*R1C2*pow2(Noco*64ull), real_t(0)); // clear
+          set(apc[0][0][0], napc, real_t(0)); // clear
+          auto const dVol = hGrid[0]*hGrid[1]*hGrid[2];
+          auto const sho_norm = sho_normalization(lmax, sigma);
+          for (int isho = 0; isho < std::min(nsho, 64); ++isho) {
+              apc[isho*nrhs][0][0][isho] = dVol/sho_norm[isho]; // same input as above
+          } // isho
+          projector_table_t table;
+          auto const stat_table = tabulate_projectors(table, AtomPos, AtomLmax, sparse_SHOprj, nrhs, sparse_SHOadd, RowIndexCubes, CubePos, hGrid, echo);
+          SHOadd_driver<real_t,R1C2,Noco>(psi, apc, AtomPos, AtomLmax, AtomStarts, sparse_SHOadd.rowStart(), sparse_SHOadd.colIndex(), RowIndexCubes, ColIndexCubes, CubePos, hGrid, nnzb, nrhs, echo, table);
+          SHOprj_driver<real_t,R1C2,Noco>(apc, psi, AtomPos, AtomLmax, AtomStarts, natoms, sparse_SHOprj, RowIndexCubes, CubePos, hGrid, nrhs, echo, table);
+          cudaDeviceSynchronize();
+          real_t const *const apc_all = apc[0][0][0]; // flat view, indexing apc[0][0][0][i] beyond 64 would be undefined
+          for (size_t i = 0; i < napc; ++i) {
+              maxdev_table = std::max(maxdev_table, float(std::abs(apc_all[i] - apc_ref[i])));
+          } // i
+          table.release();
+          if (echo > 2) std::printf("# %s<%s,R1C2=%d,Noco=%d> tabulated projectors deviate by %.1e\n",
+                                       __func__, real_t_name<real_t>(), R1C2, Noco, maxdev_table);
+          if (stat_table) maxdev_table = 9e9;
+      } // scope
+
       if (1) {
           // also test the deprecated interface 'multiply'
           auto AtomMatrices = get_memory<double*>(natoms, echo, "AtomMatrices");
@@ -1472,7 +1716,9 @@ namespace green_dyadic {
           free_memory(AtomMatrices);
       } // 0
 
-      sparse_SHOprj[0].~sparse_t<>();
+#ifndef   HAS_NO_CUDA
+      sparse_SHOprj[0].~sparse_t<>(); // cudaFree does not call destructors, delete[] in free_memory does
+#endif // HAS_NO_CUDA
       free_memory(sparse_SHOprj);
       free_memory(ColIndexCubes);
       free_memory(RowIndexCubes);
@@ -1483,7 +1729,7 @@ namespace green_dyadic {
       free_memory(apc);
       free_memory(Vpsi);
       free_memory(psi);
-      return 0;
+      return (maxdev_table > 1e-6); // tables are stored in float
   } // test_SHOprj_and_SHOadd
 
   inline status_t test_SHOprj_and_SHOadd(int const echo=0) {
@@ -1499,6 +1745,102 @@ namespace green_dyadic {
   } // test_SHOprj_and_SHOadd
 
 
+  template <typename real_t, int R1C2=2, int Noco=1, typename storage_t=real_t>
+  inline status_t test_storage(int const echo=0, int const nb=4, int8_t const lmax=3) {
+      // compare SHOprj and SHOadd on blocks stored in storage_t to the double precision version
+      int  const natoms = 1, nrhs = 1, nnzb = pow3(nb);
+      int  const nsho = sho_tools::nSHO(lmax);
+      int  constexpr LM = Noco*64;
+      size_t const n_all = nnzb*size_t(R1C2*LM*LM), napc = natoms*nsho*nrhs*size_t(R1C2*Noco*LM);
+      auto psi   = get_memory<double[R1C2][LM][LM]>(nnzb, echo, "psi");
+      auto psi_s = get_memory<storage_t[R1C2][LM][LM]>(nnzb, echo, "psi_s");
+      auto apc   = get_memory<double[R1C2][Noco][LM]>(natoms*nsho*nrhs, echo, "apc");
+      auto apc_s = get_memory<real_t[R1C2][Noco][LM]>(natoms*nsho*nrhs, echo, "apc_s");
+      double *const psi_all = psi[0][0][0], *const apc_all = apc[0][0][0]; // flat views
+      storage_t *const psi_s_all = psi_s[0][0][0];
+      real_t *const apc_s_all = apc_s[0][0][0];
+      for (size_t i = 0; i < n_all; ++i) {
+          psi_all[i] = ((i*2654435761u) % 1000)*1e-3 - 0.5; // pseudo-random
+          green_precision::store(psi_s_all[i], psi_all[i]);
+      } // i
+
+      auto sparse_SHOprj = get_memory<green_sparse::sparse_t<>>(nrhs, echo, "sparse_SHOprj");
+      {
+          std::vector<uint32_t> iota(nnzb); for (int inzb = 0; inzb < nnzb; ++inzb) iota[inzb] = inzb;
+          std::vector<std::vector<uint32_t>> SHO_prj(natoms, iota);
+          sparse_SHOprj[0] = green_sparse::sparse_t<>(SHO_prj, false, __func__, echo - 9);
+      }
+      green_sparse::sparse_t<> sparse_SHOadd;
+      {
+          std::vector<std::vector<uint32_t>> SHO_add(nnzb, std::vector<uint32_t>(1, 0));
+          sparse_SHOadd = green_sparse::sparse_t<>(SHO_add, false, __func__, echo - 9);
+      }
+      auto ColIndexCubes = get_memory<uint16_t>(nnzb, echo, "ColIndexCubes");     set(ColIndexCubes, nnzb, uint16_t(0));
+      auto RowIndexCubes = get_memory<uint32_t>(nnzb, echo, "RowIndexCubes");     for (int inzb = 0; inzb < nnzb; ++inzb) RowIndexCubes[inzb] = inzb;
+      auto hGrid         = get_memory<double>(3+1, echo, "hGrid");                set(hGrid, 3, 0.25); hGrid[3] = 7.;
+      auto AtomPos       = get_memory<double[3+1]>(natoms, echo, "AtomPos");      set(AtomPos[0], 3, hGrid, 0.5*4*nb);  AtomPos[0][3] = 1.;
+      auto AtomLmax      = get_memory<int8_t>(natoms, echo, "AtomLmax");          set(AtomLmax, natoms, lmax);
+      auto AtomStarts    = get_memory<uint32_t>(natoms + 1, echo, "AtomStarts");  for (int ia = 0; ia <= natoms; ++ia) AtomStarts[ia] = ia*nsho;
+      auto CubePos       = get_memory<float[3+1]>(nnzb, echo, "CubePos");
+      for (int iz = 0; iz < nb; ++iz) {
+      for (int iy = 0; iy < nb; ++iy) {
+      for (int ix = 0; ix < nb; ++ix) {
+          int const xyz0[] = {ix, iy, iz, 0};
+          set(CubePos[(iz*nb + iy)*nb + ix], 4, xyz0);
+      }}} // ix iy iz
+
+      // project, then add the coefficients back onto the input
+      SHOprj_driver<double,R1C2,Noco>(apc, psi, AtomPos, AtomLmax, AtomStarts, natoms, sparse_SHOprj, RowIndexCubes, CubePos, hGrid, nrhs, echo);
+      SHOprj_driver<real_t,R1C2,Noco,storage_t>(apc_s, psi_s, AtomPos, AtomLmax, AtomStarts, natoms, sparse_SHOprj, RowIndexCubes, CubePos, hGrid, nrhs, echo);
+      cudaDeviceSynchronize();
+      double dev[2] = {0, 0}, mag[2] = {0, 0}; // {SHOprj, SHOadd}
+      for (size_t i = 0; i < napc; ++i) {
+          dev[0] = std::max(dev[0], std::abs(double(apc_s_all[i]) - apc_all[i]));
+          mag[0] = std::max(mag[0], std::abs(apc_all[i]));
+      } // i
+      SHOadd_driver<double,R1C2,Noco>(psi, apc, AtomPos, AtomLmax, AtomStarts, sparse_SHOadd.rowStart(), sparse_SHOadd.colIndex(), RowIndexCubes, ColIndexCubes, CubePos, hGrid, nnzb, nrhs, echo);
+      SHOadd_driver<real_t,R1C2,Noco,storage_t>(psi_s, apc_s, AtomPos, AtomLmax, AtomStarts, sparse_SHOadd.rowStart(), sparse_SHOadd.colIndex(), RowIndexCubes, ColIndexCubes, CubePos, hGrid, nnzb, nrhs, echo);
+      cudaDeviceSynchronize();
+      for (size_t i = 0; i < n_all; ++i) {
+          dev[1] = std::max(dev[1], std::abs(green_precision::load<double>(psi_s_all[i]) - psi_all[i]));
+          mag[1] = std::max(mag[1], std::abs(psi_all[i]));
+      } // i
+      double const rel[] = {dev[0]/std::max(mag[0], 1e-300), dev[1]/std::max(mag[1], 1e-300)};
+      int const bits = std::min(green_precision::significant_bits<storage_t>(), green_precision::significant_bits<real_t>());
+      auto const tolerance = std::ldexp(1., 4 - bits);
+      if (echo > 3) std::printf("# %s<%s,R1C2=%d,Noco=%d,%s> SHOprj deviates from double by %.1e, SHOadd by %.1e relative, tolerance %.1e\n",
+                        __func__, real_t_name<real_t>(), R1C2, Noco, green_precision::storage_name<storage_t>(), rel[0], rel[1], tolerance);
+
+#ifndef   HAS_NO_CUDA
+      sparse_SHOprj[0].~sparse_t<>(); // cudaFree does not call destructors, delete[] in free_memory does
+#endif // HAS_NO_CUDA
+      free_memory(sparse_SHOprj);
+      free_memory(CubePos);
+      free_memory(AtomStarts);
+      free_memory(AtomLmax);
+      free_memory(AtomPos);
+      free_memory(hGrid);
+      free_memory(RowIndexCubes);
+      free_memory(ColIndexCubes);
+      free_memory(apc_s);
+      free_memory(apc);
+      free_memory(psi_s);
+      free_memory(psi);
+      return (rel[0] > tolerance) + (rel[1] > tolerance);
+  } // test_storage
+
+  inline status_t test_storage(int const echo=0) {
+      status_t stat(0);
+      stat += test_storage<double,2,1,double>(echo); // reference against itself
+      stat += test_storage<double,2,1,float>(echo);
+      stat += test_storage<float ,1,1,green_precision::float16_t>(echo);
+      stat += test_storage<float ,2,1,green_precision::float16_t>(echo);
+      stat += test_storage<float ,2,2,green_precision::float16_t>(echo);
+      stat += test_storage<float ,2,1,green_precision::bfloat16_t>(echo);
+      return stat;
+  } // test_storage
+
+
   template <int R1C2=2, int Noco=1>
   inline status_t test_SHOprj_right(int const echo=0, int8_t const lmax=5) {
       if (echo > 0) std::printf("\n# %s<R1C2=%d,Noco=%d>\n", __func__, R1C2, Noco);
@@ -1547,6 +1889,7 @@ namespace green_dyadic {
       status_t stat(0);
       stat += test_Hermite_polynomials_1D(echo);
       stat += test_SHOprj_and_SHOadd(echo);
+      stat += test_storage(echo);
       stat += test_SHOprj_right(echo);
       return stat;
   } // all_tests
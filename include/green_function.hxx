@@ -8,6 +8,7 @@
 #include "status.hxx" // status_t
 #include "green_action.hxx" // ::plan_t
 #include "green_dyadic.hxx" // ::dyadic_plan_t
+#include "green_input.hxx" // ::mapped_Hamiltonian_t
 
 
  /*
@@ -23,6 +24,12 @@ namespace green_function {
   char const boundary_condition_name[][16] = {"isolated", "periodic", "vacuum"};
   char const boundary_condition_shortname[][8] = {"iso", "peri", "vacu"};
 
+  struct right_hand_sides_t { // distribution of the source blocks, computed once per plan since it involves MPI collectives
+      std::vector<int64_t> global_source_indices; // global coordinates of the source blocks of this rank
+      std::vector<uint16_t> owner_rank; // MPI rank responsible for each block of the cell
+      double predicted_load = 0; // estimated cost of this rank, only with weighted load balancing
+  }; // right_hand_sides_t
+
   status_t construct_Green_function(
         green_action::plan_t & p // result, create a plan how to apply the SHO-PAW Hamiltonian to a block-sparse truncated Green function
       , uint32_t const ng[3] // numbers of grid points of the unit cell in with the potential is defined
@@ -34,6 +41,8 @@ namespace green_function {
       , int const echo=0 // log-level
       , std::complex<double> const *energy_parameter=nullptr // E in G = (H - E*S)^{-1}
       , int const Noco=2
+      , green_input::mapped_Hamiltonian_t const *hmt=nullptr // if Veff is empty, load potential blocks from here
+      , right_hand_sides_t const *rhs=nullptr // if given and not empty, reuse these instead of distributing the sources again
   ); // declaration only
 
   status_t update_atom_matrices(
@@ -0,0 +1,490 @@
+#pragma once
+// This file is part of AngstromCube under MIT License
+
+#include <cstdio> // std::printf
+#include <cstdint> // int32_t, uint32_t, int8_t
+#include <cassert> // assert
+#include <cmath> // std::abs
+#include <complex> // std::complex
+#include <vector> // std::vector<T>
+#include <algorithm> // std::max
+
+#include "status.hxx" // status_t, STATUS_TEST_NOT_INCLUDED
+#include "green_memory.hxx" // dim3, get_memory, free_memory, real_t_name
+#include "recorded_warnings.hxx" // warn
+#include "inline_math.hxx" // pow2, set
+#include "green_kinetic.hxx" // ::kinetic_plan_t, ::nhalo, ::CUBE_EXISTS, ::CUBE_IS_ZERO, ::CUBE_NEEDS_PHASE, ::set_phase
+#include "green_potential.hxx" // ::multiply
+
+namespace green_fused {
+
+  using green_kinetic::nhalo;
+  using green_kinetic::CUBE_EXISTS;
+  using green_kinetic::CUBE_IS_ZERO;
+  using green_kinetic::CUBE_NEEDS_PHASE;
+
+  // The local part of the Green function operator, (V - E) + kinetic energy, in a single traversal:
+  // each target block reads its own elements and those of up to 2 neighbor blocks in each of the
+  // six directions and writes the result once. The sequential version applies green_potential::multiply
+  // and then green_kinetic::kinetic_plan_t::multiply for x, y and z, i.e. it reads and writes y four times.
+  // The neighbor table is derived from the finite-difference lists of the kinetic plans,
+  // so the entries have the same meaning: 0 for non-existing blocks, block index + CUBE_EXISTS
+  // for regular blocks and CUBE_NEEDS_PHASE*(block index + CUBE_EXISTS) for periodic images.
+
+  template <typename real_t>
+  struct stencil_t {
+      real_t c[3][1 + 8]; // finite-difference coefficients times the kinetic energy prefactor, [dd][distance]
+      int nFD[3]; // range of the stencil in grid points, 0 (off), 4 or 8
+  }; // stencil_t, passed by value to the kernel
+
+
+  template <typename real_t, int R1C2=2, int Noco=1>
+  void __global__ Hamiltonian_local( // GPU kernel, must be launched with <<< {64, any, 1}, {Noco*64, Noco, R1C2} >>>
+#ifdef    HAS_NO_CUDA
+          dim3 const & gridDim, dim3 const & blockDim,
+#endif // HAS_NO_CUDA
+          real_t        (*const __restrict__ Hpsi)[R1C2][Noco*64][Noco*64] // result
+        , real_t  const (*const __restrict__  psi)[R1C2][Noco*64][Noco*64] // input Green function
+        , int32_t const (*const __restrict__ neighbors)[3][2][2] // [inzb][dd][left/right][distance - 1]
+        , stencil_t<real_t> const stencil // finite-difference coefficients
+        , double  const (*const __restrict__ phase)[2][2] // Bloch phases [dd][left/right][Re/Im], can be nullptr if no images
+        , double  const (*const *const __restrict__ Vloc)[64] // local potential, Vloc[Noco*Noco][iloc][4*4*4]
+        , int32_t const (*const __restrict__ iloc_of_inzb) // translation from inzb to iloc, [inzb]
+        , int16_t const (*const __restrict__ shift)[3+1] // 3D block shift vector (target minus source), 4th component unused, [inzb][0:2]
+        , double  const (*const __restrict__ hxyz) // grid spacing in X,Y,Z direction
+        , int     const nnzb // number of all blocks to be treated
+        , float   const Vconf // prefactor for the confinement potential
+        , float   const rcut2 // cutoff radius^2 for the confinement potential, negative for no confinement
+        , real_t  const E_real // real      part of the energy parameter
+        , real_t  const E_imag // imaginary part of the energy parameter
+    ) {
+        assert((1 == Noco && (1 == R1C2 || 2 == R1C2)) || (2 == Noco && 2 == R1C2));
+
+        assert(64      ==  gridDim.x);
+        assert(1       ==  gridDim.z);
+        assert(Noco*64 == blockDim.x);
+        assert(Noco    == blockDim.y);
+        assert(R1C2    == blockDim.z);
+
+        bool const imaginary = ((2 == R1C2) && (0 != E_imag));
+
+#ifndef HAS_NO_CUDA
+        int const inz0 = blockIdx.y;  // start of the grid-stride loop on y-blocks
+        int const i64  = blockIdx.x;  // target grid point index == inner column dimension, in [0, 64)
+        int const reim = threadIdx.z; // real or imaginary part of the Green function
+        int const spin = threadIdx.y; // non-collinear spin index
+        int const j64  = threadIdx.x; // source grid point index == right hand side vectorization, in [0, Noco*64)
+        for (int inzb = inz0; inzb < nnzb; inzb += gridDim.y) // grid-stride loop on y-blocks
+        { // block loop
+
+            int const row = spin*64 + i64;
+
+            // ========== local potential, as in green_potential::Potential ==========
+            real_t Vconfine = 0; // non-const
+#ifdef  CONFINEMENT_POTENTIAL
+            if (rcut2 >= 0.f) {
+                int constexpr n4 = 4;
+                auto const s = shift[inzb]; // shift vectors between target minus source cube
+                auto const d2 = pow2((int(s[0])*n4 + ( i64       & 0x3) - ( j64       & 0x3))*real_t(hxyz[0]))
+                              + pow2((int(s[1])*n4 + ((i64 >> 2) & 0x3) - ((j64 >> 2) & 0x3))*real_t(hxyz[1]))
+                              + pow2((int(s[2])*n4 + ((i64 >> 4) & 0x3) - ((j64 >> 4) & 0x3))*real_t(hxyz[2]));
+                auto const d2out = real_t(d2 - rcut2);
+                Vconfine = (d2out > 0) ? Vconf*pow2(d2out) : 0; // quartic confinement potential, V ~ d^4
+            } // rcut^2 >= 0
+#endif // CONFINEMENT_POTENTIAL
+
+            auto const iloc = iloc_of_inzb[inzb]; // target index for the local potential, can be -1 for non-existing
+            real_t const Vloc_diag = (iloc < 0) ? 0 : Vloc[spin][iloc][i64];
+            real_t const Vtot = Vloc_diag + Vconfine - E_real; // diagonal part of the potential
+
+            auto hpsi = Vtot * psi[inzb][reim][row][j64]; // non-const
+            if (imaginary) {
+                hpsi += (E_imag * real_t(1 - 2*reim)) * psi[inzb][1 - reim][row][j64];
+            } // imaginary
+            if (2 == Noco && iloc >= 0) { // the other spin component is (1 - spin)
+                real_t const cs = (1 - 2*(reim ^ spin)); // complex sign is -1 if (reim != spin)
+                hpsi += Vloc[2][iloc][i64] * psi[inzb][    reim][(1 - spin)*64 + i64][j64];    // V_x
+                hpsi += Vloc[3][iloc][i64] * psi[inzb][1 - reim][(1 - spin)*64 + i64][j64]*cs; // V_y
+            } // non-collinear
+
+            // ========== kinetic energy, as in green_kinetic::Laplace8th and Laplace16th ==========
+            for (int dd = 0; dd < 3; ++dd) { // derivative direction
+                int const nFD = stencil.nFD[dd];
+                if (nFD < 1) continue; // kinetic energy switched off in this direction
+                auto const c = stencil.c[dd];
+                int const stride = 1 << (2*dd); // 4^dd: X:1, Y:4, Z:16
+                int const q = (i64 >> (2*dd)) & 0x3; // coordinate of the target grid point inside the block
+                hpsi += c[0] * psi[inzb][reim][row][j64];
+                for (int lr = 0; lr < 2; ++lr) { // left or right
+                    int const sgn = 2*lr - 1;
+                    for (int ifd = 1; ifd <= nFD; ++ifd) {
+                        int const qs = q + sgn*ifd; // in [-8, 11]
+                        int const ib = ((qs + 8) >> 2) - 2; // floor(qs/4) in [-2, 2], block shift
+                        int const jrow = row + (qs - 4*ib - q)*stride; // source row inside the neighbor block
+                        if (0 == ib) {
+                            hpsi += c[ifd] * psi[inzb][reim][jrow][j64];
+                        } else {
+                            auto const jj = neighbors[inzb][dd][lr][sgn*ib - 1];
+                            if (jj > CUBE_IS_ZERO) { // regular block
+                                hpsi += c[ifd] * psi[jj - CUBE_EXISTS][reim][jrow][j64];
+                            } else if (jj < CUBE_IS_ZERO) { // periodic image, needs a Bloch phase
+                                int const jb = CUBE_NEEDS_PHASE*jj - CUBE_EXISTS;
+                                assert(phase && "a phase must be given for complex BCs");
+                                real_t w = real_t(phase[dd][lr][0]) * psi[jb][reim][jrow][j64];
+                                if (2 == R1C2) {
+                                    w -= real_t(phase[dd][lr][1] * (1. - 2*reim)) * psi[jb][1 - reim][jrow][j64];
+                                } // is complex
+                                hpsi += c[ifd] * w;
+                            } // CUBE_IS_ZERO: block does not exist (isolated/vacuum boundary condition)
+                        } // ib
+                    } // ifd
+                } // lr
+            } // dd
+
+            Hpsi[inzb][reim][row][j64] = hpsi; // store
+
+        } // block loop
+#else  // HAS_NO_CUDA
+        assert(1 == gridDim.y && "CPU kernel Hamiltonian_local needs increment 1 for grid stride loop");
+        // on the CPU, collect the (source row, coefficient) pairs of each target row first and
+        // then apply them to contiguous rows of Noco*64 elements so the innermost loop vectorizes
+        int constexpr max_taps = 4 + 3*2*8*2; // potential and 3 directions with 2 sides, 8 points and 2 terms for Bloch phases
+        real_t const *src[max_taps];
+        real_t coeff[max_taps];
+        for (int inzb = 0; inzb < nnzb; ++inzb) // the block loop is outermost so neighbor blocks stay in cache
+        for (int i64 = 0; i64 < 64; ++i64)
+        for (int reim = 0; reim < R1C2; ++reim)
+        for (int spin = 0; spin < Noco; ++spin)
+        { // row loops
+            int const row = spin*64 + i64;
+            int ntaps{0};
+
+            // ========== local potential, as in green_potential::Potential ==========
+            auto const iloc = iloc_of_inzb[inzb]; // target index for the local potential, can be -1 for non-existing
+            real_t const Vloc_diag = (iloc < 0) ? 0 : Vloc[spin][iloc][i64];
+            real_t diag = Vloc_diag - E_real; // non-const, the central finite-difference coefficients are added below
+            if (imaginary) {
+                src[ntaps] = psi[inzb][1 - reim][row]; coeff[ntaps] = E_imag * real_t(1 - 2*reim); ++ntaps;
+            } // imaginary
+            if (2 == Noco && iloc >= 0) { // the other spin component is (1 - spin)
+                real_t const cs = (1 - 2*(reim ^ spin)); // complex sign is -1 if (reim != spin)
+                src[ntaps] = psi[inzb][    reim][(1 - spin)*64 + i64]; coeff[ntaps] = Vloc[2][iloc][i64];    ++ntaps; // V_x
+                src[ntaps] = psi[inzb][1 - reim][(1 - spin)*64 + i64]; coeff[ntaps] = Vloc[3][iloc][i64]*cs; ++ntaps; // V_y
+            } // non-collinear
+
+            // ========== kinetic energy, as in green_kinetic::Laplace8th and Laplace16th ==========
+            for (int dd = 0; dd < 3; ++dd) { // derivative direction
+                int const nFD = stencil.nFD[dd];
+                if (nFD < 1) continue; // kinetic energy switched off in this direction
+                auto const c = stencil.c[dd];
+                int const stride = 1 << (2*dd); // 4^dd: X:1, Y:4, Z:16
+                int const q = (i64 >> (2*dd)) & 0x3; // coordinate of the target grid point inside the block
+                diag += c[0];
+                for (int lr = 0; lr < 2; ++lr) { // left or right
+                    int const sgn = 2*lr - 1;
+                    for (int ifd = 1; ifd <= nFD; ++ifd) {
+                        int const qs = q + sgn*ifd; // in [-8, 11]
+                        int const ib = ((qs + 8) >> 2) - 2; // floor(qs/4) in [-2, 2], block shift
+                        int const jrow = row + (qs - 4*ib - q)*stride; // source row inside the neighbor block
+                        auto const jj = (0 == ib) ? (inzb + CUBE_EXISTS) : neighbors[inzb][dd][lr][sgn*ib - 1];
+                        if (jj > CUBE_IS_ZERO) { // regular block
+                            src[ntaps] = psi[jj - CUBE_EXISTS][reim][jrow]; coeff[ntaps] = c[ifd]; ++ntaps;
+                        } else if (jj < CUBE_IS_ZERO) { // periodic image, needs a Bloch phase
+                            int const jb = CUBE_NEEDS_PHASE*jj - CUBE_EXISTS;
+                            assert(phase && "a phase must be given for complex BCs");
+                            src[ntaps] = psi[jb][reim][jrow]; coeff[ntaps] = c[ifd]*real_t(phase[dd][lr][0]); ++ntaps;
+                            if (2 == R1C2) {
+                                src[ntaps] = psi[jb][1 - reim][jrow]; coeff[ntaps] = -c[ifd]*real_t(phase[dd][lr][1] * (1. - 2*reim)); ++ntaps;
+                            } // is complex
+                        } // CUBE_IS_ZERO: block does not exist (isolated/vacuum boundary condition)
+                    } // ifd
+                } // lr
+            } // dd
+            assert(ntaps <= max_taps);
+
+            auto const hpsi = Hpsi[inzb][reim][row];
+            auto const psi0 = psi[inzb][reim][row];
+            for (int j64 = 0; j64 < Noco*64; ++j64) {
+                hpsi[j64] = diag * psi0[j64];
+            } // j64
+            for (int itap = 0; itap < ntaps; ++itap) {
+                auto const s = src[itap];
+                real_t const cf = coeff[itap];
+                for (int j64 = 0; j64 < Noco*64; ++j64) {
+                    hpsi[j64] += cf * s[j64];
+                } // j64
+            } // itap
+
+#ifdef  CONFINEMENT_POTENTIAL
+            if (rcut2 >= 0.f) {
+                int constexpr n4 = 4;
+                auto const s = shift[inzb]; // shift vectors between target minus source cube
+                for (int j64 = 0; j64 < Noco*64; ++j64) {
+                    auto const d2 = pow2((int(s[0])*n4 + ( i64       & 0x3) - ( j64       & 0x3))*real_t(hxyz[0]))
+                                  + pow2((int(s[1])*n4 + ((i64 >> 2) & 0x3) - ((j64 >> 2) & 0x3))*real_t(hxyz[1]))
+                                  + pow2((int(s[2])*n4 + ((i64 >> 4) & 0x3) - ((j64 >> 4) & 0x3))*real_t(hxyz[2]));
+                    auto const d2out = real_t(d2 - rcut2);
+                    if (d2out > 0) hpsi[j64] += Vconf*pow2(d2out) * psi0[j64]; // quartic confinement potential, V ~ d^4
+                } // j64
+            } // rcut^2 >= 0
+#endif // CONFINEMENT_POTENTIAL
+
+        } // row loops
+#endif // HAS_NO_CUDA
+
+    } // Hamiltonian_local
+
+
+    class fused_plan_t {
+    public:
+
+        fused_plan_t() {} // default constructor
+
+        ~fused_plan_t() {
+            free_memory(neighbors);
+        } // destructor
+
+        fused_plan_t(fused_plan_t const &) = delete;
+        fused_plan_t & operator=(fused_plan_t const &) = delete;
+
+        status_t set(
+              green_kinetic::kinetic_plan_t const kinetic[3]
+            , uint32_t const nnzbX
+            , int const echo=0 // log level
+        ) {
+            // derive for each block the neighbors in the finite-difference lists,
+            // list[nhalo + k] is the k-th central block, so list[nhalo + k -/+ d] is its left/right neighbor at distance d
+            status_t stat(0);
+            free_memory(neighbors);
+            nnzb = nnzbX;
+            neighbors = get_memory<int32_t[3][2][2]>(nnzb, echo, "neighbors");
+            ::set(neighbors[0][0][0], nnzb*size_t(3*2*2), CUBE_IS_ZERO);
+            std::vector<int8_t> found(nnzb);
+            for (int dd = 0; dd < 3; ++dd) {
+                auto const & sparse = kinetic[dd].sparse;
+                auto const rowStart = sparse.rowStart();
+                auto const colIndex = sparse.colIndex();
+                FD_range[dd] = kinetic[dd].FD_range;
+                prefactor[dd] = kinetic[dd].prefactor;
+                ::set(found.data(), nnzb, int8_t(0));
+                for (uint32_t il = 0; il < sparse.nRows(); ++il) {
+                    auto const list = &colIndex[rowStart[il]];
+                    int const n = rowStart[il + 1] - rowStart[il];
+                    int m{0}; // number of central blocks
+                    while (nhalo + m < n && list[nhalo + m] > CUBE_IS_ZERO) ++m;
+                    if (n < nhalo + m + 2) { ++stat; continue; } // the list must end with at least 2 halo entries
+                    for (int k = 0; k < m; ++k) {
+                        int32_t const i0 = list[nhalo + k] - CUBE_EXISTS;
+                        if (i0 < 0 || i0 >= int32_t(nnzb)) { ++stat; continue; }
+                        ++found[i0];
+                        for (int d = 1; d <= 2; ++d) {
+                            neighbors[i0][dd][0][d - 1] = list[nhalo + k - d]; // left
+                            neighbors[i0][dd][1][d - 1] = list[nhalo + k + d]; // right
+                        } // d
+                    } // k
+                } // il
+                for (uint32_t inzb = 0; inzb < nnzb; ++inzb) {
+                    stat += (1 != found[inzb]); // each block must appear in exactly one list
+                } // inzb
+            } // dd
+            if (stat) warn("fused_plan_t found %d inconsistencies in the finite-difference lists", int(stat));
+            if (echo > 3) std::printf("# fused_plan_t for %d blocks, FD_range= %d %d %d, neighbor table %.3f MByte\n",
+                                nnzb, FD_range[0], FD_range[1], FD_range[2], nnzb*3*2*2*sizeof(int32_t)*1e-6);
+            return stat;
+        } // set
+
+        bool is_set() const { return nullptr != neighbors; }
+
+        template <typename real_t, int R1C2=2, int Noco=1>
+        size_t multiply(
+              real_t         (*const __restrict__ Hpsi)[R1C2][Noco*64][Noco*64] // result
+            , real_t   const (*const __restrict__  psi)[R1C2][Noco*64][Noco*64] // input
+            , double   const (*const *const __restrict__ Vloc)[64] // local potential, Vloc[Noco*Noco][iloc][4*4*4]
+            , int32_t  const (*const __restrict__ vloc_index) // iloc_of_inzb[nnzb]
+            , int16_t  const (*const __restrict__ shift)[3+1] // 3D block shift vector (target minus source), 4th component unused
+            , double   const (*const __restrict__ hxyz) // grid spacing in X,Y,Z direction
+            , double   const (*const phase)[2][2] // [3] complex Bloch phase factors
+            , std::complex<double> const E_param=0 // energy parameter
+            , float    const Vconf=0  // prefactor for the confinement potential
+            , float    const rcut2=-1 // cutoff radius^2 for the confinement potential, -1: no confinement
+            , int const echo=0
+        ) const { // members of the fused_plan_t are not changed
+            assert(is_set());
+            stencil_t<real_t> stencil;
+            size_t nFD_sum{0};
+            for (int dd = 0; dd < 3; ++dd) {
+                stencil.nFD[dd] = (FD_range[dd] < 1) ? 0 : ((8 == FD_range[dd]) ? 8 : 4); // same choice as Laplace_driver
+                ::set(stencil.c[dd], 1 + 8, real_t(0));
+                if (8 == stencil.nFD[dd]) {
+                    // FD16th = [-924708642, 538137600, -94174080, 22830080, -5350800, 1053696, -156800, 15360, -735] / 302702400
+                    double const c16[] = {-924708642, 538137600, -94174080, 22830080, -5350800, 1053696, -156800, 15360, -735};
+                    for (int ifd = 0; ifd <= 8; ++ifd) stencil.c[dd][ifd] = c16[ifd]*(prefactor[dd]/302702400.);
+                } else if (4 == stencil.nFD[dd]) {
+                    double const c8[] = {-14350, 8064, -1008, 128, -9}; // / 5040 --> 8th order
+                    for (int ifd = 0; ifd <= 4; ++ifd) stencil.c[dd][ifd] = c8[ifd]*(prefactor[dd]/5040.);
+                } // nFD
+                nFD_sum += (stencil.nFD[dd] > 0)*(2*stencil.nFD[dd] + 1);
+            } // dd
+
+            Hamiltonian_local<real_t,R1C2,Noco>
+#ifndef   HAS_NO_CUDA
+                <<< dim3(64, 7, 1), dim3(Noco*64, Noco, R1C2) >>> ( // 7=any, as in green_potential::multiply
+#else  // HAS_NO_CUDA
+                  ( dim3(64, 1, 1), dim3(Noco*64, Noco, R1C2),
+#endif // HAS_NO_CUDA
+                Hpsi, psi, neighbors, stencil, phase, Vloc, vloc_index, shift, hxyz, nnzb,
+                Vconf, rcut2, E_param.real(), E_param.imag());
+
+            size_t const nops = (  1ul
+                                +  2ul*(0 != E_param.imag())
+                                +  4ul*(2 == Noco)
+#ifdef CONFINEMENT_POTENTIAL
+                                + 10ul*(rcut2 >= 0.f)
+#endif // CONFINEMENT_POTENTIAL
+                                + 2ul*nFD_sum
+                                )*nnzb*pow2(64ul*Noco)*R1C2; // the same count as potential + kinetic
+            if (echo > 7) {
+                char const fF = (8 == sizeof(real_t)) ? 'F' : 'f'; // Mflop:float, MFlop:double
+                std::printf("# green_fused::%s nFD= %d %d %d, %.3f M%clop\n",
+                    __func__, stencil.nFD[0], stencil.nFD[1], stencil.nFD[2], nops*1e-6, fF);
+            } // echo
+            return nops;
+        } // multiply
+
+    public:
+        // members
+        int32_t (*neighbors)[3][2][2] = nullptr; // [nnzb][dd][left/right][distance - 1] in device memory
+        uint32_t nnzb = 0;
+        int16_t FD_range[3] = {0, 0, 0};
+        double prefactor[3] = {0, 0, 0}; // = -0.5/h^2, as in the kinetic_plan_t
+
+    }; // class fused_plan_t
+
+
+#ifdef    NO_UNIT_TESTS
+  inline status_t all_tests(int const echo=0) { return STATUS_TEST_NOT_INCLUDED; }
+#else  // NO_UNIT_TESTS
+
+  inline void box_lists(
+        std::vector<std::vector<int32_t>> & list // result
+      , int const dd // derivative direction
+      , int const nb[3] // number of blocks in the box
+      , bool const periodic
+  ) {
+      // finite-difference lists for a box in which all blocks exist, block index = index3D(nb, ib)
+      int num[3] = {nb[0], nb[1], nb[2]}; num[dd] = 1;
+      list.resize(0);
+      for (int iz = 0; iz < num[2]; ++iz) {
+      for (int iy = 0; iy < num[1]; ++iy) {
+      for (int ix = 0; ix < num[0]; ++ix) {
+          int ib[3] = {ix, iy, iz};
+          std::vector<int32_t> li(nhalo + nb[dd] + nhalo, CUBE_IS_ZERO);
+          for (int id = 0; id < nb[dd]; ++id) {
+              ib[dd] = id;
+              li[nhalo + id] = index3D(nb, ib) + CUBE_EXISTS;
+          } // id
+          if (periodic) {
+              for (int ihalo = 0; ihalo < nhalo; ++ihalo) {
+                  ib[dd] = (nhalo*nb[dd] - nhalo + ihalo) % nb[dd];
+                  li[ihalo] = CUBE_NEEDS_PHASE*(index3D(nb, ib) + CUBE_EXISTS);
+                  ib[dd] = ihalo % nb[dd];
+                  li[nhalo + nb[dd] + ihalo] = CUBE_NEEDS_PHASE*(index3D(nb, ib) + CUBE_EXISTS);
+              } // ihalo
+          } // periodic
+          list.push_back(li);
+      }}} // ix iy iz
+  } // box_lists
+
+  template <typename real_t, int R1C2=2, int Noco=1>
+  inline status_t test_fused_vs_sequence(int const echo=0) {
+      // compare Hamiltonian_local with green_potential::multiply followed by 3 calls to kinetic_plan_t::multiply
+      status_t stat(0);
+      int const nb[] = {3, 2, 4}; // x-direction periodic
+      bool const periodic[] = {true, false, false};
+      uint32_t const nnzb = nb[0]*nb[1]*nb[2];
+      double const hg[] = {0.25, 0.3, 0.2};
+
+      green_kinetic::kinetic_plan_t kinetic[3];
+      for (int dd = 0; dd < 3; ++dd) {
+          std::vector<std::vector<int32_t>> list;
+          box_lists(list, dd, nb, periodic[dd]);
+          kinetic[dd].sparse = green_sparse::sparse_t<int32_t>(list, false, "box_list", echo);
+          kinetic[dd].set(dd, hg[dd], nnzb, echo);
+          kinetic[dd].FD_range = 8; // Laplace16th, also for the periodic direction
+      } // dd
+
+      fused_plan_t fused;
+      stat += fused.set(kinetic, nnzb, echo);
+
+      auto phase = get_memory<double[2][2]>(3, echo, "phase");
+      double const angles[] = {(2 == R1C2) ? 0.125 : 0.5, 0, 0}; // real waves need real phases
+      green_kinetic::set_phase(phase, angles, echo);
+
+      int constexpr LM = Noco*64;
+      auto Vloc = get_memory<double(*)[64]>(Noco*Noco, echo, "Vloc");
+      for (int mag = 0; mag < Noco*Noco; ++mag) {
+          Vloc[mag] = get_memory<double[64]>(nnzb, echo, "Vloc[mag]");
+          for (uint32_t iloc = 0; iloc < nnzb; ++iloc) {
+              for (int i64 = 0; i64 < 64; ++i64) Vloc[mag][iloc][i64] = 0.1*((iloc*7 + i64*3 + mag) % 11) - 0.5;
+          } // iloc
+      } // mag
+      auto vloc_index = get_memory<int32_t>(nnzb, echo, "vloc_index");
+      for (uint32_t inzb = 0; inzb < nnzb; ++inzb) vloc_index[inzb] = (5 == inzb) ? -1 : inzb; // one block without potential
+      auto shift = get_memory<int16_t[3+1]>(nnzb, echo, "shift"); set(shift[0], nnzb*4, int16_t(0));
+      auto hxyz = get_memory<double>(3+1, echo, "hxyz"); set(hxyz, 3, hg); hxyz[3] = 0;
+
+      auto psi   = get_memory<real_t[R1C2][LM][LM]>(nnzb, echo, "psi");
+      auto Hpsi  = get_memory<real_t[R1C2][LM][LM]>(nnzb, echo, "Hpsi");
+      auto Hpsi2 = get_memory<real_t[R1C2][LM][LM]>(nnzb, echo, "Hpsi2");
+      size_t const n_all = nnzb*size_t(R1C2*LM*LM);
+      real_t *const psi_all = psi[0][0][0], *const H_all = Hpsi[0][0][0], *const H2_all = Hpsi2[0][0][0];
+      for (size_t i = 0; i < n_all; ++i) psi_all[i] = ((i*2654435761u) % 1000)*1e-3 - 0.5; // pseudo-random
+
+      std::complex<double> const E_param(0.25, (2 == R1C2) ? 0.05 : 0.0);
+
+      // sequential version
+      green_potential::multiply<real_t,R1C2,Noco>(Hpsi2, psi, Vloc, vloc_index, shift, hxyz, nnzb, E_param);
+      for (int dd = 0; dd < 3; ++dd) {
+          kinetic[dd].multiply<real_t,R1C2,Noco>(Hpsi2, psi, phase[dd], echo);
+      } // dd
+
+      // fused version
+      fused.multiply<real_t,R1C2,Noco>(Hpsi, psi, Vloc, vloc_index, shift, hxyz, phase, E_param, 0.f, -1.f, echo);
+      cudaDeviceSynchronize();
+
+      double dev{0}, mag{0};
+      for (size_t i = 0; i < n_all; ++i) {
+          dev = std::max(dev, std::abs(double(H_all[i]) - double(H2_all[i])));
+          mag = std::max(mag, std::abs(double(H2_all[i])));
+      } // i
+      double const threshold = (8 == sizeof(real_t)) ? 1e-12 : 1e-5;
+      stat += (dev > threshold*mag);
+      if (echo > 3) std::printf("# %s<%s,R1C2=%d,Noco=%d> largest deviation %.1e, relative %.1e\n",
+                                  __func__, real_t_name<real_t>(), R1C2, Noco, dev, dev/std::max(mag, 1e-300));
+
+      free_memory(Hpsi2);
+      free_memory(Hpsi);
+      free_memory(psi);
+      free_memory(hxyz);
+      free_memory(shift);
+      free_memory(vloc_index);
+      for (int mag = 0; mag < Noco*Noco; ++mag) free_memory(Vloc[mag]);
+      free_memory(Vloc);
+      free_memory(phase);
+      return stat;
+  } // test_fused_vs_sequence
+
+  inline status_t all_tests(int const echo=0) {
+      status_t stat(0);
+      stat += test_fused_vs_sequence<float ,1,1>(echo);
+      stat += test_fused_vs_sequence<float ,2,1>(echo);
+      stat += test_fused_vs_sequence<float ,2,2>(echo);
+      stat += test_fused_vs_sequence<double,1,1>(echo);
+      stat += test_fused_vs_sequence<double,2,1>(echo);
+      stat += test_fused_vs_sequence<double,2,2>(echo);
+      return stat;
+  } // all_tests
+
+#endif // NO_UNIT_TESTS
+
+} // namespace green_fused
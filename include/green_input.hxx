@@ -1,6 +1,8 @@
 #pragma once
 // This file is part of AngstromCube under MIT License
 
+#include <cstdint> // uint32_t, int8_t, uint64_t
+#include <cstdlib> // size_t
 #include <vector> // std::vector<T>
 
 #include "status.hxx" // status_t
@@ -19,6 +21,91 @@ namespace green_input {
       , int const echo=0 // log-level
   ); // declaration only
 
+  // binary Hamiltonian file: versioned header followed by 64-byte aligned sections
+  //    "atoms"     natoms*8 doubles {x, y, z, Z, global_id, numax, sigma, 0}
+  //    "offsets"   natoms+1 uint64_t, start of each atom matrix in units of doubles
+  //    "matrices"  per atom 2*nSHO^2 doubles, hamiltonian then overlap
+  //    "potential" ng[2]*ng[1]*ng[0] doubles, empty if the potential is stored in blocks
+  //    "Vblocks"   only the 4x4x4 blocks that differ from a constant background value,
+  //                with per-block min/max and optionally lossless compression (since version 2)
+  status_t write_binary_Hamiltonian(
+        char const *filename
+      , uint32_t const ng[3] // numbers of grid points
+      , int8_t const bc[3] // boundary conditions
+      , double const hg[3] // grid spacings
+      , double const Veff[] // [ng[2]*ng[1]*ng[0]]
+      , int const natoms
+      , double const xyzZinso[] // [natoms*8]
+      , double const *const atom_mat[] // [natoms][2*nSHO^2]
+      , double const energy_min_max_Fermi[3]=nullptr // optional
+      , int const echo=0 // log-level
+      , int const sparse=0 // 0: dense potential, 1: potential blocks, 2: compressed potential blocks
+  ); // declaration only
+
+  bool is_binary_Hamiltonian(char const *filename); // declaration only
+
+  class mapped_Hamiltonian_t { // read-only, zero-copy views into a binary Hamiltonian file
+  public:
+
+      mapped_Hamiltonian_t() {}
+      ~mapped_Hamiltonian_t() { unmap(); }
+      mapped_Hamiltonian_t(mapped_Hamiltonian_t const &) = delete;
+      mapped_Hamiltonian_t & operator=(mapped_Hamiltonian_t const &) = delete;
+
+      status_t map(char const *filename, int const echo=0); // declaration only
+      void unmap(); // declaration only
+
+      uint32_t const * grid_points()       const { return ng_; }
+      int8_t   const * boundary_conditions() const { return bc_; }
+      double   const * grid_spacings()     const { return hg_; }
+      double   const * spectrum()          const { return has_spectrum_ ? spectrum_ : nullptr; }
+      int              number_of_atoms()   const { return natoms_; }
+      double   const * potential()         const { return Veff_; } // [ng[2]*ng[1]*ng[0]], nullptr if sparse
+      double   const * atom_info()         const { return xyzZinso_; } // [natoms][8]
+      double   const * atom_matrix(int const ia) const { return matrices_ + offsets_[ia]; } // [2][nSHO][nSHO]
+      size_t           atom_matrix_size(int const ia) const { return offsets_[ia + 1] - offsets_[ia]; }
+      bool             is_memory_mapped()  const { return is_mapped_; }
+      size_t           file_bytes()        const { return bytes_; }
+
+      // potential in 4x4x4 blocks, block index (ibz*nb[Y] + iby)*nb[X] + ibx with nb = ng/4,
+      // grid point index inside a block (i4z*4 + i4y)*4 + i4x, works for dense and sparse files
+      status_t potential_block(size_t const iblock, double V[64], double min_max[2]=nullptr) const; // declaration only
+      bool             has_sparse_potential()    const { return nullptr != block_index_; }
+      size_t           number_of_stored_blocks() const { return nstored_; }
+      double           potential_background()    const { return background_; }
+
+      // copy into the std::vector interface of load_Hamiltonian, the potential is optional
+      status_t copy_to(uint32_t ng[3], int8_t bc[3], double hg[3], std::vector<double> & Veff, int & natoms,
+                       std::vector<double> & xyzZinso, std::vector<std::vector<double>> & atom_mat,
+                       bool const with_potential=true) const; // declaration only
+
+  private:
+      char const *data_{nullptr};
+      size_t bytes_{0};
+      bool is_mapped_{false};
+      std::vector<uint64_t> buffer_; // fallback if mmap is not available
+      uint32_t ng_[3] = {0, 0, 0};
+      int8_t   bc_[3] = {0, 0, 0};
+      double   hg_[3] = {1, 1, 1};
+      double   spectrum_[3] = {0, 0, 0};
+      bool has_spectrum_{false};
+      int natoms_{0};
+      double   const *Veff_{nullptr};
+      double   const *xyzZinso_{nullptr};
+      uint64_t const *offsets_{nullptr};
+      double   const *matrices_{nullptr};
+      // sparse potential
+      size_t nstored_{0};
+      uint32_t compression_{0};
+      double background_{0};
+      uint64_t const *block_index_{nullptr}; // [nstored], ascending
+      double   const *block_min_max_{nullptr}; // [nstored][2]
+      uint64_t const *block_offset_{nullptr}; // [nstored + 1] in Byte
+      uint8_t  const *block_data_{nullptr};
+  }; // class mapped_Hamiltonian_t
+
+  status_t convert_Hamiltonian(char const *infile, char const *outfile, int const echo=0); // declaration only
+
   status_t all_tests(int echo=0); // declaration only
 
 } // namespace green_input
@@ -9,6 +9,8 @@
 #include "green_memory.hxx" // get_memory, free_memory --> used in multiply, ToDo: move into planning phase
 #include "green_sparse.hxx" // ::sparse_t<T>
 #include "data_view.hxx" // view3D<T>
+#include "inline_math.hxx" // pow2, set
+#include "green_precision.hxx" // ::load, ::add_to
 
   // ToDo: move to green_utils.hxx or similar
   template <typename uint_t, typename int_t> inline
@@ -27,13 +29,13 @@ namespace green_kinetic {
     int32_t constexpr CUBE_NEEDS_PHASE = -1;
 
 
-    template <typename real_t, int R1C2=2, int Noco=1> // Stride is determined by the lattice dimension along which we derive
+    template <typename real_t, int R1C2=2, int Noco=1, typename storage_t=real_t> // Stride is determined by the lattice dimension along which we derive
     void __global__ Laplace8th( // GPU kernel, must be launched with <<< {Nrows, 16, 1}, {Noco*64, Noco, R1C2} >>>
 #ifdef    HAS_NO_CUDA
           dim3 const & gridDim, dim3 const & blockDim,
 #endif // HAS_NO_CUDA
-          real_t        (*const __restrict__ Tpsi)[R1C2][Noco*64][Noco*64] // intent(inout)
-        , real_t  const (*const __restrict__  psi)[R1C2][Noco*64][Noco*64] // intent(in)
+          storage_t       (*const __restrict__ Tpsi)[R1C2][Noco*64][Noco*64] // intent(inout)
+        , storage_t const (*const __restrict__  psi)[R1C2][Noco*64][Noco*64] // intent(in)
         , int32_t const (*const *const __restrict__ index_list) // index list that brings the blocks in order,
                                                                 // list must contain at least 4+1+4 elements
         , double const prefactor
@@ -62,11 +64,17 @@ namespace green_kinetic {
         assert(R1C2    == blockDim.z);
 
 #ifdef    HAS_NO_CUDA
-        dim3 blockIdx(0,0,0);
-        for (blockIdx.y = 0; blockIdx.y < gridDim.y; ++blockIdx.y)
-        for (blockIdx.x = 0; blockIdx.x < gridDim.x; ++blockIdx.x)
+        // the rows of index_list are conflict-free, each block appears in exactly one list
+#ifndef   HAS_NO_OMP
+        #pragma omp parallel for collapse(2) schedule(static)
+#endif // HAS_NO_OMP
+        for (int block_y = 0; block_y < gridDim.y; ++block_y)
+        for (int block_x = 0; block_x < gridDim.x; ++block_x)
 #endif // HAS_NO_CUDA
         { // block loops
+#ifdef    HAS_NO_CUDA
+        dim3 const blockIdx(block_x, block_y, 0);
+#endif // HAS_NO_CUDA
 
         auto const *const list = index_list[blockIdx.x]; // abbreviate pointer
 
@@ -100,18 +108,18 @@ namespace green_kinetic {
             assert(phase && "a phase must be given for complex BCs");
             real_t const ph_Re = phase[0][0]; // real part of the left complex phase factor
             // inital halo-cube load
-            w0 = ph_Re * psi[jj]INDICES(0);
-            w1 = ph_Re * psi[jj]INDICES(1);
-            w2 = ph_Re * psi[jj]INDICES(2);
-            w3 = ph_Re * psi[jj]INDICES(3);
+            w0 = ph_Re * green_precision::load<real_t>(psi[jj]INDICES(0));
+            w1 = ph_Re * green_precision::load<real_t>(psi[jj]INDICES(1));
+            w2 = ph_Re * green_precision::load<real_t>(psi[jj]INDICES(2));
+            w3 = ph_Re * green_precision::load<real_t>(psi[jj]INDICES(3));
             if (2 == R1C2) {
                 real_t const ph_Im = phase[0][1] * (1. - 2*threadIdx.z); // imaginary part of the left complex phase factor
 #define INDICES_Im(i4) [R1C2 - 1 - threadIdx.z][threadIdx.y*64 + i64 + Stride*i4][threadIdx.x]
                 // inital load of imaginary parts
-                w0 -= ph_Im * psi[jj]INDICES_Im(0);
-                w1 -= ph_Im * psi[jj]INDICES_Im(1);
-                w2 -= ph_Im * psi[jj]INDICES_Im(2);
-                w3 -= ph_Im * psi[jj]INDICES_Im(3);
+                w0 -= ph_Im * green_precision::load<real_t>(psi[jj]INDICES_Im(0));
+                w1 -= ph_Im * green_precision::load<real_t>(psi[jj]INDICES_Im(1));
+                w2 -= ph_Im * green_precision::load<real_t>(psi[jj]INDICES_Im(2));
+                w3 -= ph_Im * green_precision::load<real_t>(psi[jj]INDICES_Im(3));
             } // is complex
         } // is periodic
         // === periodic boundary conditions ========================================================
@@ -121,10 +129,10 @@ namespace green_kinetic {
 
         ii = list[ilist++] - CUBE_EXISTS; assert(ii >= 0); // this block must be a regular index since it is the 1st block for which we store a result
         // initially load one block in advance
-        w4 = psi[ii]INDICES(0);
-        w5 = psi[ii]INDICES(1);
-        w6 = psi[ii]INDICES(2);
-        w7 = psi[ii]INDICES(3);
+        w4 = green_precision::load<real_t>(psi[ii]INDICES(0));
+        w5 = green_precision::load<real_t>(psi[ii]INDICES(1));
+        w6 = green_precision::load<real_t>(psi[ii]INDICES(2));
+        w7 = green_precision::load<real_t>(psi[ii]INDICES(3));
 
         assert(nhalo + 1 == ilist);
         // main loop
@@ -137,8 +145,8 @@ namespace green_kinetic {
 
             // FD9POINT = load?, compute, store, update rotating register file
 #define FD9POINT(i4,  M4, M3, M2, M1, W0, P1, P2, P3, P4) \
-            P4 = load ? psi[ii]INDICES(i4) : 0; \
-            Tpsi[i0]INDICES(i4) += c0*W0 + c1*M1 + c1*P1 + c2*M2 + c2*P2 + c3*M3 + c3*P3 + c4*M4 + c4*P4; \
+            P4 = load ? green_precision::load<real_t>(psi[ii]INDICES(i4)) : 0; \
+            green_precision::add_to(Tpsi[i0]INDICES(i4), c0*W0 + c1*M1 + c1*P1 + c2*M2 + c2*P2 + c3*M3 + c3*P3 + c4*M4 + c4*P4); \
             M4 = P4;
 
             if (0 == (ilist & 0x1)) { // even
@@ -172,24 +180,24 @@ namespace green_kinetic {
             assert(phase && "no (right) phase given"); // should have failed already above
             real_t const ph_Re = phase[1][0]; // real part of the right complex phase factor
             // load right halo block
-            w0 = ph_Re * psi[jj]INDICES(0);
-            w1 = ph_Re * psi[jj]INDICES(1);
-            w2 = ph_Re * psi[jj]INDICES(2);
-            w3 = ph_Re * psi[jj]INDICES(3);
+            w0 = ph_Re * green_precision::load<real_t>(psi[jj]INDICES(0));
+            w1 = ph_Re * green_precision::load<real_t>(psi[jj]INDICES(1));
+            w2 = ph_Re * green_precision::load<real_t>(psi[jj]INDICES(2));
+            w3 = ph_Re * green_precision::load<real_t>(psi[jj]INDICES(3));
             if (2 == R1C2) {
                 real_t const ph_Im = phase[1][1] * (1. - 2*threadIdx.z); // imaginary part of the right complex phase factor
                 // load of imaginary part right halo block
-                w0 -= ph_Im * psi[jj]INDICES_Im(0);
-                w1 -= ph_Im * psi[jj]INDICES_Im(1);
-                w2 -= ph_Im * psi[jj]INDICES_Im(2);
-                w3 -= ph_Im * psi[jj]INDICES_Im(3);
+                w0 -= ph_Im * green_precision::load<real_t>(psi[jj]INDICES_Im(0));
+                w1 -= ph_Im * green_precision::load<real_t>(psi[jj]INDICES_Im(1));
+                w2 -= ph_Im * green_precision::load<real_t>(psi[jj]INDICES_Im(2));
+                w3 -= ph_Im * green_precision::load<real_t>(psi[jj]INDICES_Im(3));
 #undef  INDICES_Im
             } // is complex
             // add missing terms
-            Tpsi[i0]INDICES(0) += c4*w0;
-            Tpsi[i0]INDICES(1) += c3*w0 + c4*w1;
-            Tpsi[i0]INDICES(2) += c2*w0 + c3*w1 + c4*w2;
-            Tpsi[i0]INDICES(3) += c1*w0 + c2*w1 + c3*w2 + c4*w3;
+            green_precision::add_to(Tpsi[i0]INDICES(0), c4*w0);
+            green_precision::add_to(Tpsi[i0]INDICES(1), c3*w0 + c4*w1);
+            green_precision::add_to(Tpsi[i0]INDICES(2), c2*w0 + c3*w1 + c4*w2);
+            green_precision::add_to(Tpsi[i0]INDICES(3), c1*w0 + c2*w1 + c3*w2 + c4*w3);
         } // is periodic
         // === periodic boundary conditions ========================================================
         // =========================================================================================
@@ -203,20 +211,19 @@ namespace green_kinetic {
 
 
 
-    template <typename real_t, int R1C2=2, int Noco=1>
+    template <typename real_t, int R1C2=2, int Noco=1, typename storage_t=real_t>
     void __global__ Laplace16th( // GPU kernel, must be launched with <<< {Nrows, 16, 1}, {Noco*64, Noco, R1C2} >>>
 #ifdef    HAS_NO_CUDA
           dim3 const & gridDim, dim3 const & blockDim,
 #endif // HAS_NO_CUDA
-          real_t        (*const __restrict__ Tpsi)[R1C2][Noco*64][Noco*64] // intent(inout)
-        , real_t  const (*const __restrict__  psi)[R1C2][Noco*64][Noco*64] // intent(in)
+          storage_t       (*const __restrict__ Tpsi)[R1C2][Noco*64][Noco*64] // intent(inout)
+        , storage_t const (*const __restrict__  psi)[R1C2][Noco*64][Noco*64] // intent(in)
         , int32_t const (*const *const __restrict__ index_list) // index lists that bring the blocks in order,
                                                                 // lists must contain at least 4+1+4 elements
         , double const prefactor
         , int const Stride // Stride is determined by the lattice dimension along which we derive: 1, 4 or 4^2
-        , double const phase[2][2]=nullptr // WARNING this routine cannot treat periodic boundary conditions
+        , double const phase[2][2]=nullptr // complex Bloch phase factors, only needed for periodic boundary conditions
     ) {
-        assert(nullptr == phase);          // WARNING this routine cannot treat periodic boundary conditions
         // prepare finite-difference coefficients
         //            c_0        c_1         c_2       c_3        c_4      c_5       c_6     c_7     c_8
         // FD16th = [-924708642, 538137600, -94174080, 22830080, -5350800, 1053696, -156800, 15360, -735] / 302702400
@@ -238,11 +245,17 @@ namespace green_kinetic {
         assert(R1C2    == blockDim.z);
 
 #ifdef    HAS_NO_CUDA
-        dim3 blockIdx(0,0,0);
-        for (blockIdx.y = 0; blockIdx.y < gridDim.y; ++blockIdx.y)
-        for (blockIdx.x = 0; blockIdx.x < gridDim.x; ++blockIdx.x)
+        // the rows of index_list are conflict-free, each block appears in exactly one list
+#ifndef   HAS_NO_OMP
+        #pragma omp parallel for collapse(2) schedule(static)
+#endif // HAS_NO_OMP
+        for (int block_y = 0; block_y < gridDim.y; ++block_y)
+        for (int block_x = 0; block_x < gridDim.x; ++block_x)
 #endif // HAS_NO_CUDA
         { // block loops
+#ifdef    HAS_NO_CUDA
+        dim3 const blockIdx(block_x, block_y, 0);
+#endif // HAS_NO_CUDA
 
         auto const *const list = index_list[blockIdx.x]; // abbreviate pointer
 
@@ -259,30 +272,47 @@ namespace green_kinetic {
 
 #define INDICES(i4) [threadIdx.z][threadIdx.y*64 + i64 + Stride*i4][threadIdx.x]
 
+#define INDICES_Im(i4) [R1C2 - 1 - threadIdx.z][threadIdx.y*64 + i64 + Stride*i4][threadIdx.x]
+#define PHASED(jj, i4) (ph_Re*green_precision::load<real_t>(psi[jj]INDICES(i4)) - ph_Im*green_precision::load<real_t>(psi[jj]INDICES_Im(i4)))
+
         real_t w0{0}, w1{0}, w2{0}, w3{0}, w4{0}, w5{0}, w6{0}, w7{0}, // initialize two non-existing blocks (isolated boundary condition)
                w8, w9, wa, wb, wc, wd, we, wf, wn; // 8 + 8 + 1 registers
 
-        int ilist{0}; // counter for index_list
-        for (int ih = 0; ih < nhalo; ++ih) {
-            // if (0 == threadIdx.x && 0 == blockIdx.y) std::printf("# Laplace16th ih=%i list[ilist=%i]=%i\n", ih, ilist, list[ilist]);
-            assert(0 == list[ilist] && "Laplace16th can only deal with isolated boundary conditions");
-            ++ilist; // the increment may not stand inside the assert since that is deactivated with -D NDEBUG
-        } // ih
+        int ilist{nhalo}; // counter for index_list, use only the last two entries of the halo
+        // =========================================================================================
+        // === periodic boundary conditions ========================================================
+        int const jm2 = list[nhalo - 2], jm1 = list[nhalo - 1]; // halo blocks at distance 2 and 1 left of the 1st block
+        assert(jm2 <= CUBE_IS_ZERO && jm1 <= CUBE_IS_ZERO && "halo entries must be either 0 (isolated BC) or negative (periodic BC)");
+        if (jm2 < CUBE_IS_ZERO || jm1 < CUBE_IS_ZERO) { // is periodic
+            assert(phase && "a phase must be given for complex BCs");
+            real_t const ph_Re = phase[0][0]; // real part of the left complex phase factor
+            real_t const ph_Im = (2 == R1C2) ? phase[0][1] * (1. - 2*threadIdx.z) : 0; // imaginary part of the left complex phase factor
+            if (jm2 < CUBE_IS_ZERO) {
+                int const jj = CUBE_NEEDS_PHASE*jm2 - CUBE_EXISTS; // index of the periodic image of a block
+                w0 = PHASED(jj, 0); w1 = PHASED(jj, 1); w2 = PHASED(jj, 2); w3 = PHASED(jj, 3);
+            } // jm2
+            if (jm1 < CUBE_IS_ZERO) {
+                int const jj = CUBE_NEEDS_PHASE*jm1 - CUBE_EXISTS; // index of the periodic image of a block
+                w4 = PHASED(jj, 0); w5 = PHASED(jj, 1); w6 = PHASED(jj, 2); w7 = PHASED(jj, 3);
+            } // jm1
+        } // is periodic
+        // === periodic boundary conditions ========================================================
+        // =========================================================================================
 
         // initially load two blocks in advance
         int i0 = list[ilist++] - CUBE_EXISTS; // load index for 1st non-zero block
         assert(i0 >= 0); // 1st central block must exist
-        w8 = psi[i0]INDICES(0); // inital load
-        w9 = psi[i0]INDICES(1); // inital load
-        wa = psi[i0]INDICES(2); // inital load
-        wb = psi[i0]INDICES(3); // inital load
+        w8 = green_precision::load<real_t>(psi[i0]INDICES(0)); // inital load
+        w9 = green_precision::load<real_t>(psi[i0]INDICES(1)); // inital load
+        wa = green_precision::load<real_t>(psi[i0]INDICES(2)); // inital load
+        wb = green_precision::load<real_t>(psi[i0]INDICES(3)); // inital load
 
         int i1 = list[ilist++] - CUBE_EXISTS; // load index for the 2nd block
         if (i1 >= 0) {
-            wc = psi[i1]INDICES(0); // inital load
-            wd = psi[i1]INDICES(1); // inital load
-            we = psi[i1]INDICES(2); // inital load
-            wf = psi[i1]INDICES(3); // inital load
+            wc = green_precision::load<real_t>(psi[i1]INDICES(0)); // inital load
+            wd = green_precision::load<real_t>(psi[i1]INDICES(1)); // inital load
+            we = green_precision::load<real_t>(psi[i1]INDICES(2)); // inital load
+            wf = green_precision::load<real_t>(psi[i1]INDICES(3)); // inital load
         } else {
             wc = 0; wd = 0; we = 0; wf = 0; // second block is already non-existing
         } // i1 valid
@@ -298,9 +328,9 @@ namespace green_kinetic {
 
             // FD17POINT = load?, compute, store, update rotating register file
 #define FD17POINT(i4,  M8, M7, M6, M5, M4, M3, M2, M1, W0, P1, P2, P3, P4, P5, P6, P7, P8) \
-            P8 = load ? psi[i2]INDICES(i4) : 0; \
-            Tpsi[i0]INDICES(i4) += c0*W0 + c1*M1 + c1*P1 + c2*M2 + c2*P2 + c3*M3 + c3*P3 + c4*M4 + c4*P4 \
-                                         + c5*M5 + c5*P5 + c6*M6 + c6*P6 + c7*M7 + c7*P7 + c8*M8 + c8*P8; \
+            P8 = load ? green_precision::load<real_t>(psi[i2]INDICES(i4)) : 0; \
+            green_precision::add_to(Tpsi[i0]INDICES(i4), c0*W0 + c1*M1 + c1*P1 + c2*M2 + c2*P2 + c3*M3 + c3*P3 + c4*M4 + c4*P4 \
+                                         + c5*M5 + c5*P5 + c6*M6 + c6*P6 + c7*M7 + c7*P7 + c8*M8 + c8*P8); \
             M8 = P8;
 
             int const mod4 = ilist & 0x3; // binary modulo 4
@@ -330,6 +360,44 @@ namespace green_kinetic {
             i0 = i1; i1 = i2; i2 = list[ilist++] - CUBE_EXISTS; // rotate and get next index
         } // while loop
 
+        // =========================================================================================
+        // === periodic boundary conditions ========================================================
+        // correct for the tail part of the last two blocks if periodic
+        int const jp0 = list[ilist - 3], jp1 = list[ilist - 2]; // halo blocks at distance 1 and 2 right of the last block
+        assert(jp0 <= CUBE_IS_ZERO && jp1 <= CUBE_IS_ZERO && "halo entries must be either 0 (isolated BC) or negative (periodic BC)");
+        if (jp0 < CUBE_IS_ZERO || jp1 < CUBE_IS_ZERO) { // is periodic
+            assert(phase && "no (right) phase given");
+            real_t const ph_Re = phase[1][0]; // real part of the right complex phase factor
+            real_t const ph_Im = (2 == R1C2) ? phase[1][1] * (1. - 2*threadIdx.z) : 0; // imaginary part of the right complex phase factor
+            w0 = 0; w1 = 0; w2 = 0; w3 = 0; w4 = 0; w5 = 0; w6 = 0; w7 = 0;
+            if (jp0 < CUBE_IS_ZERO) {
+                int const jj = CUBE_NEEDS_PHASE*jp0 - CUBE_EXISTS; // index of the periodic image of a block
+                w0 = PHASED(jj, 0); w1 = PHASED(jj, 1); w2 = PHASED(jj, 2); w3 = PHASED(jj, 3);
+            } // jp0
+            if (jp1 < CUBE_IS_ZERO) {
+                int const jj = CUBE_NEEDS_PHASE*jp1 - CUBE_EXISTS; // index of the periodic image of a block
+                w4 = PHASED(jj, 0); w5 = PHASED(jj, 1); w6 = PHASED(jj, 2); w7 = PHASED(jj, 3);
+            } // jp1
+            int const iB = list[ilist - 4] - CUBE_EXISTS; // recover the last central index
+            assert(iB >= 0); // must be a valid index to dereference Tpsi[]
+            // add missing terms
+            green_precision::add_to(Tpsi[iB]INDICES(0),                               c4*w0 + c5*w1 + c6*w2 + c7*w3 + c8*w4);
+            green_precision::add_to(Tpsi[iB]INDICES(1),                      c3*w0 + c4*w1 + c5*w2 + c6*w3 + c7*w4 + c8*w5);
+            green_precision::add_to(Tpsi[iB]INDICES(2),             c2*w0 + c3*w1 + c4*w2 + c5*w3 + c6*w4 + c7*w5 + c8*w6);
+            green_precision::add_to(Tpsi[iB]INDICES(3),    c1*w0 + c2*w1 + c3*w2 + c4*w3 + c5*w4 + c6*w5 + c7*w6 + c8*w7);
+            int const iA = list[ilist - 5] - CUBE_EXISTS; // recover the second last central index, negative if there is none
+            if (iA >= 0) {
+                green_precision::add_to(Tpsi[iA]INDICES(0),                               c8*w0);
+                green_precision::add_to(Tpsi[iA]INDICES(1),                      c7*w0 + c8*w1);
+                green_precision::add_to(Tpsi[iA]INDICES(2),             c6*w0 + c7*w1 + c8*w2);
+                green_precision::add_to(Tpsi[iA]INDICES(3),    c5*w0 + c6*w1 + c7*w2 + c8*w3);
+            } // iA
+        } // is periodic
+        // === periodic boundary conditions ========================================================
+        // =========================================================================================
+
+#undef  PHASED
+#undef  INDICES_Im
 #undef  INDICES
         }} // thread and block loops
 
@@ -346,10 +414,10 @@ namespace green_kinetic {
 
 
 
-    template <typename real_t, int R1C2=2, int Noco=1>
-    int Laplace_driver(
-          real_t        (*const __restrict__ Tpsi)[R1C2][Noco*64][Noco*64] // intent(inout)
-        , real_t  const (*const __restrict__  psi)[R1C2][Noco*64][Noco*64] // intent(in)
+    template <typename real_t, int R1C2=2, int Noco=1, typename storage_t=real_t>
+    int Laplace_driver( // psi and Tpsi are stored in storage_t, the stencil is applied in real_t
+          storage_t       (*const __restrict__ Tpsi)[R1C2][Noco*64][Noco*64] // intent(inout)
+        , storage_t const (*const __restrict__  psi)[R1C2][Noco*64][Noco*64] // intent(in)
         , int32_t const (*const *const __restrict__ index_list) // index list that brings the blocks in order,
                                             // list must contain at least one element and is finalized with -1
         , double const prefactor
@@ -357,23 +425,65 @@ namespace green_kinetic {
         , int const Stride // Stride is determined by the lattice dimension along which we derive: 1, 4 or 4^2
         , double const phase[2][2]=nullptr
         , int const FD_range=4 // 4 or 8 are implemented
+        , cudaStream_t const stream=0 // CUDA stream to run on
     ) {
         if (num < 1 || FD_range < 1) return 0;
         assert(1 == Stride || 4 == Stride || 16 == Stride);
-        auto const kernel_ptr = (8 == FD_range) ? Laplace16th<real_t,R1C2,Noco> : Laplace8th<real_t,R1C2,Noco>;
-        if (8 == FD_range) phase = nullptr; //    Laplace16th cannot handle Bloch phases
+        auto const kernel_ptr = (8 == FD_range) ? Laplace16th<real_t,R1C2,Noco,storage_t> : Laplace8th<real_t,R1C2,Noco,storage_t>;
         dim3 const gridDim(num, 16, 1), blockDim(Noco*64, Noco, R1C2);
         kernel_ptr // GPU kernel, must be launched with <<< {16, Nrows, 1}, {Noco*64, Noco, R1C2} >>>
 #ifdef    HAS_NO_CUDA
                   (    gridDim, blockDim,
 #else  // HAS_NO_CUDA
-                   <<< gridDim, blockDim >>> (
+                   <<< gridDim, blockDim, 0, stream >>> (
 #endif // HAS_NO_CUDA
                    Tpsi, psi, index_list, prefactor, Stride, phase);
         return (8 == FD_range) ? 17 : 9; // returns the number of stencil coefficients
     } // Laplace_driver
 
 
+    template <typename real_t, int R1C2=2, int Noco=1, typename storage_t=real_t>
+    void __global__ add_blocks( // GPU kernel, must be launched with <<< {nnzb, Noco*64, 1}, {Noco*64, 1, R1C2} >>>
+#ifdef    HAS_NO_CUDA
+          dim3 const & gridDim, dim3 const & blockDim,
+#endif // HAS_NO_CUDA
+          storage_t       (*const __restrict__ Tpsi)[R1C2][Noco*64][Noco*64] // intent(inout)
+        , storage_t const (*const __restrict__ Tpsi_y)[R1C2][Noco*64][Noco*64] // intent(in)
+        , storage_t const (*const __restrict__ Tpsi_z)[R1C2][Noco*64][Noco*64] // intent(in)
+    ) {
+        // reduce the private buffers of the y- and z-direction into the result
+        assert(Noco*64 == gridDim.y);
+        assert(Noco*64 == blockDim.x);
+        assert(R1C2    == blockDim.z);
+
+#ifdef    HAS_NO_CUDA
+#ifndef   HAS_NO_OMP
+        #pragma omp parallel for schedule(static)
+#endif // HAS_NO_OMP
+        for (int block_x = 0; block_x < gridDim.x; ++block_x)
+        for (int block_y = 0; block_y < gridDim.y; ++block_y)
+#endif // HAS_NO_CUDA
+        { // block loops
+#ifdef    HAS_NO_CUDA
+        dim3 const blockIdx(block_x, block_y, 0);
+#endif // HAS_NO_CUDA
+
+#ifdef    HAS_NO_CUDA
+        dim3 threadIdx(0,0,0);
+        for (threadIdx.z = 0; threadIdx.z < blockDim.z; ++threadIdx.z)
+        for (threadIdx.x = 0; threadIdx.x < blockDim.x; ++threadIdx.x)
+#endif // HAS_NO_CUDA
+        { // thread loops
+
+            auto const inzb = blockIdx.x, row = blockIdx.y, reim = threadIdx.z, col = threadIdx.x;
+            green_precision::add_to(Tpsi[inzb][reim][row][col], green_precision::load<real_t>(Tpsi_y[inzb][reim][row][col])
+                                                              + green_precision::load<real_t>(Tpsi_z[inzb][reim][row][col]));
+
+        }} // thread and block loops
+
+    } // add_blocks
+
+
     void __host__ set_phase(
           double phase[3][2][2]
         , double const phase_angles[3]=nullptr
@@ -496,15 +606,16 @@ namespace green_kinetic {
 
     public:
 
-        template <typename real_t, int R1C2=2, int Noco=1>
+        template <typename real_t, int R1C2=2, int Noco=1, typename storage_t=real_t>
         size_t multiply(
-              real_t         (*const __restrict__ Tpsi)[R1C2][Noco*64][Noco*64] // result
-            , real_t   const (*const __restrict__  psi)[R1C2][Noco*64][Noco*64] // input
+              storage_t       (*const __restrict__ Tpsi)[R1C2][Noco*64][Noco*64] // result
+            , storage_t const (*const __restrict__  psi)[R1C2][Noco*64][Noco*64] // input
             , double   const phase[2][2]=nullptr // complex Bloch phase factors
             , int      const echo=0
+            , cudaStream_t const stream=0 // CUDA stream to run on
         ) const { // members of the kinetic_plan_t are not changed
             int  const stride = 1 << (2*derivative_direction); // 4^dd: X:1, Y:4, Z:16
-            auto const nFD = Laplace_driver<real_t,R1C2,Noco>(Tpsi, psi, lists, prefactor, sparse.nRows(), stride, phase, FD_range);
+            auto const nFD = Laplace_driver<real_t,R1C2,Noco,storage_t>(Tpsi, psi, lists, prefactor, sparse.nRows(), stride, phase, FD_range, stream);
             size_t const nops = nnzb*nFD*R1C2*pow2(Noco*64ul)*2ul;
             if (echo > 7) {
                 char const fF = (8 == sizeof(real_t)) ? 'F' : 'f'; // Mflop:float, MFlop:double
@@ -517,6 +628,48 @@ namespace green_kinetic {
     }; // class kinetic_plan_t
 
 
+    template <typename real_t, int R1C2=2, int Noco=1, typename storage_t=real_t>
+    size_t multiply_concurrent( // returns the number of floating point operations performed
+          storage_t       (*const __restrict__ Tpsi)[R1C2][Noco*64][Noco*64] // result, the x-direction accumulates here
+        , storage_t       (*const __restrict__ Tpsi_yz)[R1C2][Noco*64][Noco*64] // private buffers [2*nnzb] for the y- and z-direction
+        , storage_t const (*const __restrict__  psi)[R1C2][Noco*64][Noco*64] // input
+        , kinetic_plan_t const kinetic[3] // plans for the x-, y- and z-direction
+        , double   const (*const phase)[2][2]=nullptr // [3] complex Bloch phase factors
+        , cudaStream_t const stream[3]=nullptr // three CUDA streams, nullptr: all in the default stream
+        , int      const echo=0
+    ) {
+        // The rows of index_list are conflict-free within one direction since each block appears in exactly one list.
+        // Across directions, all three passes would accumulate into the same blocks, so the y- and z-direction
+        // accumulate into private buffers instead, the three passes may run concurrently and
+        // the buffers are added to the result afterwards.
+        size_t const nnzb = kinetic[0].nnzb;
+        assert(nnzb == kinetic[1].nnzb && nnzb == kinetic[2].nnzb);
+        auto const Tpsi_y = Tpsi_yz, Tpsi_z = Tpsi_yz + nnzb;
+        cudaStream_t const s[3] = {stream ? stream[0] : 0, stream ? stream[1] : 0, stream ? stream[2] : 0};
+#ifndef   HAS_NO_CUDA
+        cuCheck( cudaMemsetAsync(Tpsi_y, 0, nnzb*sizeof(*Tpsi_y), s[1]) );
+        cuCheck( cudaMemsetAsync(Tpsi_z, 0, nnzb*sizeof(*Tpsi_z), s[2]) );
+#else  // HAS_NO_CUDA
+        set(Tpsi_yz[0][0][0], 2*nnzb*R1C2*pow2(Noco*64ul), storage_t{}); // clear
+#endif // HAS_NO_CUDA
+        size_t nops{0};
+        nops += kinetic[0].multiply<real_t,R1C2,Noco,storage_t>(Tpsi,   psi, phase ? phase[0] : nullptr, echo, s[0]);
+        nops += kinetic[1].multiply<real_t,R1C2,Noco,storage_t>(Tpsi_y, psi, phase ? phase[1] : nullptr, echo, s[1]);
+        nops += kinetic[2].multiply<real_t,R1C2,Noco,storage_t>(Tpsi_z, psi, phase ? phase[2] : nullptr, echo, s[2]);
+        cudaDeviceSynchronize(); // all three passes must be complete before the reduction
+        if (nnzb < 1) return nops;
+        dim3 const gridDim(nnzb, Noco*64, 1), blockDim(Noco*64, 1, R1C2);
+        add_blocks<real_t,R1C2,Noco,storage_t> // GPU kernel, must be launched with <<< {nnzb, Noco*64, 1}, {Noco*64, 1, R1C2} >>>
+#ifdef    HAS_NO_CUDA
+                  (    gridDim, blockDim,
+#else  // HAS_NO_CUDA
+                   <<< gridDim, blockDim, 0, s[0] >>> (
+#endif // HAS_NO_CUDA
+                   Tpsi, Tpsi_y, Tpsi_z);
+        return nops + nnzb*R1C2*pow2(Noco*64ul)*2ul; // 2 additions per element
+    } // multiply_concurrent
+
+
     status_t all_tests(int const echo=0); // declaration only
 
 
@@ -1,6 +1,22 @@
 #pragma once
 // This file is part of AngstromCube under MIT License
 
+#include <cstdio> // std::printf
+#include <cstdlib> // std::free, ::strtod, posix_memalign
+#include <cstring> // std::memset, ::strchr, ::strcspn, ::strlen, ::strncmp
+#include <cstdint> // int8_t, uint64_t
+#include <string> // std::string
+#include <map> // std::map<K,V>
+#include <algorithm> // std::max, ::min
+#include <type_traits> // std::is_trivial<T>
+#include <new> // std::bad_alloc
+
+#ifdef    __linux__
+  #include <unistd.h> // syscall, sysconf, _SC_PAGESIZE
+  #include <sys/syscall.h> // SYS_mbind
+  #include <sys/mman.h> // madvise, MADV_HUGEPAGE
+#endif // __linux__
+
 #ifndef   HAS_NO_CUDA
 
   #include <cuda.h> // dim3, cudaStream_t, __syncthreads, cuda*
@@ -36,6 +52,7 @@
     typedef int cudaError_t;
     inline cudaError_t cudaDeviceSynchronize(void) { return 0; } // dummy
     inline cudaError_t cudaPeekAtLastError(void) { return 0; } // dummy
+    typedef size_t cudaStream_t; // dummy, all kernels run in order
 #else  // HAS_TFQMRGPU
     #define gpuStream_t cudaStream_t
     #include "tfQMRgpu/include/tfqmrgpu_cudaStubs.hxx" // cuda... (dummies)
@@ -47,6 +64,160 @@
 
 // #define DEBUG
 
+  //
+  // Allocation policies, configurable per allocation name
+  //
+  //    alignment     in Byte, e.g. 64 for cache lines or 2M for transparent huge pages (CPU only)
+  //    first_touch   zero the memory with the same static OpenMP schedule as the compute loops,
+  //                  so the pages land on the NUMA domain of the thread that works on them (CPU only)
+  //    numa          1: local, 2: interleave over all online nodes (Linux only, needs page alignment)
+  //    advise        1: read mostly, 2: prefer the device, 3: prefer the host (GPU only)
+  //    prefetch      migrate the pages to the device right after allocation (GPU only)
+  //
+  // A policy is given as a comma-separated list of options, e.g. "align=2M,touch,interleave".
+  // set_memory_policies takes a list "name:options;name:options" where the name "*" sets
+  // the default for all allocations without a policy of their own.
+  //
+  struct memory_policy_t {
+      size_t alignment;
+      bool   first_touch;
+      int8_t numa;
+      int8_t advise;
+      bool   prefetch;
+  }; // memory_policy_t
+
+  inline memory_policy_t default_memory_policy() { memory_policy_t const p = {0, false, 0, 0, false}; return p; }
+
+  inline std::map<std::string,memory_policy_t> & memory_policies() {
+      static std::map<std::string,memory_policy_t> policies; // one registry per program
+      return policies;
+  } // memory_policies
+
+  inline void set_memory_policy(char const *const name, memory_policy_t const & policy) {
+      memory_policies()[std::string(name ? name : "*")] = policy;
+  } // set_memory_policy
+
+  inline memory_policy_t memory_policy(char const *const name) {
+      auto const & policies = memory_policies();
+      if (policies.empty()) return default_memory_policy();
+      auto const it = policies.find(std::string(name ? name : ""));
+      if (policies.end() != it) return it->second;
+      auto const all = policies.find("*");
+      return (policies.end() != all) ? all->second : default_memory_policy();
+  } // memory_policy
+
+  inline int parse_memory_policy(memory_policy_t & policy, char const *options) {
+      // parse options until ';' or the end of the string, returns the number of unknown options
+      policy = default_memory_policy();
+      int nerrors{0};
+      while (options && *options && ';' != *options) {
+          auto const o = options;
+          auto const n = std::strcspn(o, ",;");
+          auto const is = [o, n](char const *const option) { return std::strlen(option) == n && 0 == std::strncmp(o, option, n); };
+          if (n < 1) {
+              // skip empty option
+          } else
+          if (0 == std::strncmp(o, "align=", 6)) {
+              char *unit{nullptr};
+              double const a = std::strtod(o + 6, &unit);
+              double const factor = ('k' == *unit) ? 1024. : (('M' == *unit) ? 1048576. : 1.);
+              policy.alignment = size_t(a*factor);
+          } else
+          if (is("touch"))      { policy.first_touch = true; } else
+          if (is("local"))      { policy.numa = 1; } else
+          if (is("interleave")) { policy.numa = 2; } else
+          if (is("readmostly")) { policy.advise = 1; } else
+          if (is("device"))     { policy.advise = 2; } else
+          if (is("host"))       { policy.advise = 3; } else
+          if (is("prefetch"))   { policy.prefetch = true; } else
+          {
+              std::printf("# memory policy: unknown option \"%.*s\"\n", int(n), o);
+              ++nerrors;
+          } // options
+          options = o + n;
+          if (',' == *options) ++options;
+      } // while
+      return nerrors;
+  } // parse_memory_policy
+
+  inline int set_memory_policies(char const *spec, int const echo=0) {
+      // spec = "name:options;name:options", returns the number of errors
+      int nerrors{0};
+      while (spec && *spec) {
+          auto const colon = std::strchr(spec, ':');
+          if (nullptr == colon) { std::printf("# memory policy: missing ':' in \"%s\"\n", spec); return nerrors + 1; }
+          std::string const name(spec, colon - spec);
+          memory_policy_t policy;
+          nerrors += parse_memory_policy(policy, colon + 1);
+          set_memory_policy(name.c_str(), policy);
+          if (echo > 3) std::printf("# memory policy for \"%s\": alignment %ld Byte, %sfirst touch, numa=%d, advise=%d, %sprefetch\n",
+              name.c_str(), policy.alignment, policy.first_touch?"":"no ", policy.numa, policy.advise, policy.prefetch?"":"no ");
+          spec = std::strchr(colon, ';');
+          if (spec) ++spec;
+      } // while
+      return nerrors;
+  } // set_memory_policies
+
+#ifdef    __linux__
+  inline uint64_t online_numa_nodes() {
+      // bit mask of the online NUMA nodes from a list like "0-3,5", only the first 64 nodes
+      uint64_t mask{0};
+      auto *const f = std::fopen("/sys/devices/system/node/online", "r");
+      if (nullptr != f) {
+          int first, last;
+          while (1 == std::fscanf(f, "%d", &first)) {
+              last = first;
+              if (1 != std::fscanf(f, "-%d", &last)) last = first;
+              for (int node = first; node <= last && node < 64; ++node) mask |= uint64_t(1) << node;
+              if (',' != std::fgetc(f)) break;
+          } // while
+          std::fclose(f);
+      } // f
+      return mask ? mask : 1;
+  } // online_numa_nodes
+#endif // __linux__
+
+  inline void* _place_memory(size_t const bytes, size_t const min_alignment, memory_policy_t const & policy) {
+      // aligned host memory with NUMA placement and first touch according to the policy
+      size_t alignment = sizeof(void*);
+      while (alignment < std::max(min_alignment, policy.alignment)) alignment *= 2; // posix_memalign needs a power of 2
+#ifdef    __linux__
+      size_t const page = sysconf(_SC_PAGESIZE);
+      if (policy.numa && alignment < page) alignment = page; // mbind works on entire pages
+#endif // __linux__
+      size_t const nbytes = (alignment >= 4096) ? ((std::max(bytes, size_t(1)) - 1)/alignment + 1)*alignment : bytes; // own all pages
+      void* ptr{nullptr};
+      if (0 != posix_memalign(&ptr, alignment, std::max(nbytes, size_t(1)))) {
+          std::printf("# failed to allocate %.6f MByte with %ld Byte alignment\n", nbytes*1e-6, alignment);
+          throw std::bad_alloc(); // fail loudly like new T[size]
+      } // posix_memalign failed
+#ifdef    __linux__
+      if (alignment >= (size_t(2) << 20)) madvise(ptr, nbytes, MADV_HUGEPAGE); // hint only
+      if (policy.numa) {
+          int const MPOL_LOCAL_ = 4, MPOL_INTERLEAVE_ = 3; // from linux/mempolicy.h
+          uint64_t const nodes = online_numa_nodes();
+          long const stat = (2 == policy.numa) ? syscall(SYS_mbind, ptr, nbytes, MPOL_INTERLEAVE_, &nodes, 64, 0)
+                                               : syscall(SYS_mbind, ptr, nbytes, MPOL_LOCAL_, nullptr, 0, 0);
+#ifdef    DEBUGGPU
+          if (0 != stat) std::printf("# mbind failed for %.3f kByte at %p\n", nbytes*1e-3, ptr);
+#endif // DEBUGGPU
+          (void)stat; // placement is a hint, the memory is usable anyway
+      } // numa
+#endif // __linux__
+      if (policy.first_touch) {
+          size_t constexpr chunk = 4096;
+          auto const bytes_ptr = (char*)ptr;
+          long const nchunks = (nbytes + chunk - 1)/chunk;
+#ifndef   HAS_NO_OMP
+          #pragma omp parallel for schedule(static)
+#endif // HAS_NO_OMP
+          for (long ichunk = 0; ichunk < nchunks; ++ichunk) {
+              std::memset(bytes_ptr + ichunk*chunk, 0, std::min(chunk, nbytes - ichunk*chunk));
+          } // ichunk
+      } // first_touch
+      return ptr;
+  } // _place_memory
+
   template <typename T>
   T* get_memory(size_t const size=1, int const echo=0, char const *const name="") {
 
@@ -60,11 +231,25 @@
       } // echo
 #endif // DEBUG
 
+      auto const policy = memory_policy(name);
       T* ptr{nullptr};
 #ifndef HAS_NO_CUDA
       cuCheck(cudaMallocManaged(&ptr, size*sizeof(T)));
+      if (policy.advise || policy.prefetch) {
+          int device{0};
+          cuCheck(cudaGetDevice(&device));
+          if (1 == policy.advise) cuCheck(cudaMemAdvise(ptr, size*sizeof(T), cudaMemAdviseSetReadMostly, device));
+          if (2 == policy.advise) cuCheck(cudaMemAdvise(ptr, size*sizeof(T), cudaMemAdviseSetPreferredLocation, device));
+          if (3 == policy.advise) cuCheck(cudaMemAdvise(ptr, size*sizeof(T), cudaMemAdviseSetPreferredLocation, cudaCpuDeviceId));
+          if (policy.prefetch)    cuCheck(cudaMemPrefetchAsync(ptr, size*sizeof(T), device, 0));
+      } // hints
 #else  // HAS_NO_CUDA
-      ptr = new T[size];
+      if (std::is_trivial<T>::value) {
+          // plain data is allocated with alignment and placement, see _free_memory
+          ptr = (T*)_place_memory(size*sizeof(T), alignof(T), policy);
+      } else {
+          ptr = new T[size];
+      } // trivial
 #endif // HAS_NO_CUDA
 
 #ifdef    DEBUGGPU
@@ -86,7 +271,11 @@
 #ifndef HAS_NO_CUDA
           cuCheck(cudaFree((void*)ptr));
 #else  // HAS_NO_CUDA
-          delete[] ptr;
+          if (std::is_trivial<T>::value) {
+              std::free((void*)ptr);
+          } else {
+              delete[] ptr;
+          } // trivial
 #endif // HAS_NO_CUDA
       } // d
       ptr = nullptr;
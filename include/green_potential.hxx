@@ -5,6 +5,8 @@
 #include <cstdint> // int64_t, int32_t, uint32_t, int8_t
 #include <cassert> // assert
 #include <complex> // std::complex
+#include <cmath> // std::abs, std::ldexp
+#include <algorithm> // std::max, std::min
 
 #include "status.hxx" // status_t, STATUS_TEST_NOT_INCLUDED
 #include "green_memory.hxx" // dim3, get_memory, free_memory
@@ -13,16 +15,17 @@
 #include "global_coordinates.hxx" // ::get
 #include "recorded_warnings.hxx" // error
 #include "print_tools.hxx" // printf_vector
+#include "green_precision.hxx" // ::load, ::store
 
 namespace green_potential {
 
-    template <typename real_t, int R1C2=2, int Noco=1>
+    template <typename real_t, int R1C2=2, int Noco=1, typename storage_t=real_t>
     void __global__ Potential( // GPU kernel, must be launched with <<< {64, any, 1}, {Noco*64, Noco, R1C2} >>>
 #ifdef    HAS_NO_CUDA
           dim3 const & gridDim, dim3 const & blockDim,
 #endif // HAS_NO_CUDA
-          real_t        (*const __restrict__ Vpsi)[R1C2][Noco*64][Noco*64] // result
-        , real_t  const (*const __restrict__  psi)[R1C2][Noco*64][Noco*64] // input Green function
+          storage_t       (*const __restrict__ Vpsi)[R1C2][Noco*64][Noco*64] // result
+        , storage_t const (*const __restrict__  psi)[R1C2][Noco*64][Noco*64] // input Green function, converted to real_t when loaded
         , double  const (*const *const __restrict__ Vloc)[64] // local potential, Vloc[Noco*Noco][iloc][4*4*4]
         , int32_t const (*const __restrict__ iloc_of_inzb) // translation from inzb to iloc, [inzb]
         , int16_t const (*const __restrict__ shift)[3+1] // 3D block shift vector (target minus source), 4th component unused, [inzb][0:2]
@@ -95,14 +98,14 @@ namespace green_potential {
             // gather all real-valued and spin-diagonal contributions
             real_t const Vtot = Vloc_diag + Vconfine - E_real; // diagonal part of the potential
 
-            auto vpsi = Vtot * psi[inzb][reim][spin*64 + i64][j64]; // non-const, potential is diagonal in real-space
+            auto vpsi = Vtot * green_precision::load<real_t>(psi[inzb][reim][spin*64 + i64][j64]); // non-const, potential is diagonal in real-space
 
             if (imaginary) {
                 // V-E has an imaginary part V_Im = -E_imag
                 // then explicitly:
                 //    Vpsi_Re = V_Re * psi_Re - V_Im * psi_Im = V_Re * psi_Re + E_imag * psi_Im (reim=0)
                 //    Vpsi_Im = V_Re * psi_Im + V_im * psi_Re = V_Re * psi_Im - E_imag * psi_Re (reim=0)
-                vpsi += V_imag * psi[inzb][1 - reim][spin*64 + i64][j64];
+                vpsi += V_imag * green_precision::load<real_t>(psi[inzb][1 - reim][spin*64 + i64][j64]);
             } // imaginary
 
             if (2 == Noco && iloc >= 0) { // the other spin component is (1 - spin)
@@ -128,11 +131,11 @@ namespace green_potential {
                 /*                                                                   */
                 real_t const cs = (1 - 2*(reim ^ spin)); // complex sign is -1 if (reim != spin)
 
-                vpsi += Vloc[2][iloc][i64] * psi[inzb][    reim][(1 - spin)*64 + i64][j64];    // V_x
-                vpsi += Vloc[3][iloc][i64] * psi[inzb][1 - reim][(1 - spin)*64 + i64][j64]*cs; // V_y
+                vpsi += Vloc[2][iloc][i64] * green_precision::load<real_t>(psi[inzb][    reim][(1 - spin)*64 + i64][j64]);    // V_x
+                vpsi += Vloc[3][iloc][i64] * green_precision::load<real_t>(psi[inzb][1 - reim][(1 - spin)*64 + i64][j64])*cs; // V_y
             } // non-collinear
 
-            Vpsi[inzb][reim][spin*64 + i64][j64] = vpsi; // store
+            green_precision::store(Vpsi[inzb][reim][spin*64 + i64][j64], vpsi); // round to storage_t
 
         } // inzb
 
@@ -141,10 +144,10 @@ namespace green_potential {
     } // Potential
 
 
-    template <typename real_t, int R1C2=2, int Noco=1>
+    template <typename real_t, int R1C2=2, int Noco=1, typename storage_t=real_t>
     size_t multiply(
-          real_t         (*const __restrict__ Vpsi)[R1C2][Noco*64][Noco*64] // result
-        , real_t   const (*const __restrict__  psi)[R1C2][Noco*64][Noco*64] // input
+          storage_t       (*const __restrict__ Vpsi)[R1C2][Noco*64][Noco*64] // result
+        , storage_t const (*const __restrict__  psi)[R1C2][Noco*64][Noco*64] // input
         , double   const (*const *const __restrict__ Vloc)[64] // local potential, Vloc[Noco*Noco][iloc][4*4*4]
         , int32_t  const (*const __restrict__ vloc_index) // iloc_of_inzb[nnzb]
         , int16_t  const (*const __restrict__ shift)[3+1] // 3D block shift vector (target minus source), 4th component unused
@@ -157,12 +160,12 @@ namespace green_potential {
     ) {
 
         if (echo > 11) {
-            std::printf("# %s<%s,R1C2=%d,Noco=%d> Vpsi=%p, psi=%p, Vloc=%p, vloc_index=%p, shift=%p, hxyz=%p, nnzb=%d, Vconf=%g, rcut2=%.f, E=(%g, %g)\n",
-                           __func__, (4 == sizeof(real_t))?"float":"double", R1C2, Noco, (void*)Vpsi, (void*)psi,
+            std::printf("# %s<%s,R1C2=%d,Noco=%d,%s> Vpsi=%p, psi=%p, Vloc=%p, vloc_index=%p, shift=%p, hxyz=%p, nnzb=%d, Vconf=%g, rcut2=%.f, E=(%g, %g)\n",
+                           __func__, (4 == sizeof(real_t))?"float":"double", R1C2, Noco, green_precision::storage_name<storage_t>(), (void*)Vpsi, (void*)psi,
                            (void*)Vloc, (void*)vloc_index, (void*)shift, (void*)hxyz, nnzb, Vconf, rcut2, E_param.real(), E_param.imag());
         } // echo
 
-        Potential<real_t,R1C2,Noco>
+        Potential<real_t,R1C2,Noco,storage_t>
 #ifndef   HAS_NO_CUDA
             <<< dim3(64, 7, 1), dim3(Noco*64, Noco, R1C2) >>> ( // 7=any, maybe find a function for a good choice
 #else  // HAS_NO_CUDA
@@ -230,9 +233,68 @@ namespace green_potential {
       return stat;
   } // test_multiply
 
+  template <typename real_t, int R1C2=2, int Noco=1, typename storage_t=real_t>
+  inline status_t test_storage(int const echo=0, uint32_t const nnzb=3) {
+      // compare the potential action on blocks stored in storage_t to the action in double precision
+      int constexpr LM = Noco*64;
+      size_t const n_all = nnzb*size_t(R1C2*LM*LM);
+      auto psi    = get_memory<double[R1C2][LM][LM]>(nnzb, echo, "psi");
+      auto Vpsi   = get_memory<double[R1C2][LM][LM]>(nnzb, echo, "Vpsi");
+      auto psi_s  = get_memory<storage_t[R1C2][LM][LM]>(nnzb, echo, "psi_s");
+      auto Vpsi_s = get_memory<storage_t[R1C2][LM][LM]>(nnzb, echo, "Vpsi_s");
+      double *const psi_all = psi[0][0][0], *const Vpsi_all = Vpsi[0][0][0]; // flat views
+      storage_t *const psi_s_all = psi_s[0][0][0], *const Vpsi_s_all = Vpsi_s[0][0][0];
+      for (size_t i = 0; i < n_all; ++i) {
+          psi_all[i] = ((i*2654435761u) % 1000)*1e-3 - 0.5; // pseudo-random
+          green_precision::store(psi_s_all[i], psi_all[i]);
+      } // i
+      auto Vloc = get_memory<double(*)[64]>(Noco*Noco, echo, "Vloc");
+      for (int mag = 0; mag < Noco*Noco; ++mag) {
+          Vloc[mag] = get_memory<double[64]>(nnzb, echo, "Vloc[mag]");
+          for (int i = 0; i < int(nnzb)*64; ++i) Vloc[mag][0][i] = ((i*40503u + mag) % 100)*0.02 - 1.; // in [-1, 1)
+      } // mag
+      auto vloc_index = get_memory<int32_t>(nnzb, echo, "vloc_index");
+      for (uint32_t inzb = 0; inzb < nnzb; ++inzb) vloc_index[inzb] = inzb;
+      auto shift = get_memory<int16_t[3+1]>(nnzb, echo, "shift");  set(shift[0], nnzb*4, int16_t(0));
+      auto hxyz = get_memory<double>(3+1, echo, "hxyz");             set(hxyz, 3+1, 1.);
+      std::complex<double> const E_param(0.25, (2 == R1C2) ? 0.125 : 0.);
+
+      multiply<double,R1C2,Noco>(Vpsi, psi, Vloc, vloc_index, shift, hxyz, nnzb, E_param);
+      multiply<real_t,R1C2,Noco,storage_t>(Vpsi_s, psi_s, Vloc, vloc_index, shift, hxyz, nnzb, E_param);
+      cudaDeviceSynchronize();
+      double dev{0}, mag{0};
+      for (size_t i = 0; i < n_all; ++i) {
+          dev = std::max(dev, std::abs(green_precision::load<double>(Vpsi_s_all[i]) - Vpsi_all[i]));
+          mag = std::max(mag, std::abs(Vpsi_all[i]));
+      } // i
+      auto const rel = dev/std::max(mag, 1e-300);
+      // psi and Vpsi are rounded once, up to 4 terms contribute to each element
+      int const bits = std::min(green_precision::significant_bits<storage_t>(), green_precision::significant_bits<real_t>());
+      auto const tolerance = std::ldexp(1., 3 - bits);
+      if (echo > 3) std::printf("# %s<%s,R1C2=%d,Noco=%d,%s> deviates from double by %.1e relative, tolerance %.1e\n",
+                        __func__, real_t_name<real_t>(), R1C2, Noco, green_precision::storage_name<storage_t>(), rel, tolerance);
+
+      free_memory(hxyz);
+      free_memory(shift);
+      free_memory(vloc_index);
+      for (int mag = 0; mag < Noco*Noco; ++mag) free_memory(Vloc[mag]);
+      free_memory(Vloc);
+      free_memory(Vpsi_s);
+      free_memory(psi_s);
+      free_memory(Vpsi);
+      free_memory(psi);
+      return (rel > tolerance);
+  } // test_storage
+
   inline status_t all_tests(int const echo=0) {
       status_t stat(0);
       stat += test_multiply(echo);
+      stat += test_storage<double,2,1,double>(echo); // reference against itself
+      stat += test_storage<double,2,1,float>(echo);
+      stat += test_storage<float ,1,1,green_precision::float16_t>(echo);
+      stat += test_storage<float ,2,1,green_precision::float16_t>(echo);
+      stat += test_storage<float ,2,2,green_precision::float16_t>(echo);
+      stat += test_storage<float ,2,1,green_precision::bfloat16_t>(echo);
       return stat;
   } // all_tests
 
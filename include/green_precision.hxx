@@ -0,0 +1,200 @@
+#pragma once
+// This file is part of AngstromCube under MIT License
+
+#include <cstdio> // std::printf
+#include <cstdint> // uint16_t, uint32_t
+#include <cstring> // std::memcpy
+#include <cmath> // std::abs, std::cos, std::ldexp, std::log2
+#include <algorithm> // std::max
+
+#include "status.hxx" // status_t, STATUS_TEST_NOT_INCLUDED
+#include "green_memory.hxx" // __host__, __device__, real_t_name
+#include "constants.hxx" // ::pi
+
+namespace green_precision {
+
+  // Storage types for Green function blocks with less than 32 bit per real number.
+  // The dominant memory is nnzb*R1C2*(64*Noco)^2*sizeof(storage_t), so 16 bit storage halves the memory
+  // of the float version and allows for twice the number of blocks, i.e. a 2^(1/3) times larger truncation radius.
+  // Arithmetic is not done in these types: the kernels convert to real_t when loading a block element
+  // with load<real_t>, compute as before and round the result with store or add_to.
+  // On the CPU the conversions are emulated with integer operations, rounding is to nearest, ties to even.
+  //
+  // Precision budget: the 8th order finite-difference stencil in green_kinetic::Laplace8th
+  // has c0/c4 = 2^10.64, i.e. the rounding error of the central term is as large as the outermost term
+  // if less than 11 significant bits are stored. So
+  //    float16_t  (11 significant bits, range [6e-8, 65504]) is at the limit and
+  //    bfloat16_t ( 8 significant bits, range of float) effectively reduces the kinetic energy to 6th order.
+
+  struct float16_t  { uint16_t bits; }; // IEEE 754 binary16: 1 sign, 5 exponent and 10 mantissa bits
+  struct bfloat16_t { uint16_t bits; }; // bfloat16: 1 sign, 8 exponent and 7 mantissa bits, the upper half of a float
+
+  template <typename storage_t> char const * storage_name() { return real_t_name<storage_t>(); } // "float" or "double"
+  template <> inline char const * storage_name<float16_t>()  { return "half"; }
+  template <> inline char const * storage_name<bfloat16_t>() { return "bfloat16"; }
+
+  template <typename storage_t> int significant_bits() { return 24; } // float
+  template <> inline int significant_bits<double>()     { return 53; }
+  template <> inline int significant_bits<float16_t>()  { return 11; }
+  template <> inline int significant_bits<bfloat16_t>() { return  8; }
+
+  inline uint32_t __host__ __device__ float_bits(float const f) { uint32_t u; std::memcpy(&u, &f, 4); return u; }
+  inline float __host__ __device__ bits_float(uint32_t const u) { float f; std::memcpy(&f, &u, 4); return f; }
+
+  inline bfloat16_t __host__ __device__ to_bfloat16(float const f) {
+      uint32_t const u = float_bits(f);
+      if ((u & 0x7fffffff) > 0x7f800000) return bfloat16_t{uint16_t((u >> 16) | 0x40)}; // quiet NaN
+      uint32_t const rounded = u + 0x7fff + ((u >> 16) & 1); // round to nearest, ties to even
+      return bfloat16_t{uint16_t(rounded >> 16)};
+  } // to_bfloat16
+
+  inline float __host__ __device__ to_float(bfloat16_t const b) { return bits_float(uint32_t(b.bits) << 16); }
+
+  inline float16_t __host__ __device__ to_float16(float const f) {
+      uint32_t const u = float_bits(f);
+      uint16_t const sign = (u >> 16) & 0x8000;
+      uint32_t const absu = u & 0x7fffffff;
+      if (absu >= 0x7f800000) return float16_t{uint16_t(sign | 0x7c00 | ((absu > 0x7f800000) ? 0x200 : 0))}; // Inf or NaN
+      if (absu >= 0x477ff000) return float16_t{uint16_t(sign | 0x7c00)}; // |f| >= 65520 overflows
+      if (absu < 0x33000000) return float16_t{sign}; // |f| <= 2^-25 underflows
+      uint32_t mantissa, shift;
+      if (absu < 0x38800000) { // below 2^-14: subnormal in half precision, units of 2^-24
+          mantissa = (absu & 0x7fffff) | 0x800000; // with the implicit leading bit
+          shift = 126 - (absu >> 23); // in [14, 24]
+      } else {
+          mantissa = absu - 0x38000000; // rebias the exponent from 127 to 15
+          shift = 13;
+      } // subnormal
+      uint32_t const half = 1u << (shift - 1), rest = mantissa & ((1u << shift) - 1);
+      uint32_t h = mantissa >> shift;
+      if (rest > half || (rest == half && (h & 1))) ++h; // round to nearest, ties to even, may carry into the exponent
+      return float16_t{uint16_t(sign | h)};
+  } // to_float16
+
+  inline float __host__ __device__ to_float(float16_t const h) {
+      uint32_t const sign = uint32_t(h.bits & 0x8000) << 16;
+      uint32_t const exponent = (h.bits >> 10) & 0x1f, mantissa = h.bits & 0x3ff;
+      if (0 == exponent) { // zero or subnormal
+          float const f = mantissa*5.9604644775390625e-8f; // 2^-24
+          return sign ? -f : f;
+      } // subnormal
+      if (31 == exponent) return bits_float(sign | 0x7f800000 | (mantissa << 13)); // Inf or NaN
+      return bits_float(sign | ((exponent + 112) << 23) | (mantissa << 13));
+  } // to_float
+
+  // element access for the kernels: convert to the compute type real_t at load and round at store
+  template <typename real_t> inline real_t __host__ __device__ load(float      const s) { return s; }
+  template <typename real_t> inline real_t __host__ __device__ load(double     const s) { return s; }
+  template <typename real_t> inline real_t __host__ __device__ load(float16_t  const s) { return to_float(s); }
+  template <typename real_t> inline real_t __host__ __device__ load(bfloat16_t const s) { return to_float(s); }
+
+  template <typename real_t> inline void __host__ __device__ store(float      & s, real_t const r) { s = r; }
+  template <typename real_t> inline void __host__ __device__ store(double     & s, real_t const r) { s = r; }
+  template <typename real_t> inline void __host__ __device__ store(float16_t  & s, real_t const r) { s = to_float16(float(r)); }
+  template <typename real_t> inline void __host__ __device__ store(bfloat16_t & s, real_t const r) { s = to_bfloat16(float(r)); }
+
+  template <typename storage_t, typename real_t>
+  inline void __host__ __device__ add_to(storage_t & s, real_t const r) { store(s, load<real_t>(s) + r); } // s += r
+
+  template <typename storage_t>
+  float round_to(float const f) { storage_t s; store(s, f); return load<float>(s); }
+
+#ifdef    NO_UNIT_TESTS
+  inline status_t all_tests(int const echo=0) { return STATUS_TEST_NOT_INCLUDED; }
+#else  // NO_UNIT_TESTS
+
+  inline status_t test_conversion(int const echo=0) {
+      status_t stat(0);
+      float const exact[] = {0.f, 1.f, -2.f, .5f, 3.f, 1024.f, 65504.f, -6.103515625e-5f, 5.9604644775390625e-8f};
+      for (auto const f : exact) {
+          stat += (round_to<float16_t>(f) != f); // these values are representable in half precision
+          stat += (round_to<bfloat16_t>(f) != f) * (65504.f != f); // 65504 needs 11 significant bits
+      } // f
+      // ties to even
+      stat += (round_to<float16_t>(1.f + std::ldexp(1.f, -11)) != 1.f);
+      stat += (round_to<float16_t>(1.f + 3*std::ldexp(1.f, -11)) != 1.f + std::ldexp(1.f, -9));
+      stat += (round_to<bfloat16_t>(1.f + std::ldexp(1.f, -8)) != 1.f);
+      stat += (round_to<bfloat16_t>(1.f + 3*std::ldexp(1.f, -8)) != 1.f + std::ldexp(1.f, -6));
+      // subnormals, overflow and NaN
+      stat += (round_to<float16_t>(std::ldexp(1.f, -25)) != 0.f);
+      stat += (round_to<float16_t>(3*std::ldexp(1.f, -25)) != std::ldexp(1.f, -23));
+      stat += (round_to<float16_t>(65519.f) != 65504.f);
+      stat += (to_float16(65520.f).bits != 0x7c00);
+      stat += (round_to<bfloat16_t>(1e30f) > 1.01e30f);
+      float const nan = bits_float(0x7fc00000);
+      stat += (round_to<float16_t>(nan) == round_to<float16_t>(nan)); // NaN compares unequal to itself
+      stat += (round_to<bfloat16_t>(nan) == round_to<bfloat16_t>(nan));
+      // accumulation with add_to rounds once per addition
+      float16_t acc; store(acc, 1.f);
+      add_to(acc, std::ldexp(1.f, -12)); // below half a unit in the last place
+      stat += (load<float>(acc) != 1.f);
+      add_to(acc, 1.5f);
+      stat += (load<double>(acc) != 2.5);
+      // relative rounding error of normal numbers
+      double maxrel[2] = {0, 0};
+      for (int i = 1; i < (1 << 16); ++i) {
+          float const f = (i*0.618034f - int(i*0.618034f) + 1.f)*std::ldexp(1.f, (i % 20) - 10); // in [2^-10, 2^10]
+          maxrel[0] = std::max(maxrel[0], std::abs(round_to<float16_t>(f)  - f)/double(f));
+          maxrel[1] = std::max(maxrel[1], std::abs(round_to<bfloat16_t>(f) - f)/double(f));
+      } // i
+      if (echo > 3) std::printf("# %s largest relative rounding error is 2^%.3f for half and 2^%.3f for bfloat16\n",
+                                  __func__, std::log2(maxrel[0]), std::log2(maxrel[1]));
+      stat += (maxrel[0] > std::ldexp(1., -significant_bits<float16_t>()));
+      stat += (maxrel[1] > std::ldexp(1., -significant_bits<bfloat16_t>()));
+      if (echo > 2) std::printf("# %s status= %i\n", __func__, int(stat));
+      return stat;
+  } // test_conversion
+
+  template <typename storage_t>
+  double Laplace8th_deviation(double *const error_in_c4_units, int const echo=0) {
+      // apply the 8th order stencil of green_kinetic::Laplace8th in float to a smooth periodic function
+      // that is stored in storage_t and compare to the result for float storage
+      int constexpr n = 64;
+      float const norm = 1./5040., c[5] = {-14350*norm, 8064*norm, -1008*norm, 128*norm, -9*norm};
+      float f[n], fs[n];
+      for (int i = 0; i < n; ++i) {
+          f[i] = std::cos(2*constants::pi*i/n) + 0.5*std::cos(6*constants::pi*i/n + 1.);
+          fs[i] = round_to<storage_t>(f[i]);
+      } // i
+      double dev{0}, mag{0}, maxf{0};
+      for (int i = 0; i < n; ++i) {
+          float Lf{c[0]*f[i]}, Lfs{c[0]*fs[i]};
+          for (int d = 1; d <= 4; ++d) {
+              Lf  += c[d]*(f[(i + d) % n]  + f[(i - d + n) % n]);
+              Lfs += c[d]*(fs[(i + d) % n] + fs[(i - d + n) % n]);
+          } // d
+          dev = std::max(dev, std::abs(double(Lfs) - double(Lf)));
+          mag = std::max(mag, std::abs(double(Lf)));
+          maxf = std::max(maxf, std::abs(double(f[i])));
+      } // i
+      *error_in_c4_units = dev/(std::abs(c[4])*maxf); // > 1 means that the outermost stencil term is lost in the noise
+      if (echo > 3) std::printf("# Laplace8th with %s storage deviates by %.1e relative, %.2f in units of |c4*f|\n",
+                                  storage_name<storage_t>(), dev/mag, *error_in_c4_units);
+      return dev/mag;
+  } // Laplace8th_deviation
+
+  inline status_t test_Laplace8th_budget(int const echo=0) {
+      status_t stat(0);
+      double c4_units[3];
+      Laplace8th_deviation<float>(&c4_units[0], echo);
+      Laplace8th_deviation<float16_t>(&c4_units[1], echo);
+      Laplace8th_deviation<bfloat16_t>(&c4_units[2], echo);
+      stat += (0 != c4_units[0]); // same storage and same arithmetic
+      // sum of all |c_k|/|c4| is 32768/9, times the relative rounding error of half or bfloat16
+      stat += (c4_units[1] > 32768/9.*std::ldexp(1., -significant_bits<float16_t>()));
+      stat += (c4_units[2] > 32768/9.*std::ldexp(1., -significant_bits<bfloat16_t>()));
+      stat += (c4_units[1] >= c4_units[2]);
+      if (echo > 2) std::printf("# %s status= %i\n", __func__, int(stat));
+      return stat;
+  } // test_Laplace8th_budget
+
+  inline status_t all_tests(int const echo=0) {
+      status_t stat(0);
+      stat += test_conversion(echo);
+      stat += test_Laplace8th_budget(echo);
+      return stat;
+  } // all_tests
+
+#endif // NO_UNIT_TESTS
+
+} // namespace green_precision
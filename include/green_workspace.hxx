@@ -0,0 +1,189 @@
+#pragma once
+// This file is part of AngstromCube under MIT License
+
+#include <cstdio> // std::printf
+#include <cstdint> // int64_t
+#include <cassert> // assert
+#include <algorithm> // std::max
+#include <vector> // std::vector<T>
+
+#include "status.hxx" // status_t, STATUS_TEST_NOT_INCLUDED
+#include "green_memory.hxx" // get_memory, free_memory
+
+namespace green_workspace {
+
+  // An arena for temporary (managed) memory used inside the solver iterations.
+  // Requests are rounded up to size classes of powers of two and returned buffers are kept
+  // for reuse, so after reserve() has seen the sizes needed, take() and give() do not allocate.
+  // The statistics tell how much memory is held and how many allocations happened after all.
+
+  class workspace_t {
+  public:
+
+      static int constexpr min_log2 = 8; // the smallest size class holds 256 Byte
+      static int constexpr n_classes = 40;
+
+      static int size_class(size_t const bytes) {
+          int c{0};
+          while ((size_t(1) << (min_log2 + c)) < bytes) ++c;
+          assert(c < n_classes);
+          return c;
+      } // size_class
+
+      static size_t class_bytes(int const c) { return size_t(1) << (min_log2 + c); }
+
+      workspace_t() {}
+
+      ~workspace_t() { release(); }
+
+      workspace_t(workspace_t const &) = delete;
+      workspace_t & operator=(workspace_t const &) = delete;
+
+      void reserve(size_t const bytes[], int const n, int const echo=0) {
+          // make sure that n buffers of these sizes can be in use at the same time
+          int count[n_classes];
+          for (int c = 0; c < n_classes; ++c) count[c] = 0;
+          for (int i = 0; i < n; ++i) {
+              if (bytes[i] > 0) ++count[size_class(bytes[i])];
+          } // i
+          auto const reserved_before = bytes_reserved_;
+          for (int c = 0; c < n_classes; ++c) {
+              while (n_slabs_[c] < count[c]) {
+                  free_[c].push_back(allocate(c));
+              } // while
+          } // c
+          if (echo > 3 && bytes_reserved_ > reserved_before) std::printf("# workspace reserved %.6f MByte, %.6f MByte total\n",
+                                  (bytes_reserved_ - reserved_before)*1e-6, bytes_reserved_*1e-6);
+      } // reserve
+
+      template <typename T>
+      T* take(size_t const n, char const *const name="") {
+          // get a buffer for n elements of type T, allocates only if the size class has no free buffer
+          size_t const bytes = n*sizeof(T);
+          if (bytes < 1) return nullptr;
+          int const c = size_class(bytes);
+          ++takes_;
+          if (free_[c].empty()) {
+              ++allocations_;
+              free_[c].push_back(allocate(c));
+#ifdef    DEBUGGPU
+              std::printf("# workspace allocates %.3f kByte for %s\n", class_bytes(c)*1e-3, name);
+#endif // DEBUGGPU
+          } // no free buffer
+          auto const islab = free_[c].back();
+          free_[c].pop_back();
+          bytes_in_use_ += class_bytes(c);
+          high_water_mark_ = std::max(high_water_mark_, bytes_in_use_);
+          return reinterpret_cast<T*>(slabs_[islab].ptr);
+      } // take
+
+      template <typename T>
+      void give(T* & ptr) {
+          // return a buffer obtained from take
+          if (nullptr == ptr) return;
+          for (size_t islab = 0; islab < slabs_.size(); ++islab) {
+              if (reinterpret_cast<char*>(ptr) == reinterpret_cast<char*>(slabs_[islab].ptr)) {
+                  auto const c = slabs_[islab].size_class;
+                  free_[c].push_back(islab);
+                  bytes_in_use_ -= class_bytes(c);
+                  ptr = nullptr;
+                  return;
+              } // found
+          } // islab
+          std::printf("# workspace::give: pointer %p was not taken from this workspace\n", (void*)ptr);
+          assert(false && "pointer was not taken from this workspace");
+      } // give
+
+      void release() {
+          // free all buffers, none may be in use
+          assert(0 == bytes_in_use_);
+          for (auto & slab : slabs_) {
+              free_memory(slab.ptr);
+          } // slab
+          slabs_.clear();
+          for (int c = 0; c < n_classes; ++c) {
+              free_[c].clear();
+              n_slabs_[c] = 0;
+          } // c
+          bytes_reserved_ = 0;
+      } // release
+
+      void show(int const echo=1) const {
+          if (echo < 1) return;
+          std::printf("# workspace: %ld buffers, %.6f MByte reserved, high-water mark %.6f MByte, "
+                      "%lld takes, %lld allocations after reserve\n", slabs_.size(), bytes_reserved_*1e-6,
+                      high_water_mark_*1e-6, (long long)takes_, (long long)allocations_);
+      } // show
+
+      size_t bytes_reserved()  const { return bytes_reserved_; }
+      size_t bytes_in_use()    const { return bytes_in_use_; }
+      size_t high_water_mark() const { return high_water_mark_; }
+      int64_t takes()          const { return takes_; }
+      int64_t allocations()    const { return allocations_; } // number of take calls that had to allocate
+
+  private:
+
+      struct slab_t {
+          double* ptr; // double ensures 8 Byte alignment, cudaMallocManaged aligns to 256 Byte
+          int size_class;
+      }; // slab_t
+
+      size_t allocate(int const c) {
+          slab_t const slab = {get_memory<double>(class_bytes(c)/sizeof(double), 0, "workspace"), c};
+          slabs_.push_back(slab);
+          ++n_slabs_[c];
+          bytes_reserved_ += class_bytes(c);
+          return slabs_.size() - 1;
+      } // allocate
+
+      std::vector<slab_t> slabs_;
+      std::vector<size_t> free_[n_classes]; // indices into slabs_
+      int n_slabs_[n_classes] = {0};
+      size_t bytes_reserved_{0}, bytes_in_use_{0}, high_water_mark_{0};
+      int64_t takes_{0}, allocations_{0};
+
+  }; // class workspace_t
+
+
+#ifdef    NO_UNIT_TESTS
+  inline status_t all_tests(int const echo=0) { return STATUS_TEST_NOT_INCLUDED; }
+#else  // NO_UNIT_TESTS
+
+  inline status_t test_reuse(int const echo=0) {
+      status_t stat(0);
+      workspace_t w;
+      size_t const bytes[] = {1000, 1000, 5000}; // two buffers in the 1 kiByte class, one in the 8 kiByte class
+      w.reserve(bytes, 3, echo);
+      stat += (w.bytes_reserved() != 2*1024 + 8192);
+      double *first{nullptr};
+      for (int iteration = 0; iteration < 10; ++iteration) {
+          auto a = w.take<double>(125, "a"); // 1000 Byte
+          auto b = w.take<float>(250, "b"); // 1000 Byte
+          auto c = w.take<char>(5000, "c");
+          if (0 == iteration) first = a;
+          stat += (a != first); // the same buffer is reused
+          a[124] = 1; b[249] = 2; c[4999] = 3; // buffers are large enough
+          w.give(b);
+          w.give(a);
+          w.give(c);
+          stat += (nullptr != a);
+      } // iteration
+      stat += (0 != w.allocations()) + (30 != w.takes()) + (0 != w.bytes_in_use());
+      stat += (w.high_water_mark() != w.bytes_reserved());
+      auto d = w.take<double>(4096, "d"); // 32 kiByte have not been reserved
+      stat += (1 != w.allocations());
+      w.give(d);
+      if (echo > 3) w.show(echo);
+      if (echo > 0) std::printf("# %s status= %i\n", __func__, int(stat));
+      return stat;
+  } // test_reuse
+
+  inline status_t all_tests(int const echo=0) {
+      status_t stat(0);
+      stat += test_reuse(echo);
+      return stat;
+  } // all_tests
+
+#endif // NO_UNIT_TESTS
+
+} // namespace green_workspace
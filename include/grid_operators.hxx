@@ -17,11 +17,13 @@
 #include "recorded_warnings.hxx" // error, warn
 #include "complex_tools.hxx" // conjugate, to_complex_t
 #include "inline_math.hxx" // intpow
-#include "sho_projection.hxx" // ::sho_project, ::sho_add, ::sho_prefactor
+#include "sho_projection.hxx" // ::sho_project, ::sho_add, ::sho_project_images, ::sho_add_images, ::sho_prefactor
+#include "data_view.hxx" // view2D<T>
 #include "simple_stats.hxx" // ::Stats<>
 #include "chemical_symbol.hxx" // ::get
 #include "display_units.h" // Ang, _Ang
 #include "print_tools.hxx" // printf_vector
+#include "green_input.hxx" // ::write_binary_Hamiltonian
 
 #ifdef DEVEL
   #include "control.hxx" // ::get
@@ -101,14 +103,16 @@ namespace grid_operators {
 
               if (psi) {
                   if (a[ia].nimages() > 1) {
-                      for (int ii = 0; ii < a[ia].nimages(); ++ii) {
-                          std::vector<complex_t> image_coeff(ncoeff, 0.0); // can we omit the initialization?
-
-                          stat += sho_projection::sho_project(image_coeff.data(), numax, a[ia].pos(ii), sigma, psi, g, echo_sho);
-
-                          complex_t const Bloch_factor = Bloch_phase(boundary_phase, a[ia].idx(ii));
-                          add_product(atom_coeff[ia].data(), ncoeff, image_coeff.data(), Bloch_factor);
+                      int const nimages = a[ia].nimages();
+                      view2D<double> image_pos(nimages, 4, 0.0);
+                      std::vector<complex_t> Bloch_factor(nimages);
+                      for (int ii = 0; ii < nimages; ++ii) {
+                          set(image_pos[ii], 3, a[ia].pos(ii));
+                          Bloch_factor[ii] = Bloch_phase(boundary_phase, a[ia].idx(ii));
                       } // ii
+                      double const origin[] = {0, 0, 0}; // image_pos are absolute positions
+                      stat += sho_projection::sho_project_images(atom_coeff[ia].data(), numax, origin, sigma, psi, g,
+                                                                 nimages, image_pos, Bloch_factor.data(), echo_sho);
 #ifdef DEBUG
                   } else if (a[ia].nimages() < 1) {
                       error("atom #%i has no image!", a[ia].atom_id());
@@ -167,13 +171,16 @@ namespace grid_operators {
                   } // start_wave_coefficients
 
                   if (a[ia].nimages() > 1) {
-                      for (int ii = 0; ii < a[ia].nimages(); ++ii) {
-                          complex_t const inv_Bloch_factor = Bloch_phase(boundary_phase, a[ia].idx(ii), 1);
-                          std::vector<complex_t> V_image_coeff(ncoeff);
-                          set(V_image_coeff.data(), ncoeff, V_atom_coeff_ia.data(), inv_Bloch_factor);
-
-                          stat += sho_projection::sho_add(Hpsi, g, V_image_coeff.data(), numax, a[ia].pos(ii), sigma, echo_sho);
+                      int const nimages = a[ia].nimages();
+                      view2D<double> image_pos(nimages, 4, 0.0);
+                      std::vector<complex_t> inv_Bloch_factor(nimages);
+                      for (int ii = 0; ii < nimages; ++ii) {
+                          set(image_pos[ii], 3, a[ia].pos(ii));
+                          inv_Bloch_factor[ii] = Bloch_phase(boundary_phase, a[ia].idx(ii), 1);
                       } // ii
+                      double const origin[] = {0, 0, 0}; // image_pos are absolute positions
+                      stat += sho_projection::sho_add_images(Hpsi, g, V_atom_coeff_ia.data(), numax, origin, sigma,
+                                                             nimages, image_pos, inv_Bloch_factor.data(), echo_sho);
                   } else {
                       // Gamma point, no periodic images
                       stat += sho_projection::sho_add(Hpsi, g, V_atom_coeff_ia.data(), numax, a[ia].pos(), sigma, echo_sho);
@@ -457,7 +464,7 @@ namespace grid_operators {
 
       int write_to_file( // TODO: could be moved out of the templated class
             int const echo=0
-          , char const *const fileformat="xml" // or "json"
+          , char const *const fileformat="xml" // or "json" or "hmt" (binary)
           , double const energy_min_max_Fermi[3]=nullptr
           , char const *filename=nullptr // filename, nullptr: use a default name
           , char const *pathname="."
@@ -470,14 +477,46 @@ namespace grid_operators {
           } // generate a default file name
           if (echo > 0) std::printf("# %s filename=%s\n", __func__, filename);
 
+          double const grid_offset[] = {0.5*(grid[0] - 1)*grid.h[0], 0.5*(grid[1] - 1)*grid.h[1], 0.5*(grid[2] - 1)*grid.h[2]};
+
+          if ('h' == (*fileformat | 32)) {
+              // binary file format, see green_input.hxx
+              int const natoms = atoms.size();
+              std::vector<double> xyzZinso(natoms*8, 0.0);
+              std::vector<std::vector<double>> atom_mat(natoms);
+              std::vector<double const*> atom_mat_ptr(natoms);
+              for (int ia = 0; ia < natoms; ++ia) {
+                  auto const & atom = atoms[ia];
+                  auto const pos = atom.pos();
+                  for (int d = 0; d < 3; ++d) xyzZinso[ia*8 + d] = pos[d] - grid_offset[d];
+                  xyzZinso[ia*8 + 3] = atom.atom_iZ();
+                  xyzZinso[ia*8 + 4] = atom.atom_id();
+                  xyzZinso[ia*8 + 5] = atom.numax();
+                  xyzZinso[ia*8 + 6] = atom.sigma();
+                  int const nSHO = sho_tools::nSHO(atom.numax());
+                  auto const stride = atom.stride();
+                  atom_mat[ia].resize(2*nSHO*nSHO);
+                  for (int h0s1 = 0; h0s1 <= 1; ++h0s1) {
+                      auto const mat = atom.get_matrix(h0s1);
+                      for (int i = 0; i < nSHO; ++i) {
+                          set(&atom_mat[ia][(h0s1*nSHO + i)*nSHO], nSHO, &mat[i*stride]); // remove the stride
+                      } // i
+                  } // h0s1
+                  atom_mat_ptr[ia] = atom_mat[ia].data();
+              } // ia
+              uint32_t const ng[] = {uint32_t(grid[0]), uint32_t(grid[1]), uint32_t(grid[2])};
+              int8_t const bc[] = {int8_t(grid.boundary_condition(0)), int8_t(grid.boundary_condition(1)), int8_t(grid.boundary_condition(2))};
+              int const sparse = control::get("hamiltonian.export.sparse", 0.); // 1: only blocks that differ from the background, 2: compressed
+              return green_input::write_binary_Hamiltonian(filename, ng, bc, grid.h, potential.data(), natoms,
+                                          xyzZinso.data(), atom_mat_ptr.data(), energy_min_max_Fermi, echo, sparse);
+          } // binary
+
           auto *const f = std::fopen(filename, "w");
           if (nullptr == f) {
               if (echo > 0) std::printf("# %s Error opening file %s for writing!\n", __func__, filename);
               return __LINE__;
           } // failed to open
 
-          double const grid_offset[] = {0.5*(grid[0] - 1)*grid.h[0], 0.5*(grid[1] - 1)*grid.h[1], 0.5*(grid[2] - 1)*grid.h[2]};
-
           if ('x' == (*fileformat | 32)) {
 
               // XML file format
@@ -3,6 +3,8 @@
 
 #include <cstdlib> // size_t
 #include <cmath> // std::round
+#include <vector> // std::vector<T>
+#include <algorithm> // std::min
 
 #include "status.hxx" // status_t, STATUS_TEST_NOT_INCLUDED
 
@@ -101,6 +103,65 @@
 
   inline bool is_integer(double const f) { return (f == std::round(f)); }
 
+  // variants of the above for long arrays, e.g. all points of a real-space grid:
+  // the work is distributed over OpenMP threads in blocks of fixed size,
+  // so the result of a reduction does not depend on the number of threads.
+  size_t constexpr parallel_block = 1 << 12; // elements per block
+
+  template <typename real_t> inline
+  void set_parallel(real_t y[], size_t const n, real_t const a) {
+      #pragma omp parallel for schedule(static) if (n > 4*parallel_block)
+      for (size_t i = 0; i < n; ++i) { y[i] = a; }
+  } // set_parallel
+
+  template <typename real_t, typename real_a_t, typename real_f_t=real_t> inline
+  void set_parallel(real_t y[], size_t const n, real_a_t const a[], real_f_t const f=1) {
+      #pragma omp parallel for schedule(static) if (n > 4*parallel_block)
+      for (size_t i = 0; i < n; ++i) { y[i] = a[i]*f; }
+  } // set_parallel
+
+  template <typename real_t> inline
+  void scale_parallel(real_t y[], size_t const n, real_t const f) {
+      #pragma omp parallel for schedule(static) if (n > 4*parallel_block)
+      for (size_t i = 0; i < n; ++i) { y[i] *= f; }
+  } // scale_parallel
+
+  template <typename real_t, typename real_a_t> inline
+  void add_product_parallel(real_t y[], size_t const n, real_a_t const a[], real_t const f) {
+      #pragma omp parallel for schedule(static) if (n > 4*parallel_block)
+      for (size_t i = 0; i < n; ++i) { y[i] += a[i]*f; }
+  } // add_product_parallel
+
+  template <typename real_t, typename real_a_t> inline
+  double dot_product_block(size_t const i0, size_t const i1, real_t const bra[], real_a_t const ket[]) {
+      double d4[4] = {0, 0, 0, 0}; // four independent partial sums can be vectorized
+      size_t i{i0};
+      for (; i + 4 <= i1; i += 4) {
+          for (int k = 0; k < 4; ++k) {
+              d4[k] += bra[i + k]*ket[i + k];
+          } // k
+      } // i
+      for (; i < i1; ++i) { d4[0] += bra[i]*ket[i]; } // remainder
+      return (d4[0] + d4[1]) + (d4[2] + d4[3]);
+  } // dot_product_block
+
+  template <typename real_t, typename real_a_t> inline
+  double dot_product_parallel(size_t const n, real_t const bra[], real_a_t const ket[]) {
+      size_t const nblocks = (n + parallel_block - 1)/parallel_block;
+      std::vector<double> partial(nblocks, 0.0);
+      #pragma omp parallel for schedule(static) if (nblocks > 4)
+      for (size_t ib = 0; ib < nblocks; ++ib) {
+          size_t const i0 = ib*parallel_block;
+          partial[ib] = dot_product_block(i0, std::min(n, i0 + parallel_block), bra, ket);
+      } // ib
+      double dot{0};
+      for (size_t ib = 0; ib < nblocks; ++ib) {
+          dot += partial[ib]; // serial summation in fixed order
+      } // ib
+      return dot;
+  } // dot_product_parallel
+
+
 
 
 
@@ -204,6 +265,32 @@ namespace inline_math {
       return stat;
   } // test_align
 
+  inline status_t test_parallel_variants(int const echo=1) {
+      // the parallel variants must reproduce the serial ones
+      status_t stat(0);
+      size_t const n = 5*parallel_block + 37; // not a multiple of the block size
+      std::vector<double> a(n), b(n), y(n), z(n);
+      for (size_t i = 0; i < n; ++i) {
+          a[i] = std::cos(0.001*i);
+          b[i] = 1./(1. + 0.01*i);
+      } // i
+      set(y.data(), n, a.data(), 0.5);     set_parallel(z.data(), n, a.data(), 0.5);
+      scale(y.data(), n, 3.0);             scale_parallel(z.data(), n, 3.0);
+      add_product(y.data(), n, b.data(), -.75); add_product_parallel(z.data(), n, b.data(), -.75);
+      for (size_t i = 0; i < n; ++i) { stat += (y[i] != z[i]); }
+      auto const dot_serial   = dot_product(n, a.data(), b.data());
+      auto const dot_parallel = dot_product_parallel(n, a.data(), b.data());
+      auto const rel_dev = std::abs(dot_parallel - dot_serial)/std::abs(dot_serial);
+      stat += (rel_dev > 1e-14);
+      stat += (dot_product_parallel(n, a.data(), b.data()) != dot_parallel); // must be reproducible
+      set_parallel(z.data(), n, 0.0);
+      stat += (0 != dot_product_parallel(n, z.data(), z.data()));
+      if (echo > 3) std::printf("# %s: dot products %.15f and %.15f, relative deviation %.1e\n",
+                                  __func__, dot_serial, dot_parallel, rel_dev);
+      if (echo > 0 && stat) std::printf("# %s: %d errors\n", __func__, int(stat));
+      return stat;
+  } // test_parallel_variants
+
   inline status_t all_tests(int const echo=0) {
       if (echo > 0) std::printf("\n# %s %s\n", __FILE__, __func__);
       status_t stat(0);
@@ -211,6 +298,7 @@ namespace inline_math {
       stat += test_intpow<double>(echo);
       stat += test_align(echo);
       stat += test_factorials(echo);
+      stat += test_parallel_variants(echo);
       return stat;
   } // all_tests
 
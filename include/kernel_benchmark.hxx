@@ -0,0 +1,26 @@
+#pragma once
+// This file is part of AngstromCube under MIT License
+
+#include "status.hxx" // status_t
+
+namespace kernel_benchmark {
+
+  // Sweep over the performance-critical kernels of the grid Hamiltonian and of the Green function:
+  //    finite_difference::apply, sho_projection, green_kinetic::Laplace_driver,
+  //    green_potential::multiply, green_dyadic::SHOprj/SHOadd and davidson_solver::eigensolve,
+  //    and a triad on memory allocated with different placement policies (alignment, first touch, NUMA).
+  // Each case reports GFlop/s and GByte/s and the fraction of the attainable performance
+  // min(peak GFlop/s, arithmetic intensity * peak GByte/s) of a roofline model.
+  // Control keys:
+  //    kernel_benchmark.sweep      0: smoke test with the smallest sizes, 1: full sweep
+  //    kernel_benchmark.select     bit mask 1:finite_difference, 2:sho_projection, 4:Laplace,
+  //                                         8:Potential, 16:SHOprj/SHOadd, 32:davidson_solver, 64:placement
+  //    kernel_benchmark.repeat     number of repetitions, the fastest one is reported
+  //    kernel_benchmark.peak.gbytes, kernel_benchmark.peak.gflops    roofline, 0: measure
+  //    kernel_benchmark.store      write the timings to this file
+  //    kernel_benchmark.baseline   compare the timings to a file written before
+  //    kernel_benchmark.tolerance  relative slowdown that is reported as a regression
+
+  status_t all_tests(int const echo=0); // declaration only
+
+} // namespace kernel_benchmark
@@ -2,6 +2,7 @@
 // This file is part of AngstromCube under MIT License
 
 #include <cstdint> // uint32_t, uint16_t
+#include <cstddef> // size_t
 
 #include "status.hxx" // status_t, STATUS_TEST_NOT_INCLUDED
 
@@ -14,6 +15,13 @@ namespace load_balancer {
       , int const echo=0 // log level
       , double rank_center[4]=nullptr // export the rank center [0/1/2] and number of items [3]
       , uint16_t *owner_rank=nullptr // export the owner rank of each task, [nb[Z]*nb[Y]*nb[X]]
+      , double const *block_weights=nullptr // estimated cost of each task, [nb[Z]*nb[Y]*nb[X]], default all 1
+  ); // declaration only
+
+  size_t count_cut_faces(
+        uint32_t const nb[3] // number of blocks in X/Y/Z direction
+      , uint16_t const owner_rank[] // owner rank of each task, [nb[Z]*nb[Y]*nb[X]]
+      , double const *block_weights=nullptr // tasks with zero weight do not count
   ); // declaration only
 
   status_t all_tests(int const echo=0); // declaration only
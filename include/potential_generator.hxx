@@ -2,6 +2,7 @@
 // This file is part of AngstromCube under MIT License
 
 #include <cstdio> // std::printf, ::snprintf
+#include <vector> // std::vector<T>
 
 #include "status.hxx" // status_t
 #include "control.hxx" // ::get
@@ -66,13 +67,8 @@ namespace potential_generator {
           } // echo
 #endif // DEVEL
           double q_added{0};
-          for (int ii = 0; ii < n_periodic_images; ++ii) {
-              double cnt[3]; set(cnt, 3, center[ia]); add_product(cnt, 3, periodic_images[ii], 1.0);
-              double q_added_image{0};
-              stat += real_space::add_function(values, g, atom_qnt[ia], nr2[ia], ar2[ia], &q_added_image, cnt, factor);
-              if (echo_q > 11) std::printf("# %g electrons %s of atom #%d added for image #%i\n", q_added_image, quantity, ia, ii);
-              q_added += q_added_image;
-          } // periodic images
+          stat += real_space::add_function_images(values, g, atom_qnt[ia], nr2[ia], ar2[ia], &q_added, center[ia],
+                                                  n_periodic_images, periodic_images, factor, -1, echo_q - 6);
 #ifdef DEVEL
           if (echo_q > 0) {
               std::printf("# after adding %g electrons %s of atom #%d:", q_added, quantity, ia);
@@ -86,6 +82,43 @@ namespace potential_generator {
   } // add_smooth_quantities
 
 
+  template <typename real_t>
+  status_t add_smooth_quantities(
+        int const nq // number of quantities added in the same sweep over the grid
+      , real_t *const values[] // [nq] add to these functions on a 3D grid, the same array may appear more than once
+      , real_space::grid_t const & g // real-space grid descriptor
+      , int const na // number of atoms (radial grid centers)
+      , int32_t const nr2[] // number of r^2-grid points
+      , float const ar2[] // r2-grid density
+      , view2D<double> const & center // [natoms][4] center coordinates
+      , int const n_periodic_images
+      , view2D<double> const & periodic_images
+      , double const *const *const atom_qnt[] // [nq] atom data on r2-grids
+      , double const factors[] // [nq] multipliers
+      , int const echo=0 // log-level
+  ) {
+      // add several atom-centered quantities which share the r^2-grids, e.g. smooth core and valence densities
+      status_t stat(0);
+      std::vector<double const*> qnt(nq);
+      std::vector<double> q_added(nq, 0.0);
+      for (int ia = 0; ia < na; ++ia) {
+          for (int iq = 0; iq < nq; ++iq) {
+              qnt[iq] = atom_qnt[iq][ia];
+          } // iq
+          stat += real_space::add_functions_images(nq, values, qnt.data(), factors, q_added.data(), g, nr2[ia], ar2[ia],
+                                                   center[ia], n_periodic_images, periodic_images, -1, echo - 6);
+          if (echo > 7) {
+              std::printf("# added for atom #%d:", ia);
+              for (int iq = 0; iq < nq; ++iq) {
+                  std::printf(" %g", q_added[iq]);
+              } // iq
+              std::printf("\n");
+          } // echo
+      } // ia
+      return stat;
+  } // add_smooth_quantities
+
+
   template <typename real_t, int debug=0>
   status_t add_generalized_Gaussian(
         real_t values[] // grid values which are modified
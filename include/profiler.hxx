@@ -0,0 +1,64 @@
+#pragma once
+// This file is part of AngstromCube under MIT License
+
+#include <cstdint> // int64_t
+#include <chrono> // std::chrono::steady_clock, ::duration
+
+#include "status.hxx" // status_t
+
+namespace profiler {
+
+  // Hierarchical profiling regions, e.g.
+  //    { profiler::region_t region("Poisson", bytes, flops); ... }
+  // accumulate the number of calls, the wall time and optional estimates of the memory traffic
+  // and of the floating point operations. A region opened while another region is open becomes
+  // its child, so the same name can appear at different places of the tree.
+  // Names are matched by their address first, so pass string literals or strings that do not change.
+  // Only the thread that opened the first region records, regions opened by other threads
+  // are ignored, so no locks are needed. Regions must not be opened inside OpenMP parallel loops.
+  // With CUDA, kernels run asynchronously, so a region only measures the launch unless it synchronizes.
+
+  int open_region(char const *name); // returns the node index or -1 if not recorded, declaration only
+
+  void close_region(int const node, double const seconds, double const bytes, double const flops); // declaration only
+
+  class region_t {
+  public:
+
+      region_t(char const *name, double const bytes=0, double const flops=0)
+        : node_(open_region(name)), bytes_(bytes), flops_(flops) {
+          if (node_ >= 0) start_ = std::chrono::steady_clock::now();
+      } // constructor
+
+      ~region_t() {
+          if (node_ < 0) return;
+          std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start_;
+          close_region(node_, elapsed.count(), bytes_, flops_);
+      } // destructor
+
+      region_t(region_t const &) = delete;
+      region_t & operator=(region_t const &) = delete;
+
+      void add(double const bytes, double const flops=0) { bytes_ += bytes; flops_ += flops; } // add estimates after the work is done
+
+  private:
+      int node_;
+      double bytes_, flops_;
+      std::chrono::time_point<std::chrono::steady_clock> start_;
+  }; // class region_t
+
+  void set_iteration(int const iteration); // attribute times to this SCF iteration, -1: none, declaration only
+
+  void set_enabled(bool const enabled=true); // declaration only
+
+  status_t show(int const echo=1); // print the tree of regions to stdout, declaration only
+
+  // write all regions with path, calls, seconds, bytes, flops and the seconds per SCF iteration,
+  // format .csv if the filename ends with ".csv", JSON otherwise, nothing if the filename is empty
+  status_t write_report(char const *filename, int const echo=0); // declaration only
+
+  status_t clear(); // forget all regions, fails if a region is open, declaration only
+
+  status_t all_tests(int const echo=0); // declaration only
+
+} // namespace profiler
@@ -6,6 +6,7 @@
 #include <algorithm> // std::min, ::max
 #include <cmath> // std::floor, ::ceil, ::sqrt, ::abs
 #include <cassert> // assert
+#include <vector> // std::vector<T>
 
 #include "inline_math.hxx" // set, scale
 #include "simple_math.hxx" // ::determinant
@@ -14,6 +15,7 @@
 #include "bessel_transform.hxx" // ::Bessel_j0
 #include "recorded_warnings.hxx" // warn
 #include "boundary_condition.hxx" // Periodic_Boundary, Isolated_Boundary, Mirrored_Boundary, Invalid_Boundary
+#include "data_view.hxx" // view2D<T>
 
 #include "status.hxx" // status_t
 
@@ -262,85 +264,207 @@ namespace real_space {
 
 
 
+  int constexpr row_chunk = 64; // number of grid points per chunk in add_row_functions
+
   template <typename real_t>
-  status_t add_function(
-        real_t values[] // grid values which are modified
+  size_t add_row_functions(
+        int const nq // number of quantities
+      , real_t *const rows[] // [nq] grid rows which are modified, indexed by ix
+      , double const *const r2coeff[] // [nq] coefficients of the radial functions on the r^2-grid
+      , double const factors[] // [nq] scaling factors
+      , double added[] // [nq] accumulated sums of the added values
+      , int const ncoeff // number of coefficients on the r^2-grid
+      , float const hcoeff // r^2-grid parameter
+      , int const ix_begin // first grid point in the row
+      , int const ix_end // end of the row segment (excluded)
+      , double const hx // grid spacing in x-direction
+      , double const cx // center coordinate in x-direction
+      , double const vzy2 // squared distance from the center in the yz-plane
+      , double const r2cut // squared truncation radius
+  ) {
+      // Add radial functions to a segment of an x-row, chunk by chunk:
+      // the r^2-grid indices and interpolation weights of a chunk are computed in a branch-free loop,
+      // then all quantities are gathered and interpolated with the same indices and weights.
+      // Points outside of r2cut get zero weights, so the results match the scalar version exactly.
+      int    i_lo[row_chunk], i_hi[row_chunk];
+      double w_lo[row_chunk], w_hi[row_chunk];
+      size_t out_of_range{0};
+      for (int ix0 = ix_begin; ix0 < ix_end; ix0 += row_chunk) {
+          int const n = std::min(row_chunk, ix_end - ix0);
+          for (int i = 0; i < n; ++i) {
+              double const vx = (ix0 + i)*hx - cx;
+              double const r2 = vzy2 + vx*vx;
+              int const ir2 = int(hcoeff*r2);
+              double const w8 = hcoeff*r2 - ir2; // linear interpolation weight
+              bool const inside = (r2 < r2cut);
+              bool const in_range = (ir2 < ncoeff);
+              out_of_range += (inside && !in_range);
+              double const active = (inside && in_range) ? 1 : 0;
+              i_lo[i] = std::min(ir2, ncoeff - 1);
+              i_hi[i] = std::min(ir2 + 1, ncoeff - 1);
+              w_lo[i] = active*(1 - w8);
+              w_hi[i] = (ir2 + 1 < ncoeff) ? active*w8 : 0;
+          } // i
+          for (int iq = 0; iq < nq; ++iq) {
+              auto const c = r2coeff[iq];
+              auto const f = factors[iq];
+              auto const row = rows[iq] + ix0;
+              double sum{added[iq]};
+              for (int i = 0; i < n; ++i) {
+                  double const value_to_add = c[i_lo[i]]*w_lo[i] + c[i_hi[i]]*w_hi[i];
+                  row[i] += f*value_to_add;
+                  sum    += f*value_to_add;
+              } // i
+              added[iq] = sum;
+          } // iq
+      } // ix0
+      return out_of_range;
+  } // add_row_functions
+
+
+  template <typename real_t>
+  status_t add_functions_images(
+        int const nq // number of quantities added in the same sweep
+      , real_t *const values[] // [nq] grid values which are modified, the same array may appear more than once
+      , double const *const r2coeff[] // [nq] coefficients of the radial functions on the same r^2-grid
+      , double const factors[] // [nq] scaling factors
+      , double added[] // [nq] optional result: how much (e.g. charge) was added by all images together
       , grid_t const & g // grid descriptor
-      , double const r2coeff[] // coefficients of the radial function on r^2-grid
       , int const ncoeff // number of coefficients on the r^2-grid
       , float const hcoeff // r^2-grid parameter
-      , double *added=nullptr // optional result: how much (e.g. charge) was added
-      , double const center[3]=nullptr // spherical center w.r.t. the position of grid point (0,0,0)
-      , double const factor=1 // optional scaling
+      , double const center[3] // spherical center w.r.t. the position of grid point (0,0,0)
+      , int const n_images // number of periodic images
+      , view2D<double> const & image_shifts // [n_images][4] shifts of the periodic images w.r.t. center
       , float const r_cut=-1 // radial truncation, -1:use the max radius of the r^2-grid
+      , int const echo=0 // log-level
   ) {
-      // Add a spherically symmetric regular function to the grid.
-      // The function is tabulated as r2coeff[0 <= hcoeff*r^2 < ncoeff]
+      // Add several spherically symmetric regular functions tabulated on the same r^2-grid
+      // and their periodic images to the grid.
+      // Same result as calling add_function once per quantity and image, but images that do not touch
+      // the grid are skipped before any work is done and the grid is swept only once, row by row.
       status_t stat(0);
-      double c[3] = {0,0,0}; if (center) set(c, 3, center);
+      std::vector<double> added_q(nq, 0.0);
+      if (!g.is_Cartesian()) {
+          for (int iq = 0; iq < nq; ++iq) {
+              for (int ii = 0; ii < n_images; ++ii) {
+                  double cnt[3]; set(cnt, 3, center); add_product(cnt, 3, image_shifts[ii], 1.0);
+                  double added_image{0};
+                  stat += add_function_general(values[iq], g, r2coeff[iq], ncoeff, hcoeff, &added_image, cnt, factors[iq], r_cut);
+                  added_q[iq] += added_image;
+              } // ii
+          } // iq
+          if (added) set(added, nq, added_q.data());
+          return stat;
+      } // not Cartesian
       double const r_max = std::sqrt((ncoeff - 1.)/hcoeff); // largest radius of the r^2-grid
       double const rcut = (-1 == r_cut) ? r_max : std::min(double(r_cut), r_max);
       double const r2cut = rcut*rcut;
       assert(hcoeff*r2cut < ncoeff);
-      if (!g.is_Cartesian()) {
-          return add_function_general(values, g, r2coeff, ncoeff, hcoeff, added, center, factor, r_cut);
-      } // not Cartesian
-      int imn[3], imx[3];
-#ifdef    DEBUG
-      size_t nwindow{1};
-      size_t modified{0};
-#endif // DEBUG
-      for (int d = 0; d < 3; ++d) {
-          imn[d] = std::max(0, int(std::floor((c[d] - rcut)*g.inv_h[d])));
-          imx[d] = std::min(   int(std::ceil ((c[d] + rcut)*g.inv_h[d])), g[d] - 1);
-#ifdef    DEBUG
-          std::printf("# %s window %c = %d elements from %d to %d\n", __func__, 'x'+d, imx[d] + 1 - imn[d], imn[d], imx[d]);
-          nwindow *= std::max(0, imx[d] + 1 - imn[d]);
-#endif // DEBUG
-      } // d
       assert(hcoeff > 0);
-      double added_charge{0}; // clear
+
+      // determine the windows of all images and keep only those that overlap with the grid
+      std::vector<int> active; active.reserve(n_images);
+      view2D<double> c(n_images, 4, 0.0); // image centers
+      view2D<int> imn(n_images, 4, 0), imx(n_images, 4, -1);
+      int wmn[3] = {g[0], g[1], g[2]}, wmx[3] = {-1, -1, -1}; // union of all windows
+      for (int ii = 0; ii < n_images; ++ii) {
+          bool empty{false};
+          for (int d = 0; d < 3; ++d) {
+              c(ii,d) = center[d] + image_shifts(ii,d);
+              imn(ii,d) = std::max(0, int(std::floor((c(ii,d) - rcut)*g.inv_h[d])));
+              imx(ii,d) = std::min(   int(std::ceil ((c(ii,d) + rcut)*g.inv_h[d])), g[d] - 1);
+              empty = empty || (imx(ii,d) < imn(ii,d));
+          } // d
+          if (!empty) {
+              active.push_back(ii);
+              for (int d = 0; d < 3; ++d) {
+                  wmn[d] = std::min(wmn[d], imn(ii,d));
+                  wmx[d] = std::max(wmx[d], imx(ii,d));
+              } // d
+          } // window is not empty
+      } // ii
+      int const n_active = active.size();
+      if (echo > 5) std::printf("# %s: %d of %d periodic images touch the grid, %d quantities\n", __func__, n_active, n_images, nq);
+
+      std::vector<real_t*> rows(nq);
       size_t out_of_range{0};
-      for (            int iz = imn[2]; iz <= imx[2]; ++iz) {  double const vz = iz*g.h[2] - c[2], vz2 = vz*vz;
-          for (        int iy = imn[1]; iy <= imx[1]; ++iy) {  double const vy = iy*g.h[1] - c[1], vy2 = vy*vy;
-              if (vz2 + vy2 < r2cut) {
-                  for (int ix = imn[0]; ix <= imx[0]; ++ix) {  double const vx = ix*g.h[0] - c[0], vx2 = vx*vx;
-                      double const r2 = vz2 + vy2 + vx2;
-                      if (r2 < r2cut) {
-                          int const ir2 = int(hcoeff*r2);
-                          if (ir2 < ncoeff) {
-                              int const izyx = (iz*g('y') + iy)*g('x') + ix;
-                              double const w8 = hcoeff*r2 - ir2; // linear interpolation weight
-                              int const ir2p1 = ir2 + 1;
-                              auto const value_to_add = (r2coeff[ir2] * (1 - w8)
-                                   + ((ir2p1 < ncoeff) ? r2coeff[ir2p1] : 0)*w8);
-                              values[izyx] += factor*value_to_add;
-                              added_charge += factor*value_to_add;
-#ifdef    DEBUG
-                              ++modified;
-#endif // DEBUG
-
-#if       0
-//        std::printf("#rs %g %g\n", std::sqrt(r2), value_to_add);
-//        std::printf("#rs %.1f %.1f %.1f %.12f\n", vx*g.inv_h[0], vy*g.inv_h[1], vz*g.inv_h[2], value_to_add);
-#endif // 0
-                          } else {
-                              ++out_of_range;
-                          } // ir2 < ncoeff
-                      } // inside rcut
-                  } // ix
-              } // rcut for (y,z)
+      for (            int iz = wmn[2]; iz <= wmx[2]; ++iz) {
+          for (        int iy = wmn[1]; iy <= wmx[1]; ++iy) {
+              size_t const row_offset = (iz*g('y') + iy)*g('x');
+              for (int iq = 0; iq < nq; ++iq) {
+                  rows[iq] = values[iq] + row_offset;
+              } // iq
+              for (int ia = 0; ia < n_active; ++ia) {
+                  int const ii = active[ia];
+                  if (iz < imn(ii,2) || iz > imx(ii,2) || iy < imn(ii,1) || iy > imx(ii,1)) continue;
+                  double const vz = iz*g.h[2] - c(ii,2), vy = iy*g.h[1] - c(ii,1), vzy2 = vz*vz + vy*vy;
+                  if (vzy2 < r2cut) {
+                      // the segment of the row inside the sphere, widened by one point for rounding
+                      double const dx = std::sqrt(r2cut - vzy2);
+                      int const ix_begin = std::max(imn(ii,0), int(std::floor((c(ii,0) - dx)*g.inv_h[0])) - 1);
+                      int const ix_end   = std::min(imx(ii,0), int(std::ceil ((c(ii,0) + dx)*g.inv_h[0])) + 1) + 1;
+                      out_of_range += add_row_functions(nq, rows.data(), r2coeff, factors, added_q.data(),
+                                          ncoeff, hcoeff, ix_begin, ix_end, g.h[0], c(ii,0), vzy2, r2cut);
+                  } // rcut for (y,z)
+              } // ia
           } // iy
       } // iz
-      if (added) *added = added_charge * g.dV(); // volume integral
-#ifdef    DEBUG
-      std::printf("# %s modified %.3f k inside a window of %.3f k on a grid of %.3f k grid values.\n", 
-              __func__, modified*1e-3, nwindow*1e-3, g('x')*g('y')*g('z')*1e-3); // show stats
-#endif // DEBUG
+      if (added) {
+          for (int iq = 0; iq < nq; ++iq) {
+              added[iq] = added_q[iq] * g.dV(); // volume integral
+          } // iq
+      } // added
       if (out_of_range > 0) {
           stat += 0 < warn("Found %ld entries out of range of the radial function!", out_of_range);
       } // out of range of the radial function
       return stat;
+  } // add_functions_images
+
+
+  template <typename real_t>
+  status_t add_function_images(
+        real_t values[] // grid values which are modified
+      , grid_t const & g // grid descriptor
+      , double const r2coeff[] // coefficients of the radial function on r^2-grid
+      , int const ncoeff // number of coefficients on the r^2-grid
+      , float const hcoeff // r^2-grid parameter
+      , double *added // optional result: how much (e.g. charge) was added by all images together
+      , double const center[3] // spherical center w.r.t. the position of grid point (0,0,0)
+      , int const n_images // number of periodic images
+      , view2D<double> const & image_shifts // [n_images][4] shifts of the periodic images w.r.t. center
+      , double const factor=1 // optional scaling
+      , float const r_cut=-1 // radial truncation, -1:use the max radius of the r^2-grid
+      , int const echo=0 // log-level
+  ) {
+      // Add a spherically symmetric regular function and its periodic images to the grid.
+      real_t *const values_q[] = {values};
+      double const *const r2coeff_q[] = {r2coeff};
+      double const factor_q[] = {factor};
+      return add_functions_images(1, values_q, r2coeff_q, factor_q, added, g, ncoeff, hcoeff,
+                                  center, n_images, image_shifts, r_cut, echo);
+  } // add_function_images
+
+
+  template <typename real_t>
+  status_t add_function(
+        real_t values[] // grid values which are modified
+      , grid_t const & g // grid descriptor
+      , double const r2coeff[] // coefficients of the radial function on r^2-grid
+      , int const ncoeff // number of coefficients on the r^2-grid
+      , float const hcoeff // r^2-grid parameter
+      , double *added=nullptr // optional result: how much (e.g. charge) was added
+      , double const center[3]=nullptr // spherical center w.r.t. the position of grid point (0,0,0)
+      , double const factor=1 // optional scaling
+      , float const r_cut=-1 // radial truncation, -1:use the max radius of the r^2-grid
+  ) {
+      // Add a spherically symmetric regular function to the grid.
+      // The function is tabulated as r2coeff[0 <= hcoeff*r^2 < ncoeff]
+      double c[3] = {0,0,0}; if (center) set(c, 3, center);
+      if (!g.is_Cartesian()) {
+          return add_function_general(values, g, r2coeff, ncoeff, hcoeff, added, c, factor, r_cut);
+      } // not Cartesian
+      view2D<double> const no_shift(1, 4, 0.0); // a single image without shift
+      return add_function_images(values, g, r2coeff, ncoeff, hcoeff, added, c, 1, no_shift, factor, r_cut);
   } // add_function
 
   template <typename real_t>
@@ -457,10 +581,103 @@ namespace real_space {
       return std::abs(diff/rad_integral) > 4e-4;
   } // test_add_function
 
+  inline status_t test_add_function_images(int const echo=9) {
+      if (echo > 0) std::printf("\n# %s\n", __func__);
+      int const dims[] = {12, 10, 14};
+      int8_t const bc[] = {Periodic_Boundary, Periodic_Boundary, Isolated_Boundary};
+      double const h = 0.4, cell[3][4] = {{dims[0]*h, 0, 0, 0}, {0, dims[1]*h, 0, 0}, {0, 0, dims[2]*h, 0}};
+      grid_t g(dims);
+      g.set_boundary_conditions(bc);
+      g.set_cell_shape(cell); // small periodic cell, many images contribute
+      double const cnt[] = {g[0]*.3*g.h[0], g[1]*.7*g.h[1], g[2]*.45*g.h[2]};
+      int const nr2 = 1 << 12;
+      float const rcut = 6, inv_hr2 = nr2/(rcut*rcut);
+      std::vector<double> r2c(nr2);
+      for (int ir2 = 0; ir2 < nr2; ++ir2) {
+          r2c[ir2] = std::exp(-.25*ir2/inv_hr2); // exp(-r^2/4)
+      } // ir2
+      view2D<double> image_shifts;
+      auto const n_images = boundary_condition::periodic_images(image_shifts, g.cell, g.boundary_conditions(), rcut, echo/4);
+
+      std::vector<double> values_ref(g.all(), 0.0), values(g.all(), 0.0);
+      double added_ref{0}, added{0};
+      for (int ii = 0; ii < n_images; ++ii) { // reference: one call per image
+          double c[3]; set(c, 3, cnt); add_product(c, 3, image_shifts[ii], 1.0);
+          double added_image{0};
+          add_function(values_ref.data(), g, r2c.data(), nr2, inv_hr2, &added_image, c);
+          added_ref += added_image;
+      } // ii
+      add_function_images(values.data(), g, r2c.data(), nr2, inv_hr2, &added, cnt, n_images, image_shifts, 1., -1, echo);
+      double maxdev{0};
+      for (size_t izyx = 0; izyx < g.all(); ++izyx) {
+          maxdev = std::max(maxdev, std::abs(values[izyx] - values_ref[izyx]));
+      } // izyx
+      if (echo > 2) std::printf("# %s: %d images, added %.12f (reference %.12f), largest deviation %.1e\n",
+                                  __func__, n_images, added, added_ref, maxdev);
+      return (maxdev > 1e-12) + (std::abs(added - added_ref) > 1e-9);
+  } // test_add_function_images
+
+  inline status_t test_add_functions_batched(int const echo=9) {
+      if (echo > 0) std::printf("\n# %s\n", __func__);
+      int const dims[] = {24, 20, 28};
+      int8_t const bc[] = {Periodic_Boundary, Periodic_Boundary, Periodic_Boundary};
+      double const h = 0.25, cell[3][4] = {{dims[0]*h, 0, 0, 0}, {0, dims[1]*h, 0, 0}, {0, 0, dims[2]*h, 0}};
+      grid_t g(dims);
+      g.set_boundary_conditions(bc);
+      g.set_cell_shape(cell);
+      double const cnt[] = {g[0]*.41*g.h[0], g[1]*.62*g.h[1], g[2]*.53*g.h[2]};
+      int const nr2 = 1 << 12;
+      float const rcut = 5, inv_hr2 = nr2/(rcut*rcut);
+      int const nq = 3;
+      std::vector<double> r2c(nq*nr2);
+      for (int ir2 = 0; ir2 < nr2; ++ir2) {
+          double const r2 = ir2/inv_hr2;
+          r2c[0*nr2 + ir2] = std::exp(-r2); // like a core density
+          r2c[1*nr2 + ir2] = std::exp(-.5*r2)*(1 - .1*r2); // like a zero potential
+          r2c[2*nr2 + ir2] = std::exp(-.75*r2); // like a valence density
+      } // ir2
+      view2D<double> image_shifts;
+      auto const n_images = boundary_condition::periodic_images(image_shifts, g.cell, g.boundary_conditions(), rcut, echo/4);
+
+      // quantities 0 and 2 go into the same array, quantity 1 into a different one
+      std::vector<double> rho_ref(g.all(), 0.0), pot_ref(g.all(), 0.0), rho(g.all(), 0.0), pot(g.all(), 0.0);
+      double const factors[] = {.5, -2., 1.5};
+      double added_ref[nq] = {0, 0, 0}, added[nq];
+      double *const values_ref[] = {rho_ref.data(), pot_ref.data(), rho_ref.data()};
+      for (int iq = 0; iq < nq; ++iq) { // reference: scalar code, one call per image and quantity
+          for (int ii = 0; ii < n_images; ++ii) {
+              double c[3]; set(c, 3, cnt); add_product(c, 3, image_shifts[ii], 1.0);
+              double added_image{0};
+              add_function_general(values_ref[iq], g, &r2c[iq*nr2], nr2, inv_hr2, &added_image, c, factors[iq]);
+              added_ref[iq] += added_image;
+          } // ii
+      } // iq
+
+      double *const values[] = {rho.data(), pot.data(), rho.data()};
+      double const *const coeff[] = {&r2c[0*nr2], &r2c[1*nr2], &r2c[2*nr2]};
+      add_functions_images(nq, values, coeff, factors, added, g, nr2, inv_hr2, cnt, n_images, image_shifts, -1, echo);
+
+      double maxdev{0};
+      for (size_t izyx = 0; izyx < g.all(); ++izyx) {
+          maxdev = std::max(maxdev, std::abs(rho[izyx] - rho_ref[izyx]));
+          maxdev = std::max(maxdev, std::abs(pot[izyx] - pot_ref[izyx]));
+      } // izyx
+      double maxdev_added{0};
+      for (int iq = 0; iq < nq; ++iq) {
+          maxdev_added = std::max(maxdev_added, std::abs(added[iq] - added_ref[iq]));
+          if (echo > 3) std::printf("# %s: quantity #%d added %.12f (reference %.12f)\n", __func__, iq, added[iq], added_ref[iq]);
+      } // iq
+      if (echo > 2) std::printf("# %s: %d quantities, %d images, largest deviation %.1e, in added %.1e\n",
+                                  __func__, nq, n_images, maxdev, maxdev_added);
+      return (maxdev > 1e-12) + (maxdev_added > 1e-9);
+  } // test_add_functions_batched
+
   inline status_t all_tests(int const echo=0) {
       status_t stat(0);
       stat += test_create_and_destroy(echo);
       stat += test_add_function(echo);
+      stat += test_add_function_images(echo);
+      stat += test_add_functions_batched(echo);
       return stat;
   } // all_tests
 
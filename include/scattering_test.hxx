@@ -30,6 +30,7 @@ namespace scattering_test {
       , char const *label="" // log-prefix
       , int const echo=0 // log-level
       , float const Rlog_over_sigma=6.f
+      , int const refine=0 // start the energy scan on a grid coarser by 2^refine, subdivide only near resonances
   ); // declaration only
 
   status_t eigenstate_analysis(
@@ -0,0 +1,87 @@
+#pragma once
+// This file is part of AngstromCube under MIT License
+
+#include <cstdint> // uint64_t
+#include <cstdlib> // size_t
+#include <vector> // std::vector<T>
+#include <string> // std::string
+#include <thread> // std::thread
+#include <atomic> // std::atomic<T>
+
+#include "status.hxx" // status_t
+
+namespace scf_checkpoint {
+
+  // A checkpoint file is a stream of named records
+  //    header    {magic, version, endian, scf_iteration}
+  //    record    {name[24], bytes} followed by the data, padded to 8 Byte
+  //    ...
+  //    "end"     record with zero bytes, files without it are incomplete
+  // Files are written to a temporary name and renamed when complete,
+  // so a job preempted during the write still finds the previous checkpoint.
+
+  struct record_t {
+      std::string name;
+      std::vector<char> data;
+  }; // record_t
+
+  class writer_t { // asynchronous writer
+  public:
+
+      writer_t(char const *filename="", int const every=0, int const echo=0); // declaration only
+      ~writer_t() { wait(); }
+      writer_t(writer_t const &) = delete;
+      writer_t & operator=(writer_t const &) = delete;
+
+      // true if a checkpoint should be taken after this iteration,
+      // false if the previous write is still running (the checkpoint is skipped rather than waited for)
+      bool due(int const scf_iteration) const; // declaration only
+
+      void add(char const *name, void const *data, size_t const bytes); // copy data into the pending snapshot, declaration only
+
+      status_t commit(int const scf_iteration); // start writing the pending snapshot in the background, declaration only
+
+      status_t wait(); // block until the background write has finished, declaration only
+
+      size_t bytes_written() const { return total_bytes_.load(); }
+
+  private:
+      void write_records(); // runs in the background thread, declaration only
+
+      std::string filename_;
+      int every_{0};
+      int echo_{0};
+      std::vector<record_t> pending_, writing_;
+      int64_t writing_iteration_{-1};
+      std::thread worker_;
+      std::atomic<bool> busy_{false};
+      std::atomic<int> write_status_{0};
+      std::atomic<size_t> total_bytes_{0}; // incremented by the background thread
+  }; // class writer_t
+
+  class reader_t {
+  public:
+
+      status_t read(char const *filename, int const echo=0); // declaration only
+
+      int64_t scf_iteration() const { return scf_iteration_; }
+
+      size_t bytes(char const *name) const; // 0 if missing, declaration only
+
+      // copy a record into data, fails unless the record has exactly the expected number of bytes
+      status_t get(char const *name, void *data, size_t const bytes, int const echo=0) const; // declaration only
+
+      template <typename T>
+      status_t get(char const *name, std::vector<T> & v, int const echo=0) const {
+          v.resize(bytes(name)/sizeof(T));
+          return get(name, v.data(), v.size()*sizeof(T), echo);
+      } // get
+
+  private:
+      std::vector<record_t> records_;
+      int64_t scf_iteration_{-1};
+  }; // class reader_t
+
+  status_t all_tests(int const echo=0); // declaration only
+
+} // namespace scf_checkpoint
@@ -4,6 +4,7 @@
 #include <cstdio> // std::printf
 #include <cstdint> // uint32_t
 #include <complex> // std::real
+#include <vector> // std::vector<T>
 
 #include "status.hxx" // status_t
 
@@ -13,6 +14,7 @@
 #include "inline_math.hxx" // pow3, factorial<T>
 #include "constants.hxx" // ::sqrtpi
 #include "sho_unitary.hxx" // Unitary_SHO_Transform
+#include "data_view.hxx" // view2D<T>
 
 
 namespace sho_projection {
@@ -22,7 +24,105 @@ namespace sho_projection {
   template <typename real_t>
   inline real_t truncation_radius(real_t const sigma, int const numax=-1) { return 9*sigma; }
 
-  template <typename complex_t, int PROJECT0_OR_ADD1> inline
+  template <typename complex_t, int PROJECT0_OR_ADD1, typename xtable_t, typename real_t> inline
+  void _sho_sum_factorized(
+        complex_t coeff[] // result if projecting (accumulated), coefficients are zyx-ordered
+      , int const numax // how many
+      , complex_t values[] // grid array, result if adding
+      , real_space::grid_t const &g // grid descriptor, assume that g is a Cartesian grid
+      , int const off[3] // lower corner of the rectangular sub-domain
+      , int const num[3] // extent of the rectangular sub-domain
+      , xtable_t const h1d_x[] // [num[0]*M] 1D functions in x-direction, may carry phase factors
+      , real_t const h1d_y[] // [num[1]*M] 1D functions in y-direction
+      , real_t const h1d_z[] // [num[2]*M] 1D functions in z-direction
+  ) {
+      int const M = sho_tools::n1HO(numax);
+      int const nSHO = sho_tools::nSHO(numax);
+      // the basis functions are products of 1D functions, so we contract one direction after the other
+      // t1[iz][iy][mx] and t2[iz][my][mx] hold the partially transformed quantities
+      std::vector<complex_t> t1(size_t(num[2])*num[1]*M, complex_t(0)), t2(size_t(num[2])*M*M, complex_t(0));
+      if (0 == PROJECT0_OR_ADD1) {
+          for (        int iz = 0; iz < num[2]; ++iz) {
+              for (    int iy = 0; iy < num[1]; ++iy) {
+                  auto const row = &values[((iz + off[2])*g('y') + (iy + off[1]))*g('x') + off[0]];
+                  auto const t = &t1[(iz*num[1] + iy)*M];
+                  for (int ix = 0; ix < num[0]; ++ix) {
+                      auto const val = row[ix]; // load
+                      auto const hx = &h1d_x[ix*M];
+                      for (int mx = 0; mx <= numax; ++mx) {
+                          t[mx] += val * hx[mx]; // contract x
+                      } // mx
+                  } // ix
+              } // iy
+          } // iz
+          for (        int iz = 0; iz < num[2]; ++iz) {
+              for (    int iy = 0; iy < num[1]; ++iy) {
+                  auto const t = &t1[(iz*num[1] + iy)*M];
+                  for (int my = 0; my <= numax; ++my) {                 auto const H1d_y = h1d_y[iy*M + my];
+                      auto const tt = &t2[(iz*M + my)*M];
+                      for (int mx = 0; mx <= numax - my; ++mx) {
+                          tt[mx] += t[mx] * H1d_y; // contract y
+                      } // mx
+                  } // my
+              } // iy
+          } // iz
+          int iSHO{0};
+          for (int mz = 0; mz <= numax; ++mz) {
+              for (int my = 0; my <= numax - mz; ++my) {
+                  for (int mx = 0; mx <= numax - mz - my; ++mx) {
+                      complex_t c(0);
+                      for (int iz = 0; iz < num[2]; ++iz) {
+                          c += t2[(iz*M + my)*M + mx] * h1d_z[iz*M + mz]; // contract z
+                      } // iz
+                      coeff[iSHO] += c; // here, the projection happens
+                      ++iSHO; // in sho_tools::zyx_order
+                  } // mx
+              } // my
+          } // mz
+          assert( nSHO == iSHO );
+      } else {
+          for (int iz = 0; iz < num[2]; ++iz) {
+              int iSHO{0};
+              for (int mz = 0; mz <= numax; ++mz) {                    auto const H1d_z = h1d_z[iz*M + mz];
+                  for (int my = 0; my <= numax - mz; ++my) {
+                      auto const tt = &t2[(iz*M + my)*M];
+                      for (int mx = 0; mx <= numax - mz - my; ++mx) {
+                          tt[mx] += coeff[iSHO] * H1d_z; // expand z
+                          ++iSHO; // in sho_tools::zyx_order
+                      } // mx
+                  } // my
+              } // mz
+              assert( nSHO == iSHO );
+          } // iz
+          for (        int iz = 0; iz < num[2]; ++iz) {
+              for (    int iy = 0; iy < num[1]; ++iy) {
+                  auto const t = &t1[(iz*num[1] + iy)*M];
+                  for (int my = 0; my <= numax; ++my) {                 auto const H1d_y = h1d_y[iy*M + my];
+                      auto const tt = &t2[(iz*M + my)*M];
+                      for (int mx = 0; mx <= numax - my; ++mx) {
+                          t[mx] += tt[mx] * H1d_y; // expand y
+                      } // mx
+                  } // my
+              } // iy
+          } // iz
+          for (        int iz = 0; iz < num[2]; ++iz) {
+              for (    int iy = 0; iy < num[1]; ++iy) {
+                  auto const row = &values[((iz + off[2])*g('y') + (iy + off[1]))*g('x') + off[0]];
+                  auto const t = &t1[(iz*num[1] + iy)*M];
+                  for (int ix = 0; ix < num[0]; ++ix) {
+                      auto const hx = &h1d_x[ix*M];
+                      complex_t val(0);
+                      for (int mx = 0; mx <= numax; ++mx) {
+                          val += t[mx] * hx[mx]; // expand x
+                      } // mx
+                      row[ix] += val; // here, the addition happens
+                  } // ix
+              } // iy
+          } // iz
+      } // PROJECT0_OR_ADD1
+  } // _sho_sum_factorized
+
+  template <typename complex_t, int PROJECT0_OR_ADD1, bool SumFactorized=true> inline
   status_t _sho_project_or_add(
         complex_t coeff[] // result if projecting, coefficients are zyx-ordered
       , int const numax // how many
@@ -98,40 +198,46 @@ namespace sho_projection {
       } // ADD
 #endif // DEVEL
 
-      for (        int iz = 0; iz < num[2]; ++iz) {
-          for (    int iy = 0; iy < num[1]; ++iy) {
-              for (int ix = 0; ix < num[0]; ++ix) {
-                  int const ixyz = ((iz + off[2])*g('y') + (iy + off[1]))*g('x') + (ix + off[0]);
-
-                  complex_t val(0);
-                  if (0 == PROJECT0_OR_ADD1) {
-                      val = values[ixyz]; // load
-                  } // project
-                  if (true) {
-//                    if (echo > 6) std::printf("%g %g\n", std::sqrt(vz*vz + vy*vy + vx*vx), val); // plot function value vs r
-                      int iSHO{0};
-                      for (int nz = 0; nz <= numax; ++nz) {                    auto const H1d_z = H1d[2][iz*M + nz];
-                          for (int ny = 0; ny <= numax - nz; ++ny) {           auto const H1d_y = H1d[1][iy*M + ny];
-                              for (int nx = 0; nx <= numax - nz - ny; ++nx) {  auto const H1d_x = H1d[0][ix*M + nx];
-                                  auto const H3d = H1d_z * H1d_y * H1d_x;
-                                  if (1 == PROJECT0_OR_ADD1) {
-                                      val += coeff[iSHO] * H3d; // here, the addition happens
-                                  } else {
-                                      coeff[iSHO] += val * H3d; // here, the projection happens
-                                  }
-                                  ++iSHO; // in sho_tools::zyx_order
-                              } // nx
-                          } // ny
-                      } // nz
-                      assert( nSHO == iSHO );
-                  } // true
-                  if (1 == PROJECT0_OR_ADD1) {
-                      values[ixyz] += val; // load-modify-store, must be atomic if threads are involved
-                  } // write back (add)
-
-              } // ix
-          } // iy
-      } // iz
+      if (SumFactorized) {
+          _sho_sum_factorized<complex_t,PROJECT0_OR_ADD1>(coeff, numax, values, g, off, num, H1d[0].data(), H1d[1].data(), H1d[2].data());
+      } else { // SumFactorized
+          // reference implementation: evaluate the full 3D basis function at each grid point
+          for (        int iz = 0; iz < num[2]; ++iz) {
+              for (    int iy = 0; iy < num[1]; ++iy) {
+                  for (int ix = 0; ix < num[0]; ++ix) {
+                      int const ixyz = ((iz + off[2])*g('y') + (iy + off[1]))*g('x') + (ix + off[0]);
+
+                      complex_t val(0);
+                      if (0 == PROJECT0_OR_ADD1) {
+                          val = values[ixyz]; // load
+                      } // project
+                      if (true) {
+    //                    if (echo > 6) std::printf("%g %g\n", std::sqrt(vz*vz + vy*vy + vx*vx), val); // plot function value vs r
+                          int iSHO{0};
+                          for (int nz = 0; nz <= numax; ++nz) {                    auto const H1d_z = H1d[2][iz*M + nz];
+                              for (int ny = 0; ny <= numax - nz; ++ny) {           auto const H1d_y = H1d[1][iy*M + ny];
+                                  for (int nx = 0; nx <= numax - nz - ny; ++nx) {  auto const H1d_x = H1d[0][ix*M + nx];
+                                      auto const H3d = H1d_z * H1d_y * H1d_x;
+                                      if (1 == PROJECT0_OR_ADD1) {
+                                          val += coeff[iSHO] * H3d; // here, the addition happens
+                                      } else {
+                                          coeff[iSHO] += val * H3d; // here, the projection happens
+                                      }
+                                      ++iSHO; // in sho_tools::zyx_order
+                                  } // nx
+                              } // ny
+                          } // nz
+                          assert( nSHO == iSHO );
+                      } // true
+                      if (1 == PROJECT0_OR_ADD1) {
+                          values[ixyz] += val; // load-modify-store, must be atomic if threads are involved
+                      } // write back (add)
+
+                  } // ix
+              } // iy
+          } // iz
+
+      } // SumFactorized
 
       if (0 == PROJECT0_OR_ADD1) scale(coeff, nSHO, complex_t(g.dV())); // volume element of the grid
 
@@ -151,6 +257,114 @@ namespace sho_projection {
   } // _sho_project_or_add
 
 
+  template <typename table_t, typename real_t> inline
+  void _add_Gauss_Hermite_table(
+        table_t h1d[] // [num*M] 1D table, result is accumulated
+      , int const off // grid index of the first table row
+      , int const image_off // first grid index covered by this image
+      , int const image_end // end of the grid index range covered by this image
+      , double const grid_spacing
+      , double const center // image position in this direction
+      , double const sigma_inv
+      , int const numax
+      , table_t const factor // e.g. a phase factor
+  ) {
+      int const M = sho_tools::n1HO(numax);
+      std::vector<real_t> h1(M);
+      for (int ix = image_off; ix < image_end; ++ix) {
+          real_t const x = (ix*grid_spacing - center)*sigma_inv;
+          Gauss_Hermite_polynomials(h1.data(), x, numax);
+          add_product(&h1d[(ix - off)*M], M, h1.data(), factor);
+      } // ix
+  } // _add_Gauss_Hermite_table
+
+  template <typename complex_t, int PROJECT0_OR_ADD1, typename xtable_t> inline
+  status_t _sho_project_or_add_images(
+        complex_t coeff[] // result if projecting, coefficients are zyx-ordered
+      , int const numax // how many
+      , double const center[3] // where
+      , double const sigma
+      , complex_t values[] // grid array, result if adding
+      , real_space::grid_t const &g // grid descriptor, assume that g is a Cartesian grid
+      , int const n_images // number of periodic images
+      , view2D<double> const & image_shifts // [n_images][4] shifts of the periodic images w.r.t. center
+      , xtable_t const phase[]=nullptr // [n_images] optional phase factors, e.g. Bloch phases
+      , int const echo=0 // log-level
+  ) {
+      // Images with the same y- and z-shift share their y- and z-tables. Their x-tables, multiplied
+      // by the phase factors, are summed up into a single table over the union of the x-windows,
+      // so each group of images is treated with one sum-factorized sweep. Images whose window
+      // does not overlap with the grid are skipped before any table is computed.
+      using real_t = decltype(std::real(complex_t(1))); // base type
+
+      auto const rcut = truncation_radius(sigma, numax);
+      assert(sigma > 0);
+      double const sigma_inv = 1./sigma;
+      int const nSHO = sho_tools::nSHO(numax);
+      int const M = sho_tools::n1HO(numax);
+      if (0 == PROJECT0_OR_ADD1) set(coeff, nSHO, complex_t(0));
+
+      view2D<int> window(n_images, 8, 0); // [off[3], end[3], -, -] per image
+      std::vector<int> group_leader, group(n_images, -1);
+      int n_skipped{0};
+      for (int ii = 0; ii < n_images; ++ii) {
+          bool empty{false};
+          for (int d = 0; d < 3; ++d) {
+              double const c = center[d] + image_shifts(ii,d);
+              window(ii,d)     = std::max(int(std::ceil((c - rcut)*g.inv_h[d])), 0);
+              window(ii,d + 3) = std::min(int(std::ceil((c + rcut)*g.inv_h[d])), g[d]);
+              empty = empty || (window(ii,d + 3) <= window(ii,d));
+          } // d
+          if (empty) {
+              ++n_skipped;
+          } else {
+              int ig{0};
+              while (ig < int(group_leader.size()) && (image_shifts(group_leader[ig],1) != image_shifts(ii,1) ||
+                                                       image_shifts(group_leader[ig],2) != image_shifts(ii,2))) ++ig;
+              if (int(group_leader.size()) == ig) group_leader.push_back(ii); // start a new group
+              group[ii] = ig;
+          } // empty
+      } // ii
+      int const n_groups = group_leader.size();
+      if (echo > 5) std::printf("# %s %d of %d images in %d groups, %d images skipped\n", (0 == PROJECT0_OR_ADD1)?"project":"add",
+                                  n_images - n_skipped, n_images, n_groups, n_skipped);
+
+      for (int ig = 0; ig < n_groups; ++ig) {
+          int const il = group_leader[ig];
+          int off[3], end[3], num[3];
+          for (int d = 0; d < 3; ++d) {
+              off[d] = window(il,d);
+              end[d] = window(il,d + 3);
+          } // d
+          for (int ii = il; ii < n_images; ++ii) {
+              if (ig == group[ii]) {
+                  off[0] = std::min(off[0], window(ii,0)); // union of the x-windows
+                  end[0] = std::max(end[0], window(ii,3));
+              } // in group
+          } // ii
+          for (int d = 0; d < 3; ++d) {
+              num[d] = end[d] - off[d];
+          } // d
+
+          std::vector<xtable_t> hx(num[0]*M, xtable_t(0));
+          for (int ii = il; ii < n_images; ++ii) {
+              if (ig == group[ii]) {
+                  xtable_t const factor = phase ? phase[ii] : xtable_t(1);
+                  _add_Gauss_Hermite_table<xtable_t,real_t>(hx.data(), off[0], window(ii,0), window(ii,3),
+                                  g.h[0], center[0] + image_shifts(ii,0), sigma_inv, numax, factor);
+              } // in group
+          } // ii
+          std::vector<real_t> hy(num[1]*M, real_t(0)), hz(num[2]*M, real_t(0));
+          _add_Gauss_Hermite_table<real_t,real_t>(hy.data(), off[1], off[1], end[1], g.h[1], center[1] + image_shifts(il,1), sigma_inv, numax, 1);
+          _add_Gauss_Hermite_table<real_t,real_t>(hz.data(), off[2], off[2], end[2], g.h[2], center[2] + image_shifts(il,2), sigma_inv, numax, 1);
+
+          _sho_sum_factorized<complex_t,PROJECT0_OR_ADD1>(coeff, numax, values, g, off, num, hx.data(), hy.data(), hz.data());
+      } // ig
+
+      if (0 == PROJECT0_OR_ADD1) scale(coeff, nSHO, complex_t(g.dV())); // volume element of the grid
+      return 0; // success
+  } // _sho_project_or_add_images
+
   template <typename complex_t>
   status_t sho_project( // wrapper function
         complex_t coeff[] // result, coefficients are zyx-ordered
@@ -177,6 +391,42 @@ namespace sho_projection {
       return _sho_project_or_add<complex_t,1>((complex_t*)coeff, numax, center, sigma, values, g, echo); // un-const coeff pointer
   } // sho_add
 
+  template <typename complex_t>
+  status_t sho_project_images( // wrapper function
+        complex_t coeff[] // result, sum over all images, coefficients are zyx-ordered
+      , int const numax // SHO basis size
+      , double const center[3] // where
+      , double const sigma // SHO basis spread
+      , complex_t const values[] // input, grid array
+      , real_space::grid_t const &g // grid descriptor, assume that g is a Cartesian grid
+      , int const n_images // number of periodic images
+      , view2D<double> const & image_shifts // [n_images][4] shifts of the periodic images w.r.t. center
+      , complex_t const phase[]=nullptr // [n_images] optional phase factors applied to each image projection
+      , int const echo=0 // log-level
+  ) {
+      if (phase) return _sho_project_or_add_images<complex_t,0,complex_t>(coeff, numax, center, sigma, (complex_t*)values, g, n_images, image_shifts, phase, echo);
+      using real_t = decltype(std::real(complex_t(1))); // no phases, use real 1D tables
+      return _sho_project_or_add_images<complex_t,0,real_t>(coeff, numax, center, sigma, (complex_t*)values, g, n_images, image_shifts, nullptr, echo);
+  } // sho_project_images
+
+  template <typename complex_t>
+  status_t sho_add_images( // wrapper function
+        complex_t values[] // result gets modified, grid array
+      , real_space::grid_t const &g // grid descriptor, assume that g is a Cartesian grid
+      , complex_t const coeff[] // input, coefficients are zyx-ordered
+      , int const numax // SHO basis size
+      , double const center[3] // where
+      , double const sigma // SHO basis spread
+      , int const n_images // number of periodic images
+      , view2D<double> const & image_shifts // [n_images][4] shifts of the periodic images w.r.t. center
+      , complex_t const phase[]=nullptr // [n_images] optional phase factors applied to the coefficients of each image
+      , int const echo=0 // log-level
+  ) {
+      if (phase) return _sho_project_or_add_images<complex_t,1,complex_t>((complex_t*)coeff, numax, center, sigma, values, g, n_images, image_shifts, phase, echo);
+      using real_t = decltype(std::real(complex_t(1))); // no phases, use real 1D tables
+      return _sho_project_or_add_images<complex_t,1,real_t>((complex_t*)coeff, numax, center, sigma, values, g, n_images, image_shifts, nullptr, echo);
+  } // sho_add_images
+
 
   inline double sho_1D_prefactor(int const nu, double const sigma) {
       return std::sqrt( ( 1 << nu ) / ( constants::sqrtpi * sigma * factorial(nu) ) ); // 1 << nu == 2^nu
@@ -42,6 +42,9 @@ namespace sho_unitary {
 
   }; // class Unitary_SHO_Transform
 
+  // read-only instance up to the largest compiled-in nu, constructed at first use, can be shared between threads
+  Unitary_SHO_Transform const & get_shared(); // declaration only
+
   status_t all_tests(int const echo=0); // declaration only
 
 } // namespace sho_unitary
@@ -0,0 +1,1730 @@
+#pragma once
+// This file is part of AngstromCube under MIT License
+
+#include <stdint.h> // int8_t, int32_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // Matrix elements of the unitary transform from Cartesian to radial SHO states up to nu=9,
+  // the same entries as data/sho_unitary.dat, compiled in to avoid reading the file at startup.
+  // Each matrix element is sign(nom)*sqrt(|nom|/den), only non-zero entries are listed in nu-order.
+
+  typedef struct {
+      int8_t nx, ny, nz, ell, emm, nrn; // Cartesian and radial quantum numbers
+      int32_t nom, den; // the entry is sign(nom)*sqrt(|nom|/den)
+  } sho_unitary_entry_t;
+
+  int const sho_unitary_table_numax = 9;
+
+  int const sho_unitary_table_size = 1692;
+
+  sho_unitary_entry_t const sho_unitary_table[] = {
+    // nu=0
+    {0,0,0, 0, 0,0, 1, 1},
+    // nu=1
+    {1,0,0, 1,-1,0, 1, 1},
+    {0,1,0, 1, 1,0, 1, 1},
+    {0,0,1, 1, 0,0, 1, 1},
+    // nu=2
+    {2,0,0, 0, 0,1, -2, 6},
+    {2,0,0, 2,-2,0, 3, 6},
+    {2,0,0, 2, 0,0, -1, 6},
+    {1,1,0, 2, 2,0, 6, 6},
+    {0,2,0, 0, 0,1, -2, 6},
+    {0,2,0, 2,-2,0, -3, 6},
+    {0,2,0, 2, 0,0, -1, 6},
+    {1,0,1, 2,-1,0, 6, 6},
+    {0,1,1, 2, 1,0, 6, 6},
+    {0,0,2, 0, 0,1, -2, 6},
+    {0,0,2, 2, 0,0, 4, 6},
+    // nu=3
+    {3,0,0, 1,-1,1, -12, 20},
+    {3,0,0, 3,-3,0, 5, 20},
+    {3,0,0, 3,-1,0, -3, 20},
+    {2,1,0, 1, 1,1, -4, 20},
+    {2,1,0, 3, 1,0, -1, 20},
+    {2,1,0, 3, 3,0, 15, 20},
+    {1,2,0, 1,-1,1, -4, 20},
+    {1,2,0, 3,-3,0, -15, 20},
+    {1,2,0, 3,-1,0, -1, 20},
+    {0,3,0, 1, 1,1, -12, 20},
+    {0,3,0, 3, 1,0, -3, 20},
+    {0,3,0, 3, 3,0, -5, 20},
+    {2,0,1, 1, 0,1, -4, 20},
+    {2,0,1, 3,-2,0, 10, 20},
+    {2,0,1, 3, 0,0, -6, 20},
+    {1,1,1, 3, 2,0, 20, 20},
+    {0,2,1, 1, 0,1, -4, 20},
+    {0,2,1, 3,-2,0, -10, 20},
+    {0,2,1, 3, 0,0, -6, 20},
+    {1,0,2, 1,-1,1, -4, 20},
+    {1,0,2, 3,-1,0, 16, 20},
+    {0,1,2, 1, 1,1, -4, 20},
+    {0,1,2, 3, 1,0, 16, 20},
+    {0,0,3, 1, 0,1, -12, 20},
+    {0,0,3, 3, 0,0, 8, 20},
+    // nu=4
+    {4,0,0, 0, 0,2, 168, 840},
+    {4,0,0, 2,-2,1, -360, 840},
+    {4,0,0, 2, 0,1, 120, 840},
+    {4,0,0, 4,-4,0, 105, 840},
+    {4,0,0, 4,-2,0, -60, 840},
+    {4,0,0, 4, 0,0, 27, 840},
+    {3,1,0, 2, 2,1, -360, 840},
+    {3,1,0, 4, 2,0, -60, 840},
+    {3,1,0, 4, 4,0, 420, 840},
+    {2,2,0, 0, 0,2, 112, 840},
+    {2,2,0, 2, 0,1, 80, 840},
+    {2,2,0, 4,-4,0, -630, 840},
+    {2,2,0, 4, 0,0, 18, 840},
+    {1,3,0, 2, 2,1, -360, 840},
+    {1,3,0, 4, 2,0, -60, 840},
+    {1,3,0, 4, 4,0, -420, 840},
+    {0,4,0, 0, 0,2, 168, 840},
+    {0,4,0, 2,-2,1, 360, 840},
+    {0,4,0, 2, 0,1, 120, 840},
+    {0,4,0, 4,-4,0, 105, 840},
+    {0,4,0, 4,-2,0, 60, 840},
+    {0,4,0, 4, 0,0, 27, 840},
+    {3,0,1, 2,-1,1, -360, 840},
+    {3,0,1, 4,-3,0, 210, 840},
+    {3,0,1, 4,-1,0, -270, 840},
+    {2,1,1, 2, 1,1, -120, 840},
+    {2,1,1, 4, 1,0, -90, 840},
+    {2,1,1, 4, 3,0, 630, 840},
+    {1,2,1, 2,-1,1, -120, 840},
+    {1,2,1, 4,-3,0, -630, 840},
+    {1,2,1, 4,-1,0, -90, 840},
+    {0,3,1, 2, 1,1, -360, 840},
+    {0,3,1, 4, 1,0, -270, 840},
+    {0,3,1, 4, 3,0, -210, 840},
+    {2,0,2, 0, 0,2, 112, 840},
+    {2,0,2, 2,-2,1, -60, 840},
+    {2,0,2, 2, 0,1, -20, 840},
+    {2,0,2, 4,-2,0, 360, 840},
+    {2,0,2, 4, 0,0, -288, 840},
+    {1,1,2, 2, 2,1, -120, 840},
+    {1,1,2, 4, 2,0, 720, 840},
+    {0,2,2, 0, 0,2, 112, 840},
+    {0,2,2, 2,-2,1, 60, 840},
+    {0,2,2, 2, 0,1, -20, 840},
+    {0,2,2, 4,-2,0, -360, 840},
+    {0,2,2, 4, 0,0, -288, 840},
+    {1,0,3, 2,-1,1, -360, 840},
+    {1,0,3, 4,-1,0, 480, 840},
+    {0,1,3, 2, 1,1, -360, 840},
+    {0,1,3, 4, 1,0, 480, 840},
+    {0,0,4, 0, 0,2, 168, 840},
+    {0,0,4, 2, 0,1, -480, 840},
+    {0,0,4, 4, 0,0, 192, 840},
+    // nu=5
+    {5,0,0, 1,-1,2, 2160, 5040},
+    {5,0,0, 3,-3,1, -1400, 5040},
+    {5,0,0, 3,-1,1, 840, 5040},
+    {5,0,0, 5,-5,0, 315, 5040},
+    {5,0,0, 5,-3,0, -175, 5040},
+    {5,0,0, 5,-1,0, 150, 5040},
+    {4,1,0, 1, 1,2, 432, 5040},
+    {4,1,0, 3, 1,1, 168, 5040},
+    {4,1,0, 3, 3,1, -2520, 5040},
+    {4,1,0, 5, 1,0, 30, 5040},
+    {4,1,0, 5, 3,0, -315, 5040},
+    {4,1,0, 5, 5,0, 1575, 5040},
+    {3,2,0, 1,-1,2, 864, 5040},
+    {3,2,0, 3,-3,1, 560, 5040},
+    {3,2,0, 3,-1,1, 336, 5040},
+    {3,2,0, 5,-5,0, -3150, 5040},
+    {3,2,0, 5,-3,0, 70, 5040},
+    {3,2,0, 5,-1,0, 60, 5040},
+    {2,3,0, 1, 1,2, 864, 5040},
+    {2,3,0, 3, 1,1, 336, 5040},
+    {2,3,0, 3, 3,1, -560, 5040},
+    {2,3,0, 5, 1,0, 60, 5040},
+    {2,3,0, 5, 3,0, -70, 5040},
+    {2,3,0, 5, 5,0, -3150, 5040},
+    {1,4,0, 1,-1,2, 432, 5040},
+    {1,4,0, 3,-3,1, 2520, 5040},
+    {1,4,0, 3,-1,1, 168, 5040},
+    {1,4,0, 5,-5,0, 1575, 5040},
+    {1,4,0, 5,-3,0, 315, 5040},
+    {1,4,0, 5,-1,0, 30, 5040},
+    {0,5,0, 1, 1,2, 2160, 5040},
+    {0,5,0, 3, 1,1, 840, 5040},
+    {0,5,0, 3, 3,1, 1400, 5040},
+    {0,5,0, 5, 1,0, 150, 5040},
+    {0,5,0, 5, 3,0, 175, 5040},
+    {0,5,0, 5, 5,0, 315, 5040},
+    {4,0,1, 1, 0,2, 432, 5040},
+    {4,0,1, 3,-2,1, -1680, 5040},
+    {4,0,1, 3, 0,1, 1008, 5040},
+    {4,0,1, 5,-4,0, 630, 5040},
+    {4,0,1, 5,-2,0, -840, 5040},
+    {4,0,1, 5, 0,0, 450, 5040},
+    {3,1,1, 3, 2,1, -1680, 5040},
+    {3,1,1, 5, 2,0, -840, 5040},
+    {3,1,1, 5, 4,0, 2520, 5040},
+    {2,2,1, 1, 0,2, 288, 5040},
+    {2,2,1, 3, 0,1, 672, 5040},
+    {2,2,1, 5,-4,0, -3780, 5040},
+    {2,2,1, 5, 0,0, 300, 5040},
+    {1,3,1, 3, 2,1, -1680, 5040},
+    {1,3,1, 5, 2,0, -840, 5040},
+    {1,3,1, 5, 4,0, -2520, 5040},
+    {0,4,1, 1, 0,2, 432, 5040},
+    {0,4,1, 3,-2,1, 1680, 5040},
+    {0,4,1, 3, 0,1, 1008, 5040},
+    {0,4,1, 5,-4,0, 630, 5040},
+    {0,4,1, 5,-2,0, 840, 5040},
+    {0,4,1, 5, 0,0, 450, 5040},
+    {3,0,2, 1,-1,2, 864, 5040},
+    {3,0,2, 3,-3,1, -140, 5040},
+    {3,0,2, 3,-1,1, -756, 5040},
+    {3,0,2, 5,-3,0, 1120, 5040},
+    {3,0,2, 5,-1,0, -2160, 5040},
+    {2,1,2, 1, 1,2, 288, 5040},
+    {2,1,2, 3, 1,1, -252, 5040},
+    {2,1,2, 3, 3,1, -420, 5040},
+    {2,1,2, 5, 1,0, -720, 5040},
+    {2,1,2, 5, 3,0, 3360, 5040},
+    {1,2,2, 1,-1,2, 288, 5040},
+    {1,2,2, 3,-3,1, 420, 5040},
+    {1,2,2, 3,-1,1, -252, 5040},
+    {1,2,2, 5,-3,0, -3360, 5040},
+    {1,2,2, 5,-1,0, -720, 5040},
+    {0,3,2, 1, 1,2, 864, 5040},
+    {0,3,2, 3, 1,1, -756, 5040},
+    {0,3,2, 3, 3,1, 140, 5040},
+    {0,3,2, 5, 1,0, -2160, 5040},
+    {0,3,2, 5, 3,0, -1120, 5040},
+    {2,0,3, 1, 0,2, 864, 5040},
+    {2,0,3, 3,-2,1, -840, 5040},
+    {2,0,3, 3, 0,1, 56, 5040},
+    {2,0,3, 5,-2,0, 1680, 5040},
+    {2,0,3, 5, 0,0, -1600, 5040},
+    {1,1,3, 3, 2,1, -1680, 5040},
+    {1,1,3, 5, 2,0, 3360, 5040},
+    {0,2,3, 1, 0,2, 864, 5040},
+    {0,2,3, 3,-2,1, 840, 5040},
+    {0,2,3, 3, 0,1, 56, 5040},
+    {0,2,3, 5,-2,0, -1680, 5040},
+    {0,2,3, 5, 0,0, -1600, 5040},
+    {1,0,4, 1,-1,2, 432, 5040},
+    {1,0,4, 3,-1,1, -2688, 5040},
+    {1,0,4, 5,-1,0, 1920, 5040},
+    {0,1,4, 1, 1,2, 432, 5040},
+    {0,1,4, 3, 1,1, -2688, 5040},
+    {0,1,4, 5, 1,0, 1920, 5040},
+    {0,0,5, 1, 0,2, 2160, 5040},
+    {0,0,5, 3, 0,1, -2240, 5040},
+    {0,0,5, 5, 0,0, 640, 5040},
+    // nu=6
+    {6,0,0, 0, 0,3, -5280, 36960},
+    {6,0,0, 2,-2,2, 13200, 36960},
+    {6,0,0, 2, 0,2, -4400, 36960},
+    {6,0,0, 4,-4,1, -6300, 36960},
+    {6,0,0, 4,-2,1, 3600, 36960},
+    {6,0,0, 4, 0,1, -1620, 36960},
+    {6,0,0, 6,-6,0, 1155, 36960},
+    {6,0,0, 6,-4,0, -630, 36960},
+    {6,0,0, 6,-2,0, 525, 36960},
+    {6,0,0, 6, 0,0, -250, 36960},
+    {5,1,0, 2, 2,2, 8800, 36960},
+    {5,1,0, 4, 2,1, 2400, 36960},
+    {5,1,0, 4, 4,1, -16800, 36960},
+    {5,1,0, 6, 2,0, 350, 36960},
+    {5,1,0, 6, 4,0, -1680, 36960},
+    {5,1,0, 6, 6,0, 6930, 36960},
+    {4,2,0, 0, 0,3, -3168, 36960},
+    {4,2,0, 2,-2,2, 880, 36960},
+    {4,2,0, 2, 0,2, -2640, 36960},
+    {4,2,0, 4,-4,1, 10500, 36960},
+    {4,2,0, 4,-2,1, 240, 36960},
+    {4,2,0, 4, 0,1, -972, 36960},
+    {4,2,0, 6,-6,0, -17325, 36960},
+    {4,2,0, 6,-4,0, 1050, 36960},
+    {4,2,0, 6,-2,0, 35, 36960},
+    {4,2,0, 6, 0,0, -150, 36960},
+    {3,3,0, 2, 2,2, 10560, 36960},
+    {3,3,0, 4, 2,1, 2880, 36960},
+    {3,3,0, 6, 2,0, 420, 36960},
+    {3,3,0, 6, 6,0, -23100, 36960},
+    {2,4,0, 0, 0,3, -3168, 36960},
+    {2,4,0, 2,-2,2, -880, 36960},
+    {2,4,0, 2, 0,2, -2640, 36960},
+    {2,4,0, 4,-4,1, 10500, 36960},
+    {2,4,0, 4,-2,1, -240, 36960},
+    {2,4,0, 4, 0,1, -972, 36960},
+    {2,4,0, 6,-6,0, 17325, 36960},
+    {2,4,0, 6,-4,0, 1050, 36960},
+    {2,4,0, 6,-2,0, -35, 36960},
+    {2,4,0, 6, 0,0, -150, 36960},
+    {1,5,0, 2, 2,2, 8800, 36960},
+    {1,5,0, 4, 2,1, 2400, 36960},
+    {1,5,0, 4, 4,1, 16800, 36960},
+    {1,5,0, 6, 2,0, 350, 36960},
+    {1,5,0, 6, 4,0, 1680, 36960},
+    {1,5,0, 6, 6,0, 6930, 36960},
+    {0,6,0, 0, 0,3, -5280, 36960},
+    {0,6,0, 2,-2,2, -13200, 36960},
+    {0,6,0, 2, 0,2, -4400, 36960},
+    {0,6,0, 4,-4,1, -6300, 36960},
+    {0,6,0, 4,-2,1, -3600, 36960},
+    {0,6,0, 4, 0,1, -1620, 36960},
+    {0,6,0, 6,-6,0, -1155, 36960},
+    {0,6,0, 6,-4,0, -630, 36960},
+    {0,6,0, 6,-2,0, -525, 36960},
+    {0,6,0, 6, 0,0, -250, 36960},
+    {5,0,1, 2,-1,2, 8800, 36960},
+    {5,0,1, 4,-3,1, -8400, 36960},
+    {5,0,1, 4,-1,1, 10800, 36960},
+    {5,0,1, 6,-5,0, 2310, 36960},
+    {5,0,1, 6,-3,0, -3150, 36960},
+    {5,0,1, 6,-1,0, 3500, 36960},
+    {4,1,1, 2, 1,2, 1760, 36960},
+    {4,1,1, 4, 1,1, 2160, 36960},
+    {4,1,1, 4, 3,1, -15120, 36960},
+    {4,1,1, 6, 1,0, 700, 36960},
+    {4,1,1, 6, 3,0, -5670, 36960},
+    {4,1,1, 6, 5,0, 11550, 36960},
+    {3,2,1, 2,-1,2, 3520, 36960},
+    {3,2,1, 4,-3,1, 3360, 36960},
+    {3,2,1, 4,-1,1, 4320, 36960},
+    {3,2,1, 6,-5,0, -23100, 36960},
+    {3,2,1, 6,-3,0, 1260, 36960},
+    {3,2,1, 6,-1,0, 1400, 36960},
+    {2,3,1, 2, 1,2, 3520, 36960},
+    {2,3,1, 4, 1,1, 4320, 36960},
+    {2,3,1, 4, 3,1, -3360, 36960},
+    {2,3,1, 6, 1,0, 1400, 36960},
+    {2,3,1, 6, 3,0, -1260, 36960},
+    {2,3,1, 6, 5,0, -23100, 36960},
+    {1,4,1, 2,-1,2, 1760, 36960},
+    {1,4,1, 4,-3,1, 15120, 36960},
+    {1,4,1, 4,-1,1, 2160, 36960},
+    {1,4,1, 6,-5,0, 11550, 36960},
+    {1,4,1, 6,-3,0, 5670, 36960},
+    {1,4,1, 6,-1,0, 700, 36960},
+    {0,5,1, 2, 1,2, 8800, 36960},
+    {0,5,1, 4, 1,1, 10800, 36960},
+    {0,5,1, 4, 3,1, 8400, 36960},
+    {0,5,1, 6, 1,0, 3500, 36960},
+    {0,5,1, 6, 3,0, 3150, 36960},
+    {0,5,1, 6, 5,0, 2310, 36960},
+    {4,0,2, 0, 0,3, -3168, 36960},
+    {4,0,2, 2,-2,2, 3520, 36960},
+    {4,0,2, 4,-4,1, -420, 36960},
+    {4,0,2, 4,-2,1, -6000, 36960},
+    {4,0,2, 4, 0,1, 5292, 36960},
+    {4,0,2, 6,-4,0, 4200, 36960},
+    {4,0,2, 6,-2,0, -8960, 36960},
+    {4,0,2, 6, 0,0, 5400, 36960},
+    {3,1,2, 2, 2,2, 3520, 36960},
+    {3,1,2, 4, 2,1, -6000, 36960},
+    {3,1,2, 4, 4,1, -1680, 36960},
+    {3,1,2, 6, 2,0, -8960, 36960},
+    {3,1,2, 6, 4,0, 16800, 36960},
+    {2,2,2, 0, 0,3, -2112, 36960},
+    {2,2,2, 4,-4,1, 2520, 36960},
+    {2,2,2, 4, 0,1, 3528, 36960},
+    {2,2,2, 6,-4,0, -25200, 36960},
+    {2,2,2, 6, 0,0, 3600, 36960},
+    {1,3,2, 2, 2,2, 3520, 36960},
+    {1,3,2, 4, 2,1, -6000, 36960},
+    {1,3,2, 4, 4,1, 1680, 36960},
+    {1,3,2, 6, 2,0, -8960, 36960},
+    {1,3,2, 6, 4,0, -16800, 36960},
+    {0,4,2, 0, 0,3, -3168, 36960},
+    {0,4,2, 2,-2,2, -3520, 36960},
+    {0,4,2, 4,-4,1, -420, 36960},
+    {0,4,2, 4,-2,1, 6000, 36960},
+    {0,4,2, 4, 0,1, 5292, 36960},
+    {0,4,2, 6,-4,0, 4200, 36960},
+    {0,4,2, 6,-2,0, 8960, 36960},
+    {0,4,2, 6, 0,0, 5400, 36960},
+    {3,0,3, 2,-1,2, 10560, 36960},
+    {3,0,3, 4,-3,1, -2520, 36960},
+    {3,0,3, 4,-1,1, -360, 36960},
+    {3,0,3, 6,-3,0, 6720, 36960},
+    {3,0,3, 6,-1,0, -16800, 36960},
+    {2,1,3, 2, 1,2, 3520, 36960},
+    {2,1,3, 4, 1,1, -120, 36960},
+    {2,1,3, 4, 3,1, -7560, 36960},
+    {2,1,3, 6, 1,0, -5600, 36960},
+    {2,1,3, 6, 3,0, 20160, 36960},
+    {1,2,3, 2,-1,2, 3520, 36960},
+    {1,2,3, 4,-3,1, 7560, 36960},
+    {1,2,3, 4,-1,1, -120, 36960},
+    {1,2,3, 6,-3,0, -20160, 36960},
+    {1,2,3, 6,-1,0, -5600, 36960},
+    {0,3,3, 2, 1,2, 10560, 36960},
+    {0,3,3, 4, 1,1, -360, 36960},
+    {0,3,3, 4, 3,1, 2520, 36960},
+    {0,3,3, 6, 1,0, -16800, 36960},
+    {0,3,3, 6, 3,0, -6720, 36960},
+    {2,0,4, 0, 0,3, -3168, 36960},
+    {2,0,4, 2,-2,2, 880, 36960},
+    {2,0,4, 2, 0,2, 2640, 36960},
+    {2,0,4, 4,-2,1, -8640, 36960},
+    {2,0,4, 4, 0,1, 3072, 36960},
+    {2,0,4, 6,-2,0, 8960, 36960},
+    {2,0,4, 6, 0,0, -9600, 36960},
+    {1,1,4, 2, 2,2, 1760, 36960},
+    {1,1,4, 4, 2,1, -17280, 36960},
+    {1,1,4, 6, 2,0, 17920, 36960},
+    {0,2,4, 0, 0,3, -3168, 36960},
+    {0,2,4, 2,-2,2, -880, 36960},
+    {0,2,4, 2, 0,2, 2640, 36960},
+    {0,2,4, 4,-2,1, 8640, 36960},
+    {0,2,4, 4, 0,1, 3072, 36960},
+    {0,2,4, 6,-2,0, -8960, 36960},
+    {0,2,4, 6, 0,0, -9600, 36960},
+    {1,0,5, 2,-1,2, 8800, 36960},
+    {1,0,5, 4,-1,1, -19200, 36960},
+    {1,0,5, 6,-1,0, 8960, 36960},
+    {0,1,5, 2, 1,2, 8800, 36960},
+    {0,1,5, 4, 1,1, -19200, 36960},
+    {0,1,5, 6, 1,0, 8960, 36960},
+    {0,0,6, 0, 0,3, -5280, 36960},
+    {0,0,6, 2, 0,2, 17600, 36960},
+    {0,0,6, 4, 0,1, -11520, 36960},
+    {0,0,6, 6, 0,0, 2560, 36960},
+    // nu=7
+    {7,0,0, 1,-1,3, -960960, 2882880},
+    {7,0,0, 3,-3,2, 764400, 2882880},
+    {7,0,0, 3,-1,2, -458640, 2882880},
+    {7,0,0, 5,-5,1, -291060, 2882880},
+    {7,0,0, 5,-3,1, 161700, 2882880},
+    {7,0,0, 5,-1,1, -138600, 2882880},
+    {7,0,0, 7,-7,0, 45045, 2882880},
+    {7,0,0, 7,-5,0, -24255, 2882880},
+    {7,0,0, 7,-3,0, 19845, 2882880},
+    {7,0,0, 7,-1,0, -18375, 2882880},
+    {6,1,0, 1, 1,3, -137280, 2882880},
+    {6,1,0, 3, 1,2, -65520, 2882880},
+    {6,1,0, 3, 3,2, 982800, 2882880},
+    {6,1,0, 5, 1,1, -19800, 2882880},
+    {6,1,0, 5, 3,1, 207900, 2882880},
+    {6,1,0, 5, 5,1, -1039500, 2882880},
+    {6,1,0, 7, 1,0, -2625, 2882880},
+    {6,1,0, 7, 3,0, 25515, 2882880},
+    {6,1,0, 7, 5,0, -86625, 2882880},
+    {6,1,0, 7, 7,0, 315315, 2882880},
+    {5,2,0, 1,-1,3, -411840, 2882880},
+    {5,2,0, 3,-3,2, -36400, 2882880},
+    {5,2,0, 3,-1,2, -196560, 2882880},
+    {5,2,0, 5,-5,1, 1122660, 2882880},
+    {5,2,0, 5,-3,1, -7700, 2882880},
+    {5,2,0, 5,-1,1, -59400, 2882880},
+    {5,2,0, 7,-7,0, -945945, 2882880},
+    {5,2,0, 7,-5,0, 93555, 2882880},
+    {5,2,0, 7,-3,0, -945, 2882880},
+    {5,2,0, 7,-1,0, -7875, 2882880},
+    {4,3,0, 1, 1,3, -247104, 2882880},
+    {4,3,0, 3, 1,2, -117936, 2882880},
+    {4,3,0, 3, 3,2, 546000, 2882880},
+    {4,3,0, 5, 1,1, -35640, 2882880},
+    {4,3,0, 5, 3,1, 115500, 2882880},
+    {4,3,0, 5, 5,1, 207900, 2882880},
+    {4,3,0, 7, 1,0, -4725, 2882880},
+    {4,3,0, 7, 3,0, 14175, 2882880},
+    {4,3,0, 7, 5,0, 17325, 2882880},
+    {4,3,0, 7, 7,0, -1576575, 2882880},
+    {3,4,0, 1,-1,3, -247104, 2882880},
+    {3,4,0, 3,-3,2, -546000, 2882880},
+    {3,4,0, 3,-1,2, -117936, 2882880},
+    {3,4,0, 5,-5,1, 207900, 2882880},
+    {3,4,0, 5,-3,1, -115500, 2882880},
+    {3,4,0, 5,-1,1, -35640, 2882880},
+    {3,4,0, 7,-7,0, 1576575, 2882880},
+    {3,4,0, 7,-5,0, 17325, 2882880},
+    {3,4,0, 7,-3,0, -14175, 2882880},
+    {3,4,0, 7,-1,0, -4725, 2882880},
+    {2,5,0, 1, 1,3, -411840, 2882880},
+    {2,5,0, 3, 1,2, -196560, 2882880},
+    {2,5,0, 3, 3,2, 36400, 2882880},
+    {2,5,0, 5, 1,1, -59400, 2882880},
+    {2,5,0, 5, 3,1, 7700, 2882880},
+    {2,5,0, 5, 5,1, 1122660, 2882880},
+    {2,5,0, 7, 1,0, -7875, 2882880},
+    {2,5,0, 7, 3,0, 945, 2882880},
+    {2,5,0, 7, 5,0, 93555, 2882880},
+    {2,5,0, 7, 7,0, 945945, 2882880},
+    {1,6,0, 1,-1,3, -137280, 2882880},
+    {1,6,0, 3,-3,2, -982800, 2882880},
+    {1,6,0, 3,-1,2, -65520, 2882880},
+    {1,6,0, 5,-5,1, -1039500, 2882880},
+    {1,6,0, 5,-3,1, -207900, 2882880},
+    {1,6,0, 5,-1,1, -19800, 2882880},
+    {1,6,0, 7,-7,0, -315315, 2882880},
+    {1,6,0, 7,-5,0, -86625, 2882880},
+    {1,6,0, 7,-3,0, -25515, 2882880},
+    {1,6,0, 7,-1,0, -2625, 2882880},
+    {0,7,0, 1, 1,3, -960960, 2882880},
+    {0,7,0, 3, 1,2, -458640, 2882880},
+    {0,7,0, 3, 3,2, -764400, 2882880},
+    {0,7,0, 5, 1,1, -138600, 2882880},
+    {0,7,0, 5, 3,1, -161700, 2882880},
+    {0,7,0, 5, 5,1, -291060, 2882880},
+    {0,7,0, 7, 1,0, -18375, 2882880},
+    {0,7,0, 7, 3,0, -19845, 2882880},
+    {0,7,0, 7, 5,0, -24255, 2882880},
+    {0,7,0, 7, 7,0, -45045, 2882880},
+    {6,0,1, 1, 0,3, -137280, 2882880},
+    {6,0,1, 3,-2,2, 655200, 2882880},
+    {6,0,1, 3, 0,2, -393120, 2882880},
+    {6,0,1, 5,-4,1, -415800, 2882880},
+    {6,0,1, 5,-2,1, 554400, 2882880},
+    {6,0,1, 5, 0,1, -297000, 2882880},
+    {6,0,1, 7,-6,0, 90090, 2882880},
+    {6,0,1, 7,-4,0, -124740, 2882880},
+    {6,0,1, 7,-2,0, 141750, 2882880},
+    {6,0,1, 7, 0,0, -73500, 2882880},
+    {5,1,1, 3, 2,2, 436800, 2882880},
+    {5,1,1, 5, 2,1, 369600, 2882880},
+    {5,1,1, 5, 4,1, -1108800, 2882880},
+    {5,1,1, 7, 2,0, 94500, 2882880},
+    {5,1,1, 7, 4,0, -332640, 2882880},
+    {5,1,1, 7, 6,0, 540540, 2882880},
+    {4,2,1, 1, 0,3, -82368, 2882880},
+    {4,2,1, 3,-2,2, 43680, 2882880},
+    {4,2,1, 3, 0,2, -235872, 2882880},
+    {4,2,1, 5,-4,1, 693000, 2882880},
+    {4,2,1, 5,-2,1, 36960, 2882880},
+    {4,2,1, 5, 0,1, -178200, 2882880},
+    {4,2,1, 7,-6,0, -1351350, 2882880},
+    {4,2,1, 7,-4,0, 207900, 2882880},
+    {4,2,1, 7,-2,0, 9450, 2882880},
+    {4,2,1, 7, 0,0, -44100, 2882880},
+    {3,3,1, 3, 2,2, 524160, 2882880},
+    {3,3,1, 5, 2,1, 443520, 2882880},
+    {3,3,1, 7, 2,0, 113400, 2882880},
+    {3,3,1, 7, 6,0, -1801800, 2882880},
+    {2,4,1, 1, 0,3, -82368, 2882880},
+    {2,4,1, 3,-2,2, -43680, 2882880},
+    {2,4,1, 3, 0,2, -235872, 2882880},
+    {2,4,1, 5,-4,1, 693000, 2882880},
+    {2,4,1, 5,-2,1, -36960, 2882880},
+    {2,4,1, 5, 0,1, -178200, 2882880},
+    {2,4,1, 7,-6,0, 1351350, 2882880},
+    {2,4,1, 7,-4,0, 207900, 2882880},
+    {2,4,1, 7,-2,0, -9450, 2882880},
+    {2,4,1, 7, 0,0, -44100, 2882880},
+    {1,5,1, 3, 2,2, 436800, 2882880},
+    {1,5,1, 5, 2,1, 369600, 2882880},
+    {1,5,1, 5, 4,1, 1108800, 2882880},
+    {1,5,1, 7, 2,0, 94500, 2882880},
+    {1,5,1, 7, 4,0, 332640, 2882880},
+    {1,5,1, 7, 6,0, 540540, 2882880},
+    {0,6,1, 1, 0,3, -137280, 2882880},
+    {0,6,1, 3,-2,2, -655200, 2882880},
+    {0,6,1, 3, 0,2, -393120, 2882880},
+    {0,6,1, 5,-4,1, -415800, 2882880},
+    {0,6,1, 5,-2,1, -554400, 2882880},
+    {0,6,1, 5, 0,1, -297000, 2882880},
+    {0,6,1, 7,-6,0, -90090, 2882880},
+    {0,6,1, 7,-4,0, -124740, 2882880},
+    {0,6,1, 7,-2,0, -141750, 2882880},
+    {0,6,1, 7, 0,0, -73500, 2882880},
+    {5,0,2, 1,-1,3, -411840, 2882880},
+    {5,0,2, 3,-3,2, 145600, 2882880},
+    {5,0,2, 3,-1,2, 87360, 2882880},
+    {5,0,2, 5,-5,1, -13860, 2882880},
+    {5,0,2, 5,-3,1, -377300, 2882880},
+    {5,0,2, 5,-1,1, 798600, 2882880},
+    {5,0,2, 7,-5,0, 166320, 2882880},
+    {5,0,2, 7,-3,0, -378000, 2882880},
+    {5,0,2, 7,-1,0, 504000, 2882880},
+    {4,1,2, 1, 1,3, -82368, 2882880},
+    {4,1,2, 3, 1,2, 17472, 2882880},
+    {4,1,2, 3, 3,2, 262080, 2882880},
+    {4,1,2, 5, 1,1, 159720, 2882880},
+    {4,1,2, 5, 3,1, -679140, 2882880},
+    {4,1,2, 5, 5,1, -69300, 2882880},
+    {4,1,2, 7, 1,0, 100800, 2882880},
+    {4,1,2, 7, 3,0, -680400, 2882880},
+    {4,1,2, 7, 5,0, 831600, 2882880},
+    {3,2,2, 1,-1,3, -164736, 2882880},
+    {3,2,2, 3,-3,2, -58240, 2882880},
+    {3,2,2, 3,-1,2, 34944, 2882880},
+    {3,2,2, 5,-5,1, 138600, 2882880},
+    {3,2,2, 5,-3,1, 150920, 2882880},
+    {3,2,2, 5,-1,1, 319440, 2882880},
+    {3,2,2, 7,-5,0, -1663200, 2882880},
+    {3,2,2, 7,-3,0, 151200, 2882880},
+    {3,2,2, 7,-1,0, 201600, 2882880},
+    {2,3,2, 1, 1,3, -164736, 2882880},
+    {2,3,2, 3, 1,2, 34944, 2882880},
+    {2,3,2, 3, 3,2, 58240, 2882880},
+    {2,3,2, 5, 1,1, 319440, 2882880},
+    {2,3,2, 5, 3,1, -150920, 2882880},
+    {2,3,2, 5, 5,1, 138600, 2882880},
+    {2,3,2, 7, 1,0, 201600, 2882880},
+    {2,3,2, 7, 3,0, -151200, 2882880},
+    {2,3,2, 7, 5,0, -1663200, 2882880},
+    {1,4,2, 1,-1,3, -82368, 2882880},
+    {1,4,2, 3,-3,2, -262080, 2882880},
+    {1,4,2, 3,-1,2, 17472, 2882880},
+    {1,4,2, 5,-5,1, -69300, 2882880},
+    {1,4,2, 5,-3,1, 679140, 2882880},
+    {1,4,2, 5,-1,1, 159720, 2882880},
+    {1,4,2, 7,-5,0, 831600, 2882880},
+    {1,4,2, 7,-3,0, 680400, 2882880},
+    {1,4,2, 7,-1,0, 100800, 2882880},
+    {0,5,2, 1, 1,3, -411840, 2882880},
+    {0,5,2, 3, 1,2, 87360, 2882880},
+    {0,5,2, 3, 3,2, -145600, 2882880},
+    {0,5,2, 5, 1,1, 798600, 2882880},
+    {0,5,2, 5, 3,1, 377300, 2882880},
+    {0,5,2, 5, 5,1, -13860, 2882880},
+    {0,5,2, 7, 1,0, 504000, 2882880},
+    {0,5,2, 7, 3,0, 378000, 2882880},
+    {0,5,2, 7, 5,0, 166320, 2882880},
+    {4,0,3, 1, 0,3, -247104, 2882880},
+    {4,0,3, 3,-2,2, 524160, 2882880},
+    {4,0,3, 3, 0,2, -139776, 2882880},
+    {4,0,3, 5,-4,1, -83160, 2882880},
+    {4,0,3, 5,-2,1, -110880, 2882880},
+    {4,0,3, 5, 0,1, 165000, 2882880},
+    {4,0,3, 7,-4,0, 277200, 2882880},
+    {4,0,3, 7,-2,0, -806400, 2882880},
+    {4,0,3, 7, 0,0, 529200, 2882880},
+    {3,1,3, 3, 2,2, 524160, 2882880},
+    {3,1,3, 5, 2,1, -110880, 2882880},
+    {3,1,3, 5, 4,1, -332640, 2882880},
+    {3,1,3, 7, 2,0, -806400, 2882880},
+    {3,1,3, 7, 4,0, 1108800, 2882880},
+    {2,2,3, 1, 0,3, -164736, 2882880},
+    {2,2,3, 3, 0,2, -93184, 2882880},
+    {2,2,3, 5,-4,1, 498960, 2882880},
+    {2,2,3, 5, 0,1, 110000, 2882880},
+    {2,2,3, 7,-4,0, -1663200, 2882880},
+    {2,2,3, 7, 0,0, 352800, 2882880},
+    {1,3,3, 3, 2,2, 524160, 2882880},
+    {1,3,3, 5, 2,1, -110880, 2882880},
+    {1,3,3, 5, 4,1, 332640, 2882880},
+    {1,3,3, 7, 2,0, -806400, 2882880},
+    {1,3,3, 7, 4,0, -1108800, 2882880},
+    {0,4,3, 1, 0,3, -247104, 2882880},
+    {0,4,3, 3,-2,2, -524160, 2882880},
+    {0,4,3, 3, 0,2, -139776, 2882880},
+    {0,4,3, 5,-4,1, -83160, 2882880},
+    {0,4,3, 5,-2,1, 110880, 2882880},
+    {0,4,3, 5, 0,1, 165000, 2882880},
+    {0,4,3, 7,-4,0, 277200, 2882880},
+    {0,4,3, 7,-2,0, 806400, 2882880},
+    {0,4,3, 7, 0,0, 529200, 2882880},
+    {3,0,4, 1,-1,3, -247104, 2882880},
+    {3,0,4, 3,-3,2, 21840, 2882880},
+    {3,0,4, 3,-1,2, 642096, 2882880},
+    {3,0,4, 5,-3,1, -295680, 2882880},
+    {3,0,4, 5,-1,1, 63360, 2882880},
+    {3,0,4, 7,-3,0, 403200, 2882880},
+    {3,0,4, 7,-1,0, -1209600, 2882880},
+    {2,1,4, 1, 1,3, -82368, 2882880},
+    {2,1,4, 3, 1,2, 214032, 2882880},
+    {2,1,4, 3, 3,2, 65520, 2882880},
+    {2,1,4, 5, 1,1, 21120, 2882880},
+    {2,1,4, 5, 3,1, -887040, 2882880},
+    {2,1,4, 7, 1,0, -403200, 2882880},
+    {2,1,4, 7, 3,0, 1209600, 2882880},
+    {1,2,4, 1,-1,3, -82368, 2882880},
+    {1,2,4, 3,-3,2, -65520, 2882880},
+    {1,2,4, 3,-1,2, 214032, 2882880},
+    {1,2,4, 5,-3,1, 887040, 2882880},
+    {1,2,4, 5,-1,1, 21120, 2882880},
+    {1,2,4, 7,-3,0, -1209600, 2882880},
+    {1,2,4, 7,-1,0, -403200, 2882880},
+    {0,3,4, 1, 1,3, -247104, 2882880},
+    {0,3,4, 3, 1,2, 642096, 2882880},
+    {0,3,4, 3, 3,2, -21840, 2882880},
+    {0,3,4, 5, 1,1, 63360, 2882880},
+    {0,3,4, 5, 3,1, 295680, 2882880},
+    {0,3,4, 7, 1,0, -1209600, 2882880},
+    {0,3,4, 7, 3,0, -403200, 2882880},
+    {2,0,5, 1, 0,3, -411840, 2882880},
+    {2,0,5, 3,-2,2, 218400, 2882880},
+    {2,0,5, 3, 0,2, 14560, 2882880},
+    {2,0,5, 5,-2,1, -739200, 2882880},
+    {2,0,5, 5, 0,1, 450560, 2882880},
+    {2,0,5, 7,-2,0, 483840, 2882880},
+    {2,0,5, 7, 0,0, -564480, 2882880},
+    {1,1,5, 3, 2,2, 436800, 2882880},
+    {1,1,5, 5, 2,1, -1478400, 2882880},
+    {1,1,5, 7, 2,0, 967680, 2882880},
+    {0,2,5, 1, 0,3, -411840, 2882880},
+    {0,2,5, 3,-2,2, -218400, 2882880},
+    {0,2,5, 3, 0,2, 14560, 2882880},
+    {0,2,5, 5,-2,1, 739200, 2882880},
+    {0,2,5, 5, 0,1, 450560, 2882880},
+    {0,2,5, 7,-2,0, -483840, 2882880},
+    {0,2,5, 7, 0,0, -564480, 2882880},
+    {1,0,6, 1,-1,3, -137280, 2882880},
+    {1,0,6, 3,-1,2, 1048320, 2882880},
+    {1,0,6, 5,-1,1, -1267200, 2882880},
+    {1,0,6, 7,-1,0, 430080, 2882880},
+    {0,1,6, 1, 1,3, -137280, 2882880},
+    {0,1,6, 3, 1,2, 1048320, 2882880},
+    {0,1,6, 5, 1,1, -1267200, 2882880},
+    {0,1,6, 7, 1,0, 430080, 2882880},
+    {0,0,7, 1, 0,3, -960960, 2882880},
+    {0,0,7, 3, 0,2, 1223040, 2882880},
+    {0,0,7, 5, 0,1, -591360, 2882880},
+    {0,0,7, 7, 0,0, 107520, 2882880},
+    // nu=8
+    {8,0,0, 0, 0,4, 640640, 5765760},
+    {8,0,0, 2,-2,3, -1747200, 5765760},
+    {8,0,0, 2, 0,3, 582400, 5765760},
+    {8,0,0, 4,-4,2, 1058400, 5765760},
+    {8,0,0, 4,-2,2, -604800, 5765760},
+    {8,0,0, 4, 0,2, 272160, 5765760},
+    {8,0,0, 6,-6,1, -336336, 5765760},
+    {8,0,0, 6,-4,1, 183456, 5765760},
+    {8,0,0, 6,-2,1, -152880, 5765760},
+    {8,0,0, 6, 0,1, 72800, 5765760},
+    {8,0,0, 8,-8,0, 45045, 5765760},
+    {8,0,0, 8,-6,0, -24024, 5765760},
+    {8,0,0, 8,-4,0, 19404, 5765760},
+    {8,0,0, 8,-2,0, -17640, 5765760},
+    {8,0,0, 8, 0,0, 8575, 5765760},
+    {7,1,0, 2, 2,3, -873600, 5765760},
+    {7,1,0, 4, 2,2, -302400, 5765760},
+    {7,1,0, 4, 4,2, 2116800, 5765760},
+    {7,1,0, 6, 2,1, -76440, 5765760},
+    {7,1,0, 6, 4,1, 366912, 5765760},
+    {7,1,0, 6, 6,1, -1513512, 5765760},
+    {7,1,0, 8, 2,0, -8820, 5765760},
+    {7,1,0, 8, 4,0, 38808, 5765760},
+    {7,1,0, 8, 6,0, -108108, 5765760},
+    {7,1,0, 8, 8,0, 360360, 5765760},
+    {6,2,0, 0, 0,4, 366080, 5765760},
+    {6,2,0, 2,-2,3, -249600, 5765760},
+    {6,2,0, 2, 0,3, 332800, 5765760},
+    {6,2,0, 4,-4,2, -604800, 5765760},
+    {6,2,0, 4,-2,2, -86400, 5765760},
+    {6,2,0, 4, 0,2, 155520, 5765760},
+    {6,2,0, 6,-6,1, 2354352, 5765760},
+    {6,2,0, 6,-4,1, -104832, 5765760},
+    {6,2,0, 6,-2,1, -21840, 5765760},
+    {6,2,0, 6, 0,1, 41600, 5765760},
+    {6,2,0, 8,-8,0, -1261260, 5765760},
+    {6,2,0, 8,-6,0, 168168, 5765760},
+    {6,2,0, 8,-4,0, -11088, 5765760},
+    {6,2,0, 8,-2,0, -2520, 5765760},
+    {6,2,0, 8, 0,0, 4900, 5765760},
+    {5,3,0, 2, 2,3, -1123200, 5765760},
+    {5,3,0, 4, 2,2, -388800, 5765760},
+    {5,3,0, 4, 4,2, 302400, 5765760},
+    {5,3,0, 6, 2,1, -98280, 5765760},
+    {5,3,0, 6, 4,1, 52416, 5765760},
+    {5,3,0, 6, 6,1, 1177176, 5765760},
+    {5,3,0, 8, 2,0, -11340, 5765760},
+    {5,3,0, 8, 4,0, 5544, 5765760},
+    {5,3,0, 8, 6,0, 84084, 5765760},
+    {5,3,0, 8, 8,0, -2522520, 5765760},
+    {4,4,0, 0, 0,4, 329472, 5765760},
+    {4,4,0, 2, 0,3, 299520, 5765760},
+    {4,4,0, 4,-4,2, -1512000, 5765760},
+    {4,4,0, 4, 0,2, 139968, 5765760},
+    {4,4,0, 6,-4,1, -262080, 5765760},
+    {4,4,0, 6, 0,1, 37440, 5765760},
+    {4,4,0, 8,-8,0, 3153150, 5765760},
+    {4,4,0, 8,-4,0, -27720, 5765760},
+    {4,4,0, 8, 0,0, 4410, 5765760},
+    {3,5,0, 2, 2,3, -1123200, 5765760},
+    {3,5,0, 4, 2,2, -388800, 5765760},
+    {3,5,0, 4, 4,2, -302400, 5765760},
+    {3,5,0, 6, 2,1, -98280, 5765760},
+    {3,5,0, 6, 4,1, -52416, 5765760},
+    {3,5,0, 6, 6,1, 1177176, 5765760},
+    {3,5,0, 8, 2,0, -11340, 5765760},
+    {3,5,0, 8, 4,0, -5544, 5765760},
+    {3,5,0, 8, 6,0, 84084, 5765760},
+    {3,5,0, 8, 8,0, 2522520, 5765760},
+    {2,6,0, 0, 0,4, 366080, 5765760},
+    {2,6,0, 2,-2,3, 249600, 5765760},
+    {2,6,0, 2, 0,3, 332800, 5765760},
+    {2,6,0, 4,-4,2, -604800, 5765760},
+    {2,6,0, 4,-2,2, 86400, 5765760},
+    {2,6,0, 4, 0,2, 155520, 5765760},
+    {2,6,0, 6,-6,1, -2354352, 5765760},
+    {2,6,0, 6,-4,1, -104832, 5765760},
+    {2,6,0, 6,-2,1, 21840, 5765760},
+    {2,6,0, 6, 0,1, 41600, 5765760},
+    {2,6,0, 8,-8,0, -1261260, 5765760},
+    {2,6,0, 8,-6,0, -168168, 5765760},
+    {2,6,0, 8,-4,0, -11088, 5765760},
+    {2,6,0, 8,-2,0, 2520, 5765760},
+    {2,6,0, 8, 0,0, 4900, 5765760},
+    {1,7,0, 2, 2,3, -873600, 5765760},
+    {1,7,0, 4, 2,2, -302400, 5765760},
+    {1,7,0, 4, 4,2, -2116800, 5765760},
+    {1,7,0, 6, 2,1, -76440, 5765760},
+    {1,7,0, 6, 4,1, -366912, 5765760},
+    {1,7,0, 6, 6,1, -1513512, 5765760},
+    {1,7,0, 8, 2,0, -8820, 5765760},
+    {1,7,0, 8, 4,0, -38808, 5765760},
+    {1,7,0, 8, 6,0, -108108, 5765760},
+    {1,7,0, 8, 8,0, -360360, 5765760},
+    {0,8,0, 0, 0,4, 640640, 5765760},
+    {0,8,0, 2,-2,3, 1747200, 5765760},
+    {0,8,0, 2, 0,3, 582400, 5765760},
+    {0,8,0, 4,-4,2, 1058400, 5765760},
+    {0,8,0, 4,-2,2, 604800, 5765760},
+    {0,8,0, 4, 0,2, 272160, 5765760},
+    {0,8,0, 6,-6,1, 336336, 5765760},
+    {0,8,0, 6,-4,1, 183456, 5765760},
+    {0,8,0, 6,-2,1, 152880, 5765760},
+    {0,8,0, 6, 0,1, 72800, 5765760},
+    {0,8,0, 8,-8,0, 45045, 5765760},
+    {0,8,0, 8,-6,0, 24024, 5765760},
+    {0,8,0, 8,-4,0, 19404, 5765760},
+    {0,8,0, 8,-2,0, 17640, 5765760},
+    {0,8,0, 8, 0,0, 8575, 5765760},
+    {7,0,1, 2,-1,3, -873600, 5765760},
+    {7,0,1, 4,-3,2, 1058400, 5765760},
+    {7,0,1, 4,-1,2, -1360800, 5765760},
+    {7,0,1, 6,-5,1, -504504, 5765760},
+    {7,0,1, 6,-3,1, 687960, 5765760},
+    {7,0,1, 6,-1,1, -764400, 5765760},
+    {7,0,1, 8,-7,0, 90090, 5765760},
+    {7,0,1, 8,-5,0, -126126, 5765760},
+    {7,0,1, 8,-3,0, 145530, 5765760},
+    {7,0,1, 8,-1,0, -154350, 5765760},
+    {6,1,1, 2, 1,3, -124800, 5765760},
+    {6,1,1, 4, 1,2, -194400, 5765760},
+    {6,1,1, 4, 3,2, 1360800, 5765760},
+    {6,1,1, 6, 1,1, -109200, 5765760},
+    {6,1,1, 6, 3,1, 884520, 5765760},
+    {6,1,1, 6, 5,1, -1801800, 5765760},
+    {6,1,1, 8, 1,0, -22050, 5765760},
+    {6,1,1, 8, 3,0, 187110, 5765760},
+    {6,1,1, 8, 5,0, -450450, 5765760},
+    {6,1,1, 8, 7,0, 630630, 5765760},
+    {5,2,1, 2,-1,3, -374400, 5765760},
+    {5,2,1, 4,-3,2, -50400, 5765760},
+    {5,2,1, 4,-1,2, -583200, 5765760},
+    {5,2,1, 6,-5,1, 1945944, 5765760},
+    {5,2,1, 6,-3,1, -32760, 5765760},
+    {5,2,1, 6,-1,1, -327600, 5765760},
+    {5,2,1, 8,-7,0, -1891890, 5765760},
+    {5,2,1, 8,-5,0, 486486, 5765760},
+    {5,2,1, 8,-3,0, -6930, 5765760},
+    {5,2,1, 8,-1,0, -66150, 5765760},
+    {4,3,1, 2, 1,3, -224640, 5765760},
+    {4,3,1, 4, 1,2, -349920, 5765760},
+    {4,3,1, 4, 3,2, 756000, 5765760},
+    {4,3,1, 6, 1,1, -196560, 5765760},
+    {4,3,1, 6, 3,1, 491400, 5765760},
+    {4,3,1, 6, 5,1, 360360, 5765760},
+    {4,3,1, 8, 1,0, -39690, 5765760},
+    {4,3,1, 8, 3,0, 103950, 5765760},
+    {4,3,1, 8, 5,0, 90090, 5765760},
+    {4,3,1, 8, 7,0, -3153150, 5765760},
+    {3,4,1, 2,-1,3, -224640, 5765760},
+    {3,4,1, 4,-3,2, -756000, 5765760},
+    {3,4,1, 4,-1,2, -349920, 5765760},
+    {3,4,1, 6,-5,1, 360360, 5765760},
+    {3,4,1, 6,-3,1, -491400, 5765760},
+    {3,4,1, 6,-1,1, -196560, 5765760},
+    {3,4,1, 8,-7,0, 3153150, 5765760},
+    {3,4,1, 8,-5,0, 90090, 5765760},
+    {3,4,1, 8,-3,0, -103950, 5765760},
+    {3,4,1, 8,-1,0, -39690, 5765760},
+    {2,5,1, 2, 1,3, -374400, 5765760},
+    {2,5,1, 4, 1,2, -583200, 5765760},
+    {2,5,1, 4, 3,2, 50400, 5765760},
+    {2,5,1, 6, 1,1, -327600, 5765760},
+    {2,5,1, 6, 3,1, 32760, 5765760},
+    {2,5,1, 6, 5,1, 1945944, 5765760},
+    {2,5,1, 8, 1,0, -66150, 5765760},
+    {2,5,1, 8, 3,0, 6930, 5765760},
+    {2,5,1, 8, 5,0, 486486, 5765760},
+    {2,5,1, 8, 7,0, 1891890, 5765760},
+    {1,6,1, 2,-1,3, -124800, 5765760},
+    {1,6,1, 4,-3,2, -1360800, 5765760},
+    {1,6,1, 4,-1,2, -194400, 5765760},
+    {1,6,1, 6,-5,1, -1801800, 5765760},
+    {1,6,1, 6,-3,1, -884520, 5765760},
+    {1,6,1, 6,-1,1, -109200, 5765760},
+    {1,6,1, 8,-7,0, -630630, 5765760},
+    {1,6,1, 8,-5,0, -450450, 5765760},
+    {1,6,1, 8,-3,0, -187110, 5765760},
+    {1,6,1, 8,-1,0, -22050, 5765760},
+    {0,7,1, 2, 1,3, -873600, 5765760},
+    {0,7,1, 4, 1,2, -1360800, 5765760},
+    {0,7,1, 4, 3,2, -1058400, 5765760},
+    {0,7,1, 6, 1,1, -764400, 5765760},
+    {0,7,1, 6, 3,1, -687960, 5765760},
+    {0,7,1, 6, 5,1, -504504, 5765760},
+    {0,7,1, 8, 1,0, -154350, 5765760},
+    {0,7,1, 8, 3,0, -145530, 5765760},
+    {0,7,1, 8, 5,0, -126126, 5765760},
+    {0,7,1, 8, 7,0, -90090, 5765760},
+    {6,0,2, 0, 0,4, 366080, 5765760},
+    {6,0,2, 2,-2,3, -561600, 5765760},
+    {6,0,2, 2, 0,3, 20800, 5765760},
+    {6,0,2, 4,-4,2, 151200, 5765760},
+    {6,0,2, 4,-2,2, 345600, 5765760},
+    {6,0,2, 4, 0,2, -349920, 5765760},
+    {6,0,2, 6,-6,1, -12012, 5765760},
+    {6,0,2, 6,-4,1, -530712, 5765760},
+    {6,0,2, 6,-2,1, 1228500, 5765760},
+    {6,0,2, 6, 0,1, -751400, 5765760},
+    {6,0,2, 8,-6,0, 168168, 5765760},
+    {6,0,2, 8,-4,0, -399168, 5765760},
+    {6,0,2, 8,-2,0, 567000, 5765760},
+    {6,0,2, 8, 0,0, -313600, 5765760},
+    {5,1,2, 2, 2,3, -374400, 5765760},
+    {5,1,2, 4, 2,2, 230400, 5765760},
+    {5,1,2, 4, 4,2, 403200, 5765760},
+    {5,1,2, 6, 2,1, 819000, 5765760},
+    {5,1,2, 6, 4,1, -1415232, 5765760},
+    {5,1,2, 6, 6,1, -72072, 5765760},
+    {5,1,2, 8, 2,0, 378000, 5765760},
+    {5,1,2, 8, 4,0, -1064448, 5765760},
+    {5,1,2, 8, 6,0, 1009008, 5765760},
+    {4,2,2, 0, 0,4, 219648, 5765760},
+    {4,2,2, 2,-2,3, -37440, 5765760},
+    {4,2,2, 2, 0,3, 12480, 5765760},
+    {4,2,2, 4,-4,2, -252000, 5765760},
+    {4,2,2, 4,-2,2, 23040, 5765760},
+    {4,2,2, 4, 0,2, -209952, 5765760},
+    {4,2,2, 6,-6,1, 180180, 5765760},
+    {4,2,2, 6,-4,1, 884520, 5765760},
+    {4,2,2, 6,-2,1, 81900, 5765760},
+    {4,2,2, 6, 0,1, -450840, 5765760},
+    {4,2,2, 8,-6,0, -2522520, 5765760},
+    {4,2,2, 8,-4,0, 665280, 5765760},
+    {4,2,2, 8,-2,0, 37800, 5765760},
+    {4,2,2, 8, 0,0, -188160, 5765760},
+    {3,3,2, 2, 2,3, -449280, 5765760},
+    {3,3,2, 4, 2,2, 276480, 5765760},
+    {3,3,2, 6, 2,1, 982800, 5765760},
+    {3,3,2, 6, 6,1, 240240, 5765760},
+    {3,3,2, 8, 2,0, 453600, 5765760},
+    {3,3,2, 8, 6,0, -3363360, 5765760},
+    {2,4,2, 0, 0,4, 219648, 5765760},
+    {2,4,2, 2,-2,3, 37440, 5765760},
+    {2,4,2, 2, 0,3, 12480, 5765760},
+    {2,4,2, 4,-4,2, -252000, 5765760},
+    {2,4,2, 4,-2,2, -23040, 5765760},
+    {2,4,2, 4, 0,2, -209952, 5765760},
+    {2,4,2, 6,-6,1, -180180, 5765760},
+    {2,4,2, 6,-4,1, 884520, 5765760},
+    {2,4,2, 6,-2,1, -81900, 5765760},
+    {2,4,2, 6, 0,1, -450840, 5765760},
+    {2,4,2, 8,-6,0, 2522520, 5765760},
+    {2,4,2, 8,-4,0, 665280, 5765760},
+    {2,4,2, 8,-2,0, -37800, 5765760},
+    {2,4,2, 8, 0,0, -188160, 5765760},
+    {1,5,2, 2, 2,3, -374400, 5765760},
+    {1,5,2, 4, 2,2, 230400, 5765760},
+    {1,5,2, 4, 4,2, -403200, 5765760},
+    {1,5,2, 6, 2,1, 819000, 5765760},
+    {1,5,2, 6, 4,1, 1415232, 5765760},
+    {1,5,2, 6, 6,1, -72072, 5765760},
+    {1,5,2, 8, 2,0, 378000, 5765760},
+    {1,5,2, 8, 4,0, 1064448, 5765760},
+    {1,5,2, 8, 6,0, 1009008, 5765760},
+    {0,6,2, 0, 0,4, 366080, 5765760},
+    {0,6,2, 2,-2,3, 561600, 5765760},
+    {0,6,2, 2, 0,3, 20800, 5765760},
+    {0,6,2, 4,-4,2, 151200, 5765760},
+    {0,6,2, 4,-2,2, -345600, 5765760},
+    {0,6,2, 4, 0,2, -349920, 5765760},
+    {0,6,2, 6,-6,1, 12012, 5765760},
+    {0,6,2, 6,-4,1, -530712, 5765760},
+    {0,6,2, 6,-2,1, -1228500, 5765760},
+    {0,6,2, 6, 0,1, -751400, 5765760},
+    {0,6,2, 8,-6,0, -168168, 5765760},
+    {0,6,2, 8,-4,0, -399168, 5765760},
+    {0,6,2, 8,-2,0, -567000, 5765760},
+    {0,6,2, 8, 0,0, -313600, 5765760},
+    {5,0,3, 2,-1,3, -1123200, 5765760},
+    {5,0,3, 4,-3,2, 604800, 5765760},
+    {5,0,3, 4,-1,2, -86400, 5765760},
+    {5,0,3, 6,-5,1, -72072, 5765760},
+    {5,0,3, 6,-3,1, -273000, 5765760},
+    {5,0,3, 6,-1,1, 982800, 5765760},
+    {5,0,3, 8,-5,0, 288288, 5765760},
+    {5,0,3, 8,-3,0, -924000, 5765760},
+    {5,0,3, 8,-1,0, 1411200, 5765760},
+    {4,1,3, 2, 1,3, -224640, 5765760},
+    {4,1,3, 4, 1,2, -17280, 5765760},
+    {4,1,3, 4, 3,2, 1088640, 5765760},
+    {4,1,3, 6, 1,1, 196560, 5765760},
+    {4,1,3, 6, 3,1, -491400, 5765760},
+    {4,1,3, 6, 5,1, -360360, 5765760},
+    {4,1,3, 8, 1,0, 282240, 5765760},
+    {4,1,3, 8, 3,0, -1663200, 5765760},
+    {4,1,3, 8, 5,0, 1441440, 5765760},
+    {3,2,3, 2,-1,3, -449280, 5765760},
+    {3,2,3, 4,-3,2, -241920, 5765760},
+    {3,2,3, 4,-1,2, -34560, 5765760},
+    {3,2,3, 6,-5,1, 720720, 5765760},
+    {3,2,3, 6,-3,1, 109200, 5765760},
+    {3,2,3, 6,-1,1, 393120, 5765760},
+    {3,2,3, 8,-5,0, -2882880, 5765760},
+    {3,2,3, 8,-3,0, 369600, 5765760},
+    {3,2,3, 8,-1,0, 564480, 5765760},
+    {2,3,3, 2, 1,3, -449280, 5765760},
+    {2,3,3, 4, 1,2, -34560, 5765760},
+    {2,3,3, 4, 3,2, 241920, 5765760},
+    {2,3,3, 6, 1,1, 393120, 5765760},
+    {2,3,3, 6, 3,1, -109200, 5765760},
+    {2,3,3, 6, 5,1, 720720, 5765760},
+    {2,3,3, 8, 1,0, 564480, 5765760},
+    {2,3,3, 8, 3,0, -369600, 5765760},
+    {2,3,3, 8, 5,0, -2882880, 5765760},
+    {1,4,3, 2,-1,3, -224640, 5765760},
+    {1,4,3, 4,-3,2, -1088640, 5765760},
+    {1,4,3, 4,-1,2, -17280, 5765760},
+    {1,4,3, 6,-5,1, -360360, 5765760},
+    {1,4,3, 6,-3,1, 491400, 5765760},
+    {1,4,3, 6,-1,1, 196560, 5765760},
+    {1,4,3, 8,-5,0, 1441440, 5765760},
+    {1,4,3, 8,-3,0, 1663200, 5765760},
+    {1,4,3, 8,-1,0, 282240, 5765760},
+    {0,5,3, 2, 1,3, -1123200, 5765760},
+    {0,5,3, 4, 1,2, -86400, 5765760},
+    {0,5,3, 4, 3,2, -604800, 5765760},
+    {0,5,3, 6, 1,1, 982800, 5765760},
+    {0,5,3, 6, 3,1, 273000, 5765760},
+    {0,5,3, 6, 5,1, -72072, 5765760},
+    {0,5,3, 8, 1,0, 1411200, 5765760},
+    {0,5,3, 8, 3,0, 924000, 5765760},
+    {0,5,3, 8, 5,0, 288288, 5765760},
+    {4,0,4, 0, 0,4, 329472, 5765760},
+    {4,0,4, 2,-2,3, -224640, 5765760},
+    {4,0,4, 2, 0,3, -74880, 5765760},
+    {4,0,4, 4,-4,2, 15120, 5765760},
+    {4,0,4, 4,-2,2, 1045440, 5765760},
+    {4,0,4, 4, 0,2, -591408, 5765760},
+    {4,0,4, 6,-4,1, -262080, 5765760},
+    {4,0,4, 6, 0,1, 37440, 5765760},
+    {4,0,4, 8,-4,0, 443520, 5765760},
+    {4,0,4, 8,-2,0, -1612800, 5765760},
+    {4,0,4, 8, 0,0, 1128960, 5765760},
+    {3,1,4, 2, 2,3, -224640, 5765760},
+    {3,1,4, 4, 2,2, 1045440, 5765760},
+    {3,1,4, 4, 4,2, 60480, 5765760},
+    {3,1,4, 6, 4,1, -1048320, 5765760},
+    {3,1,4, 8, 2,0, -1612800, 5765760},
+    {3,1,4, 8, 4,0, 1774080, 5765760},
+    {2,2,4, 0, 0,4, 219648, 5765760},
+    {2,2,4, 2, 0,3, -49920, 5765760},
+    {2,2,4, 4,-4,2, -90720, 5765760},
+    {2,2,4, 4, 0,2, -394272, 5765760},
+    {2,2,4, 6,-4,1, 1572480, 5765760},
+    {2,2,4, 6, 0,1, 24960, 5765760},
+    {2,2,4, 8,-4,0, -2661120, 5765760},
+    {2,2,4, 8, 0,0, 752640, 5765760},
+    {1,3,4, 2, 2,3, -224640, 5765760},
+    {1,3,4, 4, 2,2, 1045440, 5765760},
+    {1,3,4, 4, 4,2, -60480, 5765760},
+    {1,3,4, 6, 4,1, 1048320, 5765760},
+    {1,3,4, 8, 2,0, -1612800, 5765760},
+    {1,3,4, 8, 4,0, -1774080, 5765760},
+    {0,4,4, 0, 0,4, 329472, 5765760},
+    {0,4,4, 2,-2,3, 224640, 5765760},
+    {0,4,4, 2, 0,3, -74880, 5765760},
+    {0,4,4, 4,-4,2, 15120, 5765760},
+    {0,4,4, 4,-2,2, -1045440, 5765760},
+    {0,4,4, 4, 0,2, -591408, 5765760},
+    {0,4,4, 6,-4,1, -262080, 5765760},
+    {0,4,4, 6, 0,1, 37440, 5765760},
+    {0,4,4, 8,-4,0, 443520, 5765760},
+    {0,4,4, 8,-2,0, 1612800, 5765760},
+    {0,4,4, 8, 0,0, 1128960, 5765760},
+    {3,0,5, 2,-1,3, -1123200, 5765760},
+    {3,0,5, 4,-3,2, 151200, 5765760},
+    {3,0,5, 4,-1,2, 540000, 5765760},
+    {3,0,5, 6,-3,1, -698880, 5765760},
+    {3,0,5, 6,-1,1, 628992, 5765760},
+    {3,0,5, 8,-3,0, 591360, 5765760},
+    {3,0,5, 8,-1,0, -2032128, 5765760},
+    {2,1,5, 2, 1,3, -374400, 5765760},
+    {2,1,5, 4, 1,2, 180000, 5765760},
+    {2,1,5, 4, 3,2, 453600, 5765760},
+    {2,1,5, 6, 1,1, 209664, 5765760},
+    {2,1,5, 6, 3,1, -2096640, 5765760},
+    {2,1,5, 8, 1,0, -677376, 5765760},
+    {2,1,5, 8, 3,0, 1774080, 5765760},
+    {1,2,5, 2,-1,3, -374400, 5765760},
+    {1,2,5, 4,-3,2, -453600, 5765760},
+    {1,2,5, 4,-1,2, 180000, 5765760},
+    {1,2,5, 6,-3,1, 2096640, 5765760},
+    {1,2,5, 6,-1,1, 209664, 5765760},
+    {1,2,5, 8,-3,0, -1774080, 5765760},
+    {1,2,5, 8,-1,0, -677376, 5765760},
+    {0,3,5, 2, 1,3, -1123200, 5765760},
+    {0,3,5, 4, 1,2, 540000, 5765760},
+    {0,3,5, 4, 3,2, -151200, 5765760},
+    {0,3,5, 6, 1,1, 628992, 5765760},
+    {0,3,5, 6, 3,1, 698880, 5765760},
+    {0,3,5, 8, 1,0, -2032128, 5765760},
+    {0,3,5, 8, 3,0, -591360, 5765760},
+    {2,0,6, 0, 0,4, 366080, 5765760},
+    {2,0,6, 2,-2,3, -62400, 5765760},
+    {2,0,6, 2, 0,3, -520000, 5765760},
+    {2,0,6, 4,-2,2, 777600, 5765760},
+    {2,0,6, 4, 0,2, -69120, 5765760},
+    {2,0,6, 6,-2,1, -1397760, 5765760},
+    {2,0,6, 6, 0,1, 1124864, 5765760},
+    {2,0,6, 8,-2,0, 645120, 5765760},
+    {2,0,6, 8, 0,0, -802816, 5765760},
+    {1,1,6, 2, 2,3, -124800, 5765760},
+    {1,1,6, 4, 2,2, 1555200, 5765760},
+    {1,1,6, 6, 2,1, -2795520, 5765760},
+    {1,1,6, 8, 2,0, 1290240, 5765760},
+    {0,2,6, 0, 0,4, 366080, 5765760},
+    {0,2,6, 2,-2,3, 62400, 5765760},
+    {0,2,6, 2, 0,3, -520000, 5765760},
+    {0,2,6, 4,-2,2, -777600, 5765760},
+    {0,2,6, 4, 0,2, -69120, 5765760},
+    {0,2,6, 6,-2,1, 1397760, 5765760},
+    {0,2,6, 6, 0,1, 1124864, 5765760},
+    {0,2,6, 8,-2,0, -645120, 5765760},
+    {0,2,6, 8, 0,0, -802816, 5765760},
+    {1,0,7, 2,-1,3, -873600, 5765760},
+    {1,0,7, 4,-1,2, 2419200, 5765760},
+    {1,0,7, 6,-1,1, -1956864, 5765760},
+    {1,0,7, 8,-1,0, 516096, 5765760},
+    {0,1,7, 2, 1,3, -873600, 5765760},
+    {0,1,7, 4, 1,2, 2419200, 5765760},
+    {0,1,7, 6, 1,1, -1956864, 5765760},
+    {0,1,7, 8, 1,0, 516096, 5765760},
+    {0,0,8, 0, 0,4, 640640, 5765760},
+    {0,0,8, 2, 0,3, -2329600, 5765760},
+    {0,0,8, 4, 0,2, 1935360, 5765760},
+    {0,0,8, 6, 0,1, -745472, 5765760},
+    {0,0,8, 8, 0,0, 114688, 5765760},
+    // nu=9
+    {9,0,0, 1,-1,4, 17821440, 65345280},
+    {9,0,0, 3,-3,3, -15993600, 65345280},
+    {9,0,0, 3,-1,3, 9596160, 65345280},
+    {9,0,0, 5,-5,2, 7916832, 65345280},
+    {9,0,0, 5,-3,2, -4398240, 65345280},
+    {9,0,0, 5,-1,2, 3769920, 65345280},
+    {9,0,0, 7,-7,1, -2162160, 65345280},
+    {9,0,0, 7,-5,1, 1164240, 65345280},
+    {9,0,0, 7,-3,1, -952560, 65345280},
+    {9,0,0, 7,-1,1, 882000, 65345280},
+    {9,0,0, 9,-9,0, 255255, 65345280},
+    {9,0,0, 9,-7,0, -135135, 65345280},
+    {9,0,0, 9,-5,0, 108108, 65345280},
+    {9,0,0, 9,-3,0, -97020, 65345280},
+    {9,0,0, 9,-1,0, 92610, 65345280},
+    {8,1,0, 1, 1,4, 1980160, 65345280},
+    {8,1,0, 3, 1,3, 1066240, 65345280},
+    {8,1,0, 3, 3,3, -15993600, 65345280},
+    {8,1,0, 5, 1,2, 418880, 65345280},
+    {8,1,0, 5, 3,2, -4398240, 65345280},
+    {8,1,0, 5, 5,2, 21991200, 65345280},
+    {8,1,0, 7, 1,1, 98000, 65345280},
+    {8,1,0, 7, 3,1, -952560, 65345280},
+    {8,1,0, 7, 5,1, 3234000, 65345280},
+    {8,1,0, 7, 7,1, -11771760, 65345280},
+    {8,1,0, 9, 1,0, 10290, 65345280},
+    {8,1,0, 9, 3,0, -97020, 65345280},
+    {8,1,0, 9, 5,0, 300300, 65345280},
+    {8,1,0, 9, 7,0, -735735, 65345280},
+    {8,1,0, 9, 9,0, 2297295, 65345280},
+    {7,2,0, 1,-1,4, 7920640, 65345280},
+    {7,2,0, 3,-1,3, 4264960, 65345280},
+    {7,2,0, 5,-5,2, -14074368, 65345280},
+    {7,2,0, 5,-1,2, 1675520, 65345280},
+    {7,2,0, 7,-7,1, 24024000, 65345280},
+    {7,2,0, 7,-5,1, -2069760, 65345280},
+    {7,2,0, 7,-1,1, 392000, 65345280},
+    {7,2,0, 9,-9,0, -9189180, 65345280},
+    {7,2,0, 9,-7,0, 1501500, 65345280},
+    {7,2,0, 9,-5,0, -192192, 65345280},
+    {7,2,0, 9,-1,0, 41160, 65345280},
+    {6,3,0, 1, 1,4, 3394560, 65345280},
+    {6,3,0, 3, 1,3, 1827840, 65345280},
+    {6,3,0, 3, 3,3, -12185600, 65345280},
+    {6,3,0, 5, 1,2, 718080, 65345280},
+    {6,3,0, 5, 3,2, -3351040, 65345280},
+    {6,3,0, 7, 1,1, 168000, 65345280},
+    {6,3,0, 7, 3,1, -725760, 65345280},
+    {6,3,0, 7, 7,1, 20180160, 65345280},
+    {6,3,0, 9, 1,0, 17640, 65345280},
+    {6,3,0, 9, 3,0, -73920, 65345280},
+    {6,3,0, 9, 7,0, 1261260, 65345280},
+    {6,3,0, 9, 9,0, -21441420, 65345280},
+    {5,4,0, 1,-1,4, 5091840, 65345280},
+    {5,4,0, 3,-3,3, 4569600, 65345280},
+    {5,4,0, 3,-1,3, 2741760, 65345280},
+    {5,4,0, 5,-5,2, -12315072, 65345280},
+    {5,4,0, 5,-3,2, 1256640, 65345280},
+    {5,4,0, 5,-1,2, 1077120, 65345280},
+    {5,4,0, 7,-7,1, -3363360, 65345280},
+    {5,4,0, 7,-5,1, -1811040, 65345280},
+    {5,4,0, 7,-3,1, 272160, 65345280},
+    {5,4,0, 7,-1,1, 252000, 65345280},
+    {5,4,0, 9,-9,0, 32162130, 65345280},
+    {5,4,0, 9,-7,0, -210210, 65345280},
+    {5,4,0, 9,-5,0, -168168, 65345280},
+    {5,4,0, 9,-3,0, 27720, 65345280},
+    {5,4,0, 9,-1,0, 26460, 65345280},
+    {4,5,0, 1, 1,4, 5091840, 65345280},
+    {4,5,0, 3, 1,3, 2741760, 65345280},
+    {4,5,0, 3, 3,3, -4569600, 65345280},
+    {4,5,0, 5, 1,2, 1077120, 65345280},
+    {4,5,0, 5, 3,2, -1256640, 65345280},
+    {4,5,0, 5, 5,2, -12315072, 65345280},
+    {4,5,0, 7, 1,1, 252000, 65345280},
+    {4,5,0, 7, 3,1, -272160, 65345280},
+    {4,5,0, 7, 5,1, -1811040, 65345280},
+    {4,5,0, 7, 7,1, 3363360, 65345280},
+    {4,5,0, 9, 1,0, 26460, 65345280},
+    {4,5,0, 9, 3,0, -27720, 65345280},
+    {4,5,0, 9, 5,0, -168168, 65345280},
+    {4,5,0, 9, 7,0, 210210, 65345280},
+    {4,5,0, 9, 9,0, 32162130, 65345280},
+    {3,6,0, 1,-1,4, 3394560, 65345280},
+    {3,6,0, 3,-3,3, 12185600, 65345280},
+    {3,6,0, 3,-1,3, 1827840, 65345280},
+    {3,6,0, 5,-3,2, 3351040, 65345280},
+    {3,6,0, 5,-1,2, 718080, 65345280},
+    {3,6,0, 7,-7,1, -20180160, 65345280},
+    {3,6,0, 7,-3,1, 725760, 65345280},
+    {3,6,0, 7,-1,1, 168000, 65345280},
+    {3,6,0, 9,-9,0, -21441420, 65345280},
+    {3,6,0, 9,-7,0, -1261260, 65345280},
+    {3,6,0, 9,-3,0, 73920, 65345280},
+    {3,6,0, 9,-1,0, 17640, 65345280},
+    {2,7,0, 1, 1,4, 7920640, 65345280},
+    {2,7,0, 3, 1,3, 4264960, 65345280},
+    {2,7,0, 5, 1,2, 1675520, 65345280},
+    {2,7,0, 5, 5,2, -14074368, 65345280},
+    {2,7,0, 7, 1,1, 392000, 65345280},
+    {2,7,0, 7, 5,1, -2069760, 65345280},
+    {2,7,0, 7, 7,1, -24024000, 65345280},
+    {2,7,0, 9, 1,0, 41160, 65345280},
+    {2,7,0, 9, 5,0, -192192, 65345280},
+    {2,7,0, 9, 7,0, -1501500, 65345280},
+    {2,7,0, 9, 9,0, -9189180, 65345280},
+    {1,8,0, 1,-1,4, 1980160, 65345280},
+    {1,8,0, 3,-3,3, 15993600, 65345280},
+    {1,8,0, 3,-1,3, 1066240, 65345280},
+    {1,8,0, 5,-5,2, 21991200, 65345280},
+    {1,8,0, 5,-3,2, 4398240, 65345280},
+    {1,8,0, 5,-1,2, 418880, 65345280},
+    {1,8,0, 7,-7,1, 11771760, 65345280},
+    {1,8,0, 7,-5,1, 3234000, 65345280},
+    {1,8,0, 7,-3,1, 952560, 65345280},
+    {1,8,0, 7,-1,1, 98000, 65345280},
+    {1,8,0, 9,-9,0, 2297295, 65345280},
+    {1,8,0, 9,-7,0, 735735, 65345280},
+    {1,8,0, 9,-5,0, 300300, 65345280},
+    {1,8,0, 9,-3,0, 97020, 65345280},
+    {1,8,0, 9,-1,0, 10290, 65345280},
+    {0,9,0, 1, 1,4, 17821440, 65345280},
+    {0,9,0, 3, 1,3, 9596160, 65345280},
+    {0,9,0, 3, 3,3, 15993600, 65345280},
+    {0,9,0, 5, 1,2, 3769920, 65345280},
+    {0,9,0, 5, 3,2, 4398240, 65345280},
+    {0,9,0, 5, 5,2, 7916832, 65345280},
+    {0,9,0, 7, 1,1, 882000, 65345280},
+    {0,9,0, 7, 3,1, 952560, 65345280},
+    {0,9,0, 7, 5,1, 1164240, 65345280},
+    {0,9,0, 7, 7,1, 2162160, 65345280},
+    {0,9,0, 9, 1,0, 92610, 65345280},
+    {0,9,0, 9, 3,0, 97020, 65345280},
+    {0,9,0, 9, 5,0, 108108, 65345280},
+    {0,9,0, 9, 7,0, 135135, 65345280},
+    {0,9,0, 9, 9,0, 255255, 65345280},
+    {8,0,1, 1, 0,4, 1980160, 65345280},
+    {8,0,1, 3,-2,3, -10662400, 65345280},
+    {8,0,1, 3, 0,3, 6397440, 65345280},
+    {8,0,1, 5,-4,2, 8796480, 65345280},
+    {8,0,1, 5,-2,2, -11728640, 65345280},
+    {8,0,1, 5, 0,2, 6283200, 65345280},
+    {8,0,1, 7,-6,1, -3363360, 65345280},
+    {8,0,1, 7,-4,1, 4656960, 65345280},
+    {8,0,1, 7,-2,1, -5292000, 65345280},
+    {8,0,1, 7, 0,1, 2744000, 65345280},
+    {8,0,1, 9,-8,0, 510510, 65345280},
+    {8,0,1, 9,-6,0, -720720, 65345280},
+    {8,0,1, 9,-4,0, 840840, 65345280},
+    {8,0,1, 9,-2,0, -905520, 65345280},
+    {8,0,1, 9, 0,0, 463050, 65345280},
+    {7,1,1, 3, 2,3, -5331200, 65345280},
+    {7,1,1, 5, 2,2, -5864320, 65345280},
+    {7,1,1, 5, 4,2, 17592960, 65345280},
+    {7,1,1, 7, 2,1, -2646000, 65345280},
+    {7,1,1, 7, 4,1, 9313920, 65345280},
+    {7,1,1, 7, 6,1, -15135120, 65345280},
+    {7,1,1, 9, 2,0, -452760, 65345280},
+    {7,1,1, 9, 4,0, 1681680, 65345280},
+    {7,1,1, 9, 6,0, -3243240, 65345280},
+    {7,1,1, 9, 8,0, 4084080, 65345280},
+    {6,2,1, 1, 0,4, 1131520, 65345280},
+    {6,2,1, 3,-2,3, -1523200, 65345280},
+    {6,2,1, 3, 0,3, 3655680, 65345280},
+    {6,2,1, 5,-4,2, -5026560, 65345280},
+    {6,2,1, 5,-2,2, -1675520, 65345280},
+    {6,2,1, 5, 0,2, 3590400, 65345280},
+    {6,2,1, 7,-6,1, 23543520, 65345280},
+    {6,2,1, 7,-4,1, -2661120, 65345280},
+    {6,2,1, 7,-2,1, -756000, 65345280},
+    {6,2,1, 7, 0,1, 1568000, 65345280},
+    {6,2,1, 9,-8,0, -14294280, 65345280},
+    {6,2,1, 9,-6,0, 5045040, 65345280},
+    {6,2,1, 9,-4,0, -480480, 65345280},
+    {6,2,1, 9,-2,0, -129360, 65345280},
+    {6,2,1, 9, 0,0, 264600, 65345280},
+    {5,3,1, 3, 2,3, -6854400, 65345280},
+    {5,3,1, 5, 2,2, -7539840, 65345280},
+    {5,3,1, 5, 4,2, 2513280, 65345280},
+    {5,3,1, 7, 2,1, -3402000, 65345280},
+    {5,3,1, 7, 4,1, 1330560, 65345280},
+    {5,3,1, 7, 6,1, 11771760, 65345280},
+    {5,3,1, 9, 2,0, -582120, 65345280},
+    {5,3,1, 9, 4,0, 240240, 65345280},
+    {5,3,1, 9, 6,0, 2522520, 65345280},
+    {5,3,1, 9, 8,0, -28588560, 65345280},
+    {4,4,1, 1, 0,4, 1018368, 65345280},
+    {4,4,1, 3, 0,3, 3290112, 65345280},
+    {4,4,1, 5,-4,2, -12566400, 65345280},
+    {4,4,1, 5, 0,2, 3231360, 65345280},
+    {4,4,1, 7,-4,1, -6652800, 65345280},
+    {4,4,1, 7, 0,1, 1411200, 65345280},
+    {4,4,1, 9,-8,0, 35735700, 65345280},
+    {4,4,1, 9,-4,0, -1201200, 65345280},
+    {4,4,1, 9, 0,0, 238140, 65345280},
+    {3,5,1, 3, 2,3, -6854400, 65345280},
+    {3,5,1, 5, 2,2, -7539840, 65345280},
+    {3,5,1, 5, 4,2, -2513280, 65345280},
+    {3,5,1, 7, 2,1, -3402000, 65345280},
+    {3,5,1, 7, 4,1, -1330560, 65345280},
+    {3,5,1, 7, 6,1, 11771760, 65345280},
+    {3,5,1, 9, 2,0, -582120, 65345280},
+    {3,5,1, 9, 4,0, -240240, 65345280},
+    {3,5,1, 9, 6,0, 2522520, 65345280},
+    {3,5,1, 9, 8,0, 28588560, 65345280},
+    {2,6,1, 1, 0,4, 1131520, 65345280},
+    {2,6,1, 3,-2,3, 1523200, 65345280},
+    {2,6,1, 3, 0,3, 3655680, 65345280},
+    {2,6,1, 5,-4,2, -5026560, 65345280},
+    {2,6,1, 5,-2,2, 1675520, 65345280},
+    {2,6,1, 5, 0,2, 3590400, 65345280},
+    {2,6,1, 7,-6,1, -23543520, 65345280},
+    {2,6,1, 7,-4,1, -2661120, 65345280},
+    {2,6,1, 7,-2,1, 756000, 65345280},
+    {2,6,1, 7, 0,1, 1568000, 65345280},
+    {2,6,1, 9,-8,0, -14294280, 65345280},
+    {2,6,1, 9,-6,0, -5045040, 65345280},
+    {2,6,1, 9,-4,0, -480480, 65345280},
+    {2,6,1, 9,-2,0, 129360, 65345280},
+    {2,6,1, 9, 0,0, 264600, 65345280},
+    {1,7,1, 3, 2,3, -5331200, 65345280},
+    {1,7,1, 5, 2,2, -5864320, 65345280},
+    {1,7,1, 5, 4,2, -17592960, 65345280},
+    {1,7,1, 7, 2,1, -2646000, 65345280},
+    {1,7,1, 7, 4,1, -9313920, 65345280},
+    {1,7,1, 7, 6,1, -15135120, 65345280},
+    {1,7,1, 9, 2,0, -452760, 65345280},
+    {1,7,1, 9, 4,0, -1681680, 65345280},
+    {1,7,1, 9, 6,0, -3243240, 65345280},
+    {1,7,1, 9, 8,0, -4084080, 65345280},
+    {0,8,1, 1, 0,4, 1980160, 65345280},
+    {0,8,1, 3,-2,3, 10662400, 65345280},
+    {0,8,1, 3, 0,3, 6397440, 65345280},
+    {0,8,1, 5,-4,2, 8796480, 65345280},
+    {0,8,1, 5,-2,2, 11728640, 65345280},
+    {0,8,1, 5, 0,2, 6283200, 65345280},
+    {0,8,1, 7,-6,1, 3363360, 65345280},
+    {0,8,1, 7,-4,1, 4656960, 65345280},
+    {0,8,1, 7,-2,1, 5292000, 65345280},
+    {0,8,1, 7, 0,1, 2744000, 65345280},
+    {0,8,1, 9,-8,0, 510510, 65345280},
+    {0,8,1, 9,-6,0, 720720, 65345280},
+    {0,8,1, 9,-4,0, 840840, 65345280},
+    {0,8,1, 9,-2,0, 905520, 65345280},
+    {0,8,1, 9, 0,0, 463050, 65345280},
+    {7,0,2, 1,-1,4, 7920640, 65345280},
+    {7,0,2, 3,-3,3, -3998400, 65345280},
+    {7,0,2, 3,-1,3, -266560, 65345280},
+    {7,0,2, 5,-5,2, 879648, 65345280},
+    {7,0,2, 5,-3,2, 4398240, 65345280},
+    {7,0,2, 5,-1,2, -10472000, 65345280},
+    {7,0,2, 7,-7,1, -60060, 65345280},
+    {7,0,2, 7,-5,1, -3913140, 65345280},
+    {7,0,2, 7,-3,1, 9552060, 65345280},
+    {7,0,2, 7,-1,1, -12960500, 65345280},
+    {7,0,2, 9,-7,0, 960960, 65345280},
+    {7,0,2, 9,-5,0, -2354352, 65345280},
+    {7,0,2, 9,-3,0, 3492720, 65345280},
+    {7,0,2, 9,-1,0, -4116000, 65345280},
+    {6,1,2, 1, 1,4, 1131520, 65345280},
+    {6,1,2, 3, 1,3, -38080, 65345280},
+    {6,1,2, 3, 3,3, -5140800, 65345280},
+    {6,1,2, 5, 1,2, -1496000, 65345280},
+    {6,1,2, 5, 3,2, 5654880, 65345280},
+    {6,1,2, 5, 5,2, 3141600, 65345280},
+    {6,1,2, 7, 1,1, -1851500, 65345280},
+    {6,1,2, 7, 3,1, 12281220, 65345280},
+    {6,1,2, 7, 5,1, -13975500, 65345280},
+    {6,1,2, 7, 7,1, -420420, 65345280},
+    {6,1,2, 9, 1,0, -588000, 65345280},
+    {6,1,2, 9, 3,0, 4490640, 65345280},
+    {6,1,2, 9, 5,0, -8408400, 65345280},
+    {6,1,2, 9, 7,0, 6726720, 65345280},
+    {5,2,2, 1,-1,4, 3394560, 65345280},
+    {5,2,2, 3,-3,3, 190400, 65345280},
+    {5,2,2, 3,-1,3, -114240, 65345280},
+    {5,2,2, 5,-5,2, -3392928, 65345280},
+    {5,2,2, 5,-3,2, -209440, 65345280},
+    {5,2,2, 5,-1,2, -4488000, 65345280},
+    {5,2,2, 7,-7,1, 1261260, 65345280},
+    {5,2,2, 7,-5,1, 15093540, 65345280},
+    {5,2,2, 7,-3,1, -454860, 65345280},
+    {5,2,2, 7,-1,1, -5554500, 65345280},
+    {5,2,2, 9,-7,0, -20180160, 65345280},
+    {5,2,2, 9,-5,0, 9081072, 65345280},
+    {5,2,2, 9,-3,0, -166320, 65345280},
+    {5,2,2, 9,-1,0, -1764000, 65345280},
+    {4,3,2, 1, 1,4, 2036736, 65345280},
+    {4,3,2, 3, 1,3, -68544, 65345280},
+    {4,3,2, 3, 3,3, -2856000, 65345280},
+    {4,3,2, 5, 1,2, -2692800, 65345280},
+    {4,3,2, 5, 3,2, 3141600, 65345280},
+    {4,3,2, 5, 5,2, -628320, 65345280},
+    {4,3,2, 7, 1,1, -3332700, 65345280},
+    {4,3,2, 7, 3,1, 6822900, 65345280},
+    {4,3,2, 7, 5,1, 2795100, 65345280},
+    {4,3,2, 7, 7,1, 2102100, 65345280},
+    {4,3,2, 9, 1,0, -1058400, 65345280},
+    {4,3,2, 9, 3,0, 2494800, 65345280},
+    {4,3,2, 9, 5,0, 1681680, 65345280},
+    {4,3,2, 9, 7,0, -33633600, 65345280},
+    {3,4,2, 1,-1,4, 2036736, 65345280},
+    {3,4,2, 3,-3,3, 2856000, 65345280},
+    {3,4,2, 3,-1,3, -68544, 65345280},
+    {3,4,2, 5,-5,2, -628320, 65345280},
+    {3,4,2, 5,-3,2, -3141600, 65345280},
+    {3,4,2, 5,-1,2, -2692800, 65345280},
+    {3,4,2, 7,-7,1, -2102100, 65345280},
+    {3,4,2, 7,-5,1, 2795100, 65345280},
+    {3,4,2, 7,-3,1, -6822900, 65345280},
+    {3,4,2, 7,-1,1, -3332700, 65345280},
+    {3,4,2, 9,-7,0, 33633600, 65345280},
+    {3,4,2, 9,-5,0, 1681680, 65345280},
+    {3,4,2, 9,-3,0, -2494800, 65345280},
+    {3,4,2, 9,-1,0, -1058400, 65345280},
+    {2,5,2, 1, 1,4, 3394560, 65345280},
+    {2,5,2, 3, 1,3, -114240, 65345280},
+    {2,5,2, 3, 3,3, -190400, 65345280},
+    {2,5,2, 5, 1,2, -4488000, 65345280},
+    {2,5,2, 5, 3,2, 209440, 65345280},
+    {2,5,2, 5, 5,2, -3392928, 65345280},
+    {2,5,2, 7, 1,1, -5554500, 65345280},
+    {2,5,2, 7, 3,1, 454860, 65345280},
+    {2,5,2, 7, 5,1, 15093540, 65345280},
+    {2,5,2, 7, 7,1, -1261260, 65345280},
+    {2,5,2, 9, 1,0, -1764000, 65345280},
+    {2,5,2, 9, 3,0, 166320, 65345280},
+    {2,5,2, 9, 5,0, 9081072, 65345280},
+    {2,5,2, 9, 7,0, 20180160, 65345280},
+    {1,6,2, 1,-1,4, 1131520, 65345280},
+    {1,6,2, 3,-3,3, 5140800, 65345280},
+    {1,6,2, 3,-1,3, -38080, 65345280},
+    {1,6,2, 5,-5,2, 3141600, 65345280},
+    {1,6,2, 5,-3,2, -5654880, 65345280},
+    {1,6,2, 5,-1,2, -1496000, 65345280},
+    {1,6,2, 7,-7,1, 420420, 65345280},
+    {1,6,2, 7,-5,1, -13975500, 65345280},
+    {1,6,2, 7,-3,1, -12281220, 65345280},
+    {1,6,2, 7,-1,1, -1851500, 65345280},
+    {1,6,2, 9,-7,0, -6726720, 65345280},
+    {1,6,2, 9,-5,0, -8408400, 65345280},
+    {1,6,2, 9,-3,0, -4490640, 65345280},
+    {1,6,2, 9,-1,0, -588000, 65345280},
+    {0,7,2, 1, 1,4, 7920640, 65345280},
+    {0,7,2, 3, 1,3, -266560, 65345280},
+    {0,7,2, 3, 3,3, 3998400, 65345280},
+    {0,7,2, 5, 1,2, -10472000, 65345280},
+    {0,7,2, 5, 3,2, -4398240, 65345280},
+    {0,7,2, 5, 5,2, 879648, 65345280},
+    {0,7,2, 7, 1,1, -12960500, 65345280},
+    {0,7,2, 7, 3,1, -9552060, 65345280},
+    {0,7,2, 7, 5,1, -3913140, 65345280},
+    {0,7,2, 7, 7,1, 60060, 65345280},
+    {0,7,2, 9, 1,0, -4116000, 65345280},
+    {0,7,2, 9, 3,0, -3492720, 65345280},
+    {0,7,2, 9, 5,0, -2354352, 65345280},
+    {0,7,2, 9, 7,0, -960960, 65345280},
+    {6,0,3, 1, 0,4, 3394560, 65345280},
+    {6,0,3, 3,-2,3, -10281600, 65345280},
+    {6,0,3, 3, 0,3, 3731840, 65345280},
+    {6,0,3, 5,-4,2, 3769920, 65345280},
+    {6,0,3, 5, 0,2, -299200, 65345280},
+    {6,0,3, 7,-6,1, -360360, 65345280},
+    {6,0,3, 7,-4,1, -2716560, 65345280},
+    {6,0,3, 7,-2,1, 10647000, 65345280},
+    {6,0,3, 7, 0,1, -7350000, 65345280},
+    {6,0,3, 9,-6,0, 1681680, 65345280},
+    {6,0,3, 9,-4,0, -5765760, 65345280},
+    {6,0,3, 9,-2,0, 9702000, 65345280},
+    {6,0,3, 9, 0,0, -5644800, 65345280},
+    {5,1,3, 3, 2,3, -6854400, 65345280},
+    {5,1,3, 5, 4,2, 10053120, 65345280},
+    {5,1,3, 7, 2,1, 7098000, 65345280},
+    {5,1,3, 7, 4,1, -7244160, 65345280},
+    {5,1,3, 7, 6,1, -2162160, 65345280},
+    {5,1,3, 9, 2,0, 6468000, 65345280},
+    {5,1,3, 9, 4,0, -15375360, 65345280},
+    {5,1,3, 9, 6,0, 10090080, 65345280},
+    {4,2,3, 1, 0,4, 2036736, 65345280},
+    {4,2,3, 3,-2,3, -685440, 65345280},
+    {4,2,3, 3, 0,3, 2239104, 65345280},
+    {4,2,3, 5,-4,2, -6283200, 65345280},
+    {4,2,3, 5, 0,2, -179520, 65345280},
+    {4,2,3, 7,-6,1, 5405400, 65345280},
+    {4,2,3, 7,-4,1, 4527600, 65345280},
+    {4,2,3, 7,-2,1, 709800, 65345280},
+    {4,2,3, 7, 0,1, -4410000, 65345280},
+    {4,2,3, 9,-6,0, -25225200, 65345280},
+    {4,2,3, 9,-4,0, 9609600, 65345280},
+    {4,2,3, 9,-2,0, 646800, 65345280},
+    {4,2,3, 9, 0,0, -3386880, 65345280},
+    {3,3,3, 3, 2,3, -8225280, 65345280},
+    {3,3,3, 7, 2,1, 8517600, 65345280},
+    {3,3,3, 7, 6,1, 7207200, 65345280},
+    {3,3,3, 9, 2,0, 7761600, 65345280},
+    {3,3,3, 9, 6,0, -33633600, 65345280},
+    {2,4,3, 1, 0,4, 2036736, 65345280},
+    {2,4,3, 3,-2,3, 685440, 65345280},
+    {2,4,3, 3, 0,3, 2239104, 65345280},
+    {2,4,3, 5,-4,2, -6283200, 65345280},
+    {2,4,3, 5, 0,2, -179520, 65345280},
+    {2,4,3, 7,-6,1, -5405400, 65345280},
+    {2,4,3, 7,-4,1, 4527600, 65345280},
+    {2,4,3, 7,-2,1, -709800, 65345280},
+    {2,4,3, 7, 0,1, -4410000, 65345280},
+    {2,4,3, 9,-6,0, 25225200, 65345280},
+    {2,4,3, 9,-4,0, 9609600, 65345280},
+    {2,4,3, 9,-2,0, -646800, 65345280},
+    {2,4,3, 9, 0,0, -3386880, 65345280},
+    {1,5,3, 3, 2,3, -6854400, 65345280},
+    {1,5,3, 5, 4,2, -10053120, 65345280},
+    {1,5,3, 7, 2,1, 7098000, 65345280},
+    {1,5,3, 7, 4,1, 7244160, 65345280},
+    {1,5,3, 7, 6,1, -2162160, 65345280},
+    {1,5,3, 9, 2,0, 6468000, 65345280},
+    {1,5,3, 9, 4,0, 15375360, 65345280},
+    {1,5,3, 9, 6,0, 10090080, 65345280},
+    {0,6,3, 1, 0,4, 3394560, 65345280},
+    {0,6,3, 3,-2,3, 10281600, 65345280},
+    {0,6,3, 3, 0,3, 3731840, 65345280},
+    {0,6,3, 5,-4,2, 3769920, 65345280},
+    {0,6,3, 5, 0,2, -299200, 65345280},
+    {0,6,3, 7,-6,1, 360360, 65345280},
+    {0,6,3, 7,-4,1, -2716560, 65345280},
+    {0,6,3, 7,-2,1, -10647000, 65345280},
+    {0,6,3, 7, 0,1, -7350000, 65345280},
+    {0,6,3, 9,-6,0, -1681680, 65345280},
+    {0,6,3, 9,-4,0, -5765760, 65345280},
+    {0,6,3, 9,-2,0, -9702000, 65345280},
+    {0,6,3, 9, 0,0, -5644800, 65345280},
+    {5,0,4, 1,-1,4, 5091840, 65345280},
+    {5,0,4, 3,-3,3, -1142400, 65345280},
+    {5,0,4, 3,-1,3, -6168960, 65345280},
+    {5,0,4, 5,-5,2, 62832, 65345280},
+    {5,0,4, 5,-3,2, 7854000, 65345280},
+    {5,0,4, 5,-1,2, -6732000, 65345280},
+    {5,0,4, 7,-5,1, -1330560, 65345280},
+    {5,0,4, 7,-3,1, -336000, 65345280},
+    {5,0,4, 7,-1,1, 4032000, 65345280},
+    {5,0,4, 9,-5,0, 2690688, 65345280},
+    {5,0,4, 9,-3,0, -11088000, 65345280},
+    {5,0,4, 9,-1,0, 18816000, 65345280},
+    {4,1,4, 1, 1,4, 1018368, 65345280},
+    {4,1,4, 3, 1,3, -1233792, 65345280},
+    {4,1,4, 3, 3,3, -2056320, 65345280},
+    {4,1,4, 5, 1,2, -1346400, 65345280},
+    {4,1,4, 5, 3,2, 14137200, 65345280},
+    {4,1,4, 5, 5,2, 314160, 65345280},
+    {4,1,4, 7, 1,1, 806400, 65345280},
+    {4,1,4, 7, 3,1, -604800, 65345280},
+    {4,1,4, 7, 5,1, -6652800, 65345280},
+    {4,1,4, 9, 1,0, 3763200, 65345280},
+    {4,1,4, 9, 3,0, -19958400, 65345280},
+    {4,1,4, 9, 5,0, 13453440, 65345280},
+    {3,2,4, 1,-1,4, 2036736, 65345280},
+    {3,2,4, 3,-3,3, 456960, 65345280},
+    {3,2,4, 3,-1,3, -2467584, 65345280},
+    {3,2,4, 5,-5,2, -628320, 65345280},
+    {3,2,4, 5,-3,2, -3141600, 65345280},
+    {3,2,4, 5,-1,2, -2692800, 65345280},
+    {3,2,4, 7,-5,1, 13305600, 65345280},
+    {3,2,4, 7,-3,1, 134400, 65345280},
+    {3,2,4, 7,-1,1, 1612800, 65345280},
+    {3,2,4, 9,-5,0, -26906880, 65345280},
+    {3,2,4, 9,-3,0, 4435200, 65345280},
+    {3,2,4, 9,-1,0, 7526400, 65345280},
+    {2,3,4, 1, 1,4, 2036736, 65345280},
+    {2,3,4, 3, 1,3, -2467584, 65345280},
+    {2,3,4, 3, 3,3, -456960, 65345280},
+    {2,3,4, 5, 1,2, -2692800, 65345280},
+    {2,3,4, 5, 3,2, 3141600, 65345280},
+    {2,3,4, 5, 5,2, -628320, 65345280},
+    {2,3,4, 7, 1,1, 1612800, 65345280},
+    {2,3,4, 7, 3,1, -134400, 65345280},
+    {2,3,4, 7, 5,1, 13305600, 65345280},
+    {2,3,4, 9, 1,0, 7526400, 65345280},
+    {2,3,4, 9, 3,0, -4435200, 65345280},
+    {2,3,4, 9, 5,0, -26906880, 65345280},
+    {1,4,4, 1,-1,4, 1018368, 65345280},
+    {1,4,4, 3,-3,3, 2056320, 65345280},
+    {1,4,4, 3,-1,3, -1233792, 65345280},
+    {1,4,4, 5,-5,2, 314160, 65345280},
+    {1,4,4, 5,-3,2, -14137200, 65345280},
+    {1,4,4, 5,-1,2, -1346400, 65345280},
+    {1,4,4, 7,-5,1, -6652800, 65345280},
+    {1,4,4, 7,-3,1, 604800, 65345280},
+    {1,4,4, 7,-1,1, 806400, 65345280},
+    {1,4,4, 9,-5,0, 13453440, 65345280},
+    {1,4,4, 9,-3,0, 19958400, 65345280},
+    {1,4,4, 9,-1,0, 3763200, 65345280},
+    {0,5,4, 1, 1,4, 5091840, 65345280},
+    {0,5,4, 3, 1,3, -6168960, 65345280},
+    {0,5,4, 3, 3,3, 1142400, 65345280},
+    {0,5,4, 5, 1,2, -6732000, 65345280},
+    {0,5,4, 5, 3,2, -7854000, 65345280},
+    {0,5,4, 5, 5,2, 62832, 65345280},
+    {0,5,4, 7, 1,1, 4032000, 65345280},
+    {0,5,4, 7, 3,1, 336000, 65345280},
+    {0,5,4, 7, 5,1, -1330560, 65345280},
+    {0,5,4, 9, 1,0, 18816000, 65345280},
+    {0,5,4, 9, 3,0, 11088000, 65345280},
+    {0,5,4, 9, 5,0, 2690688, 65345280},
+    {4,0,5, 1, 0,4, 5091840, 65345280},
+    {4,0,5, 3,-2,3, -6854400, 65345280},
+    {4,0,5, 3, 0,3, 456960, 65345280},
+    {4,0,5, 5,-4,2, 628320, 65345280},
+    {4,0,5, 5,-2,2, 7539840, 65345280},
+    {4,0,5, 5, 0,2, -6480672, 65345280},
+    {4,0,5, 7,-4,1, -3696000, 65345280},
+    {4,0,5, 7,-2,1, 1720320, 65345280},
+    {4,0,5, 7, 0,1, -282240, 65345280},
+    {4,0,5, 9,-4,0, 3843840, 65345280},
+    {4,0,5, 9,-2,0, -16558080, 65345280},
+    {4,0,5, 9, 0,0, 12192768, 65345280},
+    {3,1,5, 3, 2,3, -6854400, 65345280},
+    {3,1,5, 5, 2,2, 7539840, 65345280},
+    {3,1,5, 5, 4,2, 2513280, 65345280},
+    {3,1,5, 7, 2,1, 1720320, 65345280},
+    {3,1,5, 7, 4,1, -14784000, 65345280},
+    {3,1,5, 9, 2,0, -16558080, 65345280},
+    {3,1,5, 9, 4,0, 15375360, 65345280},
+    {2,2,5, 1, 0,4, 3394560, 65345280},
+    {2,2,5, 3, 0,3, 304640, 65345280},
+    {2,2,5, 5,-4,2, -3769920, 65345280},
+    {2,2,5, 5, 0,2, -4320448, 65345280},
+    {2,2,5, 7,-4,1, 22176000, 65345280},
+    {2,2,5, 7, 0,1, -188160, 65345280},
+    {2,2,5, 9,-4,0, -23063040, 65345280},
+    {2,2,5, 9, 0,0, 8128512, 65345280},
+    {1,3,5, 3, 2,3, -6854400, 65345280},
+    {1,3,5, 5, 2,2, 7539840, 65345280},
+    {1,3,5, 5, 4,2, -2513280, 65345280},
+    {1,3,5, 7, 2,1, 1720320, 65345280},
+    {1,3,5, 7, 4,1, 14784000, 65345280},
+    {1,3,5, 9, 2,0, -16558080, 65345280},
+    {1,3,5, 9, 4,0, -15375360, 65345280},
+    {0,4,5, 1, 0,4, 5091840, 65345280},
+    {0,4,5, 3,-2,3, 6854400, 65345280},
+    {0,4,5, 3, 0,3, 456960, 65345280},
+    {0,4,5, 5,-4,2, 628320, 65345280},
+    {0,4,5, 5,-2,2, -7539840, 65345280},
+    {0,4,5, 5, 0,2, -6480672, 65345280},
+    {0,4,5, 7,-4,1, -3696000, 65345280},
+    {0,4,5, 7,-2,1, -1720320, 65345280},
+    {0,4,5, 7, 0,1, -282240, 65345280},
+    {0,4,5, 9,-4,0, 3843840, 65345280},
+    {0,4,5, 9,-2,0, 16558080, 65345280},
+    {0,4,5, 9, 0,0, 12192768, 65345280},
+    {3,0,6, 1,-1,4, 3394560, 65345280},
+    {3,0,6, 3,-3,3, -190400, 65345280},
+    {3,0,6, 3,-1,3, -13823040, 65345280},
+    {3,0,6, 5,-3,2, 3351040, 65345280},
+    {3,0,6, 5,-1,2, 718080, 65345280},
+    {3,0,6, 7,-3,1, -8064000, 65345280},
+    {3,0,6, 7,-1,1, 13009920, 65345280},
+    {3,0,6, 9,-3,0, 4730880, 65345280},
+    {3,0,6, 9,-1,0, -18063360, 65345280},
+    {2,1,6, 1, 1,4, 1131520, 65345280},
+    {2,1,6, 3, 1,3, -4607680, 65345280},
+    {2,1,6, 3, 3,3, -571200, 65345280},
+    {2,1,6, 5, 1,2, 239360, 65345280},
+    {2,1,6, 5, 3,2, 10053120, 65345280},
+    {2,1,6, 7, 1,1, 4336640, 65345280},
+    {2,1,6, 7, 3,1, -24192000, 65345280},
+    {2,1,6, 9, 1,0, -6021120, 65345280},
+    {2,1,6, 9, 3,0, 14192640, 65345280},
+    {1,2,6, 1,-1,4, 1131520, 65345280},
+    {1,2,6, 3,-3,3, 571200, 65345280},
+    {1,2,6, 3,-1,3, -4607680, 65345280},
+    {1,2,6, 5,-3,2, -10053120, 65345280},
+    {1,2,6, 5,-1,2, 239360, 65345280},
+    {1,2,6, 7,-3,1, 24192000, 65345280},
+    {1,2,6, 7,-1,1, 4336640, 65345280},
+    {1,2,6, 9,-3,0, -14192640, 65345280},
+    {1,2,6, 9,-1,0, -6021120, 65345280},
+    {0,3,6, 1, 1,4, 3394560, 65345280},
+    {0,3,6, 3, 1,3, -13823040, 65345280},
+    {0,3,6, 3, 3,3, 190400, 65345280},
+    {0,3,6, 5, 1,2, 718080, 65345280},
+    {0,3,6, 5, 3,2, -3351040, 65345280},
+    {0,3,6, 7, 1,1, 13009920, 65345280},
+    {0,3,6, 7, 3,1, 8064000, 65345280},
+    {0,3,6, 9, 1,0, -18063360, 65345280},
+    {0,3,6, 9, 3,0, -4730880, 65345280},
+    {2,0,7, 1, 0,4, 7920640, 65345280},
+    {2,0,7, 3,-2,3, -2665600, 65345280},
+    {2,0,7, 3, 0,3, -1599360, 65345280},
+    {2,0,7, 5,-2,2, 11728640, 65345280},
+    {2,0,7, 5, 0,2, -4021248, 65345280},
+    {2,0,7, 7,-2,1, -13547520, 65345280},
+    {2,0,7, 7, 0,1, 12938240, 65345280},
+    {2,0,7, 9,-2,0, 4730880, 65345280},
+    {2,0,7, 9, 0,0, -6193152, 65345280},
+    {1,1,7, 3, 2,3, -5331200, 65345280},
+    {1,1,7, 5, 2,2, 23457280, 65345280},
+    {1,1,7, 7, 2,1, -27095040, 65345280},
+    {1,1,7, 9, 2,0, 9461760, 65345280},
+    {0,2,7, 1, 0,4, 7920640, 65345280},
+    {0,2,7, 3,-2,3, 2665600, 65345280},
+    {0,2,7, 3, 0,3, -1599360, 65345280},
+    {0,2,7, 5,-2,2, -11728640, 65345280},
+    {0,2,7, 5, 0,2, -4021248, 65345280},
+    {0,2,7, 7,-2,1, 13547520, 65345280},
+    {0,2,7, 7, 0,1, 12938240, 65345280},
+    {0,2,7, 9,-2,0, -4730880, 65345280},
+    {0,2,7, 9, 0,0, -6193152, 65345280},
+    {1,0,8, 1,-1,4, 1980160, 65345280},
+    {1,0,8, 3,-1,3, -17059840, 65345280},
+    {1,0,8, 5,-1,2, 26808320, 65345280},
+    {1,0,8, 7,-1,1, -16056320, 65345280},
+    {1,0,8, 9,-1,0, 3440640, 65345280},
+    {0,1,8, 1, 1,4, 1980160, 65345280},
+    {0,1,8, 3, 1,3, -17059840, 65345280},
+    {0,1,8, 5, 1,2, 26808320, 65345280},
+    {0,1,8, 7, 1,1, -16056320, 65345280},
+    {0,1,8, 9, 1,0, 3440640, 65345280},
+    {0,0,9, 1, 0,4, 17821440, 65345280},
+    {0,0,9, 3, 0,3, -25589760, 65345280},
+    {0,0,9, 5, 0,2, 16084992, 65345280},
+    {0,0,9, 7, 0,1, -5160960, 65345280},
+    {0,0,9, 9, 0,0, 688128, 65345280},
+  }; // sho_unitary_table
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
@@ -31,12 +31,14 @@
 #include "density_generator.hxx" // ::density, ::atom_coefficients
 #include "multi_grid.hxx" // ::restrict3D, ::interpolate3D
 #include "brillouin_zone.hxx" // ::get_kpoint_mesh, ::needs_complex, ::WEIGHT
+#include "symmetry_group.hxx" // ::find_crystal_symmetries, ::symmetrize_on_grid, ::symmetrize_atom_matrices
 #include "plane_wave.hxx" // ::solve, ::DensityIngredients
 #include "sho_hamiltonian.hxx" // ::solve
 #include "print_tools.hxx" // print_stats
 #include "complex_tools.hxx" // complex_name
 #include "status.hxx" // status_t
 #include "omp_parallel.hxx" // omp_get_num_threads
+#include "profiler.hxx" // ::region_t
 
 namespace structure_solver {
 
@@ -171,43 +173,46 @@ namespace structure_solver {
             if (num_threads > 1 && echo > 0) std::printf("# parallelize %d k-points by %d threads\n", nkpoints, num_threads);
         }
 
-        #pragma omp parallel for reduction(+:stat)
-        for (int ikpoint = 0; ikpoint < nkpoints; ++ikpoint) {
-            status_t stat_k(0);
-            auto const kp = op.set_kpoint(kmesh[ikpoint], echo);
-            auto psi_k = psi[ikpoint]; // get a mutable sub-view
-
-            // solve the Kohn-Sham equation using various solvers
-            if ('c' == *grid_eigensolver_method) { // "cg" or "conjugate_gradients"
-                stat_k += davidson_solver::rotate(psi_k.data(), energies[ikpoint], nbands, op, kp, echo);
-                for (int irepeat = 0; irepeat < nrepeat; ++irepeat) {
-                    if (echo > 6) { std::printf("# SCF cycle #%i, k-point #%i of %d, CG repetition #%i\n", scf_iteration, ikpoint, nkpoints, irepeat); std::fflush(stdout); }
-                    stat_k += conjugate_gradients::eigensolve(psi_k.data(), energies[ikpoint], nbands, op, kp, echo - 5);
+        { // scope: eigensolver for all k-points
+            profiler::region_t region("eigensolver");
+            #pragma omp parallel for reduction(+:stat)
+            for (int ikpoint = 0; ikpoint < nkpoints; ++ikpoint) {
+                status_t stat_k(0);
+                auto const kp = op.set_kpoint(kmesh[ikpoint], echo);
+                auto psi_k = psi[ikpoint]; // get a mutable sub-view
+
+                // solve the Kohn-Sham equation using various solvers
+                if ('c' == *grid_eigensolver_method) { // "cg" or "conjugate_gradients"
                     stat_k += davidson_solver::rotate(psi_k.data(), energies[ikpoint], nbands, op, kp, echo);
-                } // irepeat
-            } else
-            if ('d' == *grid_eigensolver_method) { // "davidson"
-                for (int irepeat = 0; irepeat < nrepeat; ++irepeat) {
-                    if (echo > 6) { std::printf("# SCF cycle #%i, k-point #%i of %d, DAV repetition #%i\n", scf_iteration, ikpoint, nkpoints, irepeat); std::fflush(stdout); }
-                    stat_k += davidson_solver::eigensolve(psi_k.data(), energies[ikpoint], nbands, op, kp, echo);
-                } // irepeat
-            } else
-            if ('e' == *grid_eigensolver_method) { // "explicit" dense matrix solver
-                view3D<wave_function_t> HSm(2, gc.all(), align<4>(gc.all()), 0.0); // get memory for the dense representation
-                op.construct_dense_operator(HSm(0,0), HSm(1,0), HSm.stride(), kp, echo);
-                char x_axis[96]; std::snprintf(x_axis, 96, "# %g %g %g spectrum ", kmesh(ikpoint,0),kmesh(ikpoint,1),kmesh(ikpoint,2));
-                stat_k += dense_solver::solve(HSm, x_axis, echo, nbands, energies[ikpoint]);
-                wave_function_t const factor = 1./std::sqrt(gc.dV()); // normalization factor?
-                for (int iband = 0; iband < nbands; ++iband) {
-                    set(psi_k[iband], gc.all(), HSm(0,iband), factor);
-                } // iband
-            } // grid_eigensolver_method
+                    for (int irepeat = 0; irepeat < nrepeat; ++irepeat) {
+                        if (echo > 6) { std::printf("# SCF cycle #%i, k-point #%i of %d, CG repetition #%i\n", scf_iteration, ikpoint, nkpoints, irepeat); std::fflush(stdout); }
+                        stat_k += conjugate_gradients::eigensolve(psi_k.data(), energies[ikpoint], nbands, op, kp, echo - 5);
+                        stat_k += davidson_solver::rotate(psi_k.data(), energies[ikpoint], nbands, op, kp, echo);
+                    } // irepeat
+                } else
+                if ('d' == *grid_eigensolver_method) { // "davidson"
+                    for (int irepeat = 0; irepeat < nrepeat; ++irepeat) {
+                        if (echo > 6) { std::printf("# SCF cycle #%i, k-point #%i of %d, DAV repetition #%i\n", scf_iteration, ikpoint, nkpoints, irepeat); std::fflush(stdout); }
+                        stat_k += davidson_solver::eigensolve(psi_k.data(), energies[ikpoint], nbands, op, kp, echo);
+                    } // irepeat
+                } else
+                if ('e' == *grid_eigensolver_method) { // "explicit" dense matrix solver
+                    view3D<wave_function_t> HSm(2, gc.all(), align<4>(gc.all()), 0.0); // get memory for the dense representation
+                    op.construct_dense_operator(HSm(0,0), HSm(1,0), HSm.stride(), kp, echo);
+                    char x_axis[96]; std::snprintf(x_axis, 96, "# %g %g %g spectrum ", kmesh(ikpoint,0),kmesh(ikpoint,1),kmesh(ikpoint,2));
+                    stat_k += dense_solver::solve(HSm, x_axis, echo, nbands, energies[ikpoint]);
+                    wave_function_t const factor = 1./std::sqrt(gc.dV()); // normalization factor?
+                    for (int iband = 0; iband < nbands; ++iband) {
+                        set(psi_k[iband], gc.all(), HSm(0,iband), factor);
+                    } // iband
+                } // grid_eigensolver_method
 
-//          if we used the fermi.level=linearized option, we could combine the Kohn-Sham
-//          equation solving for a k-point with the evaluation of the density contribution
+//              if we used the fermi.level=linearized option, we could combine the Kohn-Sham
+//              equation solving for a k-point with the evaluation of the density contribution
 
-            stat += stat_k; // reduction
-        } // ikpoint
+                stat += stat_k; // reduction
+            } // ikpoint
+        } // scope
         op.set_kpoint(); // reset to Gamma
 
         here;
@@ -238,15 +243,24 @@ namespace structure_solver {
         here;
 
         // density generation
+        profiler::region_t region_density("density", 2.*nkpoints*nbands*gc.all()*sizeof(wave_function_t));
+        // the projections onto the atomic projectors are independent for each k-point
+        std::vector<view2D<wave_function_t>> atom_coeff(nkpoints);
+        std::vector<std::vector<uint32_t>> coeff_starts(nkpoints);
+        #pragma omp parallel for schedule(dynamic)
         for (int ikpoint = 0; ikpoint < nkpoints; ++ikpoint) {
             auto const kp = op.set_kpoint(kmesh[ikpoint], echo);
-            double const kpoint_weight = kmesh(ikpoint,brillouin_zone::WEIGHT);
-            std::vector<uint32_t> coeff_starts;
-            auto const atom_coeff = density_generator::atom_coefficients(coeff_starts,
+            atom_coeff[ikpoint] = density_generator::atom_coefficients(coeff_starts[ikpoint],
                                             psi(ikpoint,0), op, kp, nbands, echo/2, ikpoint);
+        } // ikpoint
+
+        // the accumulation runs over the k-points in order (occupation numbers and the
+        // Fermi level statistics are accumulated here), each k-point is threaded over the grid
+        for (int ikpoint = 0; ikpoint < nkpoints; ++ikpoint) {
+            double const kpoint_weight = kmesh(ikpoint,brillouin_zone::WEIGHT);
             stat += density_generator::density(rho_valence_gc[0], atom_rho_new[0].data(), Fermi,
-                                            energies[ikpoint], psi(ikpoint,0), atom_coeff.data(),
-                                            coeff_starts.data(), na, gc, nbands, kpoint_weight, echo/2, ikpoint,
+                                            energies[ikpoint], psi(ikpoint,0), atom_coeff[ikpoint].data(),
+                                            coeff_starts[ikpoint].data(), na, gc, nbands, kpoint_weight, echo/2, ikpoint,
                                             rho_valence_gc[1], atom_rho_new[1].data(), charges);
         } // ikpoint
         op.set_kpoint(); // reset to Gamma
@@ -259,6 +273,10 @@ namespace structure_solver {
         return dump_to_file(filename, nbands, psi(0,0), nullptr, psi.stride(), gc.all(), "wave functions", echo);
     } // store
 
+    // raw access to the wave functions of all k-points for binary checkpoints
+    size_t wave_function_bytes() const { return size_t(nkpoints)*psi.dim1()*psi.stride()*sizeof(wave_function_t); }
+    void * wave_function_data() const { return psi.data(); }
+
     ~KohnShamStates() {
 #ifdef    DEBUG
         std::printf("# ~KohnShamStates<%s>\n", complex_name<wave_function_t>());
@@ -316,8 +334,32 @@ namespace structure_solver {
         key = (*basis_method) | 32; // lower case
         psi_on_grid = ((*basis_method | 32) == 'g');
 
+        std::vector<int8_t> rotations; // point group operations for the k-point mesh reduction
+        if (control::get("hamiltonian.kmesh.symmetries", 1.) > 1) {
+            if (psi_on_grid && g.is_Cartesian() && 3 == g.number_of_boundary_conditions(Periodic_Boundary)) {
+                // symmetry operations of cell and atoms that map the coarse grid onto itself
+                double cell[3], hc[3];
+                for (int d = 0; d < 3; ++d) {
+                    cell[d] = g.cell[d][d];
+                    hc[d] = cell[d]/std::max(1, g[d]/2);
+                } // d
+                symmetries = symmetry_group::find_crystal_symmetries(cell, hc, xyzZinso.data(), na, xyzZinso.stride(), echo);
+                rotations.resize(symmetries.size()*3*3);
+                for (size_t iop = 0; iop < symmetries.size(); ++iop) {
+                    set(&rotations[iop*3*3], 3*3, symmetries[iop].rotation[0]);
+                } // iop
+                numax.resize(na);
+                for (int ia = 0; ia < na; ++ia) {
+                    numax[ia] = xyzZinso(ia,5);
+                } // ia
+                if (echo > 1) std::printf("# use %ld symmetry operations to reduce the k-point mesh\n", symmetries.size());
+            } else {
+                warn("hamiltonian.kmesh.symmetries needs basis=grid, a Cartesian cell and periodic boundary conditions", 0);
+            }
+        } // use symmetries
+
         // get a default kmesh controlled by +hamiltonian.kmesh or +hamiltonian.kmesh.x, .y, .z
-        nkpoints = brillouin_zone::get_kpoint_mesh(kmesh);
+        nkpoints = brillouin_zone::get_kpoint_mesh(kmesh, (int8_t const (*)[3][3])rotations.data(), rotations.size()/(3*3));
         if (echo > 1) std::printf("# k-point mesh has %d points\n", nkpoints);
         // ToDo: warn if boundary_condition is isolated but there is more than 1 kpoint
 
@@ -431,6 +473,15 @@ namespace structure_solver {
             if (d) d->solve(rho_valence_gc, atom_rho_new, energies, charges, Fermi, Veff, atom_mat, occupation_method, solver_method, scf, echo);
             if (s) s->solve(rho_valence_gc, atom_rho_new, energies, charges, Fermi, Veff, atom_mat, occupation_method, solver_method, scf, echo);
 
+            if (symmetries.size() > 1) {
+                // the irreducible k-points produce a density of lower symmetry, restore the full crystal symmetry
+                int const n[] = {int(gc[0]), int(gc[1]), int(gc[2])};
+                for (int i01 = 0; i01 < 2; ++i01) { // valence and response density
+                    stat += symmetry_group::symmetrize_on_grid(rho_valence_gc[i01], n, symmetries, echo);
+                    stat += symmetry_group::symmetrize_atom_matrices(atom_rho_new[i01].data(), natoms, numax.data(), symmetries, echo);
+                } // i01
+            } // symmetries
+
             auto const dcc_coarse = dot_product(gc.all(), rho_valence_gc[0], Veff.data()) * gc.dV();
             if (echo > 4) std::printf("\n# double counting (coarse grid) %.9f %s\n", dcc_coarse*eV, _eV);
             // beware: if fermi.level=linearized, dcc_coarse is computed from uncorrected densities
@@ -501,6 +552,25 @@ namespace structure_solver {
         return nerrors;
     } // store
 
+    size_t wave_function_bytes() const { // 0 unless the wave functions are stored on a real-space grid
+        if (!psi_on_grid) return 0;
+        if (z) return z->wave_function_bytes();
+        if (c) return c->wave_function_bytes();
+        if (d) return d->wave_function_bytes();
+        if (s) return s->wave_function_bytes();
+        return 0;
+    } // wave_function_bytes
+
+    void * wave_function_data() const {
+        if (z) return z->wave_function_data();
+        if (c) return c->wave_function_data();
+        if (d) return d->wave_function_data();
+        if (s) return s->wave_function_data();
+        return nullptr;
+    } // wave_function_data
+
+    char wave_function_type() const { return psi_on_grid ? key : '\0'; } // 'z', 'c', 'd' or 's'
+
   private:
     
       void sanity_check() {
@@ -522,6 +592,7 @@ namespace structure_solver {
       std::vector<double> sigma_a;
       std::vector<int> numax;
       view2D<double> const & xyzZ;
+      std::vector<symmetry_group::crystal_symmetry_t> symmetries; // empty: no density symmetrization
 
       // 2x2 versions for real space Kohn-Sham wave functions
       KohnShamStates<std::complex<double>> *z = nullptr;
@@ -4,14 +4,17 @@
 #include <cstdio> // std::printf, std::snprintf
 #include <cstdint> // uint32_t, int32_t
 #include <vector> // std::vector<T>
+#include <cmath> // std::abs, ::round
+#include <algorithm> // std::min, ::max
 
 #include "status.hxx" // status_t
 #include "geometry_analysis.hxx" // ::read_xyz_file
 #include "data_view.hxx" // view2D<>, view3D<>
 #include "display_units.h" // Ang, _Ang
-#include "inline_math.hxx" // set
+#include "inline_math.hxx" // set, pow2
 #include "print_tools.hxx" // printf_vector(format, vec, n, final, scale, add)
 #include "simple_math.hxx" // ::invert3x3, ::determinant
+#include "sho_tools.hxx" // ::nSHO, ::zyx_index
 #include "recorded_warnings.hxx" // warn, error
 
 namespace symmetry_group {
@@ -203,6 +206,215 @@ namespace symmetry_group {
   } // generate_cubic_symmetry_matrix
 
 
+  struct crystal_symmetry_t {
+      int8_t rotation[3][3]; // signed permutation matrix acting on Cartesian coordinates
+      int32_t shift[3]; // fractional translation in units of grid points
+      std::vector<int32_t> atom_image; // atom #ia is mapped onto atom #atom_image[ia]
+  }; // crystal_symmetry_t
+
+  inline std::vector<crystal_symmetry_t> find_crystal_symmetries(
+        double const cell[3] // lengths of a Cartesian cell
+      , double const grid_spacing[3] // translations must be integer multiples of the grid spacings
+      , double const xyzZ[] // atom positions relative to the cell center, Z, and more species info
+      , int const natoms
+      , int const stride=4 // columns 3 (Z), 5 (numax) and 6 (sigma) must agree between images
+      , int const echo=0 // log-level
+      , double const tolerance=1e-6 // in Bohr
+  ) {
+      // find the subset of the 48 cubic point group operations (signed permutations)
+      // that map the cell, the grid and the atoms (possibly with a fractional translation) onto themselves
+      std::vector<crystal_symmetry_t> ops;
+      int ncell{0}, ngrid{0};
+      for (int i48 = 0; i48 < 48; ++i48) {
+          crystal_symmetry_t op;
+          generate_cubic_symmetry_matrix(op.rotation, i48);
+          int perm[3]; // (R x)_i = sign_i x_{perm_i}
+          for (int i = 0; i < 3; ++i) {
+              for (int j = 0; j < 3; ++j) if (0 != op.rotation[i][j]) perm[i] = j;
+          } // i
+          bool lattice{true};
+          for (int i = 0; i < 3; ++i) {
+              lattice = lattice && (std::abs(cell[i] - cell[perm[i]]) < tolerance)
+                                && (std::abs(grid_spacing[i] - grid_spacing[perm[i]]) < tolerance);
+          } // i
+          if (!lattice) continue;
+          ++ncell;
+
+          auto const same_species = [xyzZ, stride] (int const ia, int const ja) {
+              for (int c = 3; c < std::min(stride, 7); ++c) {
+                  if (4 != c && std::abs(xyzZ[ia*stride + c] - xyzZ[ja*stride + c]) > 1e-12) return false;
+              } // c
+              return true;
+          }; // same_species
+
+          auto const image_of = [&] (int const ia, double const t[3]) { // find the image of atom #ia
+              double const *const pos = &xyzZ[ia*stride];
+              double Rx[3];
+              for (int i = 0; i < 3; ++i) {
+                  Rx[i] = op.rotation[i][perm[i]]*pos[perm[i]] + t[i];
+              } // i
+              for (int ja = 0; ja < natoms; ++ja) {
+                  if (same_species(ia, ja)) {
+                      double d2{0};
+                      for (int i = 0; i < 3; ++i) {
+                          auto const d = Rx[i] - xyzZ[ja*stride + i];
+                          d2 += pow2(d - cell[i]*std::round(d/cell[i])); // periodic images
+                      } // i
+                      if (d2 < pow2(tolerance)) return ja;
+                  } // same species
+              } // ja
+              return -1; // not found
+          }; // image_of
+
+          // candidate translations move atom #0 onto an atom of the same species
+          bool found{(natoms < 1)};
+          double t[3] = {0, 0, 0};
+          for (int ja = 0; ja < natoms && !found; ++ja) {
+              if (!same_species(0, ja)) continue;
+              for (int i = 0; i < 3; ++i) {
+                  t[i] = xyzZ[ja*stride + i] - op.rotation[i][perm[i]]*xyzZ[0*stride + perm[i]];
+              } // i
+              op.atom_image.resize(natoms);
+              found = true;
+              for (int ia = 0; ia < natoms && found; ++ia) {
+                  op.atom_image[ia] = image_of(ia, t);
+                  found = (op.atom_image[ia] >= 0);
+              } // ia
+          } // ja
+          if (!found) continue;
+
+          bool on_grid{true};
+          for (int i = 0; i < 3; ++i) {
+              auto const tc = t[i] - cell[i]*std::round(t[i]/cell[i]);
+              auto const s = tc/grid_spacing[i];
+              op.shift[i] = std::round(s);
+              on_grid = on_grid && (std::abs(s - op.shift[i])*grid_spacing[i] < tolerance);
+          } // i
+          if (!on_grid) {
+              if (echo > 7) std::printf("# %s: operation #%d needs a translation off the grid\n", __func__, i48);
+              continue;
+          } // on_grid
+          ++ngrid;
+          if (echo > 9) {
+              char str[4] = "???"; get_string(str, op.rotation);
+              std::printf("# %s: operation #%d %s with shift %d %d %d grid points\n", __func__,
+                            i48, str, op.shift[0], op.shift[1], op.shift[2]);
+          } // echo
+          ops.push_back(op);
+      } // i48
+      if (echo > 3) std::printf("# %s: %d of 48 operations leave the cell invariant, %d the atoms and the grid\n",
+                                    __func__, ncell, ngrid);
+      assert(ops.size() > 0 && "the identity must always be found");
+      return ops;
+  } // find_crystal_symmetries
+
+
+  template <typename real_t>
+  inline status_t symmetrize_on_grid(
+        real_t values[] // in/out, data layout [n[2]][n[1]][n[0]]
+      , int const n[3] // grid dimensions, the grid points are centered in the cell
+      , std::vector<crystal_symmetry_t> const & ops
+      , int const echo=0 // log-level
+  ) {
+      int const nops = ops.size();
+      if (nops < 2) return 0; // only the identity
+      size_t const nall = size_t(n[2])*size_t(n[1])*size_t(n[0]);
+      std::vector<double> sym(nall, 0.0);
+      for (int iop = 0; iop < nops; ++iop) {
+          auto const & op = ops[iop];
+          int perm[3], sign[3];
+          for (int i = 0; i < 3; ++i) {
+              for (int j = 0; j < 3; ++j) if (0 != op.rotation[i][j]) { perm[i] = j; sign[i] = op.rotation[i][j]; }
+              if (n[i] != n[perm[i]]) return 1 + i; // grid is not compatible with this operation
+          } // i
+          int j[3];
+          for (j[2] = 0; j[2] < n[2]; ++j[2]) {
+          for (j[1] = 0; j[1] < n[1]; ++j[1]) {
+          for (j[0] = 0; j[0] < n[0]; ++j[0]) {
+              // grid point j sits at (j - (n - 1)/2)*h, so its image is at index sign*(j - (n - 1)/2) + (n - 1)/2 + shift
+              int k[3];
+              for (int i = 0; i < 3; ++i) {
+                  auto const jp = j[perm[i]];
+                  k[i] = ((sign[i] > 0) ? jp : (n[i] - 1 - jp)) + op.shift[i];
+                  k[i] = ((k[i] % n[i]) + n[i]) % n[i]; // periodic
+              } // i
+              sym[(size_t(j[2])*n[1] + j[1])*n[0] + j[0]] += values[(size_t(k[2])*n[1] + k[1])*n[0] + k[0]];
+          }}} // j
+      } // iop
+      double const by_nops = 1./nops;
+      double dev{0};
+      for (size_t izyx = 0; izyx < nall; ++izyx) {
+          auto const v = sym[izyx]*by_nops;
+          dev = std::max(dev, std::abs(v - values[izyx]));
+          values[izyx] = v;
+      } // izyx
+      if (echo > 5) std::printf("# %s with %d operations, largest change %.1e\n", __func__, nops, dev);
+      return 0;
+  } // symmetrize_on_grid
+
+
+  inline status_t symmetrize_atom_matrices(
+        double *const atom_mat[] // in/out, square matrices in SHO order_zyx
+      , int const natoms
+      , int const numax[] // SHO basis size for each atom
+      , std::vector<crystal_symmetry_t> const & ops
+      , int const echo=0 // log-level
+  ) {
+      // a 3D SHO basis function transforms as phi_{nx,ny,nz}(R^T u) = sign*phi_{n'}(u)
+      // with n'_i = n_{perm_i} and sign = prod_i sign_i^{n_{perm_i}}
+      int const nops = ops.size();
+      if (nops < 2) return 0; // only the identity
+      std::vector<std::vector<double>> sym(natoms);
+      for (int ia = 0; ia < natoms; ++ia) {
+          sym[ia].assign(pow2(sho_tools::nSHO(numax[ia])), 0.0);
+      } // ia
+      for (int iop = 0; iop < nops; ++iop) {
+          auto const & op = ops[iop];
+          int perm[3], sign[3];
+          for (int i = 0; i < 3; ++i) {
+              for (int j = 0; j < 3; ++j) if (0 != op.rotation[i][j]) { perm[i] = j; sign[i] = op.rotation[i][j]; }
+          } // i
+          for (int ia = 0; ia < natoms; ++ia) {
+              int const ja = op.atom_image[ia];
+              if (numax[ja] != numax[ia]) return 1; // images must be of the same species
+              int const nb = sho_tools::nSHO(numax[ia]);
+              std::vector<int> index(nb), phase(nb);
+              for (int nz = 0; nz <= numax[ia]; ++nz) {
+                  for (int ny = 0; ny <= numax[ia] - nz; ++ny) {
+                      for (int nx = 0; nx <= numax[ia] - nz - ny; ++nx) {
+                          int const nn[] = {nx, ny, nz};
+                          int mm[3], s{1};
+                          for (int i = 0; i < 3; ++i) {
+                              mm[i] = nn[perm[i]];
+                              if ((sign[i] < 0) && (mm[i] & 1)) s = -s;
+                          } // i
+                          int const izyx = sho_tools::zyx_index(numax[ia], nx, ny, nz);
+                          index[izyx] = sho_tools::zyx_index(numax[ia], mm[0], mm[1], mm[2]);
+                          phase[izyx] = s;
+                      } // nx
+                  } // ny
+              } // nz
+              for (int ib = 0; ib < nb; ++ib) {
+                  for (int jb = 0; jb < nb; ++jb) {
+                      sym[ja][index[ib]*nb + index[jb]] += phase[ib]*phase[jb]*atom_mat[ia][ib*nb + jb];
+                  } // jb
+              } // ib
+          } // ia
+      } // iop
+      double const by_nops = 1./nops;
+      double dev{0};
+      for (int ia = 0; ia < natoms; ++ia) {
+          for (size_t ij = 0; ij < sym[ia].size(); ++ij) {
+              auto const v = sym[ia][ij]*by_nops;
+              dev = std::max(dev, std::abs(v - atom_mat[ia][ij]));
+              atom_mat[ia][ij] = v;
+          } // ij
+      } // ia
+      if (echo > 5) std::printf("# %s with %d operations, largest change %.1e\n", __func__, nops, dev);
+      return 0;
+  } // symmetrize_atom_matrices
+
+
 #ifdef NO_UNIT_TESTS
   inline status_t all_tests(int const echo=0) { return STATUS_TEST_NOT_INCLUDED; }
 #else // NO_UNIT_TESTS
@@ -424,8 +636,72 @@ namespace symmetry_group {
       return stat;
   } // test_check_group48
 
+  inline status_t test_crystal_symmetries(int const echo=0) {
+      status_t stat(0);
+      double const h[] = {0.5, 0.5, 0.5}; // grid spacing in Bohr
+      double const cubic[] = {8., 8., 8.}, tetragonal[] = {8., 8., 10.};
+      //                   x    y    z    Z  id numax sigma
+      double const xyzZ[] = {0,   0,   0,  14,  0,  3,  .5,
+                             4,   4,   4,   8,  1,  2,  .5,  // at the corner, equivalent to -4,-4,-4
+                             0,   0,   1,   1,  2,  1,  .5}; // off-center
+      int const stride = 7;
+      int const expected[] = {48, 48, 8, 16}, natoms_case[] = {1, 2, 3, 1};
+      for (int t = 0; t < 4; ++t) {
+          int const natoms = natoms_case[t];
+          auto const ops = find_crystal_symmetries((3 == t) ? tetragonal : cubic, h, xyzZ, natoms, stride, echo);
+          if (echo > 3) std::printf("# %s: case %d with %d atoms has %ld symmetry operations, expected %d\n",
+                                        __func__, t, natoms, ops.size(), expected[t]);
+          stat += (int(ops.size()) != expected[t]);
+      } // t
+
+      { // scope: symmetrization must conserve the integral and be idempotent
+          auto const ops = find_crystal_symmetries(cubic, h, xyzZ, 2, stride, echo);
+          int const n[] = {16, 16, 16};
+          int const nall = n[2]*n[1]*n[0];
+          std::vector<double> rho(nall);
+          double sum0{0};
+          for (int i = 0; i < nall; ++i) { rho[i] = (i*7919 % 1009)*1e-3; sum0 += rho[i]; }
+          stat += symmetrize_on_grid(rho.data(), n, ops, echo);
+          auto const rho1 = rho;
+          stat += symmetrize_on_grid(rho.data(), n, ops, echo);
+          double sum1{0}, dev{0};
+          for (int i = 0; i < nall; ++i) { sum1 += rho[i]; dev = std::max(dev, std::abs(rho[i] - rho1[i])); }
+          if (echo > 3) std::printf("# %s: grid symmetrization changes the sum by %.1e, deviation in 2nd application %.1e\n",
+                                        __func__, sum1 - sum0, dev);
+          stat += (std::abs(sum1 - sum0) > 1e-9*std::abs(sum0)) + (dev > 1e-12);
+
+          int const numax[] = {3, 2};
+          std::vector<std::vector<double>> mat(2);
+          double *ptr[2];
+          for (int ia = 0; ia < 2; ++ia) {
+              int const nb = sho_tools::nSHO(numax[ia]);
+              mat[ia].resize(nb*nb);
+              for (int ij = 0; ij < nb*nb; ++ij) mat[ia][ij] = ((ij + ia)*7919 % 101)*1e-2;
+              ptr[ia] = mat[ia].data();
+          } // ia
+          stat += symmetrize_atom_matrices(ptr, 2, numax, ops, echo);
+          auto const mat1 = mat;
+          stat += symmetrize_atom_matrices(ptr, 2, numax, ops, echo);
+          double devm{0};
+          for (int ia = 0; ia < 2; ++ia) {
+              for (size_t ij = 0; ij < mat[ia].size(); ++ij) devm = std::max(devm, std::abs(mat[ia][ij] - mat1[ia][ij]));
+          } // ia
+          // the p-block of an atom in a cubic site must be a multiple of the unit matrix: (px,px) == (pz,pz) and (px,py) == 0
+          int const nb = sho_tools::nSHO(numax[0]);
+          int const ix = sho_tools::zyx_index(numax[0], 1, 0, 0),
+                    iy = sho_tools::zyx_index(numax[0], 0, 1, 0),
+                    iz = sho_tools::zyx_index(numax[0], 0, 0, 1);
+          devm = std::max(devm, std::abs(mat[0][ix*nb + ix] - mat[0][iz*nb + iz]));
+          devm = std::max(devm, std::abs(mat[0][ix*nb + iy]));
+          if (echo > 3) std::printf("# %s: atom matrix symmetrization deviates by %.1e\n", __func__, devm);
+          stat += (devm > 1e-12);
+      } // scope
+      return stat;
+  } // test_crystal_symmetries
+
   inline status_t all_tests(int const echo=0) {
       status_t stat(0);
+      stat += test_crystal_symmetries(echo);
       stat += test_symmetry_group(echo);
       stat += test_generate_group(echo);
       stat += test_check_group24(echo);
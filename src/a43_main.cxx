@@ -18,6 +18,8 @@
   #include "fourier_transform.hxx" // ::all_tests
   #include "iterative_poisson.hxx" // ::all_tests
   #include "self_consistency.hxx" // ::all_tests
+  #include "kernel_benchmark.hxx" // ::all_tests
+  #include "scf_checkpoint.hxx" // ::all_tests
   #include "radial_potential.hxx" // ::all_tests
   #include "bessel_transform.hxx" // ::all_tests
   #include "parallel_domains.hxx" // ::all_tests
@@ -73,6 +75,7 @@
   #include "sho_basis.hxx" // ::all_tests
   #include "atom_core.hxx" // ::all_tests
   #include "data_view.hxx" // ::all_tests
+  #include "profiler.hxx" // ::all_tests
   #include "control.hxx" // ::all_tests
 
   // "green_*.hxx" headers requiring CUDA are included in green_tests.cu/green_tests.cxx
@@ -91,6 +94,7 @@
 
 #include "recorded_warnings.hxx" // warn, ::show_warnings, ::clear_warnings
 #include "simple_timer.hxx" // SimpleTimer
+#include "profiler.hxx" // ::show, ::write_report
 #include "unit_system.hxx" // ::set_output_units
 #include "control.hxx" // ::command_line_interface, ::get
 
@@ -137,6 +141,7 @@
           add_module_test(recorded_warnings);
           add_module_test(simple_stats);
           add_module_test(simple_timer);
+          add_module_test(profiler);
           add_module_test(progress_report);
           add_module_test(json_reading);
           add_module_test(xml_reading);
@@ -227,6 +232,7 @@
           add_module_test(davidson_solver);
           add_module_test(dense_solver);
           add_module_test(structure_solver);
+          add_module_test(kernel_benchmark);
 
           start_a_chapter("DFT-specific"); // *****************************************
           add_module_test(symmetry_group);
@@ -236,6 +242,7 @@
           add_module_test(potential_generator);
           add_module_test(density_generator);
           add_module_test(self_consistency);
+          add_module_test(scf_checkpoint);
 
           start_a_chapter("================"); // last separator
 #undef    start_a_chapter
@@ -414,6 +421,9 @@
           }
       } // show all variable names defined in the control environment
 
+      stat += profiler::show(control::get("profiler.show", 0.)*echo);
+      stat += profiler::write_report(control::get("profiler.file", ""), echo);
+
       if (echo > 0) recorded_warnings::show_warnings(3);
       recorded_warnings::clear_warnings(1);
       return int(stat);
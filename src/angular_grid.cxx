@@ -12,7 +12,7 @@
 
 #include "status.hxx" // status_t
 #include "constants.hxx" // ::pi
-#include "inline_math.hxx" // pow2, align<nBits>, dot_product
+#include "inline_math.hxx" // pow2, align<nBits>, dot_product, set
 #include "solid_harmonics.hxx" // ::rlXlm, ::cleanup
 #include "spherical_harmonics.hxx" // ::Ylm, ::cleanup
 #include "gaunt_entry.h" // gaunt_entry_t
@@ -1790,28 +1790,78 @@ namespace angular_grid {
       return linear_algebra::gemm(M, N, K, out, M, b, ldb, in, M);
   } // transform
 
+  status_t transform(
+        double *const out[] // resulting matrices, one per block
+      , double const *const in[] // input matrices, one per block
+      , int const nblocks // number of blocks
+      , int const M[] // strides for in[ib] and out[ib]
+      , int const ellmax // largest angular momentum
+      , bool const back // =false:forward, true:backward transform
+      , int const echo // =0 log-level
+  ) {
+      if (nblocks < 1) return 0;
+      if (1 == nblocks) return transform(out[0], in[0], M[0], ellmax, back, echo);
+      auto const g = get_grid(ellmax, echo);
+      if (nullptr == g) return -1;
+      int N, K, ldb;
+      double const *b;
+      if (back) { N = pow2(1 + ellmax); K = g->npoints; b = g->grid2Xlm; ldb = g->grid2Xlm_stride; }
+      else      { K = pow2(1 + ellmax); N = g->npoints; b = g->Xlm2grid; ldb = g->Xlm2grid_stride; }
+
+      // pack all blocks side by side to run a single matrix-matrix multiplication
+      std::vector<int> offset(nblocks + 1, 0);
+      for (int ib = 0; ib < nblocks; ++ib) {
+          offset[ib + 1] = offset[ib] + M[ib];
+      } // ib
+      int const MM = offset[nblocks];
+      if (echo > 7) std::printf("# %s: %d blocks with %d columns for ellmax= %d\n", __func__, nblocks, MM, ellmax);
+      std::vector<double> packed_in(K*size_t(MM)), packed_out(N*size_t(MM));
+      for (int k = 0; k < K; ++k) {
+          for (int ib = 0; ib < nblocks; ++ib) {
+              set(&packed_in[k*size_t(MM) + offset[ib]], M[ib], &in[ib][k*size_t(M[ib])]);
+          } // ib
+      } // k
+      auto const stat = linear_algebra::gemm(MM, N, K, packed_out.data(), MM, b, ldb, packed_in.data(), MM);
+      for (int n = 0; n < N; ++n) {
+          for (int ib = 0; ib < nblocks; ++ib) {
+              set(&out[ib][n*size_t(M[ib])], M[ib], &packed_out[n*size_t(MM) + offset[ib]]);
+          } // ib
+      } // n
+      return stat;
+  } // transform
+
   std::vector<gaunt_entry_t> create_numerical_Gaunt(int const ellmax, int const echo) {
       std::vector<gaunt_entry_t> gaunt_coeffs;
       auto const *const g = get_grid(2*ellmax);
       if (nullptr != g) {
           assert(2*ellmax == g->ellmax);
-          int const M = pow2(1 + ellmax), M2 = pow2(1 + 2*ellmax);
+          int const M = pow2(1 + ellmax), M2 = pow2(1 + 2*ellmax), MM = M*M;
           size_t const n_expected = (M2*M*M) >> 5; // estimate is good for ellmax=6
           gaunt_coeffs.reserve(n_expected); // try to avoid resizing
+          int const npt = g->npoints;
+
+          // products of two spherical harmonics on the grid, pair12(ipt, lm1*M + lm2)
+          std::vector<double> pair12(npt*size_t(MM));
+          for (int ipt = 0; ipt < npt; ++ipt) {
+              double const *const xlm = &(g->Xlm2grid[ipt*g->Xlm2grid_stride]);
+              double *const p12 = &pair12[ipt*size_t(MM)];
+              for (int lm1 = 0; lm1 < M; ++lm1) {
+                  set(&p12[lm1*M], M, xlm, xlm[lm1]);
+              } // lm1
+          } // ipt
+
+          // project onto the third spherical harmonic, grid2Xlm already contains the weights times 4pi
+          std::vector<double> Gaunt(M2*size_t(MM));
+          linear_algebra::gemm(MM, M2, npt, Gaunt.data(), MM, g->grid2Xlm, g->grid2Xlm_stride, pair12.data(), MM);
+
           size_t n{0}, nnz{0};
           for (int lm0 = 0; lm0 < M2; ++lm0) {
               for (int lm1 = 0; lm1 < M; ++lm1) {
                   for (int lm2 = 0; lm2 < M; ++lm2) {
-                      double Gaunt{0};
-                      for (int ipt = 0; ipt < g->npoints; ++ipt) {
-                          double const weight = g->xyzw[ipt][3];
-                          double const *const xlm = &(g->Xlm2grid[ipt*g->Xlm2grid_stride]);
-                          Gaunt += xlm[lm0] * xlm[lm1] * xlm[lm2] * weight;
-                      } // ipt
-                      Gaunt *= 4*constants::pi;
-                      if (std::abs(Gaunt) > 1e-14) {
-                          if (echo > 8) std::printf("%i %i %i %.9f\n", lm0, lm1, lm2, Gaunt);
-                          gaunt_coeffs.push_back({Gaunt, lm0, int16_t(lm1), int16_t(lm2)});
+                      double const G = Gaunt[lm0*size_t(MM) + lm1*M + lm2];
+                      if (std::abs(G) > 1e-14) {
+                          if (echo > 8) std::printf("%i %i %i %.9f\n", lm0, lm1, lm2, G);
+                          gaunt_coeffs.push_back({G, lm0, int16_t(lm1), int16_t(lm2)});
                           ++nnz;
                       } // non-zero
                       ++n;
@@ -1948,15 +1998,60 @@ namespace angular_grid {
       auto const gaunt_coeffs = create_numerical_Gaunt(ellmax, echo);
       double const dev = gaunt_coeffs[0].G - solid_harmonics::Y00;
       if (echo > 3) std::printf("# %s: Gaunt(00, 00,00) = Y00 + %.1e\n", __func__, dev);
-      return std::abs(dev) > 3e-16;
+      // compare to a direct quadrature
+      auto const *const g = get_grid(2*ellmax);
+      double maxdev{0};
+      for (auto const & e : gaunt_coeffs) {
+          double Gaunt{0};
+          for (int ipt = 0; ipt < g->npoints; ++ipt) {
+              double const *const xlm = &(g->Xlm2grid[ipt*g->Xlm2grid_stride]);
+              Gaunt += xlm[e.lm] * xlm[e.lm1] * xlm[e.lm2] * g->xyzw[ipt][3];
+          } // ipt
+          maxdev = std::max(maxdev, std::abs(Gaunt*4*constants::pi - e.G));
+      } // e
+      if (echo > 3) std::printf("# %s: %ld coefficients deviate %.1e from direct quadrature\n", __func__, gaunt_coeffs.size(), maxdev);
+      return (std::abs(dev) > 3e-16) + (maxdev > 1e-14);
   } // test_numerical_Gaunt
 
+  status_t test_batched_transform(int const echo=1, int const ellmax=6, int const nblocks=5) {
+      if (echo > 3) std::printf("\n# %s:\n", __func__);
+      int const nlm = pow2(1 + ellmax), npt = get_grid_size(ellmax, echo);
+      std::vector<int> M(nblocks);
+      std::vector<std::vector<double>> inp(nblocks), out(nblocks), ref(nblocks);
+      std::vector<double const*> inp_ptr(nblocks);
+      std::vector<double*> out_ptr(nblocks);
+      status_t stat(0);
+      double maxdev{0};
+      for (int back = 0; back <= 1; ++back) {
+          int const K = back ? npt : nlm, N = back ? nlm : npt;
+          for (int ib = 0; ib < nblocks; ++ib) {
+              M[ib] = 17 + 8*ib; // different strides, e.g. TRU and SMT radial grids
+              inp[ib].resize(K*M[ib]);
+              for (size_t i = 0; i < inp[ib].size(); ++i) { inp[ib][i] = std::cos(1.5*i + ib); } // some values
+              out[ib].assign(N*M[ib], 0.0);
+              ref[ib].assign(N*M[ib], 0.0);
+              inp_ptr[ib] = inp[ib].data();
+              out_ptr[ib] = out[ib].data();
+              stat += transform(ref[ib].data(), inp[ib].data(), M[ib], ellmax, back, echo);
+          } // ib
+          stat += transform(out_ptr.data(), inp_ptr.data(), nblocks, M.data(), ellmax, back, echo);
+          for (int ib = 0; ib < nblocks; ++ib) {
+              for (size_t i = 0; i < out[ib].size(); ++i) {
+                  maxdev = std::max(maxdev, std::abs(out[ib][i] - ref[ib][i]));
+              } // i
+          } // ib
+      } // back
+      if (echo > 3) std::printf("# %s: %d blocks deviate %.1e from separate transforms\n", __func__, nblocks, maxdev);
+      return stat + (maxdev > 1e-12);
+  } // test_batched_transform
+
   status_t all_tests(int const echo) {
       status_t stat(0);
       stat += test_generation(echo);
       stat += test_spherical_harmonics(echo);
       stat += test_identity_transform(echo);
       stat += test_numerical_Gaunt(echo);
+      stat += test_batched_transform(echo);
       spherical_harmonics::cleanup(echo); // free internal memory
       solid_harmonics::cleanup(echo); // free internal memory
       angular_grid::cleanup(echo);
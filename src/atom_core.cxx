@@ -7,6 +7,9 @@
 #include <algorithm> // std::min, ::max
 #include <iomanip> // std::setprecision
 #include <vector> // std::vector<T>
+#include <string> // std::string
+#include <cstdint> // uint64_t, int32_t
+#include <cstring> // std::memcpy, ::strncmp
 
 #include "atom_core.hxx" // ::guess_energy, ::nl_index, ::get_Zeff_file_name
 
@@ -17,6 +20,7 @@
 #include "radial_potential.hxx" // ::Hartree_potential
 #include "exchange_correlation.hxx" // ::LDA_kernel
 #include "inline_math.hxx" // pow2, set, scale, product, add_product, dot_product
+#include "data_view.hxx" // view2D<T>
 #include "radial_eigensolver.hxx" // ::shooting_method
 #include "constants.hxx" // ::pi
 #include "control.hxx" // ::get
@@ -200,6 +204,134 @@ namespace atom_core {
       ell_QN_t ell; // angular momentum
   } orbital_t;
 
+  // cache of converged atoms, the file name contains a hash of everything that determines the result
+  char const cache_magic[8] = "a43atom"; // file signature
+  int32_t const cache_version = 1; // increment when the file layout or the SCF algorithm changes
+
+  template <typename T>
+  uint64_t fnv1a_hash(T const data[], size_t const n, uint64_t hash=14695981039346656037ull) {
+      auto const bytes = (unsigned char const*)data;
+      for (size_t i = 0; i < n*sizeof(T); ++i) {
+          hash ^= bytes[i];
+          hash *= 1099511628211ull; // FNV-1a 64bit prime
+      } // i
+      return hash;
+  } // fnv1a_hash
+
+  uint64_t cache_key(
+        radial_grid_t const & g // radial grid descriptor
+      , double const Z // number of protons
+      , orbital_t const orb[] // orbitals with occupation numbers
+      , int const norb // number of orbitals
+      , int const sra // relativistic mode
+      , double const threshold // convergence threshold of the SCF residual
+  ) {
+      int32_t const ints[] = {cache_version, sra, g.n, norb};
+      auto hash = fnv1a_hash(cache_magic, 8);
+      hash = fnv1a_hash(&Z, 1, hash);
+      hash = fnv1a_hash(&threshold, 1, hash);
+      hash = fnv1a_hash(ints, 4, hash);
+      hash = fnv1a_hash(g.r, g.n, hash);
+      for (int i = 0; i < norb; ++i) {
+          hash = fnv1a_hash(&orb[i].occ, 1, hash);
+      } // i
+      return hash;
+  } // cache_key
+
+  void get_cache_file_name(char *filename, char const *directory, double const Z, uint64_t const key, size_t const nchars=256) {
+      std::snprintf(filename, nchars, "%s/atom.%03g.%016llx", directory, Z, (unsigned long long)key);
+  } // get_cache_file_name
+
+  typedef struct {
+      char magic[8];
+      uint64_t key;
+      double Z;
+      int32_t nr; // number of radial grid points
+      int32_t norb; // number of orbitals
+      int32_t nenergies; // number of energy contributions
+      int32_t iterations; // number of SCF iterations needed originally
+  } cache_header_t;
+
+  status_t load_from_cache(
+        double rV[] // result: r*V(r)
+      , double rho4pi[] // result: 4*pi*rho(r)
+      , double energies[] // result: energy contributions
+      , orbital_t orb[] // result: energy eigenvalues are modified
+      , int const norb // number of orbitals
+      , int const nenergies // number of energy contributions
+      , radial_grid_t const & g // radial grid descriptor
+      , double const Z // number of protons
+      , uint64_t const key // hash of the inputs
+      , char const *directory
+      , int const echo=0 // log-level
+  ) {
+      char filename[256];
+      get_cache_file_name(filename, directory, Z, key);
+      std::ifstream infile(filename, std::ios::binary);
+      if (!infile.is_open()) {
+          if (echo > 3) std::printf("# %s  Z=%g  no cached result in \'%s\'\n", __func__, Z, filename);
+          return -1; // not found
+      } // is_open
+      cache_header_t h;
+      infile.read((char*)&h, sizeof(h));
+      if (!infile || 0 != std::strncmp(h.magic, cache_magic, 8) || key != h.key || Z != h.Z
+                  || g.n != h.nr || norb != h.norb || nenergies != h.nenergies) {
+          warn("Z=%g cache file \'%s\' does not match", Z, filename);
+          return -2; // mismatch
+      } // check header
+      std::vector<double> energy(norb);
+      infile.read((char*)energies, nenergies*sizeof(double));
+      infile.read((char*)energy.data(), norb*sizeof(double));
+      infile.read((char*)rV, g.n*sizeof(double));
+      infile.read((char*)rho4pi, g.n*sizeof(double));
+      if (!infile) {
+          warn("Z=%g cache file \'%s\' is incomplete", Z, filename);
+          return -3; // too short
+      } // read failed
+      for (int i = 0; i < norb; ++i) {
+          orb[i].E = energy[i];
+      } // i
+      if (echo > 2) std::printf("# %s  Z=%g  loaded \'%s\', originally converged in %d iterations\n", __func__, Z, filename, h.iterations);
+      return 0;
+  } // load_from_cache
+
+  status_t store_to_cache(
+        double const rV[] // r*V(r)
+      , double const rho4pi[] // 4*pi*rho(r)
+      , double const energies[] // energy contributions
+      , orbital_t const orb[] // orbitals
+      , int const norb // number of orbitals
+      , int const nenergies // number of energy contributions
+      , radial_grid_t const & g // radial grid descriptor
+      , double const Z // number of protons
+      , uint64_t const key // hash of the inputs
+      , int const iterations // number of SCF iterations
+      , char const *directory
+      , int const echo=0 // log-level
+  ) {
+      char filename[256];
+      get_cache_file_name(filename, directory, Z, key);
+      std::ofstream outfile(filename, std::ios::binary);
+      if (!outfile.is_open()) {
+          warn("Z=%g failed to open cache file \'%s\' for writing", Z, filename);
+          return 1; // failure
+      } // is_open
+      cache_header_t h;
+      std::memcpy(h.magic, cache_magic, 8);
+      h.key = key; h.Z = Z; h.nr = g.n; h.norb = norb; h.nenergies = nenergies; h.iterations = iterations;
+      std::vector<double> energy(norb);
+      for (int i = 0; i < norb; ++i) {
+          energy[i] = orb[i].E;
+      } // i
+      outfile.write((char const*)&h, sizeof(h));
+      outfile.write((char const*)energies, nenergies*sizeof(double));
+      outfile.write((char const*)energy.data(), norb*sizeof(double));
+      outfile.write((char const*)rV, g.n*sizeof(double));
+      outfile.write((char const*)rho4pi, g.n*sizeof(double));
+      if (echo > 3) std::printf("# %s  Z=%g  stored \'%s\'\n", __func__, Z, filename);
+      return outfile ? 0 : 2;
+  } // store_to_cache
+
 
   status_t scf_atom(
         radial_grid_t const & g // radial grid descriptor
@@ -255,6 +387,8 @@ namespace atom_core {
       std::vector<double> r2rho4pi(g.n);
       std::vector<double> rV_new(g.n, -Z); // init as Hydrogen-like potential
       std::vector<double> rV_old(g.n, -Z); // init as Hydrogen-like potential
+      view2D<double> r2rho_orb(imax + 1, g.n, 0.0); // densities of each orbital
+      std::vector<status_t> solve_stat(imax + 1, 0);
 
       double mix{0}; // init mixing coefficient for the potential
       double const alpha = 0.33; // limit case potential mixing coefficient
@@ -265,8 +399,16 @@ namespace atom_core {
 
       enum { Task_Solve, Task_ChkRho, Task_GenPot, Task_MixPot, Task_Energy } next_task{Task_Solve};
 
+      // converged atoms can be reloaded from a cache directory, the file name contains a hash over all inputs
+      char const *const cache_directory = control::get("atom_core.cache", ""); // empty: do not use a cache
+      bool const use_cache = ('\0' != *cache_directory);
+      int constexpr norb = 20;
+      auto const key = use_cache ? cache_key(g, Z, orb, norb, sra, THRESHOLD) : 0;
+      bool const cached = use_cache && (0 == load_from_cache(rV_old.data(), rho4pi.data(), energies,
+                                  orb, norb, NumEnergyContributions, g, Z, key, cache_directory, echo));
+
       int icyc{0};
-      { // start scope
+      if (!cached) { // start scope
           auto const read_stat = read_Zeff_from_file(rV_old.data(), g, Z, "pot/Zeff", -1.);
           bool loading_failed = (0 != int(read_stat));
           full_debug(dump_to_file("rV_loaded.dat", g.n, rV_old.data(), g.r));
@@ -288,8 +430,8 @@ namespace atom_core {
           } // loading_failed
       } // start scope
 
-      double residual{9e9};
-      bool run{true};
+      double residual{cached ? 0 : 9e9};
+      bool run{!cached};
       while (run) {
 
           switch (next_task) {
@@ -300,10 +442,19 @@ namespace atom_core {
                   set(r2rho4pi.data(), g.n, 0.0); // init accumulator density
                   eigenvalue_sum = 0; // reset energy accumulator
 
+                  // the orbitals are independent for a given potential
+                  #pragma omp parallel for schedule(dynamic)
                   for (int i = 0; i <= imax; ++i) {
                       if (orb[i].occ > 0) {
                           previous_eigenvalues[i] = orb[i].E; // copy
-                          auto const stat = radial_eigensolver::shooting_method(sra, g, rV_old.data(), orb[i].enn, orb[i].ell, orb[i].E, nullptr, r2rho.data());
+                          solve_stat[i] = radial_eigensolver::shooting_method(sra, g, rV_old.data(), orb[i].enn, orb[i].ell, orb[i].E, nullptr, r2rho_orb[i]);
+                      } // occupied
+                  } // i, orbitals
+
+                  // accumulate in a fixed order to be independent of the number of threads
+                  for (int i = 0; i <= imax; ++i) {
+                      if (orb[i].occ > 0) {
+                          auto const stat = solve_stat[i];
                           if (stat) {
                               std::printf("# %s  Z=%g  failed solving for %d%c, status = %d\n",  __func__, Z, orb[i].enn, ellchar(orb[i].ell), int(stat));
                               return stat;
@@ -312,10 +463,10 @@ namespace atom_core {
                               std::printf("# %s  Z=%g  %d%c E=%15.6f %s\n",  __func__, Z, orb[i].enn, ellchar(orb[i].ell), orb[i].E*eV, _eV);
                           } // echo
                           // add orbital density
-                          double const q = dot_product(g.n, r2rho.data(), g.dr);
+                          double const q = dot_product(g.n, r2rho_orb[i], g.dr);
                           assert(q > 0);
                           double const f = orb[i].occ/q;
-                          add_product(r2rho4pi.data(), g.n, r2rho.data(), f);
+                          add_product(r2rho4pi.data(), g.n, r2rho_orb[i], f);
                           if (echo > 9) {
                               std::printf("# %s  %d%c f= %g q= %g dE= %g %s\n",
                                      __func__, orb[i].enn, ellchar(orb[i].ell), orb[i].occ, q,
@@ -432,6 +583,11 @@ namespace atom_core {
           } else {
               stat += store_stat;
           }
+
+          if (use_cache && !cached) {
+              store_to_cache(rV_old.data(), rho4pi.data(), energies, orb, norb, NumEnergyContributions,
+                             g, Z, key, icyc, cache_directory, echo); // failure is not critical
+          } // use_cache
       } // converged?
 
       // dump_to_file("rV_converged.dat", g.n, rV_old, g.r);
@@ -753,6 +909,40 @@ namespace atom_core {
   } // test_Zeff_file_compression
 
   
+  status_t test_cache(int const echo=0) {
+      status_t stat(0);
+      { // scope: the key must depend on the convergence threshold
+          auto & g = *radial_grid::create_radial_grid(radial_grid::default_points(29.));
+          orbital_t orb[1] = {{0., 2., 1, 0}};
+          auto const key = cache_key(g, 29., orb, 1, 1, 1e-11);
+          stat += (key != cache_key(g, 29., orb, 1, 1, 1e-11)); // reproducible
+          stat += (key == cache_key(g, 29., orb, 1, 1, 1e-10)); // other threshold
+          stat += (key == cache_key(g, 29., orb, 1, 0, 1e-11)); // other relativistic mode
+          if (echo > 3) std::printf("# %s: cache key %016llx, %d errors\n", __func__, (unsigned long long)key, int(stat));
+          radial_grid::destroy_radial_grid(&g);
+      } // scope
+      char const *const directory = control::get("atom_core.test.cache", ""); // an existing directory
+      if ('\0' == *directory) return stat; // no directory given, skip the round trip
+      if (echo > 0) std::printf("\n# %s:%d  %s(echo=%d) in \'%s\'\n\n", __FILE__, __LINE__, __func__, echo, directory);
+      double const Z = control::get("atom_core.test.Z", 29.); // default copper
+      auto & g = *radial_grid::create_radial_grid(radial_grid::default_points(Z));
+      std::string const cache_before(control::get("atom_core.cache", ""));
+      control::set("atom_core.cache", directory);
+      std::vector<double> Zeff[2];
+      for (int i = 0; i < 2; ++i) { // 0:compute and store (or load), 1:load
+          Zeff[i].resize(g.n);
+          stat += scf_atom(g, Z, echo, nullptr, Zeff[i].data());
+      } // i
+      control::set("atom_core.cache", cache_before.c_str());
+      double maxdev{0};
+      for (int ir = 0; ir < g.n; ++ir) {
+          maxdev = std::max(maxdev, std::abs(Zeff[1][ir] - Zeff[0][ir]));
+      } // ir
+      if (echo > 1) std::printf("# %s: Z=%g max. deviation of cached Zeff is %g\n", __func__, Z, maxdev);
+      radial_grid::destroy_radial_grid(&g);
+      return stat + (maxdev > 0);
+  } // test_cache
+
   status_t all_tests(int const echo) {
       status_t stat(0);
       int n{0}; int const t = control::get("atom_core.select.test", -1.); // -1:all
@@ -761,6 +951,7 @@ namespace atom_core {
       if (t & (1 << n++)) stat += test_nl_index(echo);
       if (t & (1 << n++)) stat += test_core_solver(echo);
       if (t & (1 << n++)) stat += test_Zeff_file_compression(echo);
+      if (t & (1 << n++)) stat += test_cache(echo);
       return stat;
   } // all_tests
 
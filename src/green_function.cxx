@@ -3,11 +3,13 @@
 #include <cstdio>     // std::printf, ::snprintf, FILE, std::fprintf
 #include <cstdint>    // int64_t, int32_t, uint32_t, int16_t, uint16_t, int8_t, uint8_t
 #include <cassert>    // assert
-#include <cmath>      // std::sqrt, ::cbrt
+#include <cmath>      // std::sqrt, ::cbrt, ::ldexp, ::log2
 #include <algorithm>  // std::max, ::min
 #include <utility>    // std::swap
 #include <vector>     // std::vector<T>
 #include <complex>    // std::complex
+#include <array>      // std::array<T,N>
+#include <type_traits> // std::is_same
 
 #include "green_function.hxx" // ::update_energy_parameter
 
@@ -48,7 +50,9 @@
 #include "green_kinetic.hxx" // ::finite_difference_plan_t, index3D
 #include "green_potential.hxx" // ::exchange
 #include "green_dyadic.hxx" // ::dyadic_plan_t
+#include "green_precision.hxx" // ::float16_t, ::load, ::store, ::storage_name, ::significant_bits
 #include "sho_tools.hxx" // ::nSHO
+#include "constants.hxx" // ::pi
 #include "control.hxx" // ::get
 #include "load_balancer.hxx" // ::get
 #include "boundary_condition.hxx" // Isolated_Boundary, Periodic_Boundary
@@ -544,9 +548,162 @@ namespace green_function {
 
 
 
+  inline double local_cost_per_block(int const FD_range) {
+      // floating point operations for the potential and 3 finite-difference passes on a real 64x64 block
+      return 64*64*2.*(1 + 3*(2*FD_range + 1));
+  } // local_cost_per_block
+
+  std::vector<std::array<int32_t,3>> truncation_sphere_offsets(
+        uint32_t const nb[3] // number of blocks
+      , double const hg[3] // grid spacings
+      , int8_t const bc[3] // boundary conditions
+      , double const r_trunc // truncation radius
+  ) {
+      // list all target-minus-source block offsets for which at least one pair of grid points
+      // is closer than r_trunc, equivalent to the 8-corners test in construct_Green_function,
+      // r_trunc < 0 deactivates the truncation: all offsets that can reach a block of the cell
+      double h[] = {hg[X], hg[Y], hg[Z]};
+      int32_t b_first[3], b_last[3];
+      for (int d = 0; d < 3; ++d) {
+          if (r_trunc < 0) {
+              h[d] = 0;
+              b_first[d] = (Periodic_Boundary == bc[d]) ? (1 - int32_t(nb[d]))/2 : 1 - int32_t(nb[d]);
+              b_last[d]  = (Periodic_Boundary == bc[d]) ?      int32_t(nb[d]) /2 :     int32_t(nb[d]) - 1;
+          } else
+          if (Periodic_Boundary == bc[d] && 2*r_trunc > nb[d]*4*hg[d]) {
+              h[d] = 0; // truncation sphere does not fit into the cell --> no truncation in this direction
+              b_first[d] = (1 - int32_t(nb[d]))/2;
+              b_last[d]  =      int32_t(nb[d]) /2;
+          } else {
+              b_last[d]  = std::floor((r_trunc + 3*hg[d])/(4*hg[d]));
+              b_first[d] = -b_last[d];
+          }
+      } // d
+      // as in construct_Green_function, blocks far from each other only test the corner offsets {-3, 3}
+      double const r2block_circum = pow2(4.5)*(pow2(h[X]) + pow2(h[Y]) + pow2(h[Z]));
+      std::vector<std::array<int32_t,3>> offsets;
+      for (int32_t bz = b_first[Z]; bz <= b_last[Z]; ++bz) {
+      for (int32_t by = b_first[Y]; by <= b_last[Y]; ++by) {
+      for (int32_t bx = b_first[X]; bx <= b_last[X]; ++bx) {
+          int32_t const b[] = {bx, by, bz};
+          double const d2center = pow2(bx*4*h[X]) + pow2(by*4*h[Y]) + pow2(bz*4*h[Z]);
+          bool const far = (d2center > r2block_circum);
+          double d2{0}; // smallest distance^2 between the tested grid points of the two blocks
+          for (int d = 0; d < 3; ++d) {
+              d2 += pow2(((far && 0 == b[d]) ? 3 : std::max(0, 4*std::abs(b[d]) - 3))*h[d]);
+          } // d
+          if (d2 < pow2(r_trunc) || r_trunc < 0) offsets.push_back({bx, by, bz});
+      }}} // bx by bz
+      return offsets;
+  } // truncation_sphere_offsets
+
+  size_t count_target_blocks(
+        int32_t const ib[3] // source block coordinates
+      , std::vector<std::array<int32_t,3>> const & offsets
+      , uint32_t const nb[3] // number of blocks
+      , int8_t const bc[3] // boundary conditions
+  ) {
+      size_t ntb{0}; // number of target blocks
+      for (auto const & off : offsets) {
+          bool inside{true};
+          for (int d = 0; d < 3; ++d) {
+              auto const it = ib[d] + off[d];
+              if (Isolated_Boundary == bc[d]) inside = inside && (it >= 0 && it < int32_t(nb[d]));
+          } // d
+          ntb += inside;
+      } // off
+      return ntb;
+  } // count_target_blocks
+
+  double count_atom_pairs(
+        double & dyadic_flops // result: flops for SHOprj and SHOadd of all pairs, real, Noco=1
+      , int32_t const ib[3] // source block coordinates
+      , uint32_t const nb[3] // number of blocks
+      , double const hg[3] // grid spacings
+      , int8_t const bc[3] // boundary conditions
+      , std::vector<double> const & xyzZinso // [natoms*8]
+      , double const r_trunc // truncation radius
+      , double const r_proj // projection radius in units of sigma
+  ) {
+      // estimate the number of pairs of target block and atom image for this source block
+      double const cell[] = {nb[X]*4*hg[X], nb[Y]*4*hg[Y], nb[Z]*4*hg[Z]};
+      double const block_volume = 64*hg[X]*hg[Y]*hg[Z];
+      size_t const natoms = xyzZinso.size()/8;
+      double npairs{0};
+      dyadic_flops = 0;
+      for (size_t ia = 0; ia < natoms; ++ia) {
+          double d2{0}; // distance^2 between the block center and the nearest image of the atom
+          for (int d = 0; d < 3; ++d) {
+              auto dist = (ib[d]*4 + 2)*hg[d] - (xyzZinso[ia*8 + d] + 0.5*cell[d]);
+              if (Periodic_Boundary == bc[d]) dist -= std::round(dist/cell[d])*cell[d];
+              d2 += pow2(dist);
+          } // d
+          int const numax = xyzZinso[ia*8 + 5];
+          auto const r_projection = r_proj*xyzZinso[ia*8 + 6];
+          auto const dist = std::sqrt(d2);
+          if (dist < r_trunc + r_projection && numax >= 0) {
+              // the number of target blocks in the projection sphere of this atom, reduced by partial overlap
+              auto const n_proj_blocks = 4*constants::pi/3*pow3(r_projection)/block_volume;
+              auto const overlap = std::min(1., (r_trunc + r_projection - dist)/std::max(2*r_projection, 1e-9));
+              npairs += overlap*n_proj_blocks;
+              dyadic_flops += overlap*n_proj_blocks*2*64.*green_dyadic::dyadic_plan_t::flop_count_SHOprj_SHOadd(numax);
+          } // atom is in reach
+      } // ia
+      return npairs;
+  } // count_atom_pairs
+
+  std::vector<double> estimate_rhs_costs(
+        uint32_t const nb[3] // number of blocks
+      , double const hg[3] // grid spacings
+      , int8_t const bc[3] // boundary conditions
+      , std::vector<double> const & xyzZinso // [natoms*8]
+      , int const echo=0
+  ) {
+      // estimate the cost of each candidate right-hand-side block without constructing the plan:
+      //    each target block inside the truncation sphere costs local_cost_per_block and
+      //    each pair of target block and atom image costs SHOprj and SHOadd like in dyadic_plan_t::update_flop_counts
+      auto const nall = size_t(nb[Z])*size_t(nb[Y])*size_t(nb[X]);
+      std::vector<double> cost(nall, 0.0);
+      auto const r_trunc = control::get("green_function.truncation.radius", 10.);
+      auto const r_proj  = control::get("green_function.projection.radius", 6.); // in units of sigma
+      int const FD_range = control::get("green_kinetic.range", 8.);
+      double const c_local = local_cost_per_block(FD_range);
+      if (r_trunc < 0) { // truncation deactivated, all blocks have the same cost
+          int32_t const ib0[] = {0, 0, 0};
+          double dyadic{0};
+          count_atom_pairs(dyadic, ib0, nb, hg, bc, xyzZinso, 9e99, r_proj); // every atom is in reach
+          cost.assign(nall, nall*c_local + dyadic);
+          if (echo > 3) std::printf("# estimated cost per right-hand-side block %g Mflop, no truncation\n", cost[0]*1e-6);
+          return cost;
+      } // r_trunc < 0
+
+      auto const offsets = truncation_sphere_offsets(nb, hg, bc, r_trunc);
+
+      simple_stats::Stats<> st;
+      for (uint32_t iz = 0; iz < nb[Z]; ++iz) {
+      for (uint32_t iy = 0; iy < nb[Y]; ++iy) {
+      for (uint32_t ix = 0; ix < nb[X]; ++ix) {
+          int32_t const ib[] = {int32_t(ix), int32_t(iy), int32_t(iz)};
+          auto const ntb = count_target_blocks(ib, offsets, nb, bc);
+          double dyadic{0};
+          count_atom_pairs(dyadic, ib, nb, hg, bc, xyzZinso, r_trunc, r_proj);
+          auto const iall = (size_t(iz)*nb[Y] + iy)*nb[X] + ix;
+          cost[iall] = ntb*c_local + dyadic;
+          st.add(cost[iall]);
+      }}} // ix iy iz
+      if (echo > 3) std::printf("# estimated cost per right-hand-side block in [%g, %g +/- %g, %g] Mflop, %ld offsets in truncation sphere\n",
+                                   st.min()*1e-6, st.mean()*1e-6, st.dev()*1e-6, st.max()*1e-6, offsets.size());
+      return cost;
+  } // estimate_rhs_costs
+
+
   std::vector<int64_t> get_right_hand_sides(
         uint32_t const nb[3] // number of blocks
       , std::vector<uint16_t> & owner_rank
+      , double & predicted_load // result: estimated cost of this rank if weighted load balancing is active, 0 otherwise
+      , double const hg[3] // grid spacings
+      , int8_t const bc[3] // boundary conditions
+      , std::vector<double> const & xyzZinso // [natoms*8]
       , int const echo=0
   ) {
       std::vector<int64_t> global_source_indices; // result array
@@ -564,12 +721,20 @@ namespace green_function {
                                                 : green_parallel::rank(); // MPI_Comm_rank
           double rank_center[4]; // rank_center[0/1/2] are the coordinates of the center of weight of the RHSs assigned to this rank
                                  // rank_center[3] is the number of tasks with nonzero weight
-          load_balancer::get(comm_size, comm_rank, nb, echo, rank_center, owner_rank.data());
+          // weighted: balance the estimated costs instead of the number of right-hand-side blocks
+          bool const weighted = (0 != control::get("green_function.balance.weighted", 0.));
+          std::vector<double> costs(0);
+          if (weighted) costs = estimate_rhs_costs(nb, hg, bc, xyzZinso, echo);
+          auto const load = load_balancer::get(comm_size, comm_rank, nb, echo, rank_center, owner_rank.data(),
+                                                                      weighted ? costs.data() : nullptr);
+          predicted_load = weighted ? load : 0;
           if (fake_comm < 1) green_parallel::max(owner_rank.data(), nall); // MPI_Allreduce(MPI_MAX)
           if (echo > 9) {
               std::printf("# rank#%i owner_rank after  MPI_MAX ", comm_rank);
               printf_vector(" %i", owner_rank);
           } // echo
+          if (echo > 3 && fake_comm < 1) std::printf("# %ld block faces are shared between different ranks\n",
+                              load_balancer::count_cut_faces(nb, owner_rank.data(), weighted ? costs.data() : nullptr));
           auto const nrhs = size_t(rank_center[3]); // number of tasks with nonzero weight
           if (echo > 5) std::printf("# rank#%d of %d procs has %ld tasks\n", comm_rank, comm_size, nrhs);
           {
@@ -639,6 +804,157 @@ namespace green_function {
   } // get_right_hand_sides
 
 
+  status_t estimate_plan(
+        double estimate[4] // result: [0] nnzb, [1] memory of the Green function in Byte, [2] flop per multiply, [3] potential exchange in Byte
+      , std::vector<int64_t> const & global_source_indices // source blocks of this process
+      , uint32_t const nb[3] // number of blocks
+      , int8_t const bc[3] // boundary conditions
+      , double const hg[3] // grid spacings
+      , std::vector<double> const & xyzZinso // [natoms*8]
+      , double const r_trunc // truncation radius
+      , double const r_proj // projection radius in units of sigma
+      , int const FD_range // finite-difference range of the kinetic energy operator
+      , int const R1C2=2 // 1:real, 2:complex
+      , int const Noco=1 // 1:collinear, 2:non-collinear
+      , int const real_t_size=4 // sizeof(real_t)
+      , bool const parallel=false // count the potential exchange
+  ) {
+      // predict the plan shape from the geometry without constructing the plan
+      set(estimate, 4, 0.0);
+      auto const nrhs = global_source_indices.size();
+      if (nrhs < 1) return 0;
+      auto const offsets = truncation_sphere_offsets(nb, hg, bc, r_trunc); // r_trunc < 0: all blocks
+
+      // bounding box of all target blocks to count the distinct target blocks (rows)
+      int32_t min_coords[] = {1 << 21, 1 << 21, 1 << 21}, max_coords[] = {-(1 << 21), -(1 << 21), -(1 << 21)};
+      view2D<int32_t> source_coords(nrhs, 4, 0);
+      for (size_t irhs = 0; irhs < nrhs; ++irhs) {
+          global_coordinates::get(source_coords[irhs], global_source_indices[irhs]);
+          for (int d = 0; d < 3; ++d) {
+              min_coords[d] = std::min(min_coords[d], source_coords(irhs,d));
+              max_coords[d] = std::max(max_coords[d], source_coords(irhs,d));
+          } // d
+      } // irhs
+      int32_t box_min[3]; uint32_t box_num[3];
+      for (int d = 0; d < 3; ++d) {
+          int32_t omin{0}, omax{0};
+          for (auto const & off : offsets) { omin = std::min(omin, off[d]); omax = std::max(omax, off[d]); }
+          box_min[d] = min_coords[d] + omin;
+          box_num[d] = max_coords[d] + omax + 1 - box_min[d];
+      } // d
+      std::vector<bool> is_target(size_t(box_num[Z])*size_t(box_num[Y])*size_t(box_num[X]), false);
+
+      double nnzb{0}, dyadic_flops{0};
+      for (size_t irhs = 0; irhs < nrhs; ++irhs) {
+          auto const *const ib = source_coords[irhs];
+          for (auto const & off : offsets) {
+              bool inside{true};
+              int32_t idx[3];
+              for (int d = 0; d < 3; ++d) {
+                  auto const it = ib[d] + off[d];
+                  if (Isolated_Boundary == bc[d]) inside = inside && (it >= 0 && it < int32_t(nb[d]));
+                  idx[d] = it - box_min[d];
+              } // d
+              if (inside) {
+                  ++nnzb;
+                  is_target[index3D(box_num, idx)] = true;
+              } // inside
+          } // off
+          double flops{0};
+          count_atom_pairs(flops, ib, nb, hg, bc, xyzZinso, (r_trunc < 0) ? 9e99 : r_trunc, r_proj);
+          dyadic_flops += flops;
+      } // irhs
+      size_t nrows{0};
+      for (auto const t : is_target) { nrows += t; }
+
+      size_t const LM2 = pow2(64*Noco);
+      estimate[0] = nnzb;
+      estimate[1] = nnzb*R1C2*LM2*real_t_size; // nnzb * R1C2 * (64*Noco)^2 * sizeof(real_t)
+      estimate[2] = nnzb*R1C2*LM2 // potential, as in green_potential::multiply
+                  + 3*nnzb*(2*FD_range + 1)*R1C2*LM2*2. // kinetic, as in kinetic_plan_t::multiply
+                  + dyadic_flops*R1C2*pow2(Noco); // SHOprj and SHOadd, as in dyadic_plan_t::get_flop_count
+      // each target block requests the local potential, double[Noco^2][64], the own source blocks are known
+      estimate[3] = parallel ? std::max(0., nrows - 1.*nrhs)*pow2(Noco)*64*sizeof(double) : 0;
+      return 0;
+  } // estimate_plan
+
+  status_t plan_parameters(
+        uint32_t const ng[3] // numbers of grid points
+      , int8_t const bc[3] // boundary conditions
+      , double const hg[3] // grid spacings
+      , std::vector<double> const & xyzZinso // [natoms*8]
+      , int const R1C2=2 // 1:real, 2:complex
+      , int const Noco=1 // 1:collinear, 2:non-collinear
+      , int const real_t_size=4 // sizeof(real_t)
+      , int const echo=0 // log-level
+      , right_hand_sides_t *rhs=nullptr // result: the distributed sources, can be passed on to construct_Green_function
+  ) {
+      // planning mode: predict memory, flops and communication volume and
+      //                suggest a truncation radius that fits into a given memory budget per process
+      uint32_t const nb[] = {ng[X] >> 2, ng[Y] >> 2, ng[Z] >> 2};
+      right_hand_sides_t rhs_local;
+      auto & r = rhs ? *rhs : rhs_local;
+      r.global_source_indices = get_right_hand_sides(nb, r.owner_rank, r.predicted_load, hg, bc, xyzZinso, echo - 5);
+      auto const & sources = r.global_source_indices;
+      bool const parallel = (green_parallel::size() > 1) || (control::get("green_function.fake.comm", 0.) > 1);
+
+      auto const r_trunc  = control::get("green_function.truncation.radius", 10.);
+      auto const r_proj   = control::get("green_function.projection.radius", 6.);
+      int  const FD_range = control::get("green_kinetic.range", 8.);
+      if (echo > 0) std::printf("\n# %s for %ld sources, R1C2=%d, Noco=%d, %d Byte per real\n", __func__, sources.size(), R1C2, Noco, real_t_size);
+
+      double estimate[4];
+      for (int fd = 4; fd <= 8; fd += 4) { // compare the 8th and 16th order finite-difference stencils
+          estimate_plan(estimate, sources, nb, bc, hg, xyzZinso, r_trunc, r_proj, fd, R1C2, Noco, real_t_size, parallel);
+          if (echo > 1 + 4*(fd != FD_range)) std::printf("# predict for green_function.truncation.radius=%g %s and green_kinetic.range=%d: "
+              "%.3f k blocks, %.6f %s, %.3f Gflop per multiply, %.6f %s potential exchange\n",
+              r_trunc*Ang, _Ang, fd, estimate[0]*1e-3, estimate[1]*GByte, _GByte, estimate[2]*1e-9, estimate[3]*GByte, _GByte);
+      } // fd
+      estimate_plan(estimate, sources, nb, bc, hg, xyzZinso, r_trunc, r_proj, FD_range, R1C2, Noco, real_t_size, parallel);
+
+      auto const budget  = control::get("green_function.memory.budget", 0.)/GByte; // in GByte per process
+      auto const vectors = control::get("green_function.memory.vectors", 1.); // number of Green functions held by the solver
+      if (budget <= 0) return 0;
+      if (estimate[1]*vectors <= budget) {
+          if (echo > 1) std::printf("# predicted memory %.6f %s fits into green_function.memory.budget=%g %s\n",
+                                       estimate[1]*vectors*GByte, _GByte, budget*GByte, _GByte);
+          return 0;
+      } // fits
+
+      auto const memory_requested = estimate[1]*vectors;
+      // bisection for the largest truncation radius that fits into the budget, nnzb grows monotonically with r_trunc
+      // without truncation, start from the cell diagonal beyond which all blocks are reached anyway
+      double const r_all = 4*std::sqrt(pow2(nb[X]*hg[X]) + pow2(nb[Y]*hg[Y]) + pow2(nb[Z]*hg[Z]));
+      double r_fit{0}, r_fail{(r_trunc < 0) ? r_all : r_trunc};
+      bool found{false}; // r_fit is only valid if at least one radius fits
+      for (int iter = 0; iter < 24 && r_fail - r_fit > 0.01; ++iter) {
+          auto const r_try = 0.5*(r_fit + r_fail);
+          estimate_plan(estimate, sources, nb, bc, hg, xyzZinso, r_try, r_proj, FD_range, R1C2, Noco, real_t_size, parallel);
+          if (echo > 7) std::printf("# try green_function.truncation.radius=%g %s --> %.6f %s\n", r_try*Ang, _Ang, estimate[1]*vectors*GByte, _GByte);
+          if (estimate[1]*vectors <= budget) { r_fit = r_try; found = true; } else { r_fail = r_try; }
+      } // iter
+      if (!found) {
+          warn("no green_function.truncation.radius down to %g %s fits into green_function.memory.budget=%g %s",
+                    r_fail*Ang, _Ang, budget*GByte, _GByte);
+          return 1; // do not suggest radius 0
+      } // nothing fits
+      estimate_plan(estimate, sources, nb, bc, hg, xyzZinso, r_fit, r_proj, FD_range, R1C2, Noco, real_t_size, parallel);
+      if (echo > 0) std::printf("# suggest green_function.truncation.radius=%g %s to fit into %g %s: "
+              "%.3f k blocks, %.6f %s, %.3f Gflop per multiply\n", r_fit*Ang, _Ang, budget*GByte, _GByte,
+              estimate[0]*1e-3, estimate[1]*vectors*GByte, _GByte, estimate[2]*1e-9);
+      if (control::get("green_function.plan.autotune", 0.) > 0) {
+          char value[32]; std::snprintf(value, 32, "%.6f", r_fit);
+          control::set("green_function.truncation.radius", value, echo);
+          if (echo > 0) std::printf("# auto-selected green_function.truncation.radius=%g %s\n", r_fit*Ang, _Ang);
+          if (0 != control::get("green_function.balance.weighted", 0.)) r.global_source_indices.clear(); // costs depend on the radius, distribute again
+      } else {
+          warn("predicted memory %.3f %s exceeds green_function.memory.budget=%g %s, use +green_function.plan.autotune=1",
+                    memory_requested*GByte, _GByte, budget*GByte, _GByte);
+      } // autotune
+      return 0;
+  } // plan_parameters
+
+
   status_t construct_Green_function(
         green_action::plan_t & p // result, create a plan how to apply the SHO-PAW Hamiltonian to a block-sparse truncated Green function
       , uint32_t const ng[3] // numbers of grid points of the unit cell in with the potential is defined
@@ -650,11 +966,18 @@ namespace green_function {
       , int const echo // =0 // log-level
       , std::complex<double> const *energy_parameter // =nullptr // E in G = (H - E*S)^{-1}
       , int const Noco // =2
+      , green_input::mapped_Hamiltonian_t const *hmt // =nullptr, if Veff is empty, load potential blocks from here
+      , right_hand_sides_t const *rhs // =nullptr, reuse the sources distributed by plan_parameters
   ) {
       if (echo > 0) std::printf("\n#\n# %s(%s)\n#\n\n", __func__, str(ng, 1, ", "));
 
       p.E_param = energy_parameter ? *energy_parameter : 0;
 
+      // allocation policies per name, e.g. +green_memory.policy="x:align=2M,touch;kinetic_yz:device,prefetch"
+      if (set_memory_policies(control::get("green_memory.policy", ""), echo) > 0) {
+          warn("unknown options in green_memory.policy=\"%s\"", control::get("green_memory.policy", ""));
+      } // errors
+
       int8_t bc[3] = {boundary_condition[X], boundary_condition[Y], boundary_condition[Z]};
       uint32_t n_blocks[3] = {0, 0, 0};
       for (int d = 0; d < 3; ++d) {
@@ -691,7 +1014,14 @@ namespace green_function {
 
       // we assume that the source blocks lie compact in space and preferably close to each other
       std::vector<uint16_t> owner_rank(0);
-      p.global_source_indices = get_right_hand_sides(n_blocks, owner_rank, echo);
+      double predicted_load{0}; // estimated cost of this rank, only with weighted load balancing
+      if (rhs && rhs->global_source_indices.size() > 0) { // reuse, get_right_hand_sides involves MPI collectives
+          p.global_source_indices = rhs->global_source_indices;
+          owner_rank = rhs->owner_rank;
+          predicted_load = rhs->predicted_load;
+      } else {
+          p.global_source_indices = get_right_hand_sides(n_blocks, owner_rank, predicted_load, hg, bc, xyzZinso, echo);
+      } // rhs
       // now owner_rank[] tells the MPI rank of the process responsible for a RHS block
       uint32_t const nrhs = p.global_source_indices.size();
       if (echo > 0) std::printf("# total number of source blocks is %d\n", nrhs);
@@ -779,7 +1109,7 @@ namespace green_function {
       int32_t  min_target_coords[3] = {0, 0, 0}; // minimum of global target coordinates
       int32_t  max_target_coords[3] = {0, 0, 0}; // maximum of global target coordinates
       { // scope: create the truncated Green function block-sparsity pattern
-          auto const rtrunc = std::max(0., r_trunc);
+          auto const rtrunc = (r_trunc < 0) ? 9e99 : r_trunc; // r_trunc < 0: truncation deactivated, all blocks are inside
           double scale_grid_spacing[] = {1, 1, 1};
           {
               double const def = control::get(scale_grid_spacing, "green_function.scale.grid.spacing", "xyz", 1.);
@@ -820,6 +1150,8 @@ namespace green_function {
                           if (echo > 1) std::printf("# periodic boundary condition in %c-direction is wrapped\n", 'x' + d);
                       }
                   } // periodic boundary condition
+              } else {
+                  h[d] = 0; // no truncation in any direction
               } // r_trunc >= 0
 
           } // d
@@ -828,14 +1160,14 @@ namespace green_function {
           if (echo > 0) std::printf("# circumscribing radius= %g %s\n", r_block_circumscribing_sphere*Ang, _Ang);
           auto const rtrunc_plus  =              rtrunc + 2*r_block_circumscribing_sphere;
           auto const rtrunc_minus = std::max(0., rtrunc - 2*r_block_circumscribing_sphere);
-          if (echo > 0) std::printf("# truncation radius %g %s, search within %g %s\n", rtrunc*Ang, _Ang, rtrunc_plus*Ang, _Ang);
+          if (echo > 0 && r_trunc >= 0) std::printf("# truncation radius %g %s, search within %g %s\n", rtrunc*Ang, _Ang, rtrunc_plus*Ang, _Ang);
           if (echo > 0 && rtrunc_minus > 0) std::printf("# blocks with center distance below %g %s are fully inside\n", rtrunc_minus*Ang, _Ang);
 
           int32_t itr[3];
           for (int d = 0; d < 3; ++d) { // spatial directions
 
               // how many blocks around each source block do we need to check
-              itr[d] = (h[d] > 0) ? std::floor(rtrunc_plus/(4*h[d])) : (n_blocks[d]/2);
+              itr[d] = (h[d] > 0) ? std::floor(rtrunc_plus/(4*h[d])) : ((Isolated_Boundary == bc[d]) ? n_blocks[d] - 1 : n_blocks[d]/2);
               assert(itr[d] >= 0);
 
               min_target_coords[d] = min_global_source_coords[d] - itr[d];
@@ -1248,6 +1580,21 @@ namespace green_function {
                   } else error("failed to create new kinetic_plan_t in %c-direction", 'x' + dd);   
 
               } // dd derivate direction
+
+              p.fused_local = (control::get("green_function.fused", 0.) > 0); // 1: potential and kinetic energy in one pass
+              if (p.fused_local) {
+                  auto const fused_stat = p.fused.set(p.kinetic, nnzb, echo);
+                  if (fused_stat) error("failed to create fused_plan_t, status= %i", int(fused_stat));
+              } // fused_local
+
+              p.concurrent_kinetic = (control::get("green_function.kinetic.concurrent", 0.) > 0); // 1: 3 independent kinetic passes
+#ifndef   HAS_NO_CUDA
+              for (int dd = 0; dd < 3*p.concurrent_kinetic; ++dd) {
+                  cuCheck( cudaStreamCreate(&p.kinetic_streams[dd]) );
+              } // dd
+#else  // HAS_NO_CUDA
+              if (p.concurrent_kinetic) warn("green_function.kinetic.concurrent=%d only pays off on GPUs, costs two extra Green functions", int(p.concurrent_kinetic));
+#endif // HAS_NO_CUDA
           } // scope: set up kinetic plans
 
           // transfer stuff into managed GPU memory
@@ -1267,25 +1614,34 @@ namespace green_function {
           auto const Vinp = new double[nrhs*Noco*Noco][64];
           // reorder Veff[ng[Z]*ng[Y]*ng[X]] into block-structured Vinp
           auto const n_all_grid_points = size_t(ng[Z])*size_t(ng[Y])*size_t(ng[X]);
-          assert(Veff.size() == n_all_grid_points);
+          bool const blocks_on_demand = Veff.empty() && (nullptr != hmt); // decode only the blocks offered by this rank
+          assert(blocks_on_demand || Veff.size() == n_all_grid_points);
           for (uint16_t rhs{0}; rhs < nrhs; ++rhs) {
               // assume that in this MPI rank the potential values of the right-hand-sides that are to be determined are known
               auto const *const ib = global_source_coords[rhs];
               for (int d = 0; d < 3; ++d) { assert(ib[d] >= 0); }
+              double Vblock[64];
+              if (blocks_on_demand) {
+                  auto const iblock = (size_t(ib[Z])*n_blocks[Y] + ib[Y])*n_blocks[X] + ib[X];
+                  if (hmt->potential_block(iblock, Vblock)) error("failed to load potential block #%ld", iblock);
+              } // blocks_on_demand
               for (int i4z = 0; i4z < 4; ++i4z) { size_t const iz = ib[Z]*4 + i4z;
               for (int i4y = 0; i4y < 4; ++i4y) { size_t const iy = ib[Y]*4 + i4y;
               for (int i4x = 0; i4x < 4; ++i4x) { size_t const ix = ib[X]*4 + i4x;
                   auto const izyx = (iz*ng[Y] + iy)*ng[X] + ix; // global grid point index
                   assert(izyx < n_all_grid_points);
                   auto const i64 = (i4z*4 + i4y)*4 + i4x;
+                  auto const V = blocks_on_demand ? Vblock[i64] : Veff[izyx];
                   if (2 == Noco) {
                       Vinp[rhs*4 + 3][i64] = 0.0;  // set clear V_y
                       Vinp[rhs*4 + 2][i64] = 0.0;  // set clear V_x
-                      Vinp[rhs*4 + 1][i64] = Veff[izyx]; // set V_upup
+                      Vinp[rhs*4 + 1][i64] = V; // set V_upup
                   } // non-collinear
-                  Vinp[rhs*Noco*Noco][i64] = Veff[izyx]; // copy potential value to V_dndn
+                  Vinp[rhs*Noco*Noco][i64] = V; // copy potential value to V_dndn
               }}} // i4x i4y i4z
           } // rhs
+          if (blocks_on_demand && echo > 3) std::printf("# %s: %d of %ld potential blocks loaded, %ld stored in file\n",
+                                                  __func__, nrhs, n_all_grid_points/64, hmt->number_of_stored_blocks());
 
           for (int mag = 0; mag < Noco*Noco; ++mag) {
               p.Veff[mag] = get_memory<double[64]>(p.nRows, echo, "Veff[mag]"); // in managed memory
@@ -1348,6 +1704,38 @@ namespace green_function {
       auto const nerr = p.dyadic_plan.consistency_check();
       if (nerr && echo > 0) std::printf("# dyadic_plan.consistency_check has %d errors\n", nerr);
 
+      p.dyadic_plan.projector_table_estimate(p.rowindx, echo); // show the memory/compute trade-off
+      if (control::get("green_function.projector.tables", 0.) > 0) { // 1: tabulate the Hermite-Gauss functions in float
+          auto const table_stat = p.dyadic_plan.tabulate_projectors(p.rowindx, p.rowCubePos, echo);
+          if (table_stat) error("failed to tabulate the projector functions, status= %i", int(table_stat));
+      } // projector tables
+
+      { // scope: validate the plan estimate against the plan that has been built
+          double estimate[4];
+          int const FD_range = p.kinetic[X].FD_range;
+          auto const r_proj = control::get("green_function.projection.radius", 6.);
+          estimate_plan(estimate, p.global_source_indices, n_blocks, boundary_condition, hg, xyzZinso, r_trunc, r_proj, FD_range);
+          auto const nnzb = p.RowStart[p.nRows];
+          auto const dev = std::abs(estimate[0] - nnzb);
+          if (echo > 3) std::printf("# plan has %ld non-zero blocks, %.0f estimated\n", size_t(nnzb), estimate[0]);
+          if (dev > 0.01*nnzb) warn("plan has %ld non-zero blocks but %.0f were estimated", size_t(nnzb), estimate[0]);
+      } // scope
+
+      if (predicted_load > 0) { // compare the predicted to the measured load imbalance
+          // measured with the same cost model as in estimate_rhs_costs but from the actual plan
+          auto const nnzb = p.RowStart[p.nRows];
+          auto const measured_load = nnzb*local_cost_per_block(p.kinetic[X].FD_range) + 2.*p.dyadic_plan.flop_count_SHOadd;
+          simple_stats::Stats<> predicted, measured;
+          predicted.add(predicted_load);
+          measured.add(measured_load);
+          green_parallel::allreduce(predicted);
+          green_parallel::allreduce(measured);
+          if (echo > 1) std::printf("# this rank predicted %g and measured %g Mflop, ratio %.3f\n",
+                                       predicted_load*1e-6, measured_load*1e-6, measured_load/predicted_load);
+          if (echo > 0) std::printf("# load imbalance (max/mean) predicted %.3f, measured %.3f\n",
+                  predicted.max()/std::max(predicted.mean(), 1e-300), measured.max()/std::max(measured.mean(), 1e-300));
+      } // predicted_load > 0
+
 #ifdef    GREEN_FUNCTION_SVG_EXPORT
       if (nullptr != svg) {
             // show the cell boundaries if in range
@@ -1384,13 +1772,107 @@ namespace green_function {
 #else // NO_UNIT_TESTS
 
 
-  template <typename real_t, int R1C2=2, int Noco=1>
+  template <typename storage_t>
+  void pseudo_random_blocks(storage_t x_all[], size_t const n_all) {
+      for (size_t i = 0; i < n_all; ++i) {
+          green_precision::store(x_all[i], ((i*2654435761u) % 1000)*1e-3 - 0.5); // pseudo-random
+      } // i
+  } // pseudo_random_blocks
+
+  template <typename storage_t, typename reference_t>
+  double largest_deviation(double & mag, storage_t const y_all[], reference_t const z_all[], size_t const n_all) {
+      double dev{0}; mag = 0;
+      for (size_t i = 0; i < n_all; ++i) {
+          auto const z = green_precision::load<double>(z_all[i]);
+          dev = std::max(dev, std::abs(green_precision::load<double>(y_all[i]) - z));
+          mag = std::max(mag, std::abs(z));
+      } // i
+      return dev;
+  } // largest_deviation
+
+  template <typename real_t, int R1C2, int Noco, typename storage_t>
+  double compare_variant( // returns the largest deviation relative to the largest result
+        green_action::action_t<real_t,R1C2,Noco,64,storage_t> & action
+      , green_action::plan_t & p
+      , bool & variant // switch in the plan, is true on entry and on exit
+      , char const *const what
+      , storage_t (*const x)[R1C2][Noco*64][Noco*64] // will be zero on exit
+      , storage_t (*const y)[R1C2][Noco*64][Noco*64] // will be overwritten
+      , uint16_t const colIndex[]
+      , int const echo=0
+  ) {
+      // validate an alternative implementation of the action against the default one
+      int constexpr LM = Noco*64;
+      uint32_t const nnzbX = p.colindx.size();
+      size_t const n_all = nnzbX*size_t(R1C2*LM*LM);
+      auto z = get_memory<storage_t[R1C2][LM][LM]>(nnzbX, echo, "z");
+      storage_t *const x_all = x[0][0][0], *const y_all = y[0][0][0], *const z_all = z[0][0][0];
+      pseudo_random_blocks(x_all, n_all);
+      assert(variant);
+      action.multiply(y, x, colIndex, nnzbX, p.nCols);
+      variant = false;
+      action.multiply(z, x, colIndex, nnzbX, p.nCols);
+      variant = true;
+      cudaDeviceSynchronize();
+      double mag;
+      auto const dev = largest_deviation(mag, y_all, z_all, n_all);
+      if (echo > 1) std::printf("# %s deviates from the sequential version by %.1e, relative %.1e\n",
+                                   what, dev, dev/std::max(mag, 1e-300));
+      // a variant may round its partial results to storage_t in a different order
+      auto const threshold = std::max((8 == sizeof(real_t)) ? 1e-12 : 1e-5, std::ldexp(1., 2 - green_precision::significant_bits<storage_t>()));
+      if (dev > threshold*mag) warn("%s deviates by %.1e", what, dev);
+      set(x_all, n_all, storage_t{}); // restore x
+      free_memory(z);
+      return dev/std::max(mag, 1e-300);
+  } // compare_variant
+
+  template <typename real_t, int R1C2, int Noco, typename storage_t>
+  double compare_storage( // returns the largest deviation relative to the largest result
+        green_action::action_t<real_t,R1C2,Noco,64,storage_t> & action
+      , green_action::plan_t & p
+      , storage_t (*const x)[R1C2][Noco*64][Noco*64] // will be zero on exit
+      , storage_t (*const y)[R1C2][Noco*64][Noco*64] // will be overwritten
+      , uint16_t const colIndex[]
+      , int const echo=0
+  ) {
+      // validate the action on blocks stored in storage_t against the action in double precision
+      int constexpr LM = Noco*64;
+      uint32_t const nnzbX = p.colindx.size();
+      size_t const n_all = nnzbX*size_t(R1C2*LM*LM);
+      auto xd = get_memory<double[R1C2][LM][LM]>(nnzbX, echo, "xd");
+      auto yd = get_memory<double[R1C2][LM][LM]>(nnzbX, echo, "yd");
+      storage_t *const x_all = x[0][0][0], *const y_all = y[0][0][0];
+      pseudo_random_blocks(x_all, n_all);
+      pseudo_random_blocks(xd[0][0][0], n_all); // the same values, not rounded
+      action.multiply(y, x, colIndex, nnzbX, p.nCols);
+      { // scope: reference
+          green_action::action_t<double,R1C2,Noco,64> reference(&p);
+          reference.multiply(yd, xd, colIndex, nnzbX, p.nCols);
+      } // scope
+      cudaDeviceSynchronize();
+      double mag;
+      auto const dev = largest_deviation(mag, y_all, yd[0][0][0], n_all);
+      auto const rel = dev/std::max(mag, 1e-300);
+      // the input and the partial results of potential, kinetic and dyadic part are rounded to storage_t
+      int const bits = std::min(green_precision::significant_bits<storage_t>(), green_precision::significant_bits<real_t>());
+      auto const tolerance = std::ldexp(1., 4 - bits);
+      if (echo > 1) std::printf("# action on %s blocks in %s deviates from double by %.1e, relative %.1e (2^%.2f), tolerance 2^%d\n",
+                green_precision::storage_name<storage_t>(), real_t_name<real_t>(), dev, rel, std::log2(std::max(rel, 1e-300)), 4 - bits);
+      if (rel > tolerance) warn("action on %s blocks deviates by %.1e relative to double, tolerance %.1e",
+                                  green_precision::storage_name<storage_t>(), rel, tolerance);
+      set(x_all, n_all, storage_t{}); // restore x
+      free_memory(yd);
+      free_memory(xd);
+      return rel;
+  } // compare_storage
+
+  template <typename real_t, int R1C2=2, int Noco=1, typename storage_t=real_t>
   void test_action(green_action::plan_t & p, int const iterations=1, int const echo=9) {
-      if (echo > 1) std::printf("# %s<%s,R1C2=%d,Noco=%d>\n", __func__, real_t_name<real_t>(), R1C2, Noco);
-      green_action::action_t<real_t,R1C2,Noco,64> action(&p); // constructor
+      if (echo > 1) std::printf("# %s<%s,R1C2=%d,Noco=%d,%s>\n", __func__, real_t_name<real_t>(), R1C2, Noco, green_precision::storage_name<storage_t>());
+      green_action::action_t<real_t,R1C2,Noco,64,storage_t> action(&p); // constructor
 
       uint32_t const nnzbX = p.colindx.size();
-      if (echo > 3) std::printf("# memory of a Green function is %.6f %s\n", nnzbX*R1C2*pow2(64.*Noco)*sizeof(real_t)*GByte, _GByte);
+      if (echo > 3) std::printf("# memory of a Green function is %.6f %s\n", nnzbX*R1C2*pow2(64.*Noco)*sizeof(storage_t)*GByte, _GByte);
 
       if (0 == iterations) { 
           if (echo > 2) std::printf("# requested to run no iterations --> only check the action_t constructor\n");
@@ -1440,13 +1922,28 @@ namespace green_function {
 
       int const niterations = std::abs(iterations);
       int constexpr LM = Noco*64;
-      auto x = get_memory<real_t[R1C2][LM][LM]>(nnzbX, echo, "x");
-      auto y = get_memory<real_t[R1C2][LM][LM]>(nnzbX, echo, "y");
-      set(x[0][0][0], nnzbX*size_t(R1C2*LM*LM), real_t(0)); // init x
+      auto x = get_memory<storage_t[R1C2][LM][LM]>(nnzbX, echo, "x");
+      auto y = get_memory<storage_t[R1C2][LM][LM]>(nnzbX, echo, "y");
+      set(x[0][0][0], nnzbX*size_t(R1C2*LM*LM), storage_t{}); // init x
 
       auto colIndex = get_memory<uint16_t>(nnzbX, echo, "colIndex");
       set(colIndex, nnzbX, p.colindx.data()); // copy into GPU memory
 
+      if (!std::is_same<storage_t,real_t>::value && nnzbX > 0) { // scope: validate the reduced storage against double
+          compare_storage(action, p, x, y, colIndex, echo);
+      } // scope
+
+      if (p.fused_local && std::is_same<storage_t,real_t>::value && nnzbX > 0) { // scope: validate the fused kernel against potential + 3 kinetic passes
+          compare_variant(action, p, p.fused_local, "fused local operator", x, y, colIndex, echo);
+      } // scope
+
+      if (p.concurrent_kinetic && nnzbX > 0) { // scope: validate the concurrent against the serial kinetic passes
+          auto const fused_local = p.fused_local;
+          p.fused_local = false; // the fused kernel does not use the kinetic passes
+          compare_variant(action, p, p.concurrent_kinetic, "concurrent kinetic energy", x, y, colIndex, echo);
+          p.fused_local = fused_local;
+      } // scope
+
       { // scope: benchmark the action
           SimpleTimer timer(__FILE__, __LINE__, __func__, echo);
           simple_stats::Stats<> timings;
@@ -1470,6 +1967,7 @@ namespace green_function {
                                           niterations, nflops, fF, timings.sum(), nflops/timings.sum()*1e-9, fF);
           if (echo > 1) std::printf("# fastest call of action.multiply performed %.3e %clop in %.3e seconds, i.e. %g G%clop/s\n",
                                           nflops/niterations, fF, timings.min(), nflops/(niterations*timings.min())*1e-9, fF);
+          if (echo > 3) p.dyadic_plan.workspace.show(echo);
       } // scope
 
       free_memory(colIndex);
@@ -1491,7 +1989,11 @@ namespace green_function {
       std::vector<std::vector<double>> AtomMatrices(0); // non-local potential
 
       auto const *const filename = control::get("hamiltonian.file", "Hmt.xml");
-      auto stat = green_input::load_Hamiltonian(ng, bc, hg, Veff, natoms, xyzZinso, AtomMatrices, filename, echo - 5);
+      green_input::mapped_Hamiltonian_t hmt; // a sparse potential is decoded block by block in construct_Green_function
+      bool const sparse = green_input::is_binary_Hamiltonian(filename) && (0 == hmt.map(filename, echo - 5)) && hmt.has_sparse_potential();
+      auto stat = sparse ? hmt.copy_to(ng, bc, hg, Veff, natoms, xyzZinso, AtomMatrices, false)
+                         : green_input::load_Hamiltonian(ng, bc, hg, Veff, natoms, xyzZinso, AtomMatrices, filename, echo - 5);
+      if (!sparse) hmt.unmap();
       if (stat) {
           warn("failed to load_Hamiltonian with status=%d", int(stat));
           if (!already_initialized) green_parallel::finalize();
@@ -1501,16 +2003,28 @@ namespace green_function {
       int const r1c2 = control::get("green_function.benchmark.complex", 1.) + 1;
       int const noco = control::get("green_function.benchmark.noco", 1.);
 
+      int const planning = control::get("green_function.plan.estimate", 0.); // 0:off, 1:estimate and construct, 2:estimate only
+      right_hand_sides_t rhs; // filled by plan_parameters, reused by construct_Green_function
+      if (planning > 0) {
+          int const fp_bits = control::get("green_function.benchmark.floating.point.bits", 32.);
+          int const fp_bytes = (64 == fp_bits) ? 8 : ((16 == fp_bits) ? 2 : 4);
+          stat += plan_parameters(ng, bc, hg, xyzZinso, r1c2, noco, fp_bytes, echo, &rhs);
+          if (planning > 1) {
+              if (!already_initialized) green_parallel::finalize();
+              return stat;
+          } // estimate only
+      } // planning
+
 //    for (int ia = 0; ia < natoms; ++ia) { xyzZinso[ia*8 + 3] = 6; } // set all atoms to carbon
 
       green_action::plan_t p;
-      stat += construct_Green_function(p, ng, bc, hg, Veff, xyzZinso, AtomMatrices, echo, nullptr, noco);
+      stat += construct_Green_function(p, ng, bc, hg, Veff, xyzZinso, AtomMatrices, echo, nullptr, noco, &hmt, &rhs);
 
       assert(1 == r1c2 || 2 == r1c2);
       assert(1 == noco || r1c2 == noco);
       int const fp = control::get("green_function.benchmark.floating.point.bits", 32.);
       int const iterations = control::get("green_function.benchmark.iterations", 1.);
-      int const action_key = 1000*((32 == fp) ? 32 : 64) + 10*r1c2 + noco;
+      int const action_key = 1000*((16 == fp || 32 == fp) ? fp : 64) + 10*r1c2 + noco; // 16: compute in float, store in half
       int const action = control::get("green_function.benchmark.action", action_key*1.);
                       // -1: no iterations, 0:run memory initialization only, >0: iterate
       // try one of the 6 combinations (strangely, we cannot run any two of these calls after each other, ToDo: find out what's wrong here)
@@ -1523,12 +2037,17 @@ namespace green_function {
 #ifdef    HAS_TFQMRGPU
           case 32011:                                                       // real
           case 64011: error("tfQMRgpu needs R1C2 == 2 but found green_function.benchmark.action=%d", action); break;
+          case 16011: case 16021:                                           // half
+          case 16022: error("tfQMRgpu keeps its vectors in real_t but found green_function.benchmark.action=%d", action); break;
 #else  // HAS_TFQMRGPU
           case 32011: test_action<float ,1,1>(p, iterations, echo); break; // real
           case 64011: test_action<double,1,1>(p, iterations, echo); break; // real
+          case 16011: test_action<float ,1,1,green_precision::float16_t>(p, iterations, echo); break; // real, half storage
+          case 16021: test_action<float ,2,1,green_precision::float16_t>(p, iterations, echo); break; // complex, half storage
+          case 16022: test_action<float ,2,2,green_precision::float16_t>(p, iterations, echo); break; // non-collinear, half storage
 #endif // HAS_TFQMRGPU
           case 0: if (echo > 1) std::printf("# green_function.benchmark.action=0 --> test_action is not called!\n"); break;
-          default: warn("green_function.benchmark.action must be in {32011, 32021, 32022, 64011, 64021, 64022} but found %d", action);
+          default: warn("green_function.benchmark.action must be in {16011, 16021, 16022, 32011, 32021, 32022, 64011, 64021, 64022} but found %d", action);
                    ++stat;
       } // switch action
 
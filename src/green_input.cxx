@@ -6,6 +6,20 @@
 #include <cstdlib> // std::atoi, ::atof
 #include <cstdint> // int8_t
 #include <string> // std::string, ::string:npos
+#include <map> // std::map<K,V>
+#include <algorithm> // std::min, ::max, ::lower_bound
+#include <cstring> // std::memcmp, ::memcpy, ::strncpy
+#include <cmath> // std::sqrt
+
+#if defined(__unix__) || defined(__APPLE__)
+  #ifndef   HAS_NO_MMAP
+    #define HAS_MMAP
+    #include <sys/mman.h> // ::mmap, ::munmap
+    #include <sys/stat.h> // ::fstat
+    #include <fcntl.h> // ::open
+    #include <unistd.h> // ::close
+  #endif // HAS_NO_MMAP
+#endif // unix
 
 #include "green_input.hxx"
 
@@ -20,12 +34,496 @@
 
 #include "sho_tools.hxx" // ::nSHO
 #include "xml_reading.hxx" // ::read_sequence
-#include "inline_math.hxx" // set
+#include "inline_math.hxx" // set, pow2
 #include "control.hxx" // ::get
 #include "json_reading.hxx" // ::load_Hamiltonian
+#include "simple_timer.hxx" // SimpleTimer
+#include "recorded_warnings.hxx" // warn, error
 
 namespace green_input {
 
+  namespace binary_format {
+
+      char const magic[8] = {'a', '4', '3', 'H', 'm', 't', '\n', '\0'};
+      uint32_t const version = 2; // version 1 had no "Vblocks" section
+      uint32_t const endian_check = 0x01020304; // reads 0x04030201 on a machine with the other byte order
+      size_t const alignment = 64; // in Byte, sections start at cache line boundaries
+
+      enum { ATOMS=0, OFFSETS, MATRICES, POTENTIAL, BLOCKS, N_SECTIONS };
+      char const section_name[N_SECTIONS][8] = {"atoms", "offsets", "matrix", "Veff", "Vblocks"};
+
+      struct section_t {
+          char     name[8];
+          uint64_t offset; // in Byte from the start of the file
+          uint64_t bytes;
+      }; // section_t
+
+      struct header_t {
+          char     magic[8];
+          uint32_t version;
+          uint32_t endian;
+          uint32_t ng[3];
+          int32_t  natoms;
+          int8_t   bc[4];
+          int32_t  has_spectrum;
+          double   hg[3];
+          double   spectrum[3]; // min, max, Fermi level
+          uint64_t file_bytes;
+          section_t section[N_SECTIONS];
+      }; // header_t
+      static_assert(216 == sizeof(header_t), "binary_format::header_t should not contain padding");
+      size_t const header_v1_bytes = sizeof(header_t) - sizeof(section_t); // version 1 had only 4 sections
+
+      inline size_t aligned(size_t const bytes) { return ((bytes - 1)/alignment + 1)*alignment; }
+
+      // the "Vblocks" section starts with this header, followed by
+      //    uint64_t index[nstored], double min_max[nstored][2], uint64_t data_offset[nstored + 1], uint8_t data[]
+      // The data of a block has 0 Byte if the block is constant (min == max), 512 Byte if stored raw
+      // or less if compressed: each value is xor-ed with its predecessor and stored without its
+      // leading zero bytes, the numbers of dropped bytes are kept in 64 nibbles in front.
+      struct blocks_header_t {
+          uint32_t nb[3]; // number of 4x4x4 blocks per direction
+          uint32_t compression; // 0: raw, 1: xor and leading zero bytes dropped
+          uint64_t nstored; // number of blocks that differ from the background
+          double   background; // value of all blocks that are not stored
+      }; // blocks_header_t
+      static_assert(32 == sizeof(blocks_header_t), "binary_format::blocks_header_t should not contain padding");
+
+      inline uint64_t bits_of(double const value) { uint64_t b; std::memcpy(&b, &value, 8); return b; }
+      inline double value_of(uint64_t const bits) { double v; std::memcpy(&v, &bits, 8); return v; }
+
+      inline size_t compress_block(uint8_t out[512], double const V[64]) {
+          // returns the number of bytes used, 512 if the block does not compress
+          uint8_t buffer[32 + 512];
+          std::memset(buffer, 0, 32); // nibbles
+          size_t n{32};
+          uint64_t previous{0};
+          for (int i64 = 0; i64 < 64; ++i64) {
+              auto const bits = bits_of(V[i64]);
+              auto const x = bits ^ previous;
+              previous = bits;
+              int nzero{0}; // number of leading zero bytes, 0..8
+              while (nzero < 8 && 0 == ((x >> (8*(7 - nzero))) & 0xff)) ++nzero;
+              buffer[i64 >> 1] |= nzero << (4*(i64 & 1));
+              for (int ib = 0; ib < 8 - nzero; ++ib) buffer[n++] = (x >> (8*ib)) & 0xff;
+          } // i64
+          if (n >= 512) {
+              std::memcpy(out, V, 512);
+              return 512;
+          } // does not compress
+          std::memcpy(out, buffer, n);
+          return n;
+      } // compress_block
+
+      inline void decompress_block(double V[64], uint8_t const in[], size_t const nbytes) {
+          if (512 == nbytes) { std::memcpy(V, in, 512); return; } // raw
+          size_t n{32};
+          uint64_t previous{0};
+          for (int i64 = 0; i64 < 64; ++i64) {
+              int const nzero = (in[i64 >> 1] >> (4*(i64 & 1))) & 0xf;
+              uint64_t x{0};
+              for (int ib = 0; ib < 8 - nzero; ++ib) x |= uint64_t(in[n++]) << (8*ib);
+              previous ^= x;
+              V[i64] = value_of(previous);
+          } // i64
+          assert(n == nbytes);
+      } // decompress_block
+
+      inline void get_block(double V[64], double const Veff[], uint32_t const ng[3], size_t const ibx, size_t const iby, size_t const ibz) {
+          for (int i4z = 0; i4z < 4; ++i4z) {
+          for (int i4y = 0; i4y < 4; ++i4y) {
+              auto const izyx = ((ibz*4 + i4z)*ng[1] + iby*4 + i4y)*ng[0] + ibx*4;
+              set(&V[(i4z*4 + i4y)*4], 4, &Veff[izyx]);
+          }} // i4y i4z
+      } // get_block
+
+      status_t sparse_blocks(std::vector<char> & section, double const Veff[], uint32_t const ng[3], int const compression, int const echo=0) {
+          // collect all blocks that differ from the most frequent constant block value
+          blocks_header_t bh;
+          std::memset(&bh, 0, sizeof(bh));
+          for (int d = 0; d < 3; ++d) {
+              if (ng[d] & 0x3) return -1; // needs multiples of 4
+              bh.nb[d] = ng[d] >> 2;
+          } // d
+          bh.compression = compression;
+          size_t const nall = size_t(bh.nb[2])*size_t(bh.nb[1])*size_t(bh.nb[0]);
+
+          std::map<uint64_t,size_t> constant; // bit pattern --> number of constant blocks
+          double V[64];
+          for (size_t ibz = 0; ibz < bh.nb[2]; ++ibz) {
+          for (size_t iby = 0; iby < bh.nb[1]; ++iby) {
+          for (size_t ibx = 0; ibx < bh.nb[0]; ++ibx) {
+              get_block(V, Veff, ng, ibx, iby, ibz);
+              int i64{1};
+              while (i64 < 64 && bits_of(V[i64]) == bits_of(V[0])) ++i64;
+              if (64 == i64) ++constant[bits_of(V[0])];
+          }}} // ibx iby ibz
+          size_t nbackground{0};
+          for (auto const & c : constant) {
+              if (c.second > nbackground) { nbackground = c.second; bh.background = value_of(c.first); }
+          } // c
+          bh.nstored = nall - nbackground;
+
+          std::vector<uint64_t> index(bh.nstored), offset(bh.nstored + 1, 0);
+          std::vector<double> min_max(2*bh.nstored);
+          std::vector<uint8_t> data;
+          data.reserve(bh.nstored*(compression ? 256 : 512));
+          auto const background_bits = bits_of(bh.background);
+          size_t istored{0}, nconstant{0};
+          uint8_t buffer[512];
+          for (size_t ibz = 0; ibz < bh.nb[2]; ++ibz) {
+          for (size_t iby = 0; iby < bh.nb[1]; ++iby) {
+          for (size_t ibx = 0; ibx < bh.nb[0]; ++ibx) {
+              get_block(V, Veff, ng, ibx, iby, ibz);
+              bool is_constant{true};
+              double vmin{V[0]}, vmax{V[0]};
+              for (int i64 = 0; i64 < 64; ++i64) {
+                  is_constant = is_constant && (bits_of(V[i64]) == bits_of(V[0]));
+                  vmin = std::min(vmin, V[i64]);
+                  vmax = std::max(vmax, V[i64]);
+              } // i64
+              if (is_constant && nbackground > 0 && bits_of(V[0]) == background_bits) continue; // background block
+              index[istored] = (ibz*bh.nb[1] + iby)*bh.nb[0] + ibx;
+              min_max[2*istored + 0] = is_constant ? V[0] : vmin;
+              min_max[2*istored + 1] = is_constant ? V[0] : vmax;
+              size_t nbytes{0}; // constant blocks need no data, the value is in min_max
+              if (!is_constant) {
+                  if (compression) {
+                      nbytes = compress_block(buffer, V);
+                  } else {
+                      std::memcpy(buffer, V, 512);
+                      nbytes = 512;
+                  } // compression
+              } else ++nconstant;
+              data.insert(data.end(), buffer, buffer + nbytes);
+              offset[istored + 1] = offset[istored] + nbytes;
+              ++istored;
+          }}} // ibx iby ibz
+          assert(bh.nstored == istored);
+
+          section.resize(sizeof(bh) + (8 + 16 + 8)*bh.nstored + 8 + data.size());
+          auto ptr = section.data();
+          std::memcpy(ptr, &bh, sizeof(bh));                  ptr += sizeof(bh);
+          std::memcpy(ptr, index.data(), 8*bh.nstored);       ptr += 8*bh.nstored;
+          std::memcpy(ptr, min_max.data(), 16*bh.nstored);    ptr += 16*bh.nstored;
+          std::memcpy(ptr, offset.data(), 8*(bh.nstored + 1)); ptr += 8*(bh.nstored + 1);
+          std::memcpy(ptr, data.data(), data.size());
+          if (echo > 3) std::printf("# %s: %ld of %ld blocks differ from the background %g, %ld of them constant, "
+                                    "data %.3f kByte (%.1f %% of raw)\n", __func__, bh.nstored, nall, bh.background, nconstant,
+                                    data.size()*1e-3, data.size()*100./std::max(1., 512.*(bh.nstored - nconstant)));
+          return 0;
+      } // sparse_blocks
+
+  } // namespace binary_format
+
+  bool is_binary_Hamiltonian(char const *filename) {
+      char head[8];
+      auto *const f = std::fopen(filename, "rb");
+      if (nullptr == f) return false;
+      auto const nread = std::fread(head, 1, 8, f);
+      std::fclose(f);
+      return (8 == nread) && (0 == std::memcmp(head, binary_format::magic, 8));
+  } // is_binary_Hamiltonian
+
+  status_t write_binary_Hamiltonian(
+        char const *filename
+      , uint32_t const ng[3] // numbers of grid points
+      , int8_t const bc[3] // boundary conditions
+      , double const hg[3] // grid spacings
+      , double const Veff[] // [ng[2]*ng[1]*ng[0]]
+      , int const natoms
+      , double const xyzZinso[] // [natoms*8]
+      , double const *const atom_mat[] // [natoms][2*nSHO^2]
+      , double const energy_min_max_Fermi[3] // =nullptr
+      , int const echo // =0, log-level
+      , int const sparse // =0, 0: dense potential, 1: potential blocks, 2: compressed potential blocks
+  ) {
+      using namespace binary_format;
+      header_t h;
+      std::memset(&h, 0, sizeof(h));
+      std::memcpy(h.magic, magic, 8);
+      h.version = version;
+      h.endian = endian_check;
+      for (int d = 0; d < 3; ++d) {
+          h.ng[d] = ng[d];
+          h.bc[d] = bc[d];
+          h.hg[d] = hg[d];
+      } // d
+      h.natoms = natoms;
+      h.has_spectrum = (nullptr != energy_min_max_Fermi);
+      if (h.has_spectrum) set(h.spectrum, 3, energy_min_max_Fermi);
+
+      std::vector<uint64_t> offsets(natoms + 1, 0);
+      for (int ia = 0; ia < natoms; ++ia) {
+          int const nSHO = sho_tools::nSHO(int(xyzZinso[ia*8 + 5]));
+          offsets[ia + 1] = offsets[ia] + 2*nSHO*nSHO;
+      } // ia
+
+      std::vector<char> blocks; // sparse potential
+      if (sparse > 0 && 0 != sparse_blocks(blocks, Veff, ng, sparse - 1, echo)) {
+          warn("potential of %d x %d x %d grid points cannot be stored in 4x4x4 blocks, write it dense", ng[0], ng[1], ng[2]);
+      } // sparse
+      size_t const ngall = size_t(ng[2])*size_t(ng[1])*size_t(ng[0]);
+      size_t const section_bytes[] = {natoms*8*sizeof(double), (natoms + 1)*sizeof(uint64_t),
+                      offsets[natoms]*sizeof(double), blocks.empty() ? ngall*sizeof(double) : 0, blocks.size()};
+      size_t offset = aligned(sizeof(header_t));
+      for (int is = 0; is < N_SECTIONS; ++is) {
+          std::memcpy(h.section[is].name, section_name[is], 8);
+          h.section[is].offset = offset;
+          h.section[is].bytes = section_bytes[is];
+          offset = aligned(offset + section_bytes[is]);
+      } // is
+      h.file_bytes = offset;
+
+      auto *const f = std::fopen(filename, "wb");
+      if (nullptr == f) {
+          warn("failed to open \"%s\" for writing", filename);
+          return -1; // error
+      } // failed to open
+
+      char const zeros[alignment] = {0};
+      size_t written{0};
+      written += std::fwrite(&h, 1, sizeof(h), f);
+      written += std::fwrite(zeros, 1, h.section[ATOMS].offset - sizeof(h), f);
+      for (int is = 0; is < N_SECTIONS; ++is) {
+          if (section_bytes[is] > 0) {
+              if (MATRICES == is) {
+                  for (int ia = 0; ia < natoms; ++ia) {
+                      written += std::fwrite(atom_mat[ia], sizeof(double), offsets[ia + 1] - offsets[ia], f)*sizeof(double);
+                  } // ia
+              } else {
+                  void const *const data[] = {xyzZinso, offsets.data(), nullptr, Veff, blocks.data()};
+                  written += std::fwrite(data[is], 1, section_bytes[is], f);
+              }
+          } // non-empty
+          auto const next = (is + 1 < N_SECTIONS) ? h.section[is + 1].offset : h.file_bytes;
+          written += std::fwrite(zeros, 1, next - h.section[is].offset - section_bytes[is], f);
+      } // is
+      std::fclose(f);
+
+      if (written != h.file_bytes) {
+          warn("wrote only %ld of %ld Byte to \"%s\"", written, size_t(h.file_bytes), filename);
+          return -2; // error
+      } // incomplete
+      if (echo > 3) std::printf("# %s: %d atoms and %d x %d x %d grid points%s, %.3f MByte written to \"%s\"\n",
+          __func__, natoms, ng[0], ng[1], ng[2], blocks.empty() ? "" : " in blocks", h.file_bytes*1e-6, filename);
+      return 0; // success
+  } // write_binary_Hamiltonian
+
+  void mapped_Hamiltonian_t::unmap() {
+#ifdef    HAS_MMAP
+      if (is_mapped_ && nullptr != data_) ::munmap((void*)data_, bytes_);
+#endif // HAS_MMAP
+      buffer_.clear();
+      data_ = nullptr; bytes_ = 0; is_mapped_ = false;
+      natoms_ = 0; Veff_ = nullptr; xyzZinso_ = nullptr; offsets_ = nullptr; matrices_ = nullptr;
+      nstored_ = 0; compression_ = 0; background_ = 0;
+      block_index_ = nullptr; block_min_max_ = nullptr; block_offset_ = nullptr; block_data_ = nullptr;
+  } // unmap
+
+  status_t mapped_Hamiltonian_t::map(char const *filename, int const echo) {
+      using namespace binary_format;
+      unmap();
+#ifdef    HAS_MMAP
+      {
+          int const fd = ::open(filename, O_RDONLY);
+          if (fd < 0) { warn("failed to open \"%s\"", filename); return -1; }
+          struct stat st;
+          if (0 == ::fstat(fd, &st) && st.st_size >= header_v1_bytes) {
+              auto const ptr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+              if (MAP_FAILED != ptr) {
+                  data_ = (char const*)ptr;
+                  bytes_ = st.st_size;
+                  is_mapped_ = true;
+              } // mapped
+          } // size
+          ::close(fd);
+      }
+#endif // HAS_MMAP
+      if (nullptr == data_) { // fallback: read the entire file into an 8-byte aligned buffer
+          auto *const f = std::fopen(filename, "rb");
+          if (nullptr == f) { warn("failed to open \"%s\"", filename); return -1; }
+          std::fseek(f, 0, SEEK_END);
+          bytes_ = std::ftell(f);
+          std::fseek(f, 0, SEEK_SET);
+          buffer_.resize((bytes_ + 7)/8);
+          auto const nread = std::fread(buffer_.data(), 1, bytes_, f);
+          std::fclose(f);
+          if (nread != bytes_) { warn("failed to read \"%s\"", filename); unmap(); return -1; }
+          data_ = (char const*)buffer_.data();
+      } // fallback
+
+      if (bytes_ < header_v1_bytes) { warn("file \"%s\" is too short", filename); unmap(); return -2; }
+      auto const & h = *(header_t const*)data_; // the section[BLOCKS] entry is only accessed for version 2 and later
+      if (0 != std::memcmp(h.magic, magic, 8)) { warn("file \"%s\" is not a binary Hamiltonian", filename); unmap(); return -3; }
+      if (endian_check != h.endian) { warn("file \"%s\" has been written with a different byte order", filename); unmap(); return -4; }
+      if (h.version < 1 || h.version > version) { warn("file \"%s\" has version %d but expected %d", filename, h.version, version); unmap(); return -5; }
+      if (h.version > 1 && bytes_ < sizeof(header_t)) { warn("file \"%s\" is too short", filename); unmap(); return -2; }
+      if (h.file_bytes > bytes_) { warn("file \"%s\" is truncated, %ld of %ld Byte", filename, bytes_, size_t(h.file_bytes)); unmap(); return -6; }
+      int const nsections = (1 == h.version) ? BLOCKS : N_SECTIONS; // version 1 has no sparse potential
+      for (int is = 0; is < nsections; ++is) {
+          auto const & sec = h.section[is];
+          if (sec.offset % alignment || sec.offset + sec.bytes > bytes_) {
+              warn("section \"%s\" in file \"%s\" is out of bounds", section_name[is], filename); unmap(); return -7;
+          } // out of bounds
+      } // is
+
+      natoms_ = h.natoms;
+      has_spectrum_ = h.has_spectrum;
+      for (int d = 0; d < 3; ++d) {
+          ng_[d] = h.ng[d];
+          bc_[d] = h.bc[d];
+          hg_[d] = h.hg[d];
+          spectrum_[d] = h.spectrum[d];
+      } // d
+      xyzZinso_ = (double   const*)(data_ + h.section[ATOMS].offset);
+      offsets_  = (uint64_t const*)(data_ + h.section[OFFSETS].offset);
+      matrices_ = (double   const*)(data_ + h.section[MATRICES].offset);
+      Veff_     = (double   const*)(data_ + h.section[POTENTIAL].offset);
+
+      bool const sparse = (nsections > BLOCKS) && (h.section[BLOCKS].bytes > 0);
+      if (sparse) {
+          Veff_ = nullptr;
+          auto const *const block_section = data_ + h.section[BLOCKS].offset;
+          auto const & bh = *(blocks_header_t const*)block_section;
+          nstored_ = bh.nstored;
+          compression_ = bh.compression;
+          background_ = bh.background;
+          bool consistent = (h.section[BLOCKS].bytes >= sizeof(bh) + (8 + 16 + 8)*nstored_ + 8);
+          for (int d = 0; d < 3; ++d) consistent = consistent && (4*bh.nb[d] == ng_[d]);
+          if (consistent) {
+              block_index_   = (uint64_t const*)(block_section + sizeof(bh));
+              block_min_max_ = (double   const*)(block_index_ + nstored_);
+              block_offset_  = (uint64_t const*)(block_min_max_ + 2*nstored_);
+              block_data_    = (uint8_t  const*)(block_offset_ + nstored_ + 1);
+              size_t const nall = size_t(bh.nb[2])*size_t(bh.nb[1])*size_t(bh.nb[0]);
+              consistent = (0 == block_offset_[0]) && (nstored_ <= nall) && (h.section[BLOCKS].bytes ==
+                            sizeof(bh) + (8 + 16 + 8)*nstored_ + 8 + block_offset_[nstored_]);
+              for (size_t i = 0; i < nstored_ && consistent; ++i) {
+                  auto const nbytes = block_offset_[i + 1] - block_offset_[i];
+                  consistent = (block_index_[i] < nall) && (block_offset_[i + 1] >= block_offset_[i])
+                            && (i < 1 || block_index_[i] > block_index_[i - 1])
+                            && (0 == nbytes || 512 == nbytes || (compression_ && nbytes >= 32 && nbytes < 512));
+              } // i
+          } // consistent
+          if (!consistent) { warn("potential blocks in file \"%s\" are inconsistent", filename); unmap(); return -9; }
+      } // sparse
+
+      size_t const ngall = size_t(ng_[2])*size_t(ng_[1])*size_t(ng_[0]);
+      bool consistent = (h.section[ATOMS].bytes == natoms_*8*sizeof(double))
+                     && (h.section[OFFSETS].bytes == (natoms_ + 1)*sizeof(uint64_t))
+                     && (h.section[POTENTIAL].bytes == (sparse ? 0 : ngall*sizeof(double)))
+                     && (0 == offsets_[0])
+                     && (h.section[MATRICES].bytes == offsets_[natoms_]*sizeof(double));
+      for (int ia = 0; ia < natoms_ && consistent; ++ia) {
+          int const nSHO = sho_tools::nSHO(int(xyzZinso_[ia*8 + 5]));
+          consistent = (offsets_[ia + 1] - offsets_[ia] == 2*nSHO*nSHO);
+      } // ia
+      if (!consistent) { warn("section sizes in file \"%s\" are inconsistent", filename); unmap(); return -8; }
+
+      if (echo > 3) std::printf("# %s: %d atoms and %d x %d x %d grid points, %.3f MByte %s from \"%s\"\n",
+                                    __func__, natoms_, ng_[0], ng_[1], ng_[2], bytes_*1e-6, is_mapped_?"mapped":"read", filename);
+      if (echo > 3 && sparse) std::printf("# %s: %ld of %ld potential blocks stored, background %g\n",
+                                    __func__, size_t(nstored_), size_t(ng_[2])*size_t(ng_[1])*size_t(ng_[0])/64, background_);
+      return 0; // success
+  } // map
+
+  status_t mapped_Hamiltonian_t::potential_block(size_t const iblock, double V[64], double min_max[2]) const {
+      using namespace binary_format;
+      uint32_t const nb[] = {ng_[0] >> 2, ng_[1] >> 2, ng_[2] >> 2};
+      if (iblock >= size_t(nb[2])*size_t(nb[1])*size_t(nb[0])) return -1; // out of range
+      if (nullptr != block_index_) {
+          auto const it = std::lower_bound(block_index_, block_index_ + nstored_, uint64_t(iblock));
+          if (it == block_index_ + nstored_ || *it != iblock) {
+              for (int i64 = 0; i64 < 64; ++i64) V[i64] = background_;
+              if (min_max) { min_max[0] = background_; min_max[1] = background_; }
+              return 0;
+          } // background block
+          size_t const istored = it - block_index_;
+          auto const nbytes = block_offset_[istored + 1] - block_offset_[istored];
+          if (nbytes > 0) {
+              decompress_block(V, block_data_ + block_offset_[istored], nbytes);
+          } else {
+              for (int i64 = 0; i64 < 64; ++i64) V[i64] = block_min_max_[2*istored]; // constant block
+          } // nbytes
+          if (min_max) { min_max[0] = block_min_max_[2*istored]; min_max[1] = block_min_max_[2*istored + 1]; }
+      } else {
+          if (nullptr == Veff_ || (ng_[0] | ng_[1] | ng_[2]) & 0x3) return -2; // dense potential does not fit into blocks
+          size_t const ibx = iblock % nb[0], iby = (iblock/nb[0]) % nb[1], ibz = iblock/(size_t(nb[0])*nb[1]);
+          get_block(V, Veff_, ng_, ibx, iby, ibz);
+          if (min_max) {
+              min_max[0] = V[0]; min_max[1] = V[0];
+              for (int i64 = 0; i64 < 64; ++i64) {
+                  min_max[0] = std::min(min_max[0], V[i64]);
+                  min_max[1] = std::max(min_max[1], V[i64]);
+              } // i64
+          } // min_max
+      } // sparse
+      return 0;
+  } // potential_block
+
+  status_t mapped_Hamiltonian_t::copy_to(
+        uint32_t ng[3] // numbers of grid points
+      , int8_t bc[3] // boundary conditions
+      , double hg[3] // grid spacings
+      , std::vector<double> & Veff
+      , int & natoms
+      , std::vector<double> & xyzZinso
+      , std::vector<std::vector<double>> & atom_mat
+      , bool const with_potential // =true
+  ) const {
+      if (nullptr == data_) return -1; // not mapped
+      set(ng, 3, ng_);
+      set(bc, 3, bc_);
+      set(hg, 3, hg_);
+      natoms = natoms_;
+      xyzZinso.assign(xyzZinso_, xyzZinso_ + natoms*8);
+      atom_mat.resize(natoms);
+      for (int ia = 0; ia < natoms; ++ia) {
+          atom_mat[ia].assign(atom_matrix(ia), atom_matrix(ia) + atom_matrix_size(ia));
+      } // ia
+      Veff.resize(0);
+      if (!with_potential) return 0;
+      size_t const ngall = size_t(ng[2])*size_t(ng[1])*size_t(ng[0]);
+      if (nullptr != Veff_) {
+          Veff.assign(Veff_, Veff_ + ngall);
+      } else {
+          Veff.assign(ngall, background_); // materialize all blocks
+          uint32_t const nb[] = {ng_[0] >> 2, ng_[1] >> 2, ng_[2] >> 2};
+          double V[64];
+          for (size_t istored = 0; istored < nstored_; ++istored) {
+              auto const iblock = block_index_[istored];
+              potential_block(iblock, V);
+              size_t const ibx = iblock % nb[0], iby = (iblock/nb[0]) % nb[1], ibz = iblock/(size_t(nb[0])*nb[1]);
+              for (int i4z = 0; i4z < 4; ++i4z) {
+              for (int i4y = 0; i4y < 4; ++i4y) {
+                  auto const izyx = ((ibz*4 + i4z)*ng_[1] + iby*4 + i4y)*ng_[0] + ibx*4;
+                  set(&Veff[izyx], 4, &V[(i4z*4 + i4y)*4]);
+              }} // i4y i4z
+          } // istored
+      } // sparse
+      return 0;
+  } // copy_to
+
+  status_t load_binary_Hamiltonian(
+        uint32_t ng[3] // numbers of grid points
+      , int8_t bc[3] // boundary conditions
+      , double hg[3] // grid spacings
+      , std::vector<double> & Veff
+      , int & natoms
+      , std::vector<double> & xyzZinso
+      , std::vector<std::vector<double>> & atom_mat
+      , char const *filename
+      , int const echo=0 // log-level
+  ) {
+      // copies out of the mapped file into the std::vector interface,
+      // use mapped_Hamiltonian_t directly to avoid the copy
+      mapped_Hamiltonian_t mapped;
+      auto const stat = mapped.map(filename, echo);
+      if (stat) return stat;
+      return mapped.copy_to(ng, bc, hg, Veff, natoms, xyzZinso, atom_mat);
+  } // load_binary_Hamiltonian
+
   status_t load_Hamiltonian(
         uint32_t ng[3] // numbers of grid points
       , int8_t bc[3] // boundary conditions
@@ -41,6 +539,10 @@ namespace green_input {
           filename = control::get("green_input.filename", "Hmt.xml");
           if (echo > 0) std::printf("# use +green_input.filename \"%s\"\n", filename);
       } // use a default file name
+      if (is_binary_Hamiltonian(filename)) {
+          if (echo > 0) std::printf("# filename \"%s\" is a binary Hamiltonian\n", filename);
+          return load_binary_Hamiltonian(ng, bc, hg, Veff, natoms, xyzZinso, atom_mat, filename, echo);
+      } // binary
       if (std::string::npos != std::string(filename).find(".json")) {
           if (echo > 0) std::printf("# filename \"%s\" looks like .json formatted\n", filename);
           auto const json_stat = json_reading::load_Hamiltonian(ng, bc, hg, Veff, natoms, xyzZinso, atom_mat, filename, echo);
@@ -216,6 +718,31 @@ namespace green_input {
       return 0; // success
   } // load_Hamiltonian
 
+  status_t convert_Hamiltonian(char const *infile, char const *outfile, int const echo) {
+      uint32_t ng[3]; // numbers of grid points
+      int8_t bc[3]; // boundary conditions
+      double hg[3]; // grid spacings
+      std::vector<double> Veff;
+      int natoms;
+      std::vector<double> xyzZinso;
+      std::vector<std::vector<double>> atom_mat;
+      SimpleTimer timer(__FILE__, __LINE__, __func__, 0);
+      auto const stat = load_Hamiltonian(ng, bc, hg, Veff, natoms, xyzZinso, atom_mat, infile, echo/2);
+      auto const time_load = timer.stop();
+      if (stat) {
+          warn("failed to load \"%s\" with status= %i", infile, int(stat));
+          return stat;
+      } // stat
+      std::vector<double const*> atom_mat_ptr(natoms);
+      for (int ia = 0; ia < natoms; ++ia) atom_mat_ptr[ia] = atom_mat[ia].data();
+      int const sparse = control::get("green_input.convert.sparse", 0.); // 1: potential blocks, 2: compressed blocks
+      auto const stat_write = write_binary_Hamiltonian(outfile, ng, bc, hg, Veff.data(), natoms,
+                                              xyzZinso.data(), atom_mat_ptr.data(), nullptr, echo, sparse);
+      if (echo > 1) std::printf("# %s: loading \"%s\" took %.3f sec, binary written to \"%s\"\n",
+                                    __func__, infile, time_load, outfile);
+      return stat_write;
+  } // convert_Hamiltonian
+
   status_t test_loading(int const echo=0) {
       uint32_t ng[3]; // numbers of grid points
       int8_t bc[3]; // boundary conditions
@@ -228,8 +755,249 @@ namespace green_input {
       return load_Hamiltonian(ng, bc, hg, Veff, natoms, xyzZinso, atom_mat, filename, echo);
   } // test_loading
 
+  status_t test_binary_format(int const echo=0) {
+      // write a synthetic Hamiltonian to a binary file, map it and compare bitwise
+      uint32_t const ng[] = {8, 12, 20};
+      int8_t const bc[] = {1, 0, 1};
+      double const hg[] = {0.25, 0.5, 0.375};
+      int const natoms = 3;
+      size_t const ngall = size_t(ng[2])*size_t(ng[1])*size_t(ng[0]);
+      std::vector<double> Veff(ngall), xyzZinso(natoms*8, 0.0);
+      std::vector<std::vector<double>> atom_mat(natoms);
+      std::vector<double const*> atom_mat_ptr(natoms);
+      for (size_t izyx = 0; izyx < ngall; ++izyx) Veff[izyx] = std::sqrt(izyx + 0.5) - 7;
+      for (int ia = 0; ia < natoms; ++ia) {
+          int const numax = 1 + ia;
+          double const info[] = {ia - 1.5, 0.25*ia, -0.5, 1. + ia, 10. + ia, 1.*numax, 0.5 + 0.125*ia, 0};
+          set(&xyzZinso[ia*8], 8, info);
+          int const nSHO = sho_tools::nSHO(numax);
+          atom_mat[ia].resize(2*nSHO*nSHO);
+          for (int ij = 0; ij < 2*nSHO*nSHO; ++ij) atom_mat[ia][ij] = 1./(1 + ij + ia);
+          atom_mat_ptr[ia] = atom_mat[ia].data();
+      } // ia
+      double const spectrum[] = {-1.5, 2.5, 0.125};
+
+      auto const filename = control::get("green_input.test.binary.file", "green_input_test.hmt");
+      SimpleTimer write_timer(__FILE__, __LINE__, __func__, 0);
+      status_t stat = write_binary_Hamiltonian(filename, ng, bc, hg, Veff.data(), natoms,
+                                         xyzZinso.data(), atom_mat_ptr.data(), spectrum, echo);
+      auto const time_write = write_timer.stop();
+      if (stat) return stat;
+      if (!is_binary_Hamiltonian(filename)) ++stat;
+
+      double time_map{0};
+      { // scope: zero-copy views
+          SimpleTimer map_timer(__FILE__, __LINE__, __func__, 0);
+          mapped_Hamiltonian_t mapped;
+          stat += mapped.map(filename, echo);
+          time_map = map_timer.stop();
+          if (0 == stat) {
+              int ndiff{0};
+              for (int d = 0; d < 3; ++d) {
+                  ndiff += (ng[d] != mapped.grid_points()[d]) + (bc[d] != mapped.boundary_conditions()[d])
+                         + (hg[d] != mapped.grid_spacings()[d]) + (spectrum[d] != mapped.spectrum()[d]);
+              } // d
+              ndiff += (natoms != mapped.number_of_atoms());
+              ndiff += std::memcmp(Veff.data(), mapped.potential(), ngall*sizeof(double)) ? 1 : 0;
+              ndiff += std::memcmp(xyzZinso.data(), mapped.atom_info(), natoms*8*sizeof(double)) ? 1 : 0;
+              for (int ia = 0; ia < natoms; ++ia) {
+                  ndiff += (atom_mat[ia].size() != mapped.atom_matrix_size(ia));
+                  ndiff += std::memcmp(atom_mat[ia].data(), mapped.atom_matrix(ia), atom_mat[ia].size()*sizeof(double)) ? 1 : 0;
+              } // ia
+              if (echo > 3) std::printf("# %s: %d differences in mapped file\n", __func__, ndiff);
+              stat += ndiff;
+          } // mapped
+      } // scope
+
+      { // scope: the std::vector interface
+          uint32_t ng_l[3]; int8_t bc_l[3]; double hg_l[3]; int natoms_l{0};
+          std::vector<double> Veff_l, xyzZinso_l;
+          std::vector<std::vector<double>> atom_mat_l;
+          SimpleTimer load_timer(__FILE__, __LINE__, __func__, 0);
+          stat += load_Hamiltonian(ng_l, bc_l, hg_l, Veff_l, natoms_l, xyzZinso_l, atom_mat_l, filename, echo/2);
+          auto const time_load = load_timer.stop();
+          int ndiff = (Veff != Veff_l) + (xyzZinso != xyzZinso_l) + (atom_mat != atom_mat_l) + (natoms != natoms_l);
+          for (int d = 0; d < 3; ++d) ndiff += (ng[d] != ng_l[d]) + (bc[d] != bc_l[d]) + (hg[d] != hg_l[d]);
+          if (echo > 3) std::printf("# %s: %d differences after load_Hamiltonian\n", __func__, ndiff);
+          if (echo > 2) std::printf("# %s: write %.6f, map %.6f, load %.6f sec\n", __func__, time_write, time_map, time_load);
+          stat += ndiff;
+      } // scope
+
+      std::remove(filename);
+      if (echo > 0) std::printf("# %s status= %i\n", __func__, int(stat));
+      return stat;
+  } // test_binary_format
+
+  status_t test_sparse_potential(int const echo=0) {
+      // an isolated system: a constant vacuum potential with a smooth well, one constant block and one
+      // block of -0.0 which must not be confused with the background, write dense and sparse and compare
+      uint32_t const ng[] = {24, 16, 20};
+      int8_t const bc[] = {0, 0, 0};
+      double const hg[] = {0.25, 0.25, 0.25};
+      size_t const ngall = size_t(ng[2])*size_t(ng[1])*size_t(ng[0]);
+      double const vacuum = 0.125;
+      std::vector<double> Veff(ngall, vacuum);
+      for (size_t iz = 0; iz < ng[2]; ++iz) {
+      for (size_t iy = 0; iy < ng[1]; ++iy) {
+      for (size_t ix = 0; ix < ng[0]; ++ix) {
+          double const r2 = pow2(ix - 10.) + pow2(iy - 7.) + pow2(iz - 9.);
+          auto const izyx = (iz*ng[1] + iy)*ng[0] + ix;
+          if (r2 < 16) Veff[izyx] = vacuum - std::exp(-0.1*r2); // well
+          if (ix >= 20 && iy < 4 && iz < 4) Veff[izyx] = -1.5; // constant block
+          if (ix < 4 && iy >= 12 && iz >= 16) Veff[izyx] = -0.0; // block of negative zeros
+      }}} // ix iy iz
+      int const natoms = 1;
+      double const xyzZinso[] = {0, 0, 0, 1, 0, 0, 1., 0};
+      std::vector<double> const atom_mat(2, 1.0);
+      double const *const atom_mat_ptr[] = {atom_mat.data()};
+
+      auto const filename = control::get("green_input.test.binary.file", "green_input_test.hmt");
+      status_t stat(0);
+      size_t file_bytes[3];
+      for (int sparse = 0; sparse <= 2; ++sparse) {
+          stat += write_binary_Hamiltonian(filename, ng, bc, hg, Veff.data(), natoms, xyzZinso, atom_mat_ptr, nullptr, echo, sparse);
+          mapped_Hamiltonian_t mapped;
+          stat += mapped.map(filename, echo);
+          if (stat) return stat;
+          file_bytes[sparse] = mapped.file_bytes();
+          int ndiff{0};
+          ndiff += (sparse > 0) != mapped.has_sparse_potential();
+          ndiff += (sparse > 0) && (vacuum != mapped.potential_background());
+          uint32_t const nb[] = {ng[0]/4, ng[1]/4, ng[2]/4};
+          for (size_t ibz = 0; ibz < nb[2]; ++ibz) {
+          for (size_t iby = 0; iby < nb[1]; ++iby) {
+          for (size_t ibx = 0; ibx < nb[0]; ++ibx) {
+              double V[64], min_max[2], Vref[64];
+              stat += mapped.potential_block((ibz*nb[1] + iby)*nb[0] + ibx, V, min_max);
+              binary_format::get_block(Vref, Veff.data(), ng, ibx, iby, ibz);
+              ndiff += std::memcmp(V, Vref, 64*sizeof(double)) ? 1 : 0; // bitwise
+              for (int i64 = 0; i64 < 64; ++i64) {
+                  ndiff += (V[i64] < min_max[0]) + (V[i64] > min_max[1]);
+              } // i64
+          }}} // ibx iby ibz
+          uint32_t ng_l[3]; int8_t bc_l[3]; double hg_l[3]; int natoms_l{0};
+          std::vector<double> Veff_l, xyzZinso_l;
+          std::vector<std::vector<double>> atom_mat_l;
+          stat += mapped.copy_to(ng_l, bc_l, hg_l, Veff_l, natoms_l, xyzZinso_l, atom_mat_l);
+          ndiff += (Veff_l.size() != ngall) || std::memcmp(Veff.data(), Veff_l.data(), ngall*sizeof(double));
+          if (echo > 3) std::printf("# %s: %s potential, %ld of %ld blocks stored, %.3f kByte, %d differences\n", __func__,
+                                    sparse ? ((sparse > 1) ? "compressed" : "sparse") : "dense", mapped.number_of_stored_blocks(),
+                                    ngall/64, file_bytes[sparse]*1e-3, ndiff);
+          stat += ndiff;
+      } // sparse
+      stat += (file_bytes[1] >= file_bytes[0]) + (file_bytes[2] > file_bytes[1]);
+      std::remove(filename);
+      if (echo > 0) std::printf("# %s status= %i\n", __func__, int(stat));
+      return stat;
+  } // test_sparse_potential
+
+  status_t test_version1(int const echo=0) {
+      // files written before the "Vblocks" section existed have a shorter header and must still be readable:
+      // write a dense version-2 file, rewrite it with the version-1 layout and compare after mapping
+      uint32_t const ng[] = {4, 8, 12};
+      int8_t const bc[] = {0, 1, 1};
+      double const hg[] = {0.5, 0.25, 0.125};
+      size_t const ngall = size_t(ng[2])*size_t(ng[1])*size_t(ng[0]);
+      std::vector<double> Veff(ngall);
+      for (size_t izyx = 0; izyx < ngall; ++izyx) Veff[izyx] = std::cos(0.1*izyx);
+      int const natoms = 2;
+      double const xyzZinso[] = {0, 0, 0, 1, 0, 1, 1., 0,   1, 2, 3, 6, 1, 2, .5, 0};
+      std::vector<std::vector<double>> atom_mat(natoms);
+      std::vector<double const*> atom_mat_ptr(natoms);
+      for (int ia = 0; ia < natoms; ++ia) {
+          int const nSHO = sho_tools::nSHO(int(xyzZinso[ia*8 + 5]));
+          atom_mat[ia].resize(2*nSHO*nSHO);
+          for (int ij = 0; ij < 2*nSHO*nSHO; ++ij) atom_mat[ia][ij] = ij - 0.5*ia;
+          atom_mat_ptr[ia] = atom_mat[ia].data();
+      } // ia
+
+      auto const filename = control::get("green_input.test.binary.file", "green_input_test.hmt");
+      status_t stat = write_binary_Hamiltonian(filename, ng, bc, hg, Veff.data(), natoms, xyzZinso, atom_mat_ptr.data(), nullptr, echo);
+      if (stat) return stat;
+
+      std::vector<char> file;
+      { // scope: read the version-2 file
+          auto *const f = std::fopen(filename, "rb");
+          if (nullptr == f) return -1;
+          std::fseek(f, 0, SEEK_END);
+          file.resize(std::ftell(f));
+          std::fseek(f, 0, SEEK_SET);
+          stat += (file.size() != std::fread(file.data(), 1, file.size(), f));
+          std::fclose(f);
+      } // scope
+
+      using namespace binary_format;
+      header_t h;
+      std::memcpy(&h, file.data(), sizeof(h));
+      stat += (0 != h.section[BLOCKS].bytes); // the dense file has an empty "Vblocks" section
+      size_t const shift = aligned(sizeof(header_t)) - aligned(header_v1_bytes);
+      h.version = 1;
+      for (int is = 0; is < BLOCKS; ++is) h.section[is].offset -= shift;
+      h.file_bytes -= shift;
+      std::vector<char> file_v1(h.file_bytes, 0);
+      std::memcpy(file_v1.data(), &h, header_v1_bytes); // the header ends before section[BLOCKS]
+      std::memcpy(file_v1.data() + aligned(header_v1_bytes), file.data() + aligned(sizeof(header_t)), h.file_bytes - aligned(header_v1_bytes));
+      { // scope: write the version-1 file
+          auto *const f = std::fopen(filename, "wb");
+          if (nullptr == f) return -1;
+          stat += (file_v1.size() != std::fwrite(file_v1.data(), 1, file_v1.size(), f));
+          std::fclose(f);
+      } // scope
+
+      mapped_Hamiltonian_t mapped;
+      stat += mapped.map(filename, echo);
+      if (0 == stat) {
+          uint32_t ng_l[3]; int8_t bc_l[3]; double hg_l[3]; int natoms_l{0};
+          std::vector<double> Veff_l, xyzZinso_l;
+          std::vector<std::vector<double>> atom_mat_l;
+          stat += mapped.copy_to(ng_l, bc_l, hg_l, Veff_l, natoms_l, xyzZinso_l, atom_mat_l);
+          int ndiff = (Veff != Veff_l) + (atom_mat != atom_mat_l) + (natoms != natoms_l) + mapped.has_sparse_potential();
+          ndiff += (xyzZinso_l.size() != size_t(natoms*8)) || std::memcmp(xyzZinso, xyzZinso_l.data(), natoms*8*sizeof(double));
+          for (int d = 0; d < 3; ++d) ndiff += (ng[d] != ng_l[d]) + (bc[d] != bc_l[d]) + (hg[d] != hg_l[d]);
+          if (echo > 3) std::printf("# %s: %d differences after reading a version-1 file of %.3f kByte\n",
+                                    __func__, ndiff, file_v1.size()*1e-3);
+          stat += ndiff;
+      } // mapped
+      std::remove(filename);
+      if (echo > 0) std::printf("# %s status= %i\n", __func__, int(stat));
+      return stat;
+  } // test_version1
+
+  status_t test_conversion(int const echo=0) {
+      // convert +hamiltonian.file to +green_input.convert and compare the load times
+      auto const outfile = control::get("green_input.convert", "");
+      if ('\0' == *outfile) return 0; // nothing to do
+      auto const infile = control::get("hamiltonian.file", "Hmt.xml");
+      auto stat = convert_Hamiltonian(infile, outfile, echo);
+      if (stat) return stat;
+
+      uint32_t ng[3]; int8_t bc[3]; double hg[3]; int natoms{0};
+      std::vector<double> Veff, xyzZinso;
+      std::vector<std::vector<double>> atom_mat;
+      double time[2];
+      for (int i01 = 0; i01 < 2; ++i01) {
+          SimpleTimer timer(__FILE__, __LINE__, __func__, 0);
+          stat += load_Hamiltonian(ng, bc, hg, Veff, natoms, xyzZinso, atom_mat, i01 ? outfile : infile, echo/2);
+          time[i01] = timer.stop();
+      } // i01
+      double time_map{0};
+      {
+          SimpleTimer timer(__FILE__, __LINE__, __func__, 0);
+          mapped_Hamiltonian_t mapped;
+          stat += mapped.map(outfile, echo/2);
+          time_map = timer.stop();
+      }
+      if (echo > 0) std::printf("# %s: load \"%s\" %.6f sec, load \"%s\" %.6f sec, map %.6f sec\n",
+                                    __func__, infile, time[0], outfile, time[1], time_map);
+      return stat;
+  } // test_conversion
+
   status_t all_tests(int echo) {
       status_t stat(0);
+      stat += test_binary_format(echo);
+      stat += test_sparse_potential(echo);
+      stat += test_version1(echo);
+      stat += test_conversion(echo);
       stat += test_loading(echo);
       return stat;
   } // all_tests
@@ -26,6 +26,7 @@
   #include "unit_system.hxx" // ::all_tests
   #include "inline_math.hxx" // ::all_tests
   #include "sho_tools.hxx" // ::all_tests
+  #include "profiler.hxx" // ::all_tests
   #include "control.hxx" // ::all_tests
 
   // "green_*.hxx" headers requiring CUDA are included in green_tests.cu/green_tests.cxx
@@ -38,6 +39,7 @@
 #include "mpi_parallel.hxx" // ::init, ::finalize, ::rank, ::size, MPI_Comm
 #include "recorded_warnings.hxx" // warn, ::show_warnings, ::clear_warnings
 #include "simple_timer.hxx" // SimpleTimer
+#include "profiler.hxx" // ::show, ::write_report
 #include "unit_system.hxx" // ::set_output_units
 #include "control.hxx" // ::command_line_interface, ::get
 
@@ -72,6 +74,7 @@
           add_module_test(recorded_warnings);
           add_module_test(simple_stats);
           add_module_test(simple_timer);
+          add_module_test(profiler);
           add_module_test(inline_math);
           add_module_test(sho_tools);
           add_module_test(unit_system);
@@ -263,6 +266,9 @@
           }
       } // show all variable names defined in the control environment
 
+      stat += profiler::show(control::get("profiler.show", 0.)*echo);
+      stat += profiler::write_report(control::get("profiler.file", ""), echo);
+
       if (echo > 0) recorded_warnings::show_warnings(3);
       recorded_warnings::clear_warnings(1);
 
@@ -9,8 +9,11 @@
   #include "simple_timer.hxx" // SimpleTimer
   // the following header files contain CUDA code
   #include "green_sparse.hxx"       // ::all_tests
+  #include "green_workspace.hxx"    // ::all_tests
   #include "green_kinetic.hxx"      // ::all_tests
   #include "green_potential.hxx"    // ::all_tests
+  #include "green_precision.hxx"    // ::all_tests
+  #include "green_fused.hxx"        // ::all_tests
   #include "green_dyadic.hxx"       // ::all_tests
   #include "green_action.hxx"       // ::all_tests
   #include "green_function.hxx"     // ::all_tests
@@ -43,8 +46,11 @@ namespace green_tests {
 #include "add_module_test.h" // macro definition of add_module_test(MODULE_NAME), needs SimpleTimer, std::printf
 
           add_module_test(green_sparse);
+          add_module_test(green_workspace);
           add_module_test(green_kinetic);
           add_module_test(green_potential);
+          add_module_test(green_precision);
+          add_module_test(green_fused);
           add_module_test(green_dyadic);
           add_module_test(green_action);
           add_module_test(green_function);
@@ -0,0 +1,620 @@
+// This file is part of AngstromCube under MIT License
+
+#include <cstdio> // std::printf, ::snprintf, ::fopen, ::fprintf, ::fscanf, ::fclose
+#include <cstdint> // int8_t, int16_t, int32_t, uint32_t
+#include <cmath> // std::sqrt
+#include <complex> // std::complex<real_t>, ::real
+#include <vector> // std::vector<T>
+#include <string> // std::string
+#include <map> // std::map<K,V>
+#include <algorithm> // std::min, ::max
+#include <unistd.h> // sysconf, _SC_LEVEL3_CACHE_SIZE
+
+#include "kernel_benchmark.hxx"
+
+#include "status.hxx" // status_t, STATUS_TEST_NOT_INCLUDED
+
+#ifndef   NO_UNIT_TESTS
+  #include "control.hxx" // ::get
+  #include "recorded_warnings.hxx" // warn
+  #include "simple_timer.hxx" // SimpleTimer
+  #include "simple_math.hxx" // ::random
+  #include "inline_math.hxx" // set, pow2, pow3
+  #include "data_view.hxx" // view2D<T>
+  #include "real_space.hxx" // ::grid_t
+  #include "boundary_condition.hxx" // Periodic_Boundary
+  #include "finite_difference.hxx" // ::stencil_t, ::apply
+  #include "sho_projection.hxx" // ::sho_project, ::sho_add
+  #include "sho_tools.hxx" // ::nSHO, ::n1HO
+  #include "grid_operators.hxx" // ::grid_operator_t, ::empty_list_of_atoms
+  #include "davidson_solver.hxx" // ::eigensolve
+  #include "green_memory.hxx" // get_memory, free_memory, real_t_name
+  #include "omp_parallel.hxx" // omp_get_max_threads
+  #include "green_sparse.hxx" // ::sparse_t<>
+  #include "green_kinetic.hxx" // ::Laplace_driver, ::nhalo, ::CUBE_EXISTS, ::CUBE_IS_ZERO
+  #include "green_potential.hxx" // ::multiply
+  #include "green_dyadic.hxx" // ::SHOprj_driver, ::SHOadd_driver, ::dyadic_plan_t
+  #include "green_precision.hxx" // ::float16_t, ::bfloat16_t, ::store, ::storage_name
+#endif // NO_UNIT_TESTS
+
+namespace kernel_benchmark {
+
+#ifdef    NO_UNIT_TESTS
+  status_t all_tests(int const echo) { return STATUS_TEST_NOT_INCLUDED; }
+#else  // NO_UNIT_TESTS
+
+  struct result_t {
+      std::string kernel, config; // neither may contain white spaces
+      double seconds, bytes, flops; // per call
+  }; // result_t
+
+  struct roofline_t {
+      double gbytes, gflops; // peak memory bandwidth in GByte/s and peak performance in GFlop/s
+  }; // roofline_t
+
+  size_t last_level_cache_bytes() {
+      long llc{0};
+#ifdef    _SC_LEVEL3_CACHE_SIZE
+      llc = sysconf(_SC_LEVEL3_CACHE_SIZE);
+      if (llc <= 0) llc = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif // _SC_LEVEL3_CACHE_SIZE
+      return (llc > 0) ? llc : (32ul << 20); // assume 32 MiB if unknown
+  } // last_level_cache_bytes
+
+  double measure_bandwidth(size_t const n, int const echo=0) {
+      // STREAM-like triad, 3 arrays of n doubles each, run with as many threads as the kernels use
+      auto a = get_memory<double>(n, 0, "triad"), b = get_memory<double>(n, 0, "triad"), c = get_memory<double>(n, 0, "triad");
+#ifndef   HAS_NO_OMP
+      #pragma omp parallel for schedule(static)
+#endif // HAS_NO_OMP
+      for (long i = 0; i < long(n); ++i) { a[i] = 0.0; b[i] = 1.0; c[i] = 2.0; } // first touch by the same threads as the triad
+      double best{9e9};
+      for (int irepeat = 0; irepeat < 3; ++irepeat) {
+          SimpleTimer timer(__FILE__, __LINE__, __func__, 0);
+#ifndef   HAS_NO_OMP
+          #pragma omp parallel for schedule(static)
+#endif // HAS_NO_OMP
+          for (long i = 0; i < long(n); ++i) {
+              a[i] = b[i] + 0.5*c[i];
+          } // i
+          best = std::min(best, timer.stop());
+      } // irepeat
+      if (2.0 != a[n/2]) warn("triad produced %g, expected 2", a[n/2]);
+      free_memory(c); free_memory(b); free_memory(a);
+      auto const gbytes = 3*n*sizeof(double)/best*1e-9;
+      if (echo > 3) std::printf("# %s: triad over %.1f MByte with %d threads: %.3f GByte/s\n",
+                                  __func__, 3*n*sizeof(double)*1e-6, omp_get_max_threads(), gbytes);
+      return gbytes;
+  } // measure_bandwidth
+
+  double measure_flops(size_t const n, int const echo=0) {
+      // 32 independent multiply-add chains per thread that the compiler can vectorize, enough to hide the latency
+      int constexpr m = 32;
+      int const nthreads = omp_get_max_threads(); // same number of threads as the kernels
+      double const a = 0.999999, b = 1e-9;
+      double best{9e9}, sum{0};
+      for (int irepeat = 0; irepeat < 3; ++irepeat) {
+          SimpleTimer timer(__FILE__, __LINE__, __func__, 0);
+          sum = 0;
+#ifndef   HAS_NO_OMP
+          #pragma omp parallel for schedule(static) reduction(+:sum)
+#endif // HAS_NO_OMP
+          for (int ithread = 0; ithread < nthreads; ++ithread) {
+              double s[m];
+              for (int k = 0; k < m; ++k) s[k] = k*1e-3;
+              for (size_t i = 0; i < n; ++i) {
+                  for (int k = 0; k < m; ++k) {
+                      s[k] = s[k]*a + b;
+                  } // k
+              } // i
+              for (int k = 0; k < m; ++k) sum += s[k]; // use the result
+          } // ithread
+          best = std::min(best, timer.stop());
+      } // irepeat
+      auto const gflops = 2.*m*n*nthreads/best*1e-9;
+      if (echo > 3) std::printf("# %s: %.3f GFlop/s with %d threads (checksum %g)\n", __func__, gflops, nthreads, sum);
+      return gflops;
+  } // measure_flops
+
+  double attainable(result_t const & r, roofline_t const & peak) {
+      // roofline model, 0 if the kernel has no operation count
+      if (r.seconds <= 0 || r.flops <= 0 || r.bytes <= 0) return 0;
+      return std::min(peak.gflops, r.flops/r.bytes*peak.gbytes);
+  } // attainable
+
+  void report(
+        std::vector<result_t> & results
+      , char const *kernel
+      , char const *config
+      , double const seconds
+      , double const bytes
+      , double const flops
+      , roofline_t const & peak
+      , int const echo=0
+  ) {
+      result_t const r = {kernel, config, seconds, bytes, flops};
+      results.push_back(r);
+      if (echo < 1) return;
+      std::printf("# %-16s %-40s %12.6f", kernel, config, seconds);
+      auto const roof = attainable(r, peak);
+      if (roof > 0) {
+          double const gflops = flops/seconds*1e-9, gbytes = bytes/seconds*1e-9;
+          double const intensity = flops/bytes; // arithmetic intensity in Flop/Byte
+          std::printf(" %9.3f %9.3f %7.3f %9.3f", gflops, gbytes, intensity, roof);
+          if (gflops > roof) {
+              std::printf("%9s\n", ">roof!"); // the measured peaks do not bound this kernel, e.g. its working set fits into cache
+          } else {
+              std::printf(" %6.1f %%\n", gflops/roof*100);
+          }
+      } else {
+          std::printf("%10s%10s%8s%10s%9s\n", "", "", "", "", "n/a");
+      }
+  } // report
+
+  template <typename complex_t, typename real_t>
+  void bench_finite_difference(std::vector<result_t> & results, int const n, int const nn,
+                              int const repeat, roofline_t const & peak, int const echo=0) {
+      int const R1C2 = sizeof(complex_t)/sizeof(real_t);
+      real_space::grid_t g(n, n, n);
+      g.set_grid_spacing(0.25);
+      g.set_boundary_conditions(Periodic_Boundary);
+      std::vector<complex_t> in(g.all()), out(g.all());
+      for (size_t i = 0; i < g.all(); ++i) in[i] = simple_math::random(-1., 1.);
+      finite_difference::stencil_t<real_t> const fd(g.h, nn, -0.5);
+      double best{9e9};
+      for (int irepeat = 0; irepeat < repeat; ++irepeat) {
+          SimpleTimer timer(__FILE__, __LINE__, __func__, 0);
+          finite_difference::apply(out.data(), in.data(), g, fd);
+          best = std::min(best, timer.stop());
+      } // irepeat
+      double const flops = g.all()*2.*(6*nn + 1)*R1C2; // one multiply-add per stencil coefficient
+      double const bytes = g.all()*2.*sizeof(complex_t); // read in, write out
+      char config[64]; std::snprintf(config, 64, "%s,R1C2=%d,nn=%d,grid=%d^3", real_t_name<real_t>(), R1C2, nn, n);
+      report(results, "finite_difference", config, best, bytes, flops, peak, echo);
+  } // bench_finite_difference
+
+  template <typename real_t>
+  void bench_sho_projection(std::vector<result_t> & results, int const n, int const numax,
+                            int const repeat, roofline_t const & peak, int const echo=0) {
+      real_space::grid_t g(n, n, n);
+      g.set_grid_spacing(0.25);
+      double const center[] = {0.125*n, 0.125*n, 0.125*n}, sigma = 1.0; // truncation radius 9*sigma covers grids up to 72^3
+      int const nSHO = sho_tools::nSHO(numax), M = sho_tools::n1HO(numax);
+      std::vector<real_t> values(g.all()), coeff(nSHO);
+      for (size_t i = 0; i < g.all(); ++i) values[i] = simple_math::random(-1., 1.);
+      double best[2] = {9e9, 9e9};
+      for (int irepeat = 0; irepeat < repeat; ++irepeat) {
+          SimpleTimer timer(__FILE__, __LINE__, __func__, 0);
+          sho_projection::sho_project(coeff.data(), numax, center, sigma, values.data(), g, 0);
+          best[0] = std::min(best[0], timer.stop());
+      } // irepeat
+      for (int iSHO = 0; iSHO < nSHO; ++iSHO) coeff[iSHO] = simple_math::random(-1e-3, 1e-3);
+      for (int irepeat = 0; irepeat < repeat; ++irepeat) {
+          SimpleTimer timer(__FILE__, __LINE__, __func__, 0);
+          sho_projection::sho_add(values.data(), g, coeff.data(), numax, center, sigma, 0);
+          best[1] = std::min(best[1], timer.stop());
+      } // irepeat
+      // sum-factorized: contract x, then y, then z
+      double const flops = 2.*(pow3(1.*n)*M + pow2(1.*n)*((M*(M + 1))/2) + n*nSHO);
+      double const bytes = g.all()*1.*sizeof(real_t);
+      char config[64]; std::snprintf(config, 64, "%s,numax=%d,grid=%d^3", real_t_name<real_t>(), numax, n);
+      report(results, "sho_project", config, best[0], bytes, flops, peak, echo); // read values
+      report(results, "sho_add", config, best[1], 2*bytes, flops, peak, echo); // read and write values
+  } // bench_sho_projection
+
+  template <typename real_t, typename storage_t>
+  std::string precision_name() { // e.g. "float", or "float:half" for float arithmetic on blocks stored in half precision
+      std::string const storage = green_precision::storage_name<storage_t>();
+      return (storage == real_t_name<real_t>()) ? storage : (std::string(real_t_name<real_t>()) + ":" + storage);
+  } // precision_name
+
+  template <typename storage_t>
+  storage_t stored(double const value) { storage_t s; green_precision::store(s, value); return s; }
+
+  template <typename real_t, int R1C2, int Noco, typename storage_t=real_t>
+  void bench_Laplace(std::vector<result_t> & results, uint32_t const nnzb, int const FD_range,
+                     int const repeat, roofline_t const & peak, int const echo=0) {
+      // a 1D chain of nnzb blocks as in green_kinetic::test_finite_difference, derivatives in all 3 directions
+      using green_kinetic::nhalo;
+      size_t const block = R1C2*pow2(Noco*64ul);
+      auto Tpsi = get_memory<storage_t[R1C2][Noco*64][Noco*64]>(nnzb, echo, "Tpsi");
+      auto  psi = get_memory<storage_t[R1C2][Noco*64][Noco*64]>(nnzb, echo,  "psi");
+      set(Tpsi[0][0][0], nnzb*block, stored<storage_t>(0));
+      set( psi[0][0][0], nnzb*block, stored<storage_t>(1));
+      auto indx = get_memory<int32_t>(nhalo + nnzb + nhalo, echo, "indx");
+      set(indx, nhalo + nnzb + nhalo, green_kinetic::CUBE_IS_ZERO);
+      for (uint32_t i = 0; i < nnzb; ++i) {
+          indx[nhalo + i] = i + green_kinetic::CUBE_EXISTS;
+      } // i
+      auto index_list = get_memory<int32_t const*>(1, echo, "index_list");
+      index_list[0] = indx;
+      double best{9e9}, flops{0};
+      for (int irepeat = 0; irepeat < repeat; ++irepeat) {
+          SimpleTimer timer(__FILE__, __LINE__, __func__, 0);
+          flops = 0;
+          for (int dd = 0; dd < 3; ++dd) {
+              int const nFD = green_kinetic::Laplace_driver<real_t,R1C2,Noco,storage_t>(Tpsi, psi, index_list, -0.5, 1, 1 << (2*dd), nullptr, FD_range);
+              flops += nnzb*nFD*2.*block;
+          } // dd
+          cudaDeviceSynchronize();
+          best = std::min(best, timer.stop());
+      } // irepeat
+      double const bytes = 3*3.*nnzb*block*sizeof(storage_t); // per direction: read psi, read and write Tpsi
+      char config[64]; std::snprintf(config, 64, "%s,R1C2=%d,Noco=%d,FD=%d,nnzb=%d", precision_name<real_t,storage_t>().c_str(), R1C2, Noco, FD_range, nnzb);
+      report(results, (8 == FD_range) ? "Laplace16th" : "Laplace8th", config, best, bytes, flops, peak, echo);
+      free_memory(index_list);
+      free_memory(indx);
+      free_memory(psi);
+      free_memory(Tpsi);
+  } // bench_Laplace
+
+  template <typename real_t, int R1C2, int Noco, typename storage_t=real_t>
+  void bench_Potential(std::vector<result_t> & results, uint32_t const nnzb,
+                       int const repeat, roofline_t const & peak, int const echo=0) {
+      size_t const block = R1C2*pow2(Noco*64ul);
+      auto  psi = get_memory<storage_t[R1C2][Noco*64][Noco*64]>(nnzb, echo,  "psi");
+      auto Vpsi = get_memory<storage_t[R1C2][Noco*64][Noco*64]>(nnzb, echo, "Vpsi");
+      set(psi[0][0][0], nnzb*block, stored<storage_t>(1));
+      auto Vloc = get_memory<double(*)[64]>(Noco*Noco, echo, "Vloc");
+      for (int mag = 0; mag < Noco*Noco; ++mag) {
+          Vloc[mag] = get_memory<double[64]>(nnzb, echo, "Vloc[mag]");
+          set(Vloc[mag][0], nnzb*64, 0.5);
+      } // mag
+      auto vloc_index = get_memory<int32_t>(nnzb, echo, "vloc_index");
+      for (uint32_t inzb = 0; inzb < nnzb; ++inzb) vloc_index[inzb] = inzb;
+      auto shift = get_memory<int16_t[3+1]>(nnzb, echo, "shift");  set(shift[0], nnzb*4, int16_t(0));
+      auto hxyz = get_memory<double>(3+1, echo, "hxyz");             set(hxyz, 3+1, 0.25);
+      double best{9e9}, flops{0};
+      for (int irepeat = 0; irepeat < repeat; ++irepeat) {
+          SimpleTimer timer(__FILE__, __LINE__, __func__, 0);
+          flops = green_potential::multiply<real_t,R1C2,Noco,storage_t>(Vpsi, psi, Vloc, vloc_index, shift, hxyz, nnzb);
+          cudaDeviceSynchronize();
+          best = std::min(best, timer.stop());
+      } // irepeat
+      double const bytes = nnzb*(2.*block*sizeof(storage_t) + Noco*Noco*64.*sizeof(double)); // read psi and Vloc, write Vpsi
+      char config[64]; std::snprintf(config, 64, "%s,R1C2=%d,Noco=%d,nnzb=%d", precision_name<real_t,storage_t>().c_str(), R1C2, Noco, nnzb);
+      report(results, "Potential", config, best, bytes, flops, peak, echo);
+      free_memory(hxyz);
+      free_memory(shift);
+      free_memory(vloc_index);
+      for (int mag = 0; mag < Noco*Noco; ++mag) free_memory(Vloc[mag]);
+      free_memory(Vloc);
+      free_memory(Vpsi);
+      free_memory(psi);
+  } // bench_Potential
+
+  template <typename real_t, int R1C2, int Noco, typename storage_t=real_t>
+  void bench_SHOprj_SHOadd(std::vector<result_t> & results, int const nb, int const lmax,
+                           int const repeat, roofline_t const & peak, int const echo=0) {
+      // one atom in the center of a cube of nb^3 blocks as in green_dyadic::test_SHOprj_and_SHOadd
+      int const natoms = 1, nrhs = 1, nnzb = pow3(nb);
+      int const nsho = sho_tools::nSHO(lmax);
+      size_t const block = R1C2*pow2(Noco*64ul);
+      auto psi = get_memory<storage_t[R1C2][Noco*64][Noco*64]>(nnzb, echo, "psi");
+      set(psi[0][0][0], nnzb*block, stored<storage_t>(0));
+      auto apc = get_memory<real_t[R1C2][Noco   ][Noco*64]>(natoms*nsho*nrhs, echo, "apc");
+      set(apc[0][0][0], natoms*nsho*nrhs*R1C2*pow2(Noco)*64, real_t(1e-3));
+
+      auto sparse_SHOprj = get_memory<green_sparse::sparse_t<>>(nrhs, echo, "sparse_SHOprj");
+      {
+          std::vector<uint32_t> iota(nnzb); for (int inzb = 0; inzb < nnzb; ++inzb) iota[inzb] = inzb;
+          std::vector<std::vector<uint32_t>> SHO_prj(natoms, iota);
+          sparse_SHOprj[0] = green_sparse::sparse_t<>(SHO_prj, false, __func__, echo - 9);
+      }
+      green_sparse::sparse_t<> sparse_SHOadd;
+      {
+          std::vector<std::vector<uint32_t>> SHO_add(nnzb, std::vector<uint32_t>(1, 0));
+          sparse_SHOadd = green_sparse::sparse_t<>(SHO_add, false, __func__, echo - 9);
+      }
+      auto ColIndexCubes = get_memory<uint16_t>(nnzb, echo, "ColIndexCubes");     set(ColIndexCubes, nnzb, uint16_t(0));
+      auto RowIndexCubes = get_memory<uint32_t>(nnzb, echo, "RowIndexCubes");     for (int inzb = 0; inzb < nnzb; ++inzb) RowIndexCubes[inzb] = inzb;
+      auto hGrid         = get_memory<double>(3+1, echo, "hGrid");                set(hGrid, 3, 0.25); hGrid[3] = 7.;
+      auto AtomPos       = get_memory<double[3+1]>(natoms, echo, "AtomPos");      set(AtomPos[0], 3, hGrid, 0.5*4*nb);  AtomPos[0][3] = 1.;
+      auto AtomLmax      = get_memory<int8_t>(natoms, echo, "AtomLmax");          set(AtomLmax, natoms, int8_t(lmax));
+      auto AtomStarts    = get_memory<uint32_t>(natoms + 1, echo, "AtomStarts");  for (int ia = 0; ia <= natoms; ++ia) AtomStarts[ia] = ia*nsho;
+      auto CubePos       = get_memory<float[3+1]>(nnzb, echo, "CubePos");
+      for (int iz = 0; iz < nb; ++iz) {
+      for (int iy = 0; iy < nb; ++iy) {
+      for (int ix = 0; ix < nb; ++ix) {
+          int const xyz0[] = {ix, iy, iz, 0};
+          set(CubePos[(iz*nb + iy)*nb + ix], 4, xyz0);
+      }}} // ix iy iz
+
+      double best[2] = {9e9, 9e9};
+      for (int irepeat = 0; irepeat < repeat; ++irepeat) {
+          SimpleTimer timer(__FILE__, __LINE__, __func__, 0);
+          green_dyadic::SHOadd_driver<real_t,R1C2,Noco,storage_t>(psi, apc, AtomPos, AtomLmax, AtomStarts, sparse_SHOadd.rowStart(), sparse_SHOadd.colIndex(),
+                                                         RowIndexCubes, ColIndexCubes, CubePos, hGrid, nnzb, nrhs);
+          cudaDeviceSynchronize();
+          best[1] = std::min(best[1], timer.stop());
+      } // irepeat
+      for (int irepeat = 0; irepeat < repeat; ++irepeat) {
+          SimpleTimer timer(__FILE__, __LINE__, __func__, 0);
+          green_dyadic::SHOprj_driver<real_t,R1C2,Noco,storage_t>(apc, psi, AtomPos, AtomLmax, AtomStarts, natoms, sparse_SHOprj,
+                                                         RowIndexCubes, CubePos, hGrid, nrhs);
+          cudaDeviceSynchronize();
+          best[0] = std::min(best[0], timer.stop());
+      } // irepeat
+      double const flops = nnzb*64.*green_dyadic::dyadic_plan_t::flop_count_SHOprj_SHOadd(lmax)*R1C2*Noco*Noco;
+      double const bytes = nnzb*1.*block*sizeof(storage_t);
+      char config[64]; std::snprintf(config, 64, "%s,R1C2=%d,Noco=%d,lmax=%d,nnzb=%d", precision_name<real_t,storage_t>().c_str(), R1C2, Noco, lmax, nnzb);
+      report(results, "SHOprj", config, best[0], bytes, flops, peak, echo); // read psi
+      report(results, "SHOadd", config, best[1], 2*bytes, flops, peak, echo); // read and write psi
+
+#ifndef   HAS_NO_CUDA
+      sparse_SHOprj[0].~sparse_t<>(); // cudaFree does not call destructors, delete[] in free_memory does
+#endif // HAS_NO_CUDA
+      free_memory(sparse_SHOprj);
+      free_memory(CubePos);
+      free_memory(AtomStarts);
+      free_memory(AtomLmax);
+      free_memory(AtomPos);
+      free_memory(hGrid);
+      free_memory(RowIndexCubes);
+      free_memory(ColIndexCubes);
+      free_memory(apc);
+      free_memory(psi);
+  } // bench_SHOprj_SHOadd
+
+  template <typename complex_t>
+  void bench_davidson(std::vector<result_t> & results, int const n, int const nbands,
+                      int const repeat, roofline_t const & peak, int const echo=0) {
+      // particle in a box as in particle_in_box::test_eigensolve, but with random start waves
+      using real_t = decltype(std::real(complex_t(1)));
+      real_space::grid_t g(n, n, n);
+      g.set_grid_spacing(0.25);
+      view2D<complex_t> psi(nbands, g.all(), complex_t(0));
+      for (int iband = 0; iband < nbands; ++iband) {
+          for (size_t izyx = 0; izyx < g.all(); ++izyx) {
+              psi(iband,izyx) = simple_math::random(-1., 1.);
+          } // izyx
+      } // iband
+      std::vector<double> energies(nbands, 0.0);
+      auto const loa = grid_operators::empty_list_of_atoms();
+      grid_operators::grid_operator_t<complex_t,real_t> const op(g, loa);
+      auto const kp = op.set_kpoint(0); // Gamma
+      double best{9e9};
+      for (int irepeat = 0; irepeat < repeat; ++irepeat) {
+          SimpleTimer timer(__FILE__, __LINE__, __func__, 0);
+          davidson_solver::eigensolve(psi.data(), energies.data(), nbands, op, kp);
+          best = std::min(best, timer.stop());
+      } // irepeat
+      int const R1C2 = sizeof(complex_t)/sizeof(real_t);
+      char config[64]; std::snprintf(config, 64, "%s,R1C2=%d,nbands=%d,grid=%d^3", real_t_name<real_t>(), R1C2, nbands, n);
+      report(results, "davidson_solver", config, best, 0, 0, peak, echo); // no operation count
+  } // bench_davidson
+
+  void bench_placement(std::vector<result_t> & results, size_t const n, char const *const options,
+                       int const repeat, roofline_t const & peak, int const echo=0) {
+      // STREAM-like triad on arrays placed according to a memory policy, see green_memory.hxx
+      memory_policy_t policy;
+      if (parse_memory_policy(policy, options) > 0) warn("unknown option in memory policy \"%s\"", options);
+      set_memory_policy("placement", policy);
+      auto a = get_memory<double>(n, 0, "placement"), b = get_memory<double>(n, 0, "placement"),
+           c = get_memory<double>(n, 0, "placement");
+      if (policy.first_touch) {
+#ifndef   HAS_NO_OMP
+          #pragma omp parallel for schedule(static)
+#endif // HAS_NO_OMP
+          for (long i = 0; i < long(n); ++i) { b[i] = 1.0; c[i] = 2.0; } // same threads as the triad
+      } else {
+          for (size_t i = 0; i < n; ++i) { a[i] = 0.0; b[i] = 1.0; c[i] = 2.0; } // master thread touches all pages
+      } // first_touch
+      double best{9e9};
+      for (int irepeat = 0; irepeat < repeat; ++irepeat) {
+          SimpleTimer timer(__FILE__, __LINE__, __func__, 0);
+#ifndef   HAS_NO_OMP
+          #pragma omp parallel for schedule(static)
+#endif // HAS_NO_OMP
+          for (long i = 0; i < long(n); ++i) {
+              a[i] = b[i] + 0.5*c[i];
+          } // i
+          best = std::min(best, timer.stop());
+      } // irepeat
+      if (2.0 != a[n/2]) warn("triad produced %g, expected 2", a[n/2]);
+      bool const aligned = (0 == (size_t(a) % std::max(policy.alignment, sizeof(double))));
+      if (!aligned) warn("memory policy \"%s\" did not align to %ld Byte", options, policy.alignment);
+      report(results, "placement", (*options) ? options : "default", best, 3*n*sizeof(double), 2*n, peak, echo);
+      free_memory(c); free_memory(b); free_memory(a);
+      memory_policies().erase("placement");
+  } // bench_placement
+
+  template <typename real_t>
+  void bench_green_kernels(std::vector<result_t> & results, int const select, std::vector<int> const & nnzbs,
+          std::vector<int> const & nbs, std::vector<int> const & lmaxs, int const repeat, roofline_t const & peak, int const echo=0) {
+      if (select & 0x4) {
+          for (auto const nnzb : nnzbs) {
+              for (int FD_range = 4; FD_range <= 8; FD_range += 4) {
+                  bench_Laplace<real_t,1,1>(results, nnzb, FD_range, repeat, peak, echo);
+                  bench_Laplace<real_t,2,1>(results, nnzb, FD_range, repeat, peak, echo);
+                  bench_Laplace<real_t,2,2>(results, nnzb, FD_range, repeat, peak, echo);
+              } // FD_range
+          } // nnzb
+      } // Laplace
+      if (select & 0x8) {
+          for (auto const nnzb : nnzbs) {
+              bench_Potential<real_t,1,1>(results, nnzb, repeat, peak, echo);
+              bench_Potential<real_t,2,1>(results, nnzb, repeat, peak, echo);
+              bench_Potential<real_t,2,2>(results, nnzb, repeat, peak, echo);
+          } // nnzb
+      } // Potential
+      if (select & 0x10) {
+          for (auto const nb : nbs) {
+              for (auto const lmax : lmaxs) {
+                  bench_SHOprj_SHOadd<real_t,1,1>(results, nb, lmax, repeat, peak, echo);
+                  bench_SHOprj_SHOadd<real_t,2,1>(results, nb, lmax, repeat, peak, echo);
+                  bench_SHOprj_SHOadd<real_t,2,2>(results, nb, lmax, repeat, peak, echo);
+              } // lmax
+          } // nb
+      } // SHOprj and SHOadd
+  } // bench_green_kernels
+
+  template <typename real_t, typename storage_t>
+  void bench_storage(std::vector<result_t> & results, int const select, std::vector<int> const & nnzbs,
+          std::vector<int> const & nbs, std::vector<int> const & lmaxs, int const repeat, roofline_t const & peak, int const echo=0) {
+      // Green function blocks stored in reduced precision, compare to the same kernels on float and double blocks
+      if (select & 0x4) {
+          for (auto const nnzb : nnzbs) {
+              bench_Laplace<real_t,2,1,storage_t>(results, nnzb, 4, repeat, peak, echo);
+          } // nnzb
+      } // Laplace
+      if (select & 0x8) {
+          for (auto const nnzb : nnzbs) {
+              bench_Potential<real_t,2,1,storage_t>(results, nnzb, repeat, peak, echo);
+          } // nnzb
+      } // Potential
+      if (select & 0x10) {
+          for (auto const nb : nbs) {
+              for (auto const lmax : lmaxs) {
+                  bench_SHOprj_SHOadd<real_t,2,1,storage_t>(results, nb, lmax, repeat, peak, echo);
+              } // lmax
+          } // nb
+      } // SHOprj and SHOadd
+  } // bench_storage
+
+  status_t store_baseline(char const *filename, std::vector<result_t> const & results, int const echo=0) {
+      if (nullptr == filename || '\0' == *filename) return 0;
+      auto *const f = std::fopen(filename, "w");
+      if (nullptr == f) {
+          warn("failed to open \"%s\" for writing the kernel benchmark baseline", filename);
+          return -1;
+      } // failed
+      std::fprintf(f, "# kernel_benchmark: kernel configuration seconds_per_call\n");
+      for (auto const & r : results) {
+          std::fprintf(f, "%s %s %.9e\n", r.kernel.c_str(), r.config.c_str(), r.seconds);
+      } // r
+      std::fclose(f);
+      if (echo > 3) std::printf("# kernel_benchmark: %ld timings written to \"%s\"\n", results.size(), filename);
+      return 0;
+  } // store_baseline
+
+  status_t compare_baseline(char const *filename, std::vector<result_t> const & results, double const tolerance, int const echo=0) {
+      if (nullptr == filename || '\0' == *filename) return 0;
+      auto *const f = std::fopen(filename, "r");
+      if (nullptr == f) {
+          warn("failed to open kernel benchmark baseline \"%s\"", filename);
+          return -1;
+      } // failed
+      std::map<std::string,double> baseline;
+      char line[256], kernel[64], config[128];
+      double seconds;
+      while (nullptr != std::fgets(line, 256, f)) {
+          if ('#' == line[0]) continue; // comment line
+          if (3 == std::sscanf(line, "%63s %127s %lf", kernel, config, &seconds)) {
+              baseline[std::string(kernel) + " " + config] = seconds;
+          } // parsed
+      } // while
+      std::fclose(f);
+      if (echo > 1) std::printf("\n# kernel_benchmark: compare to %ld timings in \"%s\"\n", baseline.size(), filename);
+      int nregressions{0}, ncompared{0};
+      for (auto const & r : results) {
+          auto const it = baseline.find(r.kernel + " " + r.config);
+          if (baseline.end() == it || it->second <= 0) continue;
+          double const ratio = r.seconds/it->second;
+          ++ncompared;
+          if (echo > 3) std::printf("# %-16s %-40s %9.3f x baseline\n", r.kernel.c_str(), r.config.c_str(), ratio);
+          if (ratio > 1 + tolerance) {
+              warn("kernel %s %s takes %.2f times the baseline", r.kernel.c_str(), r.config.c_str(), ratio);
+              ++nregressions;
+          } // regression
+      } // r
+      if (echo > 1) std::printf("# kernel_benchmark: %d of %d compared timings are slower than the baseline by more than %g %%\n",
+                                    nregressions, ncompared, tolerance*100);
+      return nregressions;
+  } // compare_baseline
+
+  status_t test_kernels(int const echo=0) {
+      int const sweep  = control::get("kernel_benchmark.sweep", 0.); // 0: smoke test
+      int const select = control::get("kernel_benchmark.select", -1.);
+      int const repeat = std::max(1, int(control::get("kernel_benchmark.repeat", sweep ? 5. : 1.)));
+
+      roofline_t peak;
+      peak.gbytes = control::get("kernel_benchmark.peak.gbytes", 0.);
+      peak.gflops = control::get("kernel_benchmark.peak.gflops", 0.);
+      if (peak.gbytes <= 0) {
+          // the 3 triad arrays together should exceed the last-level cache by far, otherwise we measure the cache bandwidth
+          double const mbytes = control::get("kernel_benchmark.peak.mbytes", 4e-6*last_level_cache_bytes());
+          peak.gbytes = measure_bandwidth(std::max(size_t(1) << 16, size_t(mbytes*1e6/(3*sizeof(double)))), echo);
+      } // gbytes
+      if (peak.gflops <= 0) peak.gflops = measure_flops(sweep ? (1ul << 22) : (1ul << 16), echo);
+      if (echo > 1) std::printf("\n# kernel_benchmark: roofline with %.3f GByte/s and %.3f GFlop/s, ridge point at %.3f Flop/Byte\n",
+                                    peak.gbytes, peak.gflops, peak.gflops/peak.gbytes);
+
+      // the smoke test runs each kernel once on the smallest size
+      std::vector<int> const grids   = sweep ? std::vector<int>({16, 32, 48, 64}) : std::vector<int>(1, 16);
+      std::vector<int> const nns     = {1, 2, 4, 8};
+      std::vector<int> const numaxs  = sweep ? std::vector<int>({1, 3, 5, 7, 9}) : std::vector<int>(1, 3);
+      std::vector<int> const nnzbs   = sweep ? std::vector<int>({64, 256}) : std::vector<int>(1, 4);
+      std::vector<int> const nbs     = sweep ? std::vector<int>({4, 8}) : std::vector<int>(1, 2);
+      std::vector<int> const lmaxs   = sweep ? std::vector<int>({3, 5, 7}) : std::vector<int>(1, 3);
+      std::vector<int> const dgrids  = sweep ? std::vector<int>({16, 32}) : std::vector<int>(1, 8);
+      std::vector<int> const nbandss = sweep ? std::vector<int>({8, 32}) : std::vector<int>(1, 4);
+
+      std::vector<result_t> results;
+      if (echo > 1) std::printf("#  kernel           configuration                                 seconds   GFlop/s   GByte/s  Flop/B  roofline   %%peak\n");
+      if (select & 0x1) {
+          for (auto const n : grids) {
+              for (auto const nn : nns) {
+                  bench_finite_difference<float,float>(results, n, nn, repeat, peak, echo);
+                  bench_finite_difference<double,double>(results, n, nn, repeat, peak, echo);
+                  bench_finite_difference<std::complex<float>,float>(results, n, nn, repeat, peak, echo);
+                  bench_finite_difference<std::complex<double>,double>(results, n, nn, repeat, peak, echo);
+              } // nn
+          } // n
+      } // finite_difference
+      if (select & 0x2) {
+          for (auto const n : grids) {
+              for (auto const numax : numaxs) {
+                  bench_sho_projection<float>(results, n, numax, repeat, peak, echo);
+                  bench_sho_projection<double>(results, n, numax, repeat, peak, echo);
+              } // numax
+          } // n
+      } // sho_projection
+      bench_green_kernels<float >(results, select, nnzbs, nbs, lmaxs, repeat, peak, echo);
+      bench_green_kernels<double>(results, select, nnzbs, nbs, lmaxs, repeat, peak, echo);
+      if (select & 0x80) {
+          bench_storage<double,float>(results, select, nnzbs, nbs, lmaxs, repeat, peak, echo);
+          bench_storage<float,green_precision::float16_t>(results, select, nnzbs, nbs, lmaxs, repeat, peak, echo);
+          bench_storage<float,green_precision::bfloat16_t>(results, select, nnzbs, nbs, lmaxs, repeat, peak, echo);
+      } // reduced precision storage
+      if (select & 0x20) {
+          for (auto const n : dgrids) {
+              for (auto const nbands : nbandss) {
+                  bench_davidson<float>(results, n, nbands, repeat, peak, echo);
+                  bench_davidson<double>(results, n, nbands, repeat, peak, echo);
+                  bench_davidson<std::complex<float>>(results, n, nbands, repeat, peak, echo);
+                  bench_davidson<std::complex<double>>(results, n, nbands, repeat, peak, echo);
+              } // nbands
+          } // n
+      } // davidson_solver
+      if (select & 0x40) {
+          // NUMA placement: the default places all pages where the master thread touches them first
+          std::vector<char const*> const policies = {"", "align=64", "align=2M", "touch", "touch,local", "touch,interleave", "align=2M,touch,interleave"};
+          for (auto const options : policies) {
+              bench_placement(results, sweep ? (1ul << 25) : (1ul << 20), options, repeat, peak, echo);
+          } // options
+      } // placement
+
+      int nabove{0};
+      for (auto const & r : results) {
+          nabove += (r.flops/r.seconds*1e-9 > attainable(r, peak) && attainable(r, peak) > 0);
+      } // r
+      if (nabove > 0) warn("%d of %ld kernels exceed the measured roofline, their working sets may fit into cache", nabove, results.size());
+
+      status_t stat(0);
+      stat += store_baseline(control::get("kernel_benchmark.store", ""), results, echo);
+      stat += compare_baseline(control::get("kernel_benchmark.baseline", ""), results,
+                               control::get("kernel_benchmark.tolerance", 0.2), echo);
+      if (echo > 0) std::printf("# %s: %ld cases, status= %i\n", __func__, results.size(), int(stat));
+      return stat;
+  } // test_kernels
+
+  status_t all_tests(int const echo) {
+      status_t stat(0);
+      stat += test_kernels(echo);
+      return stat;
+  } // all_tests
+
+#endif // NO_UNIT_TESTS
+
+} // namespace kernel_benchmark
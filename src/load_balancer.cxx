@@ -11,9 +11,9 @@
 #include <cassert> // assert
 #include <vector> // std::vector<T>
 #include <cstdint> // size_t, uint32_t
-#include <algorithm> // std::max, ::min, ::swap
+#include <algorithm> // std::max, ::min, ::swap, ::max_element
 #include <utility> // std::pair
-#include <cmath> // std::ceil, ::pow, ::cbrt
+#include <cmath> // std::ceil, ::pow, ::cbrt, ::log2
 #include <numeric> // std::iota
 #ifndef NO_UNIT_TESTS
   #include <cstdlib> // rand, RAND_MAX
@@ -53,21 +53,70 @@ namespace load_balancer {
       , real_t const (*const xyzw)[4] // positions of work items in space [0/1/2] and their weight [3]
   ) {
       set(cow, 4, 0.0); // initialize
-      double w8sum{0};
-      for (size_t iuna = 0; iuna < nuna; ++iuna) { // parallel, reduction(+:w8sum,cow)
+      double w8sum{0}, w8pos_sum{0};
+      for (size_t iuna = 0; iuna < nuna; ++iuna) { // parallel, reduction(+:w8sum,w8pos_sum,cow)
           auto const iall = indirect[iuna];
           auto const *const xyz = xyzw[iall];
           double const w8 = xyz[W];
           w8sum += w8;
-          // contributes if the weight is positive
-          double const w8pos = double(w8 > 0);
+          // contributes with its weight if the weight is positive
+          double const w8pos = std::max(0.0, w8);
           add_product(cow, 3, xyz, w8pos);
-          cow[W] += w8pos;
+          w8pos_sum += w8pos;
+          cow[W] += double(w8 > 0); // count contributors
       } // iall
-      if (cow[W] > 0) scale(cow, 3, 1./cow[3]); // normalize
+      if (w8pos_sum > 0) scale(cow, 3, 1./w8pos_sum); // normalize
       return w8sum; // returns the sum of weights
   } // center_of_weight
 
+  template <typename real_t>
+  void project_onto_direction(
+        std::vector<std::pair<float,uint32_t>> & v // result: projections and indices, sorted in ascending order
+      , double const vec[3] // direction
+      , size_t const nuna // number of unassigned work items
+      , uint32_t const indirect[] // list of unassigned work items
+      , real_t const (*const xyzw)[4] // positions of work items in space [0/1/2] and their weight [3]
+  ) {
+      v.resize(nuna);
+      for (size_t iuna = 0; iuna < nuna; ++iuna) { // parallel
+          auto const iall = indirect[iuna];
+          auto const *const xyz = xyzw[iall];
+          auto const f = xyz[X]*vec[X] // inner product
+                       + xyz[Y]*vec[Y]
+                       + xyz[Z]*vec[Z];
+          v[iuna].first  = f;
+          v[iuna].second = iall;
+      } // iall
+      auto lambda = [](std::pair<float,uint32_t> i1, std::pair<float,uint32_t> i2) { return i1.first < i2.first; };
+      std::stable_sort(v.begin(), v.end(), lambda);
+  } // project_onto_direction
+
+  template <typename real_w_t>
+  double estimate_cut_surface(
+        std::vector<std::pair<float,uint32_t>> const & v // sorted projections and indices
+      , double const vec[3] // direction (normalized)
+      , double const target_load0 // relative target for load0 multiplied with np
+      , real_w_t const w8s[] // weights
+      , int const np // number of processes
+  ) {
+      // estimate the number of block faces that a bisecting plane perpendicular to vec cuts
+      size_t isrt{0};
+      double load0{0};
+      for (; isrt < v.size() && load0 < target_load0; ++isrt) {
+          load0 += w8s[v[isrt].second]*np;
+      } // isrt
+      if (isrt < 1 || isrt >= v.size()) return 0; // nothing is cut
+      double const f_split = 0.5*(v[isrt - 1].first + v[isrt].first);
+      // count the work items with non-zero weight inside a slab of thickness 1 around the plane
+      size_t n_slab{0};
+      for (auto const & fi : v) {
+          auto const df = fi.first - f_split;
+          n_slab += (-0.5 <= df && df < 0.5 && w8s[fi.second] > 0);
+      } // fi
+      // a plane with unit normal vec cuts |vec_x| + |vec_y| + |vec_z| faces of a unit cube grid per unit area
+      return n_slab*(std::abs(vec[X]) + std::abs(vec[Y]) + std::abs(vec[Z]));
+  } // estimate_cut_surface
+
   // idea for a stable load balancer:
   //    for np processes, uses celing(log_2(nprocs)) iterations
   //    in iteration #0, place the center at 0,0,0 and the diagonal opposite corner finding its longest extent
@@ -92,6 +141,7 @@ namespace load_balancer {
       , int const echo=0 // verbosity
       , double rank_center[4]=nullptr // export the rank center [0/1/2] and number of items [3]
       , uint16_t *const owner_rank=nullptr // export the rank of each task
+      , bool const minimize_surface=false // also try bisecting planes perpendicular to x, y and z
   ) {
       // complexity is order(N^2) as each processes loops over all tasks in the first iteration
 
@@ -150,26 +200,29 @@ namespace load_balancer {
               add_product(cow, 3, xyzw[imax], -1.);
               auto const len2 = pow2(cow[X]) + pow2(cow[Y]) + pow2(cow[Z]);
               auto const norm = (len2 > 0) ? 1./std::sqrt(len2) : 0.0;
-              double const vec[] = {cow[X]*norm, cow[Y]*norm, cow[Z]*norm};
-              if (echo > 19) std::printf("# rank#%i sort along the [%g %g %g] direction\n", rank, vec[X], vec[Y], vec[Z]);
-
-              using fui_t = std::pair<float,uint32_t>;
-              std::vector<fui_t> v(nuna);
-
-              for (size_t iuna = 0; iuna < nuna; ++iuna) { // parallel
-                  auto const iall = indirect[iuna];
-                  auto const *const xyz = xyzw[iall];
-                  auto const f = xyz[X]*vec[X] // inner product
-                               + xyz[Y]*vec[Y]
-                               + xyz[Z]*vec[Z];
-                  v[iuna].first  = f;
-                  v[iuna].second = iall;
-              } // iall
-
-              auto lambda = [](fui_t i1, fui_t i2) { return i1.first < i2.first; };
-              std::stable_sort(v.begin(), v.end(), lambda);
+              double vec[] = {cow[X]*norm, cow[Y]*norm, cow[Z]*norm};
 
               auto const target_load0 = nhalf[0]*w8sum; // relative target for load0 multiplied with np
+
+              std::vector<std::pair<float,uint32_t>> v(nuna);
+              project_onto_direction(v, vec, nuna, indirect.data(), xyzw);
+
+              if (minimize_surface) {
+                  // the communication volume between the two halves scales with the area of the bisecting plane,
+                  // so we compare the largest extent direction to the Cartesian directions
+                  auto best_cut = estimate_cut_surface(v, vec, target_load0, w8s, np);
+                  int best_dir{-1};
+                  for (int dir = 0; dir < 3; ++dir) {
+                      double axis[] = {0, 0, 0}; axis[dir] = 1;
+                      project_onto_direction(v, axis, nuna, indirect.data(), xyzw);
+                      auto const cut = estimate_cut_surface(v, axis, target_load0, w8s, np);
+                      if (echo > 29) std::printf("# rank#%i level=%d cut surface along %c is %g, best so far %g\n", rank, tree_level, 'x' + dir, cut, best_cut);
+                      if (cut < best_cut) { best_cut = cut; best_dir = dir; }
+                  } // dir
+                  if (best_dir > -1) { set(vec, 3, 0.0); vec[best_dir] = 1; }
+                  project_onto_direction(v, vec, nuna, indirect.data(), xyzw); // sort again along the chosen direction
+              } // minimize_surface
+              if (echo > 19) std::printf("# rank#%i sort along the [%g %g %g] direction\n", rank, vec[X], vec[Y], vec[Z]);
               { // scope: distribute according to target loads
                   auto const state0 = i01 ? ASSIGNED : UNASSIGNED,
                              state1 = i01 ? UNASSIGNED : ASSIGNED;
@@ -288,8 +341,9 @@ namespace load_balancer {
       , int const echo // =0, log level
       , double rank_center[4] // =nullptr, export the rank center [0/1/2] and number of items [3]
       , uint16_t *const owner_rank // =nullptr, export the owner rank of each task, [nb[Z]*nb[Y]*nb[X]]
+      , double const *const block_weights // =nullptr, estimated cost of each task, [nb[Z]*nb[Y]*nb[X]]
   ) {
-      // distribute a rectangular box of nb[X] x nb[Y] x nb[Z] with all weights 1
+      // distribute a rectangular box of nb[X] x nb[Y] x nb[Z] with all weights 1 or with the given block_weights
 
       assert(comm_rank >= 0);
       assert(comm_rank < comm_size);
@@ -307,7 +361,7 @@ namespace load_balancer {
       for (uint32_t ix = 0; ix < nb[X]; ++ix) {
           auto const iall = (size_t(iz)*nb[Y] + iy)*nb[X] + ix;
 //        assert(uint32_t(iall) == iall && "uint32_t is not long enough!");
-          float const w8 = 1.f; // weight(ix,iy,iz); // WEIGHTS CAN BE INSERTED HERE
+          float const w8 = block_weights ? std::max(0., block_weights[iall]) : 1.f; // weight(ix,iy,iz)
           w8s[iall]     = w8;
           w8sum_all    += w8;
           xyzw[iall][W] = w8;
@@ -316,12 +370,39 @@ namespace load_balancer {
           xyzw[iall][Z] = iz;
       }}} // ix iy iz
 
+      bool const minimize_surface = (0 != control::get("load_balancer.minimize.surface", 0.));
       auto const load_now = plane_balancer(comm_size, comm_rank, nall, xyzw, w8s.data(), w8sum_all, echo
-                                          , rank_center, owner_rank);
+                                          , rank_center, owner_rank, minimize_surface);
       delete[] xyzw;
       return load_now;
   } // get
 
+
+  size_t count_cut_faces(
+        uint32_t const nb[3] // number of blocks in X/Y/Z direction
+      , uint16_t const owner_rank[] // owner rank of each task, [nb[Z]*nb[Y]*nb[X]], after MPI_MAX
+      , double const *const block_weights // =nullptr, tasks with zero weight do not communicate
+  ) {
+      // count the faces between neighboring blocks which are owned by different ranks
+      size_t ncut{0};
+      for (uint32_t iz = 0; iz < nb[Z]; ++iz) {
+      for (uint32_t iy = 0; iy < nb[Y]; ++iy) {
+      for (uint32_t ix = 0; ix < nb[X]; ++ix) {
+          auto const iall = (size_t(iz)*nb[Y] + iy)*nb[X] + ix;
+          if (block_weights && block_weights[iall] <= 0) continue;
+          uint32_t const ixyz[] = {ix, iy, iz};
+          size_t const stride[] = {1, nb[X], nb[X]*size_t(nb[Y])};
+          for (int d = 0; d < 3; ++d) {
+              if (ixyz[d] + 1 < nb[d]) { // upper neighbor exists
+                  auto const jall = iall + stride[d];
+                  if (block_weights && block_weights[jall] <= 0) continue;
+                  ncut += (owner_rank[iall] != owner_rank[jall]);
+              } // upper neighbor exists
+          } // d
+      }}} // ix iy iz
+      return ncut;
+  } // count_cut_faces
+
 #ifdef  NO_UNIT_TESTS
   status_t all_tests(int const echo) { return STATUS_TEST_NOT_INCLUDED; }
 #else // NO_UNIT_TESTS
@@ -609,6 +690,60 @@ namespace load_balancer {
       return stat;
   } // test_plane_balancer
 
+  status_t test_weighted_balancer(int const nprocs, int const n[3], int const echo=0) {
+      // an isolated cluster in vacuum: only blocks inside a sphere carry work, their cost decays towards the surface
+      status_t stat(0);
+      if (nprocs < 1) return stat;
+      uint32_t const nb[] = {uint32_t(n[X]), uint32_t(n[Y]), uint32_t(n[Z])};
+      auto const nall = nb[X]*size_t(nb[Y])*size_t(nb[Z]);
+      auto const radius = control::get("load_balancer.test.cluster.radius", 0.4*std::max(n[X], n[Y]));
+      std::vector<double> cost(nall, 0.0);
+      auto const xyzw = new double[nall][4];
+      double w8sum_all{0};
+      for (int iz = 0; iz < n[Z]; ++iz) {
+      for (int iy = 0; iy < n[Y]; ++iy) {
+      for (int ix = 0; ix < n[X]; ++ix) {
+          auto const iall = size_t(iz*n[Y] + iy)*n[X] + ix;
+          auto const r = std::sqrt(pow2(ix - .5*n[X]) + pow2(iy - .5*n[Y]) + pow2(iz - .5*n[Z]));
+          cost[iall] = (r < radius) ? 2 - r/radius : 0.0; // heavier in the center
+          w8sum_all += cost[iall];
+          xyzw[iall][X] = ix; xyzw[iall][Y] = iy; xyzw[iall][Z] = iz; xyzw[iall][W] = cost[iall];
+      }}} // ix iy iz
+      if (echo > 0) std::printf("\n# %s: distribute a cluster of radius %g with total cost %g to %d processes\n",
+                                   __func__, radius, w8sum_all, nprocs);
+
+      // each bisection level can miss its target share by at most the cost of one block
+      int const nlevels = std::ceil(std::log2(std::max(nprocs, 1)));
+      double const max_load_bound = w8sum_all/nprocs + nlevels*2.0; // 2.0 is the largest cost of a single block
+      double imbalance[2], max_load[2];
+      size_t ncut[2];
+      for (int surface = 0; surface < 2; ++surface) {
+          std::vector<double> load(nprocs, 0.0);
+          std::vector<uint16_t> owner_rank(nall, no_owner);
+          for (int rank = 0; rank < nprocs; ++rank) {
+              load[rank] = plane_balancer(nprocs, rank, nall, xyzw, cost.data(), w8sum_all, echo - 10
+                                          , nullptr, owner_rank.data(), (1 == surface));
+          } // rank
+          size_t unassigned{0};
+          for (size_t iall = 0; iall < nall; ++iall) { unassigned += (no_owner == owner_rank[iall]); }
+          if (unassigned) warn("%ld work items have not been assigned to any rank", unassigned);
+          stat += (unassigned > 0);
+          imbalance[surface] = analyze_load_imbalance(load.data(), nprocs, echo);
+          ncut[surface] = count_cut_faces(nb, owner_rank.data(), cost.data());
+          if (echo > 1) std::printf("# %s %s: imbalance (max/mean) %.3f, %ld faces between ranks\n",
+                               __func__, surface ? "minimize surface" : "largest extent", imbalance[surface], ncut[surface]);
+          max_load[surface] = *std::max_element(load.begin(), load.end());
+          if (max_load[surface] > max_load_bound) warn("largest load %g exceeds the bound %g", max_load[surface], max_load_bound);
+          stat += (max_load[surface] > max_load_bound);
+      } // surface
+      // minimizing the surface must not cut more faces and may add at most the cost of one block to the largest load
+      if (ncut[1] > ncut[0]) warn("minimize surface cuts %ld faces, more than %ld", ncut[1], ncut[0]);
+      if (max_load[1] > max_load[0] + 2.0) warn("minimize surface has largest load %g, more than %g + 2", max_load[1], max_load[0]);
+      stat += (ncut[1] > ncut[0]) + (max_load[1] > max_load[0] + 2.0);
+      delete[] xyzw;
+      return stat;
+  } // test_weighted_balancer
+
   // example 5 processes -->
   //        rank#0      rank#1      rank#2      rank#3      rank#4
   //  take    3/5         3/5         3/5         2/5         2/5
@@ -683,6 +818,7 @@ namespace load_balancer {
                       __func__, nxyz[X], nxyz[Y], nxyz[Z], nxyz[X]*nxyz[Y]*nxyz[Z], nprocs);
 
       stat += test_plane_balancer(nprocs, nxyz, echo);
+      stat += test_weighted_balancer(nprocs, nxyz, echo);
 //    stat += test_reference_point_cloud(nxyz, echo);
       return stat;
   } // all_tests
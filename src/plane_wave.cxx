@@ -104,6 +104,322 @@ namespace plane_wave {
   } // Fourier_Gauss_factor_3D
 
 
+  inline int fft_friendly(int const n) {
+      // smallest number >= n with only prime factors 2, 3 and 5
+      for (int m = std::max(1, n); true; ++m) {
+          int r{m};
+          for (int const p : {2, 3, 5}) { while (0 == r % p) r /= p; }
+          if (1 == r) return m;
+      } // m
+  } // fft_friendly
+
+
+  template <typename wave_function_t> // choose from {complex<float>, complex<double>}
+  class plane_wave_operator_t {
+    //
+    //  Matrix-free action of the plane-wave Hamiltonian and overlap onto single vectors:
+    //    the kinetic energy is diagonal in the plane-wave basis,
+    //    the local potential is applied in real space between two Fourier transforms on a box
+    //    large enough to avoid aliasing and the PAW projectors enter as nB x nC matrices.
+    //  Like dense_operator_t acting on HSm, the transposed matrices are applied, so the
+    //  eigenvectors follow the same convention as those of the dense and the iterative solver.
+    //
+
+    public:
+      typedef wave_function_t complex_t;
+      typedef grid_operators::kpoint_t<complex_t> kpt_t; // dummy arguments
+
+    private:
+      using real_t = decltype(std::real(complex_t(1)));
+      int constexpr static H=0, S=1;
+
+      std::vector<PlaneWave> const & pw_basis;
+      view4D<double> const & Vcoeff; // Fourier coefficients of the local potential on the nG grid
+      view2D<complex_t> const & P_jl; //  <k+G_j|\tilde p_l>
+      view3D<complex_t> const & Psh_il; // atom-centered PAW matrices multiplied to P_jl
+      int nG[3], nM[3]; // grid of the potential and Fourier transform box
+      int nB, nC; // number of plane waves and number of PAW coefficients
+      size_t nM_all;
+      double kinetic, localpot;
+      real_t scale_h, scale_s;
+      bool has_fft;
+      std::vector<size_t> box_index; // where plane wave #iB is located in the Fourier transform box
+      std::vector<std::complex<double>> Vr; // local potential in real space, includes all normalization factors
+      std::vector<std::complex<double>> phase[3]; // exp(-2*pi*i*m/nM[d]) for the discrete Fourier transform fallback
+      std::vector<complex_t> precond; // diagonal preconditioner
+
+      status_t transform(std::complex<double> data[], bool const forward, int const echo=0) const {
+          // unnormalized Fourier transform in-place on the box nM
+          if (has_fft) {
+              // the real/imag interface is available with FFTW and with MKL
+              std::vector<double> re(nM_all), im(nM_all), out_re(nM_all), out_im(nM_all);
+              for (size_t i = 0; i < nM_all; ++i) { re[i] = data[i].real(); im[i] = data[i].imag(); }
+              auto const stat = fourier_transform::fft(out_re.data(), out_im.data(), re.data(), im.data(), nM, forward, echo);
+              for (size_t i = 0; i < nM_all; ++i) { data[i] = std::complex<double>(out_re[i], out_im[i]); }
+              return stat;
+          } // has_fft
+          // no FFT library available: separable discrete Fourier transforms along x, y and z
+          for (int d = 0; d < 3; ++d) {
+              int const n = nM[d];
+              size_t const stride = (0 == d) ? 1 : ((1 == d) ? nM[0] : size_t(nM[1])*nM[0]);
+              size_t const nlines = nM_all/n;
+              std::vector<std::complex<double>> line(n);
+              for (size_t il = 0; il < nlines; ++il) {
+                  size_t const start = (il/stride)*stride*n + (il % stride);
+                  for (int j = 0; j < n; ++j) {
+                      line[j] = data[start + j*stride];
+                  } // j
+                  for (int k = 0; k < n; ++k) {
+                      std::complex<double> c(0);
+                      for (int j = 0; j < n; ++j) {
+                          int const jk = (size_t(j)*k) % n;
+                          c += line[j] * phase[d][forward ? jk : ((n - jk) % n)];
+                      } // j
+                      data[start + k*stride] = c;
+                  } // k
+              } // il
+          } // d
+          return 0;
+      } // transform
+
+      complex_t matrix_element(int const h0s1, int const iB, int const jB) const {
+          // explicit <k+G_i|H|k+G_j> or <k+G_i|S|k+G_j>, also used to assemble the dense matrices in solve_k
+          auto const & i = pw_basis[iB];
+          auto const & j = pw_basis[jB];
+          complex_t hs(0);
+          if (H == h0s1) {
+              if (iB == jB) hs += real_t(kinetic*i.g2);
+              int const iVx = i.x - j.x, iVy = i.y - j.y, iVz = i.z - j.z;
+              if ((2*std::abs(iVx) < nG[0]) && (2*std::abs(iVy) < nG[1]) && (2*std::abs(iVz) < nG[2])) {
+                  int const imz = (iVz + nG[2])%nG[2], imy = (iVy + nG[1])%nG[1], imx = (iVx + nG[0])%nG[0];
+                  hs += real_t(localpot)*std::complex<real_t>(Vcoeff(0, imz, imy, imx), Vcoeff(1, imz, imy, imx));
+              } // inside range
+          } else {
+              if (iB == jB) hs += real_t(1);
+          } // h0s1
+          complex_t nl(0);
+          for (int lC = 0; lC < nC; ++lC) {
+              nl += Psh_il(h0s1,iB,lC) * conjugate(P_jl(jB,lC));
+          } // lC
+          return hs + nl*((H == h0s1) ? scale_h : scale_s);
+      } // matrix_element
+
+      status_t add_nonlocal(complex_t out[], complex_t const psi[], int const h0s1) const {
+          // out_i += sum_j M_ji psi_j with M_ji = Psh_jl P^*_il
+          std::vector<complex_t> a(nC, complex_t(0));
+          for (int jB = 0; jB < nB; ++jB) {
+              add_product(a.data(), nC, Psh_il(h0s1,jB), psi[jB]);
+          } // jB
+          auto const scale = (H == h0s1) ? scale_h : scale_s;
+          for (int iB = 0; iB < nB; ++iB) {
+              complex_t c(0);
+              for (int lC = 0; lC < nC; ++lC) {
+                  c += conjugate(P_jl(iB,lC)) * a[lC];
+              } // lC
+              out[iB] += c*scale;
+          } // iB
+          return 0;
+      } // add_nonlocal
+
+    public:
+
+      plane_wave_operator_t(
+            std::vector<PlaneWave> const & pw_basis // plane waves sorted by their kinetic energy
+          , view4D<double> const & Vcoeff // <G|V|G'> = potential(0:1,iGz-jGz,iGy-jGy,iGx-jGx)
+          , int const nG_potential[3] // number of plane wave entries in the potential
+          , view2D<complex_t> const & P_jl
+          , view3D<complex_t> const & Psh_il
+          , double const kinetic_prefactor
+          , double const localpot_prefactor // includes 1/(nG[0]*nG[1]*nG[2])
+          , real_t const scale_nonlocal_h=1
+          , real_t const scale_nonlocal_s=1
+          , int const echo=0 // log-level
+          , bool const matrix_free=true // false: only explicit matrix elements, no Fourier transform box
+      )
+        : pw_basis(pw_basis), Vcoeff(Vcoeff), P_jl(P_jl), Psh_il(Psh_il)
+        , kinetic(kinetic_prefactor), localpot(localpot_prefactor)
+        , scale_h(scale_nonlocal_h), scale_s(scale_nonlocal_s)
+      {
+          nB = pw_basis.size();
+          nC = P_jl.stride();
+          set(nG, 3, nG_potential);
+          set(nM, 3, 0); nM_all = 0; has_fft = false;
+          if (!matrix_free) return; // sub_matrices and matrix_element need no box
+
+          // the product of a plane wave with |G| <= maxG and the potential with 2|G| < nG
+          // must not wrap around in the box: nM > 2*maxG + (nG - 1)/2
+          int maxG[] = {0, 0, 0};
+          for (auto const & pw : pw_basis) {
+              maxG[0] = std::max(maxG[0], std::abs(int(pw.x)));
+              maxG[1] = std::max(maxG[1], std::abs(int(pw.y)));
+              maxG[2] = std::max(maxG[2], std::abs(int(pw.z)));
+          } // pw
+          for (int d = 0; d < 3; ++d) {
+              nM[d] = fft_friendly(2*maxG[d] + (nG[d] - 1)/2 + 1);
+              phase[d].resize(nM[d]);
+              for (int m = 0; m < nM[d]; ++m) {
+                  double const arg = -2*constants::pi*m/double(nM[d]);
+                  phase[d][m] = std::complex<double>(std::cos(arg), std::sin(arg));
+              } // m
+          } // d
+          nM_all = size_t(nM[2])*size_t(nM[1])*size_t(nM[0]);
+
+          box_index.resize(nB);
+          for (int iB = 0; iB < nB; ++iB) {
+              auto const & pw = pw_basis[iB];
+              int const ix = (pw.x + nM[0])%nM[0], iy = (pw.y + nM[1])%nM[1], iz = (pw.z + nM[2])%nM[2];
+              box_index[iB] = (size_t(iz)*nM[1] + iy)*nM[0] + ix;
+          } // iB
+
+          // local potential: place the Fourier coefficients into the box and transform to real space
+          Vr.assign(nM_all, 0.0);
+          for (int iz = 0; iz < nG[2]; ++iz) {  int const jz = (2*iz < nG[2]) ? iz : iz - nG[2];
+          for (int iy = 0; iy < nG[1]; ++iy) {  int const jy = (2*iy < nG[1]) ? iy : iy - nG[1];
+          for (int ix = 0; ix < nG[0]; ++ix) {  int const jx = (2*ix < nG[0]) ? ix : ix - nG[0];
+              if ((2*std::abs(jx) < nG[0]) && (2*std::abs(jy) < nG[1]) && (2*std::abs(jz) < nG[2])) {
+                  size_t const izyx = (size_t((jz + nM[2])%nM[2])*nM[1] + (jy + nM[1])%nM[1])*nM[0] + (jx + nM[0])%nM[0];
+                  Vr[izyx] = std::complex<double>(Vcoeff(0,iz,iy,ix), Vcoeff(1,iz,iy,ix));
+              } // inside range
+          }}} // ix iy iz
+          {
+              std::vector<double> test(4*nM_all, 0.0);
+              has_fft = (0 == fourier_transform::fft(&test[0], &test[nM_all], &test[2*nM_all], &test[3*nM_all], nM, false, 0));
+          }
+          transform(Vr.data(), false, echo);
+          scale(Vr.data(), nM_all, std::complex<double>(localpot/nM_all));
+          if (echo > 3) std::printf("# matrix-free plane-wave operator for %d plane waves on a %d x %d x %d box using %s\n",
+                                      nB, nM[0], nM[1], nM[2], has_fft ? "FFT" : "separable DFTs (no FFT library)");
+
+          // construct a diagonal preconditioner
+          double diag_min{9e99};
+          std::vector<double> diag(nB);
+          for (int iB = 0; iB < nB; ++iB) {
+              diag[iB] = std::real(matrix_element(H, iB, iB));
+              diag_min = std::min(diag_min, diag[iB]);
+          } // iB
+          double const diag_shift = diag_min - 1.0; // 1.0 Ha below the lowest diagonal element
+          precond.resize(nB);
+          for (int iB = 0; iB < nB; ++iB) {
+              precond[iB] = complex_t(real_t(1/(diag[iB] - diag_shift)));
+          } // iB
+      } // constructor
+
+      status_t Hamiltonian(complex_t Hpsi[], complex_t const psi[], kpt_t const & kp, int const echo=0) const {
+          assert(nM_all > 0 && "constructed without the Fourier transform box, matrix_free=false");
+          status_t stat(0);
+          // local potential, transposed action V^T psi = (V psi^*)^*
+          std::vector<std::complex<double>> box(nM_all, 0.0);
+          for (int iB = 0; iB < nB; ++iB) {
+              box[box_index[iB]] = std::conj(std::complex<double>(psi[iB]));
+          } // iB
+          stat += transform(box.data(), false, echo); // to real space
+          scale(box.data(), nM_all, Vr.data()); // multiply with the local potential
+          stat += transform(box.data(), true, echo); // back to reciprocal space
+          for (int iB = 0; iB < nB; ++iB) {
+              Hpsi[iB] = complex_t(std::conj(box[box_index[iB]])) + psi[iB]*real_t(kinetic*pw_basis[iB].g2);
+          } // iB
+          stat += add_nonlocal(Hpsi, psi, H);
+          return stat;
+      } // Hamiltonian
+
+      status_t Overlapping(complex_t Spsi[], complex_t const psi[], kpt_t const & kp, int const echo=0) const {
+          set(Spsi, nB, psi); // plane waves are orthonormal
+          return add_nonlocal(Spsi, psi, S);
+      } // Overlapping
+
+      status_t Conditioner(complex_t Cpsi[], complex_t const psi[], kpt_t const & kp, int const echo=0) const {
+          product(Cpsi, nB, precond.data(), psi); // diagonal preconditioner
+          return 0;
+      } // Pre-Conditioner
+
+      void sub_matrices(view3D<complex_t> & HSm, int const nsub) const {
+          // explicit Hamiltonian and overlap matrices for the nsub lowest plane waves
+          for (int iB = 0; iB < nsub; ++iB) {
+              for (int jB = 0; jB < nsub; ++jB) {
+                  HSm(H,iB,jB) = matrix_element(H, iB, jB);
+                  HSm(S,iB,jB) = matrix_element(S, iB, jB);
+              } // jB
+          } // iB
+      } // sub_matrices
+
+      double get_volume_element() const { return 1.0; }
+      size_t get_degrees_of_freedom() const { return size_t(nB); }
+      bool use_precond() const { return true; }
+      bool use_overlap() const { return true; }
+  }; // class plane_wave_operator_t
+
+
+  template <typename complex_t>
+  status_t matrix_free_solve(
+        double eigenenergies[] // [nbands]
+      , view2D<complex_t> & waves // [nbands,nPW] on exit eigenvectors
+      , plane_wave_operator_t<complex_t> const & op
+      , char const *x_axis=""
+      , int const echo=0
+      , int const nbands=10
+      , float const direct_ratio=2
+      , int const max_iterations=1 // outer Davidson iterations, stops earlier if the eigenvalues have converged
+  ) {
+      // Davidson method with a matrix-free Hamiltonian
+      status_t stat(0);
+      int constexpr H=0;
+      int const nPW = op.get_degrees_of_freedom();
+      if (nbands > nPW) {
+          warn("tried to find %d bands in a basis set with %d plane waves", nbands, nPW);
+          return -1;
+      } // enough plane waves?
+
+      waves = view2D<complex_t>(nbands, nPW, complex_t(0)); // get memory
+      if (nbands > 0) { // scope: start waves from the lowest plane waves
+          int const nsub = std::min(std::max(nbands, int(direct_ratio*nbands)), nPW);
+          view3D<complex_t> SHmat_b(2, nsub, align<2>(nsub));
+          op.sub_matrices(SHmat_b, nsub);
+          if (echo > 6) { std::printf("# %s get %d start waves from diagonalization of a %d x %d Hamiltonian\n",
+                                  __func__, nbands, nsub, nsub); std::fflush(stdout); }
+          auto const stat_eig = dense_solver::solve(SHmat_b, "# start waves "); // mute
+          if (stat_eig != 0) {
+              warn("diagonalization of the %d x %d sub-Hamiltonian returned status= %i", nsub, nsub, int(stat_eig));
+              return stat_eig;
+          } // error?
+          for (int ib = 0; ib < nbands; ++ib) {
+              set(waves[ib], nsub, SHmat_b(H,ib)); // the dense solver stores eigenvectors in H
+          } // ib
+      } // scope
+
+      grid_operators::kpoint_t<complex_t> const kp;
+      int const nit = max_iterations;
+      double const threshold = control::get("plane_wave.matrix.free.threshold", 1e-9); // in Hartree
+      std::vector<double> eigvals(nbands, 0.0), previous(nbands, 9e9);
+      status_t stat_slv(0);
+      int it{0};
+      double change{9e9};
+      for (; it < nit && (0 == stat_slv) && (change > threshold); ++it) {
+          stat_slv = davidson_solver::eigensolve(waves.data(), eigvals.data(), nbands, op, kp, echo - 10, 2.0f, 2);
+          change = 0;
+          for (int ib = 0; ib < nbands; ++ib) {
+              change = std::max(change, std::abs(eigvals[ib] - previous[ib]));
+          } // ib
+          set(previous.data(), nbands, eigvals.data());
+          if (echo > 7) { std::printf("# %s Davidson iteration #%i, largest eigenvalue change %.1e %s\n",
+                                  __func__, it, change*eV, _eV); std::fflush(stdout); }
+      } // it
+      stat += stat_slv;
+
+      if (0 == stat_slv) {
+          if (echo > 2) {
+              dense_solver::display_spectrum(eigvals.data(), nbands, x_axis, eV, _eV);
+              if (echo > 4) std::printf("# %s converged to %.1e %s in %d iterations\n", __func__, change*eV, _eV, it);
+              std::fflush(stdout);
+          } // echo
+      } else {
+          warn("Davidson solver for the matrix-free plane wave Hamiltonian failed with status= %i", int(stat_slv));
+      } // stat_slv
+
+      set(eigenenergies, nbands, eigvals.data()); // export
+      return stat;
+  } // matrix_free_solve
+
+
   template <typename complex_t>
   status_t iterative_solve(
         double eigenenergies[] // [nbands]
@@ -428,9 +744,16 @@ namespace plane_wave {
 
       // PAW projection matrix ready
 
+      int  const nB_auto = control::get("plane_wave.dense.solver.below", 999.);
+      char const solver = *control::get("plane_wave.solver", "auto") | 32; // expect one of {auto, both, direct, iterative, matrix-free}
+      bool const run_solver[3] = {('i' == solver) || ('b' == solver),
+                                  ('d' == solver) || ('b' == solver) || (('a' == solver) && (nB <= nB_auto)),
+                                  ('m' == solver) || (('a' == solver) && (nB >  nB_auto))};
+      bool const explicit_matrices = run_solver[0] || run_solver[1]; // the matrix-free solver needs no O(nB^2) memory
+
       // allocate bulk memory for overlap and Hamiltonian
       int const nBa = align<4>(nB); // memory aligned main matrix stride
-      view3D<complex_t> HSm(2, nB, nBa, complex_t(0)); // get memory for 1:Hamiltonian matrix H, 0:Overlap S
+      view3D<complex_t> HSm(2, nB*explicit_matrices, nBa, complex_t(0)); // get memory for 1:Hamiltonian matrix H, 0:Overlap S
 
 #ifdef DEVEL
       if (echo > 9) std::printf("# assume dimensions of Vcoeff(%d, %ld, %ld, %ld)\n", 2, Vcoeff.dim2(), Vcoeff.dim1(), Vcoeff.stride());
@@ -452,54 +775,23 @@ namespace plane_wave {
       double const kinetic = 0.5 * scale_k; // prefactor of kinetic energy in Hartree atomic units
       real_t const localpot = scale_p / (nG[0]*nG[1]*nG[2]);
 
-      for (int iB = 0; iB < nB; ++iB) {
-          auto const & i = pw_basis[iB];
-
-          HSm(S,iB,iB) += 1; // unity overlap matrix, plane waves without atoms are orthogonal
-          HSm(H,iB,iB) += kinetic*i.g2; // diagonal kinetic energy contribution
-
-          for (int jB = 0; jB < nB; ++jB) {
-              auto const & j = pw_basis[jB];
-
-              // add the contribution of the local potential
-              int const iVx = i.x - j.x, iVy = i.y - j.y, iVz = i.z - j.z;
-              if ((2*std::abs(iVx) < nG[0]) && (2*std::abs(iVy) < nG[1]) && (2*std::abs(iVz) < nG[2])) {
-                  int const imz = (iVz + nG[2])%nG[2], imy = (iVy + nG[1])%nG[1], imx = (iVx + nG[0])%nG[0];
-                  auto const V_re = Vcoeff(0, imz, imy, imx), V_im = Vcoeff(1, imz, imy, imx);
-                  HSm(H,iB,jB) += localpot*std::complex<real_t>(V_re, V_im);
-              } // inside range
-
-              // PAW contributions to H_{ij} = Ph_{il} P^*_{jl}
-              //                  and S_{ij} = Ps_{il} P^*_{jl}
-
-              // inner part of a matrix-matrix multiplication
-              { // scope: add non-local contributions
-                  complex_t h(0), s(0);
-                  for (int lC = 0; lC < nC; ++lC) { // contract
-                      auto const p = conjugate(P_jl(jB,lC)); // needs a conjugation, ToDo: here or above?
-                      h += Psh_il(H,iB,lC) * p;
-                      s += Psh_il(S,iB,lC) * p;
-                  } // lC
-                  HSm(H,iB,jB) += h * scale_h;
-                  HSm(S,iB,jB) += s * scale_s;
-              } // scope: add non-local contributions
+      // the explicit matrices are assembled from the same matrix elements that the matrix-free operator uses,
+      // the Fourier transform box and the preconditioner are only set up for the matrix-free solver
+      plane_wave_operator_t<complex_t> const op(pw_basis, Vcoeff, nG, P_jl, Psh_il, kinetic, localpot, scale_h, scale_s, echo, run_solver[2]);
+      op.sub_matrices(HSm, nB*explicit_matrices);
 
-          } // jB
-      } // iB
-
-      int  const nB_auto = control::get("plane_wave.dense.solver.below", 999.);
-      char const solver = *control::get("plane_wave.solver", "auto") | 32; // expect one of {auto, both, direct, iterative}
-      bool const run_solver[2] = {('i' == solver) || ('b' == solver) || (('a' == solver) && (nB >  nB_auto)),
-                                  ('d' == solver) || ('b' == solver) || (('a' == solver) && (nB <= nB_auto))};
       status_t solver_stat(0);
       std::vector<double> eigenenergies(nbands, -9e9);
+      view2D<complex_t> waves; // eigenvectors of the matrix-free solver
       { SimpleTimer timer("plane wave solver", __LINE__, __func__, echo);
       if (run_solver[0]) solver_stat += iterative_solve(eigenenergies.data(), HSm, x_axis, echo, nbands, direct_ratio); // ToDo: needs to export eigenenergies
       if (run_solver[1]) solver_stat += dense_solver::solve(HSm, x_axis, echo, nbands, eigenenergies.data());
+      if (run_solver[2]) solver_stat += matrix_free_solve(eigenenergies.data(), waves, op, x_axis, echo, nbands, direct_ratio,
+                                                          control::get("davidson_solver.max.iterations", 1.));
       } // timer
       // dense solver must runs second in case of "both" since it modifies the memory locations of HSm
 
-      if (export_rho && (run_solver[0] || run_solver[1])) { // at least one of both solvers needs to have executed
+      if (export_rho && (run_solver[0] || run_solver[1] || run_solver[2])) { // at least one solver needs to have executed
           double const kpoint_weight = kpoint[3];
           export_rho->constructor(nG, nbands, natoms_PAW, nC, kpoint_weight, kpoint_id, echo);
           export_rho->energies.assign(eigenenergies.begin(), eigenenergies.begin() + nbands);
@@ -517,10 +809,11 @@ namespace plane_wave {
               set(atom_coeff, nC, zero);
               set(psi_G.data(), nG_all, zero);
               // fill psi_G and atom_coefficients
+              // the eigenvectors are stored in the memory location of H if a direct solver method has been applied
+              complex_t const *const eigenvector = run_solver[2] ? waves[iband] : HSm(H,iband);
               for (int iB = 0; iB < nB; ++iB) {
-                  std::complex<double> const eigenvector_coeff = HSm(H,iband,iB);
+                  std::complex<double> const eigenvector_coeff = eigenvector[iB];
                   auto const & i = pw_basis[iB];
-                  // the eigenvectors are stored in the memory location of H if a direct solver method has been applied
                   int const iGx = (i.x + nG[0])%nG[0], iGy = (i.y + nG[1])%nG[1], iGz = (i.z + nG[2])%nG[2];
                   psi_G(iGz,iGy,iGx) = eigenvector_coeff * norm_factor;
                   for (int iC = 0; iC < nC; ++iC) {
@@ -795,8 +1088,105 @@ namespace plane_wave {
       return 0;
   } // test_Hermite_Gauss_normalization
 
+  template <typename complex_t=std::complex<double>>
+  status_t test_matrix_free(int const echo=5) {
+      // compare the matrix-free operator to the explicit matrices for a random potential and random PAW matrices
+      status_t stat(0);
+      int const nG[] = {6, 7, 8}; // grid of the local potential
+      int const nG_all = nG[2]*nG[1]*nG[0];
+      std::vector<double> vtot(nG_all);
+      for (int i = 0; i < nG_all; ++i) vtot[i] = simple_math::random(-1., 1.);
+      view4D<double> Vcoeff(2, nG[2], nG[1], nG[0], 0.0);
+      for (int iGz = 0; iGz < nG[2]; ++iGz) {
+      for (int iGy = 0; iGy < nG[1]; ++iGy) {
+      for (int iGx = 0; iGx < nG[0]; ++iGx) {
+          for (int iz = 0; iz < nG[2]; ++iz) {
+          for (int iy = 0; iy < nG[1]; ++iy) {
+          for (int ix = 0; ix < nG[0]; ++ix) {
+              double const arg = -2*constants::pi*(iGz*iz/double(nG[2]) + iGy*iy/double(nG[1]) + iGx*ix/double(nG[0]));
+              double const V = vtot[(iz*nG[1] + iy)*nG[0] + ix];
+              Vcoeff(0,iGz,iGy,iGx) += V*std::cos(arg);
+              Vcoeff(1,iGz,iGy,iGx) += V*std::sin(arg);
+          }}} // ix iy iz
+      }}} // iGx iGy iGz
+
+      std::vector<PlaneWave> pw_basis;
+      for (int iz = -3; iz <= 3; ++iz) {
+      for (int iy = -3; iy <= 3; ++iy) {
+      for (int ix = -3; ix <= 3; ++ix) {
+          double const g2 = pow2(ix + .125) + pow2(iy - .25) + pow2(iz); // some k-point
+          if (g2 < 6.25) pw_basis.push_back(PlaneWave(ix, iy, iz, g2));
+      }}} // ix iy iz
+      std::sort(pw_basis.begin(), pw_basis.end(), [](PlaneWave const & lhs, PlaneWave const & rhs) { return lhs.g2 < rhs.g2; });
+      int const nB = pw_basis.size(), nC = 4;
+
+      // random projection coefficients P and symmetric atomic matrices h and s
+      view2D<complex_t> P_jl(nB, nC, 0.0);
+      view3D<complex_t> Psh_il(2, nB, nC, 0.0);
+      double hs[2][4][4];
+      for (int i = 0; i < nC; ++i) {
+          for (int j = 0; j <= i; ++j) {
+              hs[0][i][j] = simple_math::random(-.5, .5);        hs[0][j][i] = hs[0][i][j];
+              hs[1][i][j] = simple_math::random(-.05, .05)*(i == j); hs[1][j][i] = hs[1][i][j];
+          } // j
+      } // i
+      for (int jB = 0; jB < nB; ++jB) {
+          for (int lC = 0; lC < nC; ++lC) {
+              P_jl(jB,lC) = complex_t(simple_math::random(-.3, .3), simple_math::random(-.3, .3));
+          } // lC
+          for (int h0s1 = 0; h0s1 < 2; ++h0s1) {
+              for (int lC = 0; lC < nC; ++lC) {
+                  complex_t c(0);
+                  for (int kC = 0; kC < nC; ++kC) c += P_jl(jB,kC) * hs[h0s1][kC][lC];
+                  Psh_il(h0s1,jB,lC) = c;
+              } // lC
+          } // h0s1
+      } // jB
+
+      double const localpot = 1./nG_all;
+      plane_wave_operator_t<complex_t> const op(pw_basis, Vcoeff, nG, P_jl, Psh_il, 0.5, localpot, 1, 1, echo);
+
+      // explicit matrices, assembled exactly as in solve_k
+      view3D<complex_t> HSm(2, nB, align<2>(nB), complex_t(0));
+      op.sub_matrices(HSm, nB);
+
+      // the operator must act like the transposed explicit matrices
+      grid_operators::kpoint_t<complex_t> const kp;
+      std::vector<complex_t> psi(nB), Hpsi(nB), Spsi(nB);
+      for (int iB = 0; iB < nB; ++iB) psi[iB] = complex_t(simple_math::random(-1., 1.), simple_math::random(-1., 1.));
+      op.Hamiltonian(Hpsi.data(), psi.data(), kp);
+      op.Overlapping(Spsi.data(), psi.data(), kp);
+      double dev[2] = {0, 0};
+      for (int iB = 0; iB < nB; ++iB) {
+          complex_t h(0), s(0);
+          for (int jB = 0; jB < nB; ++jB) {
+              h += HSm(0,jB,iB) * psi[jB];
+              s += HSm(1,jB,iB) * psi[jB];
+          } // jB
+          dev[0] = std::max(dev[0], double(std::abs(h - Hpsi[iB])));
+          dev[1] = std::max(dev[1], double(std::abs(s - Spsi[iB])));
+      } // iB
+      if (echo > 3) std::printf("# %s: %d plane waves, H*psi deviates by %.1e, S*psi by %.1e\n", __func__, nB, dev[0], dev[1]);
+      stat += (dev[0] > 1e-12) + (dev[1] > 1e-12);
+
+      // the lowest eigenvalues must agree with the dense solver
+      int const nbands = 8;
+      std::vector<double> eigvals(nbands), eigvals_dense(nbands);
+      view2D<complex_t> waves;
+      stat += matrix_free_solve(eigvals.data(), waves, op, "# matrix-free ", echo - 3, nbands, 2, 99);
+      stat += dense_solver::solve(HSm, "# dense ", echo - 3, nbands, eigvals_dense.data());
+      double dev_eig{0};
+      for (int ib = 0; ib < nbands; ++ib) {
+          dev_eig = std::max(dev_eig, std::abs(eigvals[ib] - eigvals_dense[ib]));
+      } // ib
+      if (echo > 3) std::printf("# %s: lowest %d eigenvalues deviate by %.1e %s\n", __func__, nbands, dev_eig*eV, _eV);
+      stat += (dev_eig > 1e-5); // Davidson does not add residuals with norm below 1e-4
+      return stat;
+  } // test_matrix_free
+
   status_t all_tests(int const echo) {
       status_t stat(0);
+      stat += test_matrix_free(echo);
       stat += test_Hamiltonian(echo);
       stat += test_Hermite_Gauss_normalization(echo);
       return stat;
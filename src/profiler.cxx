@@ -0,0 +1,285 @@
+// This file is part of AngstromCube under MIT License
+
+#include <cstdio> // std::printf, ::fprintf, ::fopen, ::fclose, ::remove
+#include <cstdint> // int64_t
+#include <cstring> // std::strlen, ::strcmp
+#include <string> // std::string
+#include <vector> // std::vector<T>
+#include <thread> // std::this_thread::get_id, std::thread::id, std::thread
+#include <atomic> // std::atomic<T>
+#include <algorithm> // std::max
+
+#include "profiler.hxx"
+
+#include "status.hxx" // status_t
+#include "recorded_warnings.hxx" // warn
+#include "simple_timer.hxx" // SimpleTimer
+
+namespace profiler {
+
+  struct node_t {
+      std::string name;
+      char const *key; // address of the name passed at creation, usually a string literal
+      int parent;
+      std::vector<int> children;
+      int64_t calls;
+      double seconds, bytes, flops;
+      std::vector<double> iteration_seconds; // [scf_iteration]
+  }; // node_t
+
+  struct state_t {
+      std::vector<node_t> nodes; // node #0 is the root
+      int current{0}; // innermost open region
+      int iteration{-1};
+      bool enabled{true};
+      std::atomic<bool> owned{false}; // claimed by the first thread that opens a region
+      std::atomic<bool> ready{false}; // owner has been written
+      std::thread::id owner; // the recording thread, valid if ready
+
+      state_t() { reset(); }
+
+      void reset() {
+          nodes.clear();
+          nodes.push_back(node_t{"total", nullptr, -1, {}, 0, 0., 0., 0., {}});
+          current = 0;
+          iteration = -1;
+          ready = false;
+          owned = false;
+      } // reset
+  }; // state_t
+
+  inline state_t & state() {
+      static state_t s; // thread-safe initialization since C++11
+      return s;
+  } // state
+
+  int open_region(char const *name) {
+      auto & s = state();
+      if (!s.enabled) return -1;
+      auto const this_thread = std::this_thread::get_id();
+      bool unowned{false};
+      if (s.owned.compare_exchange_strong(unowned, true)) { // only one thread can win the claim
+          s.owner = this_thread;
+          s.ready.store(true, std::memory_order_release);
+      } // claimed
+      if (!s.ready.load(std::memory_order_acquire) || this_thread != s.owner) return -1; // not the recording thread
+      int const parent = s.current;
+      int node{-1};
+      for (auto const child : s.nodes[parent].children) {
+          auto const & n = s.nodes[child];
+          if (n.key == name || n.name == name) { node = child; break; } // compare addresses first
+      } // child
+      if (node < 0) { // new region
+          node = s.nodes.size();
+          s.nodes.push_back(node_t{name, name, parent, {}, 0, 0., 0., 0., {}});
+          s.nodes[parent].children.push_back(node);
+      } // new
+      s.current = node;
+      return node;
+  } // open_region
+
+  void close_region(int const node, double const seconds, double const bytes, double const flops) {
+      auto & s = state();
+      if (node >= int(s.nodes.size())) return; // cleared while open
+      auto & n = s.nodes[node];
+      ++n.calls;
+      n.seconds += seconds;
+      n.bytes   += bytes;
+      n.flops   += flops;
+      if (s.iteration >= 0) {
+          if (int(n.iteration_seconds.size()) <= s.iteration) n.iteration_seconds.resize(s.iteration + 1, 0.0);
+          n.iteration_seconds[s.iteration] += seconds;
+      } // iteration
+      s.current = n.parent;
+  } // close_region
+
+  void set_iteration(int const iteration) { state().iteration = iteration; }
+
+  void set_enabled(bool const enabled) { state().enabled = enabled; }
+
+  std::string path(state_t const & s, int const node) {
+      if (node < 1) return "";
+      auto const & n = s.nodes[node];
+      return (n.parent > 0) ? (path(s, n.parent) + "/" + n.name) : n.name;
+  } // path
+
+  double children_seconds(state_t const & s, int const node) {
+      double sum{0};
+      for (auto const child : s.nodes[node].children) {
+          sum += s.nodes[child].seconds;
+      } // child
+      return sum;
+  } // children_seconds
+
+  void show_node(state_t const & s, int const node, int const depth) {
+      auto const & n = s.nodes[node];
+      if (node > 0) {
+          double const self = n.seconds - children_seconds(s, node);
+          std::printf("# %9lld %12.6f %12.6f", (long long)n.calls, n.seconds, self);
+          if (n.bytes > 0 && n.seconds > 0) std::printf(" %9.3f", n.bytes/n.seconds*1e-9); else std::printf("%10s", "");
+          if (n.flops > 0 && n.seconds > 0) std::printf(" %9.3f", n.flops/n.seconds*1e-9); else std::printf("%10s", "");
+          std::printf("  %*s%s\n", 2*(depth - 1), "", n.name.c_str());
+      } // not root
+      for (auto const child : n.children) {
+          show_node(s, child, depth + 1);
+      } // child
+  } // show_node
+
+  status_t show(int const echo) {
+      auto const & s = state();
+      if (echo < 1 || s.nodes.size() < 2) return 0;
+      std::printf("\n# profiler: %ld regions\n", s.nodes.size() - 1);
+      std::printf("#     calls      seconds         self    GByte/s   GFlop/s  region\n");
+      show_node(s, 0, 0);
+      std::printf("\n");
+      return 0;
+  } // show
+
+  status_t write_report(char const *filename, int const echo) {
+      if (nullptr == filename || '\0' == *filename) return 0;
+      auto const & s = state();
+      auto const len = std::strlen(filename);
+      bool const csv = (len > 4) && (0 == std::strcmp(filename + len - 4, ".csv"));
+      auto *const f = std::fopen(filename, "w");
+      if (nullptr == f) {
+          warn("failed to open \"%s\" for writing the profiler report", filename);
+          return -1;
+      } // failed
+      int n_iterations{0};
+      for (auto const & n : s.nodes) {
+          n_iterations = std::max(n_iterations, int(n.iteration_seconds.size()));
+      } // n
+      if (csv) {
+          std::fprintf(f, "path,calls,seconds,self_seconds,bytes,flops");
+          for (int it = 0; it < n_iterations; ++it) {
+              std::fprintf(f, ",scf_%d", it);
+          } // it
+          std::fprintf(f, "\n");
+      } else {
+          std::fprintf(f, "{\n  \"scf_iterations\": %d,\n  \"regions\": [", n_iterations);
+      } // csv
+      for (size_t node = 1; node < s.nodes.size(); ++node) {
+          auto const & n = s.nodes[node];
+          double const self = n.seconds - children_seconds(s, node);
+          auto const p = path(s, node);
+          if (csv) {
+              std::fprintf(f, "%s,%lld,%.9f,%.9f,%.6e,%.6e", p.c_str(), (long long)n.calls, n.seconds, self, n.bytes, n.flops);
+              for (int it = 0; it < n_iterations; ++it) {
+                  std::fprintf(f, ",%.9f", (it < int(n.iteration_seconds.size())) ? n.iteration_seconds[it] : 0.0);
+              } // it
+              std::fprintf(f, "\n");
+          } else {
+              std::fprintf(f, "%s\n    {\"path\": \"%s\", \"calls\": %lld, \"seconds\": %.9f, \"self_seconds\": %.9f"
+                              ", \"bytes\": %.6e, \"flops\": %.6e, \"scf_seconds\": [",
+                              (1 == node) ? "" : ",", p.c_str(), (long long)n.calls, n.seconds, self, n.bytes, n.flops);
+              for (size_t it = 0; it < n.iteration_seconds.size(); ++it) {
+                  std::fprintf(f, "%s%.9f", it ? ", " : "", n.iteration_seconds[it]);
+              } // it
+              std::fprintf(f, "]}");
+          } // csv
+      } // node
+      if (!csv) std::fprintf(f, "\n  ]\n}\n");
+      std::fclose(f);
+      if (echo > 3) std::printf("# profiler report with %ld regions written to \"%s\"\n", s.nodes.size() - 1, filename);
+      return 0;
+  } // write_report
+
+  status_t clear() {
+      auto & s = state();
+      if (s.current > 0) {
+          warn("cannot clear the profiler while region \"%s\" is open", s.nodes[s.current].name.c_str());
+          return 1;
+      } // open
+      s.reset();
+      return 0;
+  } // clear
+
+#ifdef    NO_UNIT_TESTS
+  status_t all_tests(int const echo) { return STATUS_TEST_NOT_INCLUDED; }
+#else  // NO_UNIT_TESTS
+
+  status_t test_regions(int const echo=0) {
+      status_t stat(0);
+      stat += clear(); // this test drops the regions recorded before
+      for (int it = 0; it < 3; ++it) {
+          set_iteration(it);
+          region_t scf("scf");
+          for (int i = 0; i < 2; ++i) {
+              region_t a("a", 8e3, 1e3);
+              { region_t b("b"); }
+          } // i
+          region_t b("b"); // not the same region as "a/b"
+      } // it
+      set_iteration(-1);
+      auto const & s = state();
+      stat += (5 != s.nodes.size()); // total, scf, scf/a, scf/a/b, scf/b
+      stat += (0 != s.current);
+      int const a = s.nodes[1].children[0];
+      stat += ("a" != s.nodes[a].name) + (6 != s.nodes[a].calls) + (48e3 != s.nodes[a].bytes);
+      stat += ("scf/a/b" != path(s, s.nodes[a].children[0]));
+      stat += (3 != s.nodes[1].iteration_seconds.size());
+      if (echo > 5) show(echo);
+
+      char const *const filenames[] = {"profiler_test.json", "profiler_test.csv"};
+      for (auto const filename : filenames) {
+          stat += write_report(filename, echo);
+          auto *const f = std::fopen(filename, "r");
+          stat += (nullptr == f);
+          if (f) {
+              char line[256];
+              stat += (nullptr == std::fgets(line, 256, f));
+              std::fclose(f);
+          } // f
+          std::remove(filename);
+      } // filename
+
+      { // scope: measure the overhead of an empty region
+          int const n = 1 << 20;
+          SimpleTimer timer(__FILE__, __LINE__, __func__, 0);
+          for (int i = 0; i < n; ++i) {
+              region_t r("overhead");
+          } // i
+          auto const seconds = timer.stop();
+          if (echo > 2) std::printf("# %s: overhead %.1f nsec per region\n", __func__, seconds/n*1e9);
+      } // scope
+      stat += clear();
+      if (echo > 0) std::printf("# %s status= %i\n", __func__, int(stat));
+      return stat;
+  } // test_regions
+
+  status_t test_concurrent_owners(int const echo=0) {
+      // several threads open regions at the same time, exactly one of them must be recorded
+      status_t stat(0);
+      stat += clear();
+      int constexpr nthreads = 8, n = 1000;
+      std::atomic<int> nrecorded{0};
+      std::vector<std::thread> threads;
+      for (int it = 0; it < nthreads; ++it) {
+          threads.emplace_back([&nrecorded]() {
+              int recorded{0};
+              for (int i = 0; i < n; ++i) {
+                  auto const node = open_region("concurrent");
+                  if (node >= 0) { close_region(node, 0., 0., 0.); ++recorded; }
+              } // i
+              if (recorded > 0) ++nrecorded;
+          });
+      } // it
+      for (auto & t : threads) t.join();
+      auto const & s = state();
+      stat += (1 != nrecorded.load()) + (2 != s.nodes.size());
+      if (2 == s.nodes.size()) stat += (n != s.nodes[1].calls);
+      if (echo > 3) std::printf("# %s: %d of %d threads recorded\n", __func__, nrecorded.load(), nthreads);
+      stat += clear();
+      return stat;
+  } // test_concurrent_owners
+
+  status_t all_tests(int const echo) {
+      status_t stat(0);
+      stat += test_regions(echo);
+      stat += test_concurrent_owners(echo);
+      return stat;
+  } // all_tests
+
+#endif // NO_UNIT_TESTS
+
+} // namespace profiler
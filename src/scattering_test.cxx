@@ -197,6 +197,7 @@ namespace scattering_test {
       , double const *aSm=nullptr // pointer to overlap, can be zero if n=0
       , int const stride=0 // stride for Hamiltonian and overlap
       , int const echo=0 // log-level
+      , int *const n_failed=nullptr // if given, count failed solves here instead of warning (for threaded callers)
   ) {
       double deriv[nLIM], value[nLIM], gfp[nLIM*nLIM]; assert(n < nLIM);
 
@@ -233,6 +234,7 @@ namespace scattering_test {
           } // irn
           auto const solving_status = linear_algebra::linear_solve(n0, mat, n0, x, n0);
           if (solving_status) {
+              if (n_failed) { ++(*n_failed); } else
               warn("linear solve failed for E= %g %s", energy*eV, _eV);
               return 0; // failed
           } // solving_status is non-zero
@@ -251,6 +253,126 @@ namespace scattering_test {
       return (nnodes + 0.5 - one_over_pi*arcus_tangent(der, val));
   } // generalized_node_count_SMT
 
+  void scan_energy_points( // compute generalized node counts for a list of energy points
+        view3D<float> & gncs // result gncs(ien,ell,ts), only listed ien are modified
+      , std::vector<int> const & ien_list // energy point indices to compute
+      , radial_grid_t const rg[TRU_AND_SMT] // radial grid descriptors for Vtru, Vsmt
+      , double const *const rV[TRU_AND_SMT] // true and smooth potential given on the radial grid *r
+      , int const ir_stop[TRU_AND_SMT] // radius where to stop
+      , view2D<double> const & rprj // r*projectors on the SMT grid
+      , int const ellmax // ellmax up to which the analysis should go
+      , int const numax // SHO basis size
+      , double const aHm[] // non-local Hamiltonian elements in ln_basis
+      , double const aSm[] // non-local overlap matrix elements
+      , double const energy0 // energy of ien=0
+      , double const dE // energy step
+      , int const echo=0 // log-level
+  ) {
+      int const nln = sho_tools::nSHO_radial(numax);
+      int const mr = align<2>(rg[TRU].n);
+      int const nlist = ien_list.size();
+      int n_failed{0}; // warn() is not thread-safe, so failures are counted and reported after the parallel region
+      #pragma omp parallel reduction(+:n_failed)
+      {
+          std::vector<double> gg(mr), ff(mr); // greater and smaller component, TRU grid, private to each thread
+          #pragma omp for schedule(dynamic)
+          for (int ilist = 0; ilist < nlist; ++ilist) {
+              int const ien = ien_list[ilist];
+              auto const energy = energy0 + ien*dE;
+              for (int ell = 0; ell <= ellmax; ++ell) {
+                  int const nn = (numax + 2 - ell)/2;
+                  int const iln_off = sho_tools::ln_index(numax, ell, 0);
+                  for (int ts = TRU; ts < TRU_AND_SMT; ++ts) {
+                      double const gnc = (TRU == ts) ?
+                         generalized_node_count_TRU(rg[ts], rV[ts], ell, energy, gg.data(), ff.data(), ir_stop[ts], echo/2) :
+                         generalized_node_count_SMT(rg[ts], rV[ts], ell, energy, gg.data(), ff.data(), ir_stop[ts],
+                                                    view2D<double>((iln_off < nln)?rprj[iln_off]:nullptr, rprj.stride()), nn,
+                                                    &aHm[iln_off*nln + iln_off],
+                                                    &aSm[iln_off*nln + iln_off], nln, echo/2, &n_failed);
+                      gncs(ien,ell,ts) = gnc;
+                  } // ts
+              } // ell
+          } // ilist
+      } // parallel region
+      if (n_failed > 0) warn("linear solve failed for %d of %d energy points", n_failed, nlist);
+  } // scan_energy_points
+
+  bool needs_refinement( // is there a resonance between ien0 and ien1 or a steep change?
+        view3D<float> const & gncs
+      , int const ien0
+      , int const ien1
+      , int const ellmax
+  ) {
+      float constexpr max_change = 0.25; // generalized node counts change by less than 1/4 between two samples
+      for (int ell = 0; ell <= ellmax; ++ell) {
+          for (int ts = TRU; ts < TRU_AND_SMT; ++ts) {
+              auto const change = gncs(ien1,ell,ts) - gncs(ien0,ell,ts);
+              if (change < 0 || change > max_change) return true; // a falling logder curve indicates a resonance
+          } // ts
+      } // ell
+      return false;
+  } // needs_refinement
+
+  int scan_generalized_node_counts( // returns the number of energy points computed
+        view3D<float> & gncs // result gncs(ien,ell,ts) for ien in [0, nen]
+      , int const nen // number of energy steps
+      , radial_grid_t const rg[TRU_AND_SMT] // radial grid descriptors for Vtru, Vsmt
+      , double const *const rV[TRU_AND_SMT] // true and smooth potential given on the radial grid *r
+      , int const ir_stop[TRU_AND_SMT] // radius where to stop
+      , view2D<double> const & rprj // r*projectors on the SMT grid
+      , int const ellmax // ellmax up to which the analysis should go
+      , int const numax // SHO basis size
+      , double const aHm[] // non-local Hamiltonian elements in ln_basis
+      , double const aSm[] // non-local overlap matrix elements
+      , double const energy0 // energy of ien=0
+      , double const dE // energy step
+      , int const refine=0 // start on a grid coarser by 2^refine and subdivide only where needed
+      , int const echo=0 // log-level
+  ) {
+      int coarse{1}; // step of the initial scan in units of dE
+      for (int level = 0; level < refine && 2*coarse <= nen; ++level) { coarse *= 2; }
+
+      std::vector<int> ien_list;
+      for (int ien = 0; ien < nen; ien += coarse) { ien_list.push_back(ien); }
+      ien_list.push_back(nen); // the last point is always computed
+      int npoints = ien_list.size();
+      scan_energy_points(gncs, ien_list, rg, rV, ir_stop, rprj, ellmax, numax, aHm, aSm, energy0, dE, echo);
+
+      // intervals [ien_list[i], ien_list[i + 1]] of the coarse scan
+      std::vector<int> bounds(ien_list);
+      while (bounds.size() > 1) {
+          std::vector<int> next_bounds;
+          ien_list.clear();
+          for (size_t i = 0; i + 1 < bounds.size(); ++i) {
+              int const ien0 = bounds[i], ien1 = bounds[i + 1];
+              if (ien1 - ien0 < 2) continue; // interval fully resolved
+              if (needs_refinement(gncs, ien0, ien1, ellmax)) {
+                  int const mid = (ien0 + ien1)/2;
+                  ien_list.push_back(mid);
+                  if (next_bounds.empty() || next_bounds.back() != ien0) next_bounds.push_back(ien0);
+                  next_bounds.push_back(mid);
+                  next_bounds.push_back(ien1);
+              } else {
+                  // no resonance inside: interpolate linearly
+                  for (int ien = ien0 + 1; ien < ien1; ++ien) {
+                      float const w1 = (ien - ien0)/float(ien1 - ien0), w0 = 1 - w1;
+                      for (int ell = 0; ell <= ellmax; ++ell) {
+                          for (int ts = TRU; ts < TRU_AND_SMT; ++ts) {
+                              gncs(ien,ell,ts) = w0*gncs(ien0,ell,ts) + w1*gncs(ien1,ell,ts);
+                          } // ts
+                      } // ell
+                  } // ien
+              } // needs_refinement
+          } // i
+          npoints += ien_list.size();
+          scan_energy_points(gncs, ien_list, rg, rV, ir_stop, rprj, ellmax, numax, aHm, aSm, energy0, dE, echo);
+          bounds.swap(next_bounds);
+      } // while
+
+      if (echo > 3 && coarse > 1) std::printf("# %s computed %d of %d energy points, initial step %d\n", __func__, npoints, nen + 1, coarse);
+      return npoints;
+  } // scan_generalized_node_counts
+
   status_t logarithmic_derivative(
         radial_grid_t const rg[TRU_AND_SMT] // radial grid descriptors for Vtru, Vsmt
       , double const *const rV[TRU_AND_SMT] // true and smooth potential given on the radial grid *r
@@ -263,6 +385,7 @@ namespace scattering_test {
       , char const *label // ="" // log-prefix
       , int const echo // =0 // log-level
       , float const Rlog_over_sigma // =6.f
+      , int const refine // =0 // start the energy scan on a grid coarser by 2^refine
   ) {
       status_t stat(0);
 
@@ -276,7 +399,6 @@ namespace scattering_test {
 
       int const nr_diff = rg[TRU].n - rg[SMT].n; assert(nr_diff >= 0);
       int const mr = align<2>(rg[TRU].n);
-      std::vector<double> gg(mr), ff(mr); // greater and smaller component, TRU grid
       int ir_stop[TRU_AND_SMT];
 
       int const nln = sho_tools::nSHO_radial(numax);
@@ -296,30 +418,17 @@ namespace scattering_test {
       ir_stop[TRU] = ir_stop[SMT] + nr_diff;
 
       view3D<float> gncs(1 + nen, 1 + ellmax, TRU_AND_SMT);
-      for (int ien = 0; ien <= nen; ++ien) {
-          auto const energy = energy_range[0] + ien*dE;
-//        if (echo > 0) std::printf("# node-count at %.6f %s", energy*eV, _eV);
-
-          if (echo > 22) std::printf("%.6f", energy*eV);
-          for (int ell = 0; ell <= ellmax; ++ell)
-          { // ell-loop
-              int const nn = (numax + 2 - ell)/2;
-              int const iln_off = sho_tools::ln_index(numax, ell, 0);
-              for (int ts = TRU; ts < TRU_AND_SMT; ++ts) {
-                  double const gnc = (TRU == ts) ?
-                     generalized_node_count_TRU(rg[ts], rV[ts], ell, energy, gg.data(), ff.data(), ir_stop[ts], echo/2) :
-                     generalized_node_count_SMT(rg[ts], rV[ts], ell, energy, gg.data(), ff.data(), ir_stop[ts],
-                                                view2D<double>((iln_off < nln)?rprj[iln_off]:nullptr, rprj.stride()), nn,
-                                                &aHm[iln_off*nln + iln_off],
-                                                &aSm[iln_off*nln + iln_off], nln, echo/2);
-                  gncs(ien,ell,ts) = gnc;
-                  if (echo > 22) std::printf("%c%.6f", ts?' ':'\t', gnc);
-              } // ts
-//            if (echo > 0) std::printf("# %i %g %g %g %g\n", ell, dg[TRU], vg[TRU], dg[SMT], vg[SMT]);
+      scan_generalized_node_counts(gncs, nen, rg, rV, ir_stop, rprj, ellmax, numax, aHm, aSm, energy_range[0], dE, refine, echo);
 
-          } // ell
-          if (echo > 22) std::printf("\n");
-      } // ien
+      if (echo > 22) {
+          for (int ien = 0; ien <= nen; ++ien) {
+              std::printf("%.6f", (energy_range[0] + ien*dE)*eV);
+              for (int ell = 0; ell <= ellmax; ++ell) {
+                  std::printf("\t%.6f %.6f", gncs(ien,ell,TRU), gncs(ien,ell,SMT));
+              } // ell
+              std::printf("\n");
+          } // ien
+      } // echo
 
       // analyze and show a compressed summary
       if (echo > 1) { // show summary
@@ -789,11 +898,59 @@ namespace scattering_test {
       return stat;
   } // test_expand_sho_projectors_derivative
 
+  status_t test_logarithmic_derivative_refinement(int const echo=0, int const numax=3, int const refine=4) {
+      if (echo > 0) std::printf("\n# %s %s\n", __FILE__, __func__);
+      // compare a full energy scan to an adaptively refined scan for scattering at a potential well
+      auto rg0 = *radial_grid::create_radial_grid(radial_grid::default_points());
+      radial_grid_t const rg[TRU_AND_SMT] = {rg0, rg0};
+      int const ellmax = numax, nln = sho_tools::nSHO_radial(numax);
+      double const sigma = 1.0;
+      std::vector<double> const aHm(nln*nln, 0.0); // dummy non-local matrices (constant at zero)
+      std::vector<double> rV(rg0.n);
+      for (int ir = 0; ir < rg0.n; ++ir) { rV[ir] = -2*rg0.r[ir]*std::exp(-pow2(rg0.r[ir])); } // r*V(r) for a Gaussian well
+      double const *const rVs[TRU_AND_SMT] = {rV.data(), rV.data()};
+
+      view2D<double> rprj(nln, align<2>(rg0.n));
+      status_t stat = expand_sho_projectors(rprj.data(), rprj.stride(), rg0, sigma, numax, 1, 0);
+      int const ir = std::min(radial_grid::find_grid_index(rg0, 6*sigma), rg0.n - 2);
+      int const ir_stop[TRU_AND_SMT] = {ir, ir};
+
+      double const energy0 = 0, dE = 1/1024.;
+      int const nen = 8*1024; // scan up to 8 Hartree
+      view3D<float> gncs[2];
+      int npoints[2];
+      for (int i = 0; i < 2; ++i) {
+          gncs[i] = view3D<float>(1 + nen, 1 + ellmax, TRU_AND_SMT, 0.f);
+          npoints[i] = scan_generalized_node_counts(gncs[i], nen, rg, rVs, ir_stop, rprj, ellmax, numax,
+                                        aHm.data(), aHm.data(), energy0, dE, i*refine, echo);
+      } // i
+
+      int nres[2] = {0, 0}, ndiff{0};
+      for (int ell = 0; ell <= ellmax; ++ell) {
+          for (int ts = TRU; ts < TRU_AND_SMT; ++ts) {
+              for (int ien = 1; ien <= nen; ++ien) {
+                  bool resonance[2];
+                  for (int i = 0; i < 2; ++i) {
+                      resonance[i] = (gncs[i](ien,ell,ts) < gncs[i](ien - 1,ell,ts) - 0.5); // ignore tiny wiggles
+                      nres[i] += resonance[i];
+                  } // i
+                  ndiff += (resonance[0] != resonance[1]);
+              } // ien
+          } // ts
+      } // ell
+      if (echo > 3) std::printf("# %s found %d and %d resonances, %d differ, %d of %d energy points computed\n",
+                                   __func__, nres[0], nres[1], ndiff, npoints[1], npoints[0]);
+      stat += (ndiff > 0) + (nres[0] < 1);
+      radial_grid::destroy_radial_grid(&rg0);
+      return stat;
+  } // test_logarithmic_derivative_refinement
+
   status_t all_tests(int const echo) {
       if (echo > 0) std::printf("\n# %s %s\n", __FILE__, __func__);
       status_t stat(0);
       stat += test_eigenstate_analysis(echo);
       stat += test_expand_sho_projectors_derivative(echo);
+      stat += test_logarithmic_derivative_refinement(echo);
       return stat;
   } // all_tests
 
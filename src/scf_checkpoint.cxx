@@ -0,0 +1,247 @@
+// This file is part of AngstromCube under MIT License
+
+#include <cstdio> // std::printf, ::fopen, ::fwrite, ::fread, ::fclose, ::rename, ::remove
+#include <cstring> // std::memcpy, ::memcmp, ::strncpy
+#include <cstdint> // int64_t, uint64_t, uint32_t
+#include <vector> // std::vector<T>
+#include <string> // std::string
+#include <thread> // std::thread
+
+#include "scf_checkpoint.hxx"
+
+#include "status.hxx" // status_t
+#include "recorded_warnings.hxx" // warn
+#include "simple_timer.hxx" // SimpleTimer
+
+namespace scf_checkpoint {
+
+  char const magic[8] = {'a', '4', '3', 's', 'c', 'f', '\n', '\0'};
+  uint32_t const version = 1;
+  uint32_t const endian_check = 0x01020304;
+  int const name_length = 24;
+
+  struct file_header_t {
+      char     magic[8];
+      uint32_t version;
+      uint32_t endian;
+      int64_t  scf_iteration;
+  }; // file_header_t
+
+  struct record_header_t {
+      char     name[name_length];
+      uint64_t bytes;
+  }; // record_header_t
+
+  inline size_t padded(size_t const bytes) { return ((bytes + 7) >> 3) << 3; }
+
+  writer_t::writer_t(char const *filename, int const every, int const echo)
+      : filename_(filename ? filename : ""), every_(every), echo_(echo) {
+      if (filename_.empty()) every_ = 0; // deactivate
+      if (echo > 0 && every_ > 0) std::printf("# write SCF checkpoints to \"%s\" every %d iterations\n", filename_.c_str(), every_);
+  } // constructor
+
+  bool writer_t::due(int const scf_iteration) const {
+      if (every_ < 1) return false;
+      if ((scf_iteration + 1) % every_) return false;
+      if (busy_) {
+          if (echo_ > 0) std::printf("# skip SCF checkpoint after iteration #%i, previous checkpoint is still being written\n", scf_iteration);
+          return false;
+      } // busy
+      return true;
+  } // due
+
+  void writer_t::add(char const *name, void const *data, size_t const bytes) {
+      record_t r;
+      r.name = name;
+      r.data.resize(bytes);
+      if (bytes > 0) std::memcpy(r.data.data(), data, bytes);
+      pending_.push_back(std::move(r));
+  } // add
+
+  void writer_t::write_records() {
+      SimpleTimer timer(__FILE__, __LINE__, __func__, 0);
+      auto const tmpname = filename_ + ".tmp";
+      int stat{0};
+      auto *const f = std::fopen(tmpname.c_str(), "wb");
+      size_t nbytes{0};
+      if (nullptr != f) {
+          file_header_t h;
+          std::memset(&h, 0, sizeof(h));
+          std::memcpy(h.magic, magic, 8);
+          h.version = version;
+          h.endian = endian_check;
+          h.scf_iteration = writing_iteration_;
+          nbytes += std::fwrite(&h, 1, sizeof(h), f);
+          char const zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+          size_t expected{sizeof(h)};
+          for (auto const & r : writing_) {
+              record_header_t rh;
+              std::memset(&rh, 0, sizeof(rh));
+              std::strncpy(rh.name, r.name.c_str(), name_length - 1);
+              rh.bytes = r.data.size();
+              nbytes += std::fwrite(&rh, 1, sizeof(rh), f);
+              nbytes += std::fwrite(r.data.data(), 1, r.data.size(), f);
+              nbytes += std::fwrite(zeros, 1, padded(r.data.size()) - r.data.size(), f);
+              expected += sizeof(rh) + padded(r.data.size());
+          } // r
+          stat = (nbytes != expected) + std::fclose(f);
+      } else {
+          stat = -1;
+      } // f
+      if (0 == stat) stat = std::rename(tmpname.c_str(), filename_.c_str()); // replace the previous checkpoint
+      if (echo_ > 3) std::printf("# SCF checkpoint after iteration #%lld, %.3f MByte written to \"%s\" in %.3f sec, status= %i\n",
+                                    (long long)writing_iteration_, nbytes*1e-6, filename_.c_str(), timer.stop(), stat);
+      writing_.clear();
+      total_bytes_ += nbytes;
+      write_status_ = stat;
+      busy_ = false;
+  } // write_records
+
+  status_t writer_t::commit(int const scf_iteration) {
+      auto const stat = wait();
+      add("end", nullptr, 0);
+      writing_.swap(pending_);
+      pending_.clear();
+      writing_iteration_ = scf_iteration;
+      busy_ = true;
+      worker_ = std::thread(&writer_t::write_records, this);
+      return stat;
+  } // commit
+
+  status_t writer_t::wait() {
+      if (worker_.joinable()) worker_.join();
+      int const stat = write_status_;
+      if (stat) warn("failed to write SCF checkpoint \"%s\", status= %i", filename_.c_str(), stat);
+      write_status_ = 0;
+      return stat;
+  } // wait
+
+  status_t reader_t::read(char const *filename, int const echo) {
+      records_.clear();
+      scf_iteration_ = -1;
+      auto *const f = std::fopen(filename, "rb");
+      if (nullptr == f) {
+          warn("failed to open SCF checkpoint \"%s\"", filename);
+          return -1;
+      } // f
+      status_t stat(0);
+      file_header_t h;
+      if (1 != std::fread(&h, sizeof(h), 1, f) || std::memcmp(h.magic, magic, 8)) {
+          warn("file \"%s\" is not an SCF checkpoint", filename);
+          stat = -2;
+      } else if (endian_check != h.endian || version != h.version) {
+          warn("SCF checkpoint \"%s\" has version %d or a different byte order", filename, h.version);
+          stat = -3;
+      } else {
+          bool complete{false};
+          record_header_t rh;
+          while (!complete && 1 == std::fread(&rh, sizeof(rh), 1, f)) {
+              rh.name[name_length - 1] = '\0';
+              record_t r;
+              r.name = rh.name;
+              r.data.resize(padded(rh.bytes));
+              if (r.data.size() != std::fread(r.data.data(), 1, r.data.size(), f)) break; // truncated
+              r.data.resize(rh.bytes);
+              complete = ("end" == r.name);
+              if (echo > 7) std::printf("# SCF checkpoint record \"%s\" has %lld Byte\n", rh.name, (long long)rh.bytes);
+              records_.push_back(std::move(r));
+          } // while
+          if (complete) {
+              scf_iteration_ = h.scf_iteration;
+              if (echo > 3) std::printf("# read SCF checkpoint \"%s\" after iteration #%lld with %ld records\n",
+                                            filename, (long long)scf_iteration_, records_.size());
+          } else {
+              warn("SCF checkpoint \"%s\" is incomplete", filename);
+              records_.clear();
+              stat = -4;
+          } // complete
+      } // header
+      std::fclose(f);
+      return stat;
+  } // read
+
+  size_t reader_t::bytes(char const *name) const {
+      for (auto const & r : records_) {
+          if (name == r.name) return r.data.size();
+      } // r
+      return 0;
+  } // bytes
+
+  status_t reader_t::get(char const *name, void *data, size_t const bytes, int const echo) const {
+      for (auto const & r : records_) {
+          if (name == r.name) {
+              if (bytes != r.data.size()) {
+                  warn("SCF checkpoint record \"%s\" has %ld Byte but expected %ld", name, r.data.size(), bytes);
+                  return -2;
+              } // size mismatch
+              if (bytes > 0) std::memcpy(data, r.data.data(), bytes);
+              if (echo > 5) std::printf("# SCF checkpoint record \"%s\" with %ld Byte restored\n", name, bytes);
+              return 0;
+          } // match
+      } // r
+      warn("SCF checkpoint has no record \"%s\"", name);
+      return -1;
+  } // get
+
+#ifdef    NO_UNIT_TESTS
+  status_t all_tests(int const echo) { return STATUS_TEST_NOT_INCLUDED; }
+#else  // NO_UNIT_TESTS
+
+  status_t test_write_read(int const echo=0) {
+      status_t stat(0);
+      auto const filename = "scf_checkpoint_test.bin";
+      std::vector<double> x(1000);
+      for (size_t i = 0; i < x.size(); ++i) x[i] = 1./(i + 1.);
+      int32_t const n[] = {7, 11, 13};
+      { // scope: write every 2nd iteration in the background
+          writer_t w(filename, 2, echo);
+          for (int it = 0; it < 6; ++it) {
+              if (w.due(it)) {
+                  x[0] = it;
+                  w.add("x", x.data(), x.size()*sizeof(double));
+                  w.add("n", n, 3*sizeof(int32_t));
+                  w.add("empty", nullptr, 0);
+                  stat += w.commit(it);
+                  stat += w.wait(); // make the test deterministic, otherwise due() may skip while busy
+              } // due
+          } // it
+          stat += w.wait();
+      } // scope
+
+      reader_t r;
+      stat += r.read(filename, echo);
+      std::vector<double> y;
+      stat += r.get("x", y);
+      int32_t m[3];
+      stat += r.get("n", m, 3*sizeof(int32_t));
+      stat += (5 != r.scf_iteration());
+      x[0] = 5; // the last checkpoint was written after iteration #5
+      stat += (x != y) + (n[0] != m[0]) + (n[1] != m[1]) + (n[2] != m[2]);
+      stat += (0 != r.bytes("empty")) + (0 != r.bytes("missing"));
+      if (echo > 2) std::printf("# %s: restored %ld values after iteration #%lld\n", __func__, y.size(), (long long)r.scf_iteration());
+
+      { // scope: a truncated file must be rejected
+          auto *const f = std::fopen(filename, "rb");
+          std::vector<char> buffer(sizeof(file_header_t) + 100);
+          auto const nread = std::fread(buffer.data(), 1, buffer.size(), f);
+          std::fclose(f);
+          auto *const g = std::fopen(filename, "wb");
+          std::fwrite(buffer.data(), 1, nread, g);
+          std::fclose(g);
+          reader_t t;
+          stat += (0 == t.read(filename, echo/2));
+      } // scope
+      std::remove(filename);
+      if (echo > 0) std::printf("# %s status= %i\n", __func__, int(stat));
+      return stat;
+  } // test_write_read
+
+  status_t all_tests(int const echo) {
+      status_t stat(0);
+      stat += test_write_read(echo);
+      return stat;
+  } // all_tests
+
+#endif // NO_UNIT_TESTS
+
+} // namespace scf_checkpoint
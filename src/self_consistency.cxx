@@ -9,7 +9,7 @@
 #include "self_consistency.hxx"
 
 #include "display_units.h" // eV, _eV, Ang, _Ang
-#include "inline_math.hxx" // set, pow2, align<nBits>
+#include "inline_math.hxx" // set, pow2, align<nBits>, set_parallel, scale_parallel, add_product_parallel, dot_product_parallel
 #include "constants.hxx" // ::sqrtpi, ::pi
 #include "solid_harmonics.hxx" // ::Y00
 #include "real_space.hxx" // ::grid_t, ::add_function
@@ -23,6 +23,7 @@
 
 #include "geometry_analysis.hxx" // ::read_xyz_file, ::fold_back, length
 #include "simple_timer.hxx" // SimpleTimer
+#include "profiler.hxx" // ::region_t, ::set_iteration
 #include "control.hxx" // ::get, ::set
 
 #include "print_tools.hxx" // print_stats, printf_vector
@@ -43,6 +44,7 @@
 #include "unit_system.hxx" // ::length_unit
 
 #include "poisson_solver.hxx" // ::solve, ::solver_method
+#include "scf_checkpoint.hxx" // ::writer_t, ::reader_t
 
 
 #define   DEBUG
@@ -164,6 +166,56 @@ namespace self_consistency {
   } // get_temperature
 
 
+  double exchange_correlation_on_grid( // returns the exchange-correlation energy sum_i rho_i*exc_i
+        double Vxc[] // result: exchange-correlation potential
+      , double const rho[] // density
+      , size_t const n // number of grid points
+      , double & E_dc // result: double counting sum_i rho_i*Vxc_i
+  ) {
+      // threaded over blocks of fixed size, the partial sums are added in a fixed order,
+      // so the energies do not depend on the number of threads
+      size_t const nblocks = (n + parallel_block - 1)/parallel_block;
+      view2D<double> partial(nblocks, 2, 0.0); // [E_xc, E_dc] per block
+      #pragma omp parallel for schedule(static)
+      for (size_t ib = 0; ib < nblocks; ++ib) {
+          size_t const i0 = ib*parallel_block, i1 = std::min(n, i0 + parallel_block);
+          double exc{0}, edc{0};
+          for (size_t i = i0; i < i1; ++i) {
+              auto const exc_i = exchange_correlation::LDA_kernel(rho[i], Vxc[i]);
+              exc += rho[i]*exc_i;
+              edc += rho[i]*Vxc[i]; // double counting correction
+          } // i
+          partial(ib,0) = exc;
+          partial(ib,1) = edc;
+      } // ib
+      double E_xc{0}; E_dc = 0;
+      for (size_t ib = 0; ib < nblocks; ++ib) {
+          E_xc += partial(ib,0);
+          E_dc += partial(ib,1);
+      } // ib
+      return E_xc;
+  } // exchange_correlation_on_grid
+
+  std::vector<double> data_list_to_vector(data_list<double> const & list) {
+      std::vector<double> v;
+      for (uint32_t i = 0; i < list.nrows(); ++i) {
+          v.insert(v.end(), list[i], list[i] + list.m()[i]);
+      } // i
+      return v;
+  } // data_list_to_vector
+
+  status_t vector_to_data_list(data_list<double> & list, std::vector<double> const & v) {
+      size_t n{0};
+      for (uint32_t i = 0; i < list.nrows(); ++i) n += list.m()[i];
+      if (v.size() != n) return -1; // size mismatch
+      auto const *p = v.data();
+      for (uint32_t i = 0; i < list.nrows(); ++i) {
+          set(list[i], list.m()[i], p);
+          p += list.m()[i];
+      } // i
+      return 0;
+  } // vector_to_data_list
+
   status_t init(
         int const echo // =0 // log-level
       , float const ion // =0.f // ionization between first and last atom
@@ -311,8 +363,9 @@ namespace self_consistency {
       std::vector<float>   ar2(na, 16.f); // with nr2 == 4096 rcut = 15.998 Bohr
       data_list<double> atom_vbar(nr2, 0.0); // zero potentials
       data_list<double> atom_rhoc(nr2, 0.0); // core_densities
+      data_list<double> atom_rhov(nr2, 0.0); // spherical valence densities
 
-      sho_unitary::Unitary_SHO_Transform const unitary(9);
+      auto const & unitary = sho_unitary::get_shared(); // up to numax=9
 
       // allocations of grid quantities
       std::vector<double>  rho(run*g.all()); // [augmented] charge density
@@ -378,47 +431,114 @@ namespace self_consistency {
           if (stat != 0) error("failed to write/create a stop file, status= %i", int(stat));
       } // scope
 
-      for (int scf_iteration = 0; scf_iteration < max_scf_iterations; ++scf_iteration) {
+      float rho_mixing_ratios[] = {.5, .5, .5}; // for spherical {core, semicore, valence} density
+
+      // binary checkpoints of the complete SCF state
+      scf_checkpoint::writer_t checkpoint(control::get("self_consistency.checkpoint.file", "scf_checkpoint.bin"),
+                                     int(control::get("self_consistency.checkpoint.every", 0.)), echo);
+      std::vector<int32_t> n_atom_state(na, 0);
+      stat += single_atom::atom_update("get state", na, 0, n_atom_state.data()); // get only the sizes
+      int32_t const grid_and_atoms[] = {g[0], g[1], g[2], na};
+
+      int scf_start{0};
+      auto const restart_file = control::get("self_consistency.restart", "");
+      if ('\0' != *restart_file) { // scope: resume from an SCF checkpoint
+          scf_checkpoint::reader_t cp;
+          auto rstat = cp.read(restart_file, echo);
+          int32_t grid_and_atoms_read[] = {0, 0, 0, 0};
+          if (0 == rstat) rstat = cp.get("grid_and_atoms", grid_and_atoms_read, 4*sizeof(int32_t));
+          for (int i = 0; i < 4 && 0 == rstat; ++i) {
+              if (grid_and_atoms[i] != grid_and_atoms_read[i]) {
+                  warn("SCF checkpoint \"%s\" was written for a different grid or number of atoms", restart_file);
+                  rstat = -1;
+              } // mismatch
+          } // i
+          // read everything into temporaries first so that a failure leaves the initial state untouched
+          std::vector<double> rho_valence_read, Ves_read, atom_rho_read, atom_state_read, scalars(4, 0.0);
+          data_list<double> atom_state(n_atom_state, 0.0);
+          auto const wave_bytes = KS.wave_function_bytes();
+          char wave_type = KS.wave_function_type(), wave_type_read{'\0'};
+          if (0 == rstat) {
+              rstat += cp.get("scalars", scalars.data(), scalars.size()*sizeof(double), echo);
+              rstat += cp.get("rho_valence", rho_valence_read, echo);
+              rstat += cp.get("Ves", Ves_read, echo);
+              rstat += cp.get("atom_rho", atom_rho_read, echo);
+              rstat += cp.get("atom_state", atom_state_read, echo);
+              rstat += (rho_valence_read.size() != rho_valence.size()) + (Ves_read.size() != Ves.size());
+              rstat += (0 != vector_to_data_list(atom_state, atom_state_read));
+              if (wave_bytes > 0) {
+                  rstat += cp.get("wave_function_type", &wave_type_read, 1, echo);
+                  if (wave_type_read != wave_type) {
+                      warn("SCF checkpoint has wave functions of type '%c' but expected '%c'", wave_type_read, wave_type);
+                      ++rstat;
+                  } // type mismatch
+                  if (wave_bytes != cp.bytes("wave_functions")) {
+                      warn("SCF checkpoint has %ld Byte of wave functions but expected %ld", cp.bytes("wave_functions"), wave_bytes);
+                      ++rstat;
+                  } // size mismatch
+              } // wave functions on a grid
+          } // rstat
+          if (0 == rstat) rstat = vector_to_data_list(atom_rho, atom_rho_read);
+          if (0 == rstat) {
+              set(rho_valence.data(), rho_valence.size(), rho_valence_read.data());
+              set(Ves.data(), Ves.size(), Ves_read.data());
+              if (wave_bytes > 0) rstat += cp.get("wave_functions", KS.wave_function_data(), wave_bytes, echo);
+              take_atomic_valence_densities = scalars[1];
+              density_mixing                = scalars[2];
+              Fermi.set_Fermi_level(scalars[3], echo);
+              // restore the atoms as they were before the density matrix update of the checkpoint iteration and redo it
+              stat += single_atom::atom_update("overwrite state", na, 0, n_atom_state.data(), 0, atom_state.data());
+              stat += single_atom::atom_update("atomic density matrices", na, 0, 0, rho_mixing_ratios, atom_rho.data());
+              stat += single_atom::atom_update("lmax qlm", na, 0, lmax_qlm.data(), &take_atomic_valence_densities);
+              scf_start = cp.scf_iteration() + 1;
+              if (echo > 0) std::printf("# resume from SCF checkpoint \"%s\" at SCF iteration #%i\n", restart_file, scf_start);
+          } else {
+              warn("failed to resume from SCF checkpoint \"%s\", start from scratch", restart_file);
+          } // rstat
+      } // restart
+
+      for (int scf_iteration = scf_start; scf_iteration < max_scf_iterations; ++scf_iteration) {
           SimpleTimer scf_iteration_timer(__FILE__, __LINE__, "scf_iteration", echo);
+          profiler::set_iteration(scf_iteration);
+          profiler::region_t scf_region("scf");
+          bool const checkpoint_due = checkpoint.due(scf_iteration);
           if (echo > 1) std::printf("\n\n# %s\n# SCF-iteration step #%i:\n# %s\n\n", h_line, scf_iteration, h_line);
 
           if (take_atomic_valence_densities > 0) {
               if (echo > 4) print_stats(rho_valence.data(), g.all(), g.dV(), "# previous valence density");
 
               if (echo > 4) std::printf("# compose valence density with %g %% of the atomic valence densities\n", take_atomic_valence_densities*100);
-              scale(rho_valence.data(), g.all(), 1. - take_atomic_valence_densities); // mix old
-              // add contributions from smooth core densities, and optionally spherical valence densities
-              stat += single_atom::atom_update("valence densities", na, 0, nr2.data(), ar2.data(), atom_rhoc.data());
-              stat += potential_generator::add_smooth_quantities(rho_valence.data(), g, na, nr2.data(), ar2.data(),
-                                    center, n_periodic_images, periodic_images, atom_rhoc.data(),
-                                    echo, 0, Y00sq*take_atomic_valence_densities, "smooth valence density");
+              scale_parallel(rho_valence.data(), g.all(), 1. - take_atomic_valence_densities); // mix old
+              stat += single_atom::atom_update("valence densities", na, 0, nr2.data(), ar2.data(), atom_rhov.data());
           } // take_atomic_valence_densities
 
-          if (echo > 4) print_stats(rho_valence.data(), g.all(), g.dV(), "# valence density");
-
-          set(rho.data(), g.all(), rho_valence.data());
+          set_parallel(rho.data(), g.all(), rho_valence.data());
 
           if (echo > 4) print_stats(rho.data(), g.all(), g.dV(), "# density before adding smooth core densities:");
 
           stat += single_atom::atom_update("core densities", na, 0, nr2.data(), ar2.data(), atom_rhoc.data());
           stat += single_atom::atom_update("qlm charges", na, 0, 0, 0, atom_qlm.data());
-          // add contributions from smooth core densities
-          stat += potential_generator::add_smooth_quantities(rho.data(), g, na, nr2.data(), ar2.data(),
-                                center, n_periodic_images, periodic_images, atom_rhoc.data(),
-                                echo, 0, Y00sq, "smooth core density");
+          { // scope: add contributions from smooth core densities, and optionally spherical valence densities,
+            // to rho_valence and rho in a single sweep per atom
+              profiler::region_t region("smooth densities");
+              double const take = Y00sq*take_atomic_valence_densities;
+              double *const values[] = {rho_valence.data(), rho.data(), rho.data()};
+              double const *const *const atom_qnt[] = {atom_rhov.data(), atom_rhov.data(), atom_rhoc.data()};
+              double const factors[] = {take, take, Y00sq};
+              int const iq0 = (take_atomic_valence_densities > 0) ? 0 : 2; // skip the valence densities
+              stat += potential_generator::add_smooth_quantities(3 - iq0, values + iq0, g, na, nr2.data(), ar2.data(),
+                                center, n_periodic_images, periodic_images, atom_qnt + iq0, factors + iq0, echo);
+          } // scope
 
+          if (echo > 4) print_stats(rho_valence.data(), g.all(), g.dV(), "# valence density");
           if (echo > 4) print_stats(rho.data(), g.all(), g.dV(), "# density  after adding smooth core densities:");
 
           here;
 
           { // scope: eval the XC potential and energy
-              double E_xc{0}, E_dc{0};
-              for (size_t i = 0; i < g.all(); ++i) {
-                  auto const exc_i = exchange_correlation::LDA_kernel(rho[i], Vxc[i]);
-                  E_xc += rho[i]*exc_i;
-                  E_dc += rho[i]*Vxc[i]; // double counting correction
-                  // E_dc is computed just for display so we can compare E_dc between grid and atomic[SMT] contributions in calculation with a single atom
-              } // i
+              profiler::region_t region("XC", 3*g.all()*sizeof(double));
+              double E_dc{0}; // E_dc is computed just for display so we can compare E_dc between grid and atomic[SMT] contributions in calculation with a single atom
+              double E_xc = exchange_correlation_on_grid(Vxc.data(), rho.data(), g.all(), E_dc);
               E_xc *= g.dV(); E_dc *= g.dV(); // scale with volume element
               if (echo > 2) std::printf("# exchange-correlation energy on grid %.9f %s, double counting %.9f %s\n", E_xc*eV,_eV, E_dc*eV,_eV);
               grid_xc_energy = E_xc;
@@ -426,8 +546,9 @@ namespace self_consistency {
 
           here;
 
-          set(cmp.data(), g.all(), 0.0); // init compensation charge density, contains a smooth proton density and charge deficit compensators
+          set_parallel(cmp.data(), g.all(), 0.0); // init compensation charge density, contains a smooth proton density and charge deficit compensators
           { // scope: solve the Poisson equation
+              profiler::region_t region_es("electrostatics");
 
               // add compensation charges cmp
               for (int ia = 0; ia < na; ++ia) {
@@ -442,16 +563,16 @@ namespace self_consistency {
 //                    if (echo > 7) std::printf("# before SHO-adding compensators for atom #%i coeff[000] = %g\n", ia, coeff[0]);
 #endif // DEVEL
                   } // factorizable
-                  for (int ii = 0; ii < n_periodic_images; ++ii) {
-                      double cnt[3]; set(cnt, 3, center[ia]); add_product(cnt, 3, periodic_images[ii], 1.0);
-                      if ('f' == compensator_method) { // "factorizable"
-                          stat += sho_projection::sho_add(cmp.data(), g, coeff.data(), ellmax, cnt, sigma, 0);
-                      } else {
+                  if ('f' == compensator_method) { // "factorizable"
+                      stat += sho_projection::sho_add_images(cmp.data(), g, coeff.data(), ellmax, center[ia], sigma, n_periodic_images, periodic_images);
+                  } else {
+                      for (int ii = 0; ii < n_periodic_images; ++ii) {
+                          double cnt[3]; set(cnt, 3, center[ia]); add_product(cnt, 3, periodic_images[ii], 1.0);
                           stat += potential_generator::add_generalized_Gaussian(cmp.data(), g, atom_qlm[ia], ellmax, cnt, sigma, echo);
 //                           double const one[] = {1};
 //                           stat += potential_generator::add_generalized_Gaussian(cmp.data(), g, one, 0, cnt, sigma, echo);
-                      }
-                  } // periodic images
+                      } // periodic images
+                  } // compensator_method
 #ifdef    DEVEL
                   if (echo > 6) { // report extremal values of the density on the grid
                       std::printf("# after adding %g electrons compensator density for atom #%i:", atom_qlm[ia][00]*Y00inv, ia);
@@ -461,11 +582,12 @@ namespace self_consistency {
               } // ia
 
               // add compensators cmp to rho, so now rho == rho_aug
-              add_product(rho.data(), g.all(), cmp.data(), 1.);
+              add_product_parallel(rho.data(), g.all(), cmp.data(), 1.);
               if (echo > 1) print_stats(rho.data(), g.all(), g.dV(), "\n# augmented charge density:");
 
               { // scope: solve the Poisson equation: Laplace Ves == -4 pi rho
 //                SimpleTimer timer(__FILE__, __LINE__, "Poisson equation", echo);
+                  profiler::region_t region("Poisson");
                   if (echo > 3) std::printf("\n\n# %s\n# Solve Poisson equation\n# %s\n\n", h_line, h_line);
                   stat += poisson_solver::solve(Ves.data(), rho.data(), g, es_solver_method, echo, (na > 0)?center[0]:nullptr);
               } // scope
@@ -477,13 +599,9 @@ namespace self_consistency {
                   int    const ellmax = lmax_vlm[ia];
                   int const nc = sho_tools::nSHO(ellmax);
                   std::vector<double> coeff(nc, 0.0);
-                  for (int ii = 0; ii < n_periodic_images; ++ii) {
-                      std::vector<double> coeff_image(nc, 0.0);
-                      double cnt[3]; set(cnt, 3, center[ia]); add_product(cnt, 3, periodic_images[ii], 1.0);
-                      stat += sho_projection::sho_project(coeff_image.data(), ellmax, cnt, sigma, Ves.data(), g, 0);
-                      // alternative to projecting Ves we could use Vtot (constructed later) but we need consistency with the operations inside the spheres
-                      add_product(coeff.data(), nc, coeff_image.data(), 1.0); // need phase factors? no since we only test the electrostatic
-                  } // periodic images
+                  // sum of the projections of all periodic images, no phase factors needed since we only test the electrostatic
+                  stat += sho_projection::sho_project_images(coeff.data(), ellmax, center[ia], sigma, Ves.data(), g, n_periodic_images, periodic_images);
+                  // alternative to projecting Ves we could use Vtot (constructed later) but we need consistency with the operations inside the spheres
                   // SHO-projectors are brought to the grid unnormalized, i.e. p_{000}(0) = 1.0 and p_{200}(0) = -.5
 
                   stat += sho_projection::renormalize_electrostatics(atom_vlm[ia], coeff.data(), ellmax, sigma, unitary, echo);
@@ -503,7 +621,7 @@ namespace self_consistency {
               } // ia
 
 
-              double const E_es = 0.5*dot_product(g.all(), rho.data(), Ves.data())*g.dV();
+              double const E_es = 0.5*dot_product_parallel(g.all(), rho.data(), Ves.data())*g.dV();
               grid_electrostatic_energy = E_es; // store
               if (echo > 3) std::printf("# smooth electrostatic grid energy %.9f %s\n", E_es*eV,_eV);
 
@@ -517,14 +635,16 @@ namespace self_consistency {
           stat += single_atom::atom_update("hamiltonian", na, 0, 0, 0, atom_mat.data());
           stat += single_atom::atom_update("zero potentials", na, 0, nr2.data(), ar2.data(), atom_vbar.data());
 
-          set(Vtot.data(), g.all(), Vxc.data()); add_product(Vtot.data(), g.all(), Ves.data(), 1.);
+          set_parallel(Vtot.data(), g.all(), Vxc.data()); add_product_parallel(Vtot.data(), g.all(), Ves.data(), 1.);
 
           if (echo > 1) print_stats(Vtot.data(), g.all(), 0, "\n# Total effective potential (before adding zero potentials)", eV, _eV);
 
-          // now also add the zero potential vbar to Vtot
-          stat += potential_generator::add_smooth_quantities(Vtot.data(), g, na, nr2.data(), ar2.data(),
-                                center, n_periodic_images, periodic_images, atom_vbar.data(),
-                                echo, 0, Y00, "zero potential");
+          { // scope: now also add the zero potential vbar to Vtot
+              profiler::region_t region("zero potentials");
+              stat += potential_generator::add_smooth_quantities(Vtot.data(), g, na, nr2.data(), ar2.data(),
+                                    center, n_periodic_images, periodic_images, atom_vbar.data(),
+                                    echo, 0, Y00, "zero potential");
+          } // scope
 
           if (echo > 1) print_stats(Vtot.data(), g.all(), 0, "\n# Total effective potential  (after adding zero potentials)", eV, _eV);
           here;
@@ -539,6 +659,7 @@ namespace self_consistency {
 
           { // scope: solve the Kohn-Sham equation with the given Hamiltonian
               SimpleTimer KS_timer(__FILE__, __LINE__, "solving KS-equation", echo);
+              profiler::region_t region("Kohn-Sham");
 
 #ifdef    DEVEL
               if (echo > 0) {
@@ -564,8 +685,8 @@ namespace self_consistency {
               if (charges[0] > 0 && std::abs(charges[0] - 1.0) > 1e-15) {
                   double const renormalization_factor = 1./charges[0];
                   if (echo > 2) std::printf("# %s: renormalize density and density matrices by %.15f\n", __func__, renormalization_factor);
-                  scale(rho_valence_new[0], g.all(), renormalization_factor);
-                  scale(rho_valence_new[1], g.all(), renormalization_factor);
+                  scale_parallel(rho_valence_new[0], g.all(), renormalization_factor);
+                  scale_parallel(rho_valence_new[1], g.all(), renormalization_factor);
                   for (int ia = 0; ia < na; ++ia) {
                       scale(atom_rho_new[0][ia], n_atom_rho[ia], renormalization_factor);
                       scale(atom_rho_new[1][ia], n_atom_rho[ia], renormalization_factor);
@@ -582,7 +703,7 @@ namespace self_consistency {
                       double const alpha = (Fermi.get_n_electrons() - charges[1]) / charges[2];
                       if (echo > 1) std::printf("# shift Fermi level by %g %s\n", alpha*eV, _eV);
                       // correct by energy difference alpha
-                      add_product(rho_valence_new[0], g.all(), rho_valence_new[1], alpha);
+                      add_product_parallel(rho_valence_new[0], g.all(), rho_valence_new[1], alpha);
                       for (int ia = 0; ia < na; ++ia) {
                           add_product(atom_rho_new[0][ia], n_atom_rho[ia], atom_rho_new[1][ia], alpha);
                       } // ia
@@ -603,7 +724,7 @@ namespace self_consistency {
               if (echo > 1) std::printf("\n# sum of eigenvalues %.9f %s\n\n", band_energy_sum*eV, _eV);
               // in order to compute the kinetic energy of valence states, we need to subtract
               // the expectation value of the potential which consists of two parts: the grid part
-              double_counting_correction = dot_product(g.all(), rho_valence_new[0], Vtot.data()) * g.dV();
+              double_counting_correction = dot_product_parallel(g.all(), rho_valence_new[0], Vtot.data()) * g.dV();
               if (echo > 1) std::printf("\n# grid double counting %.9f %s\n\n", double_counting_correction*eV, _eV);
               // and the atom part: for each atom sum_ij D_ij v_ij where v_ij + t_ij = h_ij,
               // with h_ij being the atomic non-local correction to the Hamiltonian
@@ -615,8 +736,8 @@ namespace self_consistency {
 
               // valence density mixing
               double const mix_old = 1 - density_mixing;
-              scale(rho_valence.data(), g.all(), mix_old); // mix old
-              add_product(rho_valence.data(), g.all(), rho_valence_new[0], density_mixing); // mix new
+              scale_parallel(rho_valence.data(), g.all(), mix_old); // mix old
+              add_product_parallel(rho_valence.data(), g.all(), rho_valence_new[0], density_mixing); // mix new
               // valence density matrix mixing
               for (int ia = 0; ia < na; ++ia) {
                   scale(atom_rho[ia], n_atom_rho[ia], mix_old); // mix old
@@ -626,7 +747,15 @@ namespace self_consistency {
 
           } // scope: Kohn-Sham
 
-          float rho_mixing_ratios[] = {.5, .5, .5}; // for spherical {core, semicore, valence} density
+          if (checkpoint_due) { // the atom state is taken before the update, a restart repeats the update
+              data_list<double> atom_state(n_atom_state, 0.0);
+              stat += single_atom::atom_update("get state", na, 0, n_atom_state.data(), 0, atom_state.data());
+              auto const atom_state_vector = data_list_to_vector(atom_state);
+              auto const atom_rho_vector = data_list_to_vector(atom_rho);
+              checkpoint.add("atom_state", atom_state_vector.data(), atom_state_vector.size()*sizeof(double));
+              checkpoint.add("atom_rho", atom_rho_vector.data(), atom_rho_vector.size()*sizeof(double));
+          } // checkpoint_due
+
           stat += single_atom::atom_update("atomic density matrices", na, 0, 0, rho_mixing_ratios, atom_rho.data());
 
 
@@ -708,7 +837,24 @@ namespace self_consistency {
           } // scope
           density_mixing = density_mixing_fixed;
 
+          if (checkpoint_due) {
+              double const scalars[] = {double(scf_iteration), take_atomic_valence_densities, density_mixing, Fermi.get_Fermi_level()};
+              checkpoint.add("grid_and_atoms", grid_and_atoms, 4*sizeof(int32_t));
+              checkpoint.add("scalars", scalars, 4*sizeof(double));
+              checkpoint.add("rho_valence", rho_valence.data(), rho_valence.size()*sizeof(double));
+              checkpoint.add("Ves", Ves.data(), Ves.size()*sizeof(double));
+              auto const wave_bytes = KS.wave_function_bytes();
+              if (wave_bytes > 0) {
+                  char const wave_type = KS.wave_function_type();
+                  checkpoint.add("wave_function_type", &wave_type, 1);
+                  checkpoint.add("wave_functions", KS.wave_function_data(), wave_bytes);
+              } // wave functions on a grid
+              stat += checkpoint.commit(scf_iteration); // the file is written in the background
+          } // checkpoint_due
+
       } // scf_iteration
+      stat += checkpoint.wait();
+      profiler::set_iteration(-1);
 
       here;
 
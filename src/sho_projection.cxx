@@ -5,12 +5,18 @@
 #include <algorithm> // std::copy, ::fill
 #include <cmath> // std::floor
 #include <vector> // std::vector<T>
+#include <complex> // std::complex<real_t>
 
 #include "sho_projection.hxx"
 
 #include "inline_math.hxx" // pow2
 #include "sho_unitary.hxx" // ::Unitary_SHO_Transform<real_t>
 #include "solid_harmonics.hxx" // ::rlXlm, ::cleanup<real_t>
+#include "simple_timer.hxx" // SimpleTimer
+#include "control.hxx" // ::get
+#include "data_view.hxx" // view2D<T>
+#include "boundary_condition.hxx" // ::periodic_images
+#include "complex_tools.hxx" // to_complex_t, complex_name
 
 namespace sho_projection {
 
@@ -208,12 +214,141 @@ namespace sho_projection {
       return (dev > 1e-12);
   } // test_L2_prefactors
 
+  template <typename complex_t>
+  status_t test_sum_factorization(int const echo=2, double const sigma=1.05) {
+      // compare the sum-factorized implementation with the reference and measure both
+      int const numax_from = control::get("sho_projection.benchmark.numax.from", 3.);
+      int const numax_to   = control::get("sho_projection.benchmark.numax.to",   9.);
+      int const repeat     = control::get("sho_projection.benchmark.repeat",     1.);
+      using real_t = decltype(std::real(complex_t(1)));
+      if (echo > 0) std::printf("\n# %s<%s> for numax= %d ... %d\n", __func__, (8 == sizeof(complex_t))?"double":
+                  ((16 == sizeof(complex_t))?"complex<double>":"float"), numax_from, numax_to);
+      int const dims[] = {42, 41, 40};
+      real_space::grid_t g(dims);
+      g.set_grid_spacing(0.472432); // 0.25 Angstrom
+      double const pos[] = {g[0]*.52*g.h[0], g[1]*.51*g.h[1], g[2]*.50*g.h[2]};
+      std::vector<complex_t> values[2];
+      status_t stat(0);
+      double maxdev_all{0};
+      for (int numax = numax_from; numax <= numax_to; ++numax) {
+          int const nSHO = sho_tools::nSHO(numax);
+          std::vector<complex_t> coeff_in(nSHO), coeff[2];
+          for (int iSHO = 0; iSHO < nSHO; ++iSHO) { coeff_in[iSHO] = complex_t(std::cos(1.7*iSHO)); } // some values
+          double time[2][2]; // [project0_or_add1][reference0_or_factorized1]
+          for (int sf = 0; sf < 2; ++sf) {
+              values[sf].assign(g.all(), complex_t(0));
+              coeff[sf].assign(nSHO, complex_t(0));
+              { // scope: add
+                  SimpleTimer timer(__FILE__, __LINE__, __func__, 0);
+                  for (int irep = 0; irep < repeat; ++irep) {
+                      stat += sf ? _sho_project_or_add<complex_t,1,true >(coeff_in.data(), numax, pos, sigma, values[sf].data(), g, 0)
+                                 : _sho_project_or_add<complex_t,1,false>(coeff_in.data(), numax, pos, sigma, values[sf].data(), g, 0);
+                  } // irep
+                  time[1][sf] = timer.stop()/repeat;
+              } // scope
+              { // scope: project
+                  SimpleTimer timer(__FILE__, __LINE__, __func__, 0);
+                  for (int irep = 0; irep < repeat; ++irep) {
+                      stat += sf ? _sho_project_or_add<complex_t,0,true >(coeff[sf].data(), numax, pos, sigma, values[sf].data(), g, 0)
+                                 : _sho_project_or_add<complex_t,0,false>(coeff[sf].data(), numax, pos, sigma, values[sf].data(), g, 0);
+                  } // irep
+                  time[0][sf] = timer.stop()/repeat;
+              } // scope
+          } // sf
+          double maxdev[2] = {0, 0}, maxval[2] = {0, 0}; // [project0_or_add1]
+          for (size_t i = 0; i < g.all(); ++i) {
+              maxdev[1] = std::max(maxdev[1], double(std::abs(values[1][i] - values[0][i])));
+              maxval[1] = std::max(maxval[1], double(std::abs(values[0][i])));
+          } // i
+          for (int iSHO = 0; iSHO < nSHO; ++iSHO) {
+              maxdev[0] = std::max(maxdev[0], double(std::abs(coeff[1][iSHO] - coeff[0][iSHO])));
+              maxval[0] = std::max(maxval[0], double(std::abs(coeff[0][iSHO])));
+          } // iSHO
+          for (int pa = 0; pa < 2; ++pa) {
+              auto const reldev = maxdev[pa]/std::max(maxval[pa], 1e-300);
+              maxdev_all = std::max(maxdev_all, reldev);
+              if (echo > 2) std::printf("# %s numax= %d %-7s reference %.6f sec, sum-factorized %.6f sec, speedup %.1f, rel. deviation %.1e\n",
+                  __func__, numax, pa?"add":"project", time[pa][0], time[pa][1], time[pa][0]/std::max(time[pa][1], 1e-9), reldev);
+          } // pa
+      } // numax
+      if (echo > 0) std::printf("# %s: max relative deviation %.1e\n", __func__, maxdev_all);
+      return stat + (maxdev_all > ((sizeof(real_t) > 4) ? 1e-12 : 1e-4));
+  } // test_sum_factorization
+
+  template <typename complex_t>
+  status_t test_periodic_images(int const echo=2, int const numax=4, double const sigma=1.05) {
+      // compare the image-set functions with one call per periodic image
+      if (echo > 0) std::printf("\n# %s<%s>\n", __func__, complex_name<complex_t>());
+      int const dims[] = {10, 12, 14};
+      int8_t const bc[] = {Periodic_Boundary, Periodic_Boundary, Isolated_Boundary};
+      double const h = 0.472432, cell[3][4] = {{dims[0]*h, 0, 0, 0}, {0, dims[1]*h, 0, 0}, {0, 0, dims[2]*h, 0}};
+      real_space::grid_t g(dims);
+      g.set_boundary_conditions(bc);
+      g.set_cell_shape(cell); // small periodic cell, many images contribute
+      double const pos[] = {g[0]*.3*g.h[0], g[1]*.8*g.h[1], g[2]*.5*g.h[2]};
+      view2D<double> image_shifts;
+      view2D<int8_t> image_index;
+      int const n_images = boundary_condition::periodic_images(image_shifts, g.cell, bc, truncation_radius(sigma), echo/4, &image_index);
+      double const kv[] = {.25, -.125, 0}; // Bloch vector in units of the reciprocal lattice vectors
+      std::vector<complex_t> phase(n_images), inv_phase(n_images);
+      for (int ii = 0; ii < n_images; ++ii) {
+          double arg{0}; for (int d = 0; d < 3; ++d) { arg += 2*constants::pi*kv[d]*image_index(ii,d); }
+          phase[ii]     = to_complex_t<complex_t,double>(std::polar(1.0,  arg)); // only the real part for complex_t==double
+          inv_phase[ii] = to_complex_t<complex_t,double>(std::polar(1.0, -arg));
+      } // ii
+      int const nSHO = sho_tools::nSHO(numax);
+      std::vector<complex_t> coeff_in(nSHO), coeff[2];
+      for (int iSHO = 0; iSHO < nSHO; ++iSHO) { coeff_in[iSHO] = complex_t(std::cos(1.7*iSHO)); } // some values
+      std::vector<complex_t> values[2];
+      status_t stat(0);
+      double time[2]; // [per_image0_or_fused1]
+      for (int fused = 0; fused < 2; ++fused) {
+          values[fused].assign(g.all(), complex_t(0));
+          coeff[fused].assign(nSHO, complex_t(0));
+          SimpleTimer timer(__FILE__, __LINE__, __func__, 0);
+          if (fused) {
+              stat += sho_add_images(values[fused].data(), g, coeff_in.data(), numax, pos, sigma, n_images, image_shifts, inv_phase.data(), echo);
+              stat += sho_project_images(coeff[fused].data(), numax, pos, sigma, values[fused].data(), g, n_images, image_shifts, phase.data(), echo);
+          } else {
+              std::vector<complex_t> coeff_image(nSHO);
+              for (int ii = 0; ii < n_images; ++ii) {
+                  double cnt[3]; set(cnt, 3, pos); add_product(cnt, 3, image_shifts[ii], 1.0);
+                  set(coeff_image.data(), nSHO, coeff_in.data(), inv_phase[ii]);
+                  stat += sho_add(values[fused].data(), g, coeff_image.data(), numax, cnt, sigma);
+              } // ii
+              for (int ii = 0; ii < n_images; ++ii) {
+                  double cnt[3]; set(cnt, 3, pos); add_product(cnt, 3, image_shifts[ii], 1.0);
+                  stat += sho_project(coeff_image.data(), numax, cnt, sigma, values[fused].data(), g);
+                  add_product(coeff[fused].data(), nSHO, coeff_image.data(), phase[ii]);
+              } // ii
+          } // fused
+          time[fused] = timer.stop();
+      } // fused
+      double maxdev[2] = {0, 0}, maxval[2] = {0, 0}; // [project0_or_add1]
+      for (size_t i = 0; i < g.all(); ++i) {
+          maxdev[1] = std::max(maxdev[1], double(std::abs(values[1][i] - values[0][i])));
+          maxval[1] = std::max(maxval[1], double(std::abs(values[0][i])));
+      } // i
+      for (int iSHO = 0; iSHO < nSHO; ++iSHO) {
+          maxdev[0] = std::max(maxdev[0], double(std::abs(coeff[1][iSHO] - coeff[0][iSHO])));
+          maxval[0] = std::max(maxval[0], double(std::abs(coeff[0][iSHO])));
+      } // iSHO
+      double const reldev = std::max(maxdev[0]/std::max(maxval[0], 1e-300), maxdev[1]/std::max(maxval[1], 1e-300));
+      if (echo > 2) std::printf("# %s %d images, per image %.6f sec, fused %.6f sec, speedup %.1f, rel. deviation %.1e\n",
+                                  __func__, n_images, time[0], time[1], time[0]/std::max(time[1], 1e-9), reldev);
+      return stat + (reldev > 1e-10); // phase factors lead to some cancellation in the projection
+  } // test_periodic_images
+
   status_t all_tests(int const echo) {
       status_t stat(0);
       stat += test_L2_prefactors(echo);
       stat += test_renormalize_electrostatics(echo);
       stat += test_L2_orthogonality<double>(echo); // takes a while
 //    stat += test_L2_orthogonality<float>(echo);
+      stat += test_sum_factorization<double>(echo);
+      stat += test_sum_factorization<std::complex<double>>(echo);
+      stat += test_periodic_images<double>(echo);
+      stat += test_periodic_images<std::complex<double>>(echo);
       return stat;
   } // all_tests
 
@@ -16,6 +16,8 @@
 
 #include "sho_tools.hxx" // ...
 #include "recorded_warnings.hxx" // warn
+#include "control.hxx" // ::get
+#include "sho_unitary_table.h" // sho_unitary_table[], sho_unitary_entry_t
 
 namespace sho_unitary {
 
@@ -103,6 +105,29 @@ namespace sho_unitary {
       return 0;
   } // read_unitary_matrix_from_file
 
+  status_t set_unitary_matrix_from_table(
+        double *const *const u
+      , int const numax
+      , int &nu_high
+      , int const echo=0
+  ) {
+      // same as read_unitary_matrix_from_file but with the compiled-in entries of data/sho_unitary.dat
+      for (int i = 0; i < sho_unitary_table_size; ++i) {
+          auto const & e = sho_unitary_table[i];
+          int const nu = sho_tools::get_nu(e.nx, e.ny, e.nz);
+          assert(nu == sho_tools::get_nu(e.ell, e.nrn));
+          nu_high = std::max(nu_high, nu);
+          if (nu > numax) break; // the table is nu-ordered
+          int const nzyx = sho_tools::Ezyx_index(e.nx, e.ny, e.nz);
+          int const nlnm = sho_tools::Elnm_index(e.ell, e.nrn, e.emm);
+          int const nb = sho_tools::n2HO(nu); // dimension of block
+          int const ioff = sho_tools::nSHO(nu - 1); // offset from previous blocks
+          u[nu][(nzyx - ioff)*nb + (nlnm - ioff)] = signed_sqrt(e.nom/double(e.den)); // set the entry
+      } // i
+      if (echo > 5) std::printf("# %s: compiled-in entries up to nu=%d, requested %d\n", __func__, nu_high, numax);
+      return 0;
+  } // set_unitary_matrix_from_table
+
       Unitary_SHO_Transform::Unitary_SHO_Transform(int const lmax, int const echo) // constructor
         : numax_(lmax)
       {
@@ -115,7 +140,10 @@ namespace sho_unitary {
           } // nu
 
           int highest_nu{-1};
-          auto const stat = read_unitary_matrix_from_file(u_, numax_, highest_nu);
+          // by default, no file is needed, +sho_unitary.file=sho_unitary.dat reads the entries from file
+          auto const filename = control::get("sho_unitary.file", "");
+          auto const stat = ('\0' == *filename) ? set_unitary_matrix_from_table(u_, numax_, highest_nu, echo)
+                                                : read_unitary_matrix_from_file(u_, numax_, highest_nu, filename, echo);
           if (stat) { // an error has occured while reading it from file
               for (int nu = 0; nu <= numax_; ++nu) { // run serial forward
                   int const nb = sho_tools::n2HO(nu); // dimension of block
@@ -127,10 +155,15 @@ namespace sho_unitary {
               warn("I/O failed with status=%i, Unitary_SHO_Transform was initialized as unit operator!", int(stat));
           } // stat
           if (highest_nu < numax_) {
-              warn("file for Unitary_SHO_Transform provided elements only up to numax=%d, requested %d", highest_nu, numax_);
+              warn("Unitary_SHO_Transform has elements only up to numax=%d, requested %d", highest_nu, numax_);
           } // warn
       } // constructor
-    
+
+  Unitary_SHO_Transform const & get_shared() {
+      static Unitary_SHO_Transform const shared(sho_unitary_table_numax, 0); // thread-safe initialization since C++11
+      return shared;
+  } // get_shared
+
       double Unitary_SHO_Transform::get_entry(int const nzyx, int const nlnm) const
       { // input must both be energy ordered indices
           int const nu = sho_tools::get_nu(nzyx);
@@ -398,6 +431,33 @@ namespace sho_unitary {
       return (dev > 2e-7); // error if deviations are too large
   } // test_loading
 
+  status_t test_table_vs_file(int const echo=1, int const numax=9) {
+      // compare the compiled-in table with the entries read from file, if the file is present
+      std::vector<double*> u_table(1 + numax), u_file(1 + numax);
+      std::vector<std::vector<double>> blocks(2*(1 + numax)); // memory for the blocks
+      for (int nu = 0; nu <= numax; ++nu) {
+          blocks[2*nu + 0].assign(sho_tools::n2HO(nu)*sho_tools::n2HO(nu), 0.0); u_table[nu] = blocks[2*nu + 0].data();
+          blocks[2*nu + 1].assign(sho_tools::n2HO(nu)*sho_tools::n2HO(nu), 0.0); u_file[nu]  = blocks[2*nu + 1].data();
+      } // nu
+      int nu_high_table{-1}, nu_high_file{-1};
+      set_unitary_matrix_from_table(u_table.data(), numax, nu_high_table, echo);
+      std::FILE *const f = std::fopen("sho_unitary.dat", "r");
+      if (nullptr == f) {
+          if (echo > 2) std::printf("# %s: file sho_unitary.dat not found, skip the comparison\n", __func__);
+          return 0;
+      } // no file
+      std::fclose(f);
+      auto const stat = read_unitary_matrix_from_file(u_file.data(), numax, nu_high_file, "sho_unitary.dat", echo/2);
+      double maxdev{0};
+      for (int nu = 0; nu <= numax; ++nu) {
+          for (int ij = 0; ij < sho_tools::n2HO(nu)*sho_tools::n2HO(nu); ++ij) {
+              maxdev = std::max(maxdev, std::abs(u_table[nu][ij] - u_file[nu][ij]));
+          } // ij
+      } // nu
+      if (echo > 2) std::printf("# %s: largest deviation between compiled-in table and file is %.1e\n", __func__, maxdev);
+      return stat + (maxdev > 0) + (nu_high_table != nu_high_file);
+  } // test_table_vs_file
+
   status_t test_vector_transform(int const echo=9, int const numax=3) {
       sho_unitary::Unitary_SHO_Transform U(numax);
       if (echo > 3) std::printf("\n# %s %s(numax=%i, echo=%i)\n", __FILE__, __func__, numax, echo);
@@ -411,6 +471,7 @@ namespace sho_unitary {
       status_t stat(0);
       stat += test_generation(echo);
       stat += test_loading(echo);
+      stat += test_table_vs_file(echo);
       stat += test_vector_transform(echo);
       return stat;
   } // all_tests
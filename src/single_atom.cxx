@@ -37,6 +37,7 @@
 #include "display_units.h" // eV, _eV, Ang, _Ang
 #include "unit_system.hxx" // ::energy_unit, ::_Rydberg
 #include "simple_timer.hxx" // SimpleTimer
+#include "profiler.hxx" // ::region_t
 #include "bessel_transform.hxx" // ::transform_to_r2grid
 #include "scattering_test.hxx" // ::eigenstate_analysis, ::logarithmic_derivative, ::emm_average, ::expand_sho_projectors
 #include "linear_algebra.hxx" // ::eigenvalues
@@ -927,10 +928,16 @@ namespace single_atom {
         overlap        = view2D<double>(nSHO, matrix_stride, 0.0); // get memory
 
         unitary_zyx_lmn = view2D<double>(nSHO, nSHO, 0.0);
-        { // scope: fill the Unitary_SHO_Transform with values from a file
-            sho_unitary::Unitary_SHO_Transform const u(numax);
-            auto const stat = u.construct_dense_matrix(unitary_zyx_lmn.data(), numax, nSHO, sho_tools::order_zyx, sho_tools::order_lmn);
-            assert(0 == int(stat));
+        { // scope: fill with values from the shared Unitary_SHO_Transform, no file I/O
+            auto const & shared = sho_unitary::get_shared();
+            if (numax <= shared.numax()) {
+                auto const stat = shared.construct_dense_matrix(unitary_zyx_lmn.data(), numax, nSHO, sho_tools::order_zyx, sho_tools::order_lmn);
+                assert(0 == int(stat));
+            } else { // beyond the compiled-in table, a private instance warns about missing elements as before
+                sho_unitary::Unitary_SHO_Transform const u(numax);
+                auto const stat = u.construct_dense_matrix(unitary_zyx_lmn.data(), numax, nSHO, sho_tools::order_zyx, sho_tools::order_lmn);
+                assert(0 == int(stat));
+            } // numax
         } // scope
 
         int const mlm = pow2(1 + numax);
@@ -1392,10 +1399,16 @@ namespace single_atom {
         overlap        = view2D<double>(nSHO, matrix_stride, 0.0); // get memory
 
         unitary_zyx_lmn = view2D<double>(nSHO, nSHO, 0.0);
-        { // scope: fill the Unitary_SHO_Transform with values from a file
-            sho_unitary::Unitary_SHO_Transform const u(numax);
-            auto const stat = u.construct_dense_matrix(unitary_zyx_lmn.data(), numax, nSHO, sho_tools::order_zyx, sho_tools::order_lmn);
-            assert(0 == int(stat));
+        { // scope: fill with values from the shared Unitary_SHO_Transform, no file I/O
+            auto const & shared = sho_unitary::get_shared();
+            if (numax <= shared.numax()) {
+                auto const stat = shared.construct_dense_matrix(unitary_zyx_lmn.data(), numax, nSHO, sho_tools::order_zyx, sho_tools::order_lmn);
+                assert(0 == int(stat));
+            } else { // beyond the compiled-in table, a private instance warns about missing elements as before
+                sho_unitary::Unitary_SHO_Transform const u(numax);
+                auto const stat = u.construct_dense_matrix(unitary_zyx_lmn.data(), numax, nSHO, sho_tools::order_zyx, sho_tools::order_lmn);
+                assert(0 == int(stat));
+            } // numax
         } // scope
 
         int const mlm = pow2(1 + numax);
@@ -3239,10 +3252,12 @@ namespace single_atom {
                 } // ip
                 // transform back to lm-index
                 assert(full_potential[ts].stride() == mr);
-                stat += angular_grid::transform(full_potential[ts].data(), vxc_on_grid, mr, ellmax_pot, true);
                 { // scope: transform also the exchange-correlation energy density
                     view2D<double> exc_lm(nlm, mr);
-                    stat += angular_grid::transform(exc_lm.data(), exc_on_grid, mr, ellmax_rho, true);
+                    double *const lm_out[] = {full_potential[ts].data(), exc_lm.data()};
+                    double const *const grid_in[] = {vxc_on_grid, exc_on_grid};
+                    int const strides[] = {int(mr), int(mr)};
+                    stat += angular_grid::transform(lm_out, grid_in, 2, strides, ellmax_pot, true); // both in one matrix-matrix multiplication
                     if (SMT == ts) {
                         if (echo > 7) std::printf("# %s local smooth exchange-correlation potential at origin is %g %s\n",
                                                             label, full_potential[SMT](00,0)*Y00*eV,_eV);
@@ -3858,7 +3873,7 @@ namespace single_atom {
             double const *const rV[TRU_AND_SMT] = {potential[TRU].data(), potential[SMT].data()};
             scattering_test::logarithmic_derivative( // scan the logarithmic derivatives
                 rg, rV, sigma, int(numax + 1), numax, hamiltonian_ln.data(), overlap_ln.data(),
-                logder_energy_range, label, echo);
+                logder_energy_range, label, echo, 6.f, int(control::get("logder.refine", 0.)));
             if (echo > 0) std::fflush(stdout);
         } // echo
 
@@ -3974,6 +3989,38 @@ namespace single_atom {
         perturbation_theory(echo);
     } // update_potential
 
+    size_t get_state_size() const {
+        // the spherical potentials r*V(r), the spherical densities, the spherical state energies,
+        // the hamiltonian matrix and take_spherical_density determine the next update_density call
+        return 4*(rg[TRU].n + rg[SMT].n) + spherical_state.size() + pow2(sho_tools::nSHO(numax)) + 3;
+    } // get_state_size
+
+    void get_or_set_state(double state[], bool const set_state) {
+        // export or import the state needed to resume the SCF iterations
+        double *p = state;
+        for (int ts = TRU; ts < TRU_AND_SMT; ++ts) {
+            int const nr = rg[ts].n;
+            if (set_state) set(potential[ts].data(), nr, p); else set(p, nr, potential[ts].data());
+            p += nr;
+            for (int csv = 0; csv < 3; ++csv) {
+                if (set_state) set(spherical_density[ts][csv], nr, p); else set(p, nr, spherical_density[ts][csv]);
+                p += nr;
+            } // csv
+        } // ts
+        for (auto & cs : spherical_state) {
+            if (set_state) cs.energy = *p; else *p = cs.energy;
+            ++p;
+        } // cs
+        int const nSHO = sho_tools::nSHO(numax);
+        for (int i = 0; i < nSHO; ++i) { // the hamiltonian enters energy_dm
+            if (set_state) set(hamiltonian[i], nSHO, p); else set(p, nSHO, hamiltonian[i]);
+            p += nSHO;
+        } // i
+        if (set_state) set(take_spherical_density, 3, p); else set(p, 3, take_spherical_density);
+        p += 3;
+        assert(get_state_size() == p - state);
+    } // get_or_set_state
+
     double get_total_energy(
           double E[]=nullptr
     ) const {
@@ -4366,6 +4413,8 @@ namespace single_atom {
           case str2int("zero potentials"):
           case str2int("atomic density matrices"):
           case str2int("radial grids"):
+          case str2int("get state"):
+          case str2int("overwrite state"):
             if (echo > 0) std::printf("# %s found selector what=\"%s\".\n", __func__, what);
           break; default:
             if (echo > 0) std::printf("# %s unknown selector what=\"%s\"!\n", __func__, what);
@@ -4405,6 +4454,8 @@ namespace single_atom {
       int na{natoms};
       if (na < 1) return 0; // no work
 
+      profiler::region_t region_atom_update("atom_update"), region_what(what); // the selector is a sub-region
+
       status_t stat(0);
       stat += test_string_switch(what); // muted
 
@@ -4607,6 +4658,29 @@ namespace single_atom {
           }
           break;
 
+          case 'g': // interface usage: atom_update("get state",       natoms, dp=null, ip=nelements, fp=null, dpp=state=null);
+          case 'o': // interface usage: atom_update("overwrite state", natoms, dp=null, ip=nelements, fp=null, dpp=state);
+          {
+              int32_t *const nelements = ip; assert(nullptr != nelements);
+              for (size_t ia = 0; ia < a.size(); ++ia) {
+                  auto const n = a[ia]->get_state_size();
+                  if ('o' == how) {
+                      assert(nullptr != dpp);
+                      if (n != nelements[ia]) {
+                          warn("%s: atom #%ld expects %ld state elements but got %d", what, ia, n, nelements[ia]);
+                          ++stat;
+                      } else {
+                          a[ia]->get_or_set_state(dpp[ia], true);
+                      }
+                  } else {
+                      nelements[ia] = n; // export the number of state elements
+                      if (nullptr != dpp) a[ia]->get_or_set_state(dpp[ia], false);
+                  } // how
+              } // ia
+              assert(!dp); assert(!fp); // all other arguments must be nullptr (by default)
+          }
+          break;
+
           default:
           {
               if (echo > 0) std::printf("# %s: first argument \'%s\' undefined, no action!\n", __func__, what);
@@ -0,0 +1,28 @@
+#!/usr/bin/env bash
+
+exe=../src/a43
+
+## Sweep over the kernels of the grid Hamiltonian and of the Green function.
+## The first run stores a baseline, later runs compare against it:
+##     ./kernel_benchmark.sh                   # compare to kernel_benchmark.baseline.dat if it exists
+##     ./kernel_benchmark.sh store             # overwrite the baseline
+
+baseline=kernel_benchmark.baseline.dat
+out=kernel_benchmark.out
+rm -f $out; echo -n "# " > $out; date >> $out
+
+if [ "$1" == "store" ] || [ ! -f $baseline ]; then
+  options="+kernel_benchmark.store=$baseline"
+else
+  options="+kernel_benchmark.baseline=$baseline"
+fi
+
+$exe -test kernel_benchmark \
+      +verbosity=4 \
+      +kernel_benchmark.sweep=1 \
+      +kernel_benchmark.repeat=5 \
+      +kernel_benchmark.tolerance=0.2 \
+      $options \
+      >> $out
+
+grep -e '^# kernel_benchmark' -e 'times the baseline' $out